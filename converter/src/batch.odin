@@ -0,0 +1,313 @@
+package program
+
+import "core:os"
+import "core:fmt"
+import "core:mem"
+import "core:sync"
+import "core:time"
+import "core:thread"
+import "base:runtime"
+import "core:c/libc"
+import "core:mem/virtual"
+import str "core:strings"
+
+// Batch conversion:
+// A batch converts a set of independent translation units on a fixed number of worker threads.
+// Workers grab the next unconverted unit whenever they are done with one, so long units don't hold up short ones.
+// Files referenced by path get read and tokenized once per token cache and are shared by all units that include them,
+// every unit gets its own input map on top of those because the preprocessor marks inputs as used.
+//
+// Everything a unit allocates lives in an arena that is dropped once the unit is done, only the output is kept.
+// A unit that fails (see batch_abort_current_unit) is dropped the same way and the worker moves on to the next one.
+
+BatchFile :: struct {
+	name : string, // name the preprocessor resolves includes to
+	path : string, // file to read relative to the cache root, shared between units through the token cache
+	content : string, // used instead if there is no path, tokenized for each unit
+}
+
+BatchUnit :: struct {
+	name : string,
+	entry_file : string,
+	files : []BatchFile,
+	ignored_identifiers : []string,
+	known_defines : []PreProcKnownDefine,
+	implicit_names : [][2]string,
+	record_xrefs : bool,
+	// Optional. Runs on the worker right after conversion while the ast is still alive, anything appended to ctx.result ends up in the output.
+	finish : proc(unit : ^BatchUnit, ctx : ^ConverterContext),
+	user_data : rawptr,
+}
+
+BatchPhase :: enum {
+	Tokenize,
+	Preprocess,
+	Parse,
+	Convert,
+	Finish,
+}
+
+BatchResult :: struct {
+	output : string,
+	timings : [BatchPhase]time.Duration,
+	convert_bytes_allocated, convert_temp_bytes_allocated : int,
+	done : bool, // false if the unit aborted
+}
+
+BatchCachedFile :: struct {
+	content : []u8,
+	tokens  : []Token,
+}
+
+BatchTokenCache :: struct {
+	root : string, // prepended to file paths when reading
+	mutex : sync.Mutex,
+	allocator : runtime.Allocator, // has to be thread safe
+	files : map[string]BatchCachedFile,
+}
+
+Batch :: struct {
+	units : []BatchUnit,
+	results : []BatchResult,
+	next_unit : int,
+	tokens : ^BatchTokenCache,
+	output_allocator : runtime.Allocator,
+	worker_context : runtime.Context,
+
+	workers : [dynamic]^BatchWorker,
+}
+
+BatchWorker :: struct {
+	batch : ^Batch,
+	thread : ^thread.Thread,
+	unit : int,
+	unit_arena : virtual.Arena, // owned by the worker loop so aborted units get it dropped as well
+	abort_jump : libc.jmp_buf, // where batch_abort_current_unit resumes the worker loop
+	temp : runtime.Default_Temp_Allocator,
+}
+
+@(thread_local) batch_current_worker : ^BatchWorker
+
+// Converts all units and blocks until they are done. Results are in the same order as the units and allocated with context.allocator.
+// worker_count <= 0 uses one worker per core. Pass a cache to keep tokens of unchanged files around between batches.
+convert_batch :: proc(units : []BatchUnit, worker_count := 0, tokens : ^BatchTokenCache = nil) -> []BatchResult
+{
+	local_tokens : BatchTokenCache
+	defer if tokens == nil {
+		for path, file in local_tokens.files {
+			delete(path, local_tokens.allocator)
+			delete(file.content, local_tokens.allocator)
+			delete(file.tokens, local_tokens.allocator)
+		}
+		delete(local_tokens.files)
+	}
+
+	batch := Batch {
+		units = units,
+		results = make([]BatchResult, len(units)),
+		tokens = tokens,
+		output_allocator = context.allocator,
+		worker_context = context,
+	}
+	if batch.tokens == nil {
+		local_tokens.allocator = context.allocator
+		batch.tokens = &local_tokens
+	}
+
+	worker_count := worker_count
+	if worker_count <= 0 { worker_count = os.processor_core_count() }
+	worker_count = clamp(worker_count, 1, len(units))
+
+	for _ in 0..<worker_count { batch_start_worker(&batch) }
+
+	for worker in batch.workers {
+		thread.join(worker.thread)
+		thread.destroy(worker.thread)
+		free(worker)
+	}
+	delete(batch.workers)
+
+	return batch.results
+}
+
+// The unit the calling thread is converting, nil outside of batch workers.
+batch_current_unit :: proc() -> ^BatchUnit
+{
+	worker := batch_current_worker
+	return worker != nil ? &worker.batch.units[worker.unit] : nil
+}
+
+// Gives up on the current unit without taking the rest of the batch down with it. Meant to be called from an assertion_failure_proc.
+// Jumps back to the worker loop, which drops the unit arena and temp allocator and goes on with the next unit, the result keeps done = false.
+// Defers between the worker loop and the failure don't run, anything the unit allocated outside of its arena and temp allocator leaks.
+batch_abort_current_unit :: proc() -> !
+{
+	worker := batch_current_worker
+	assert(worker != nil, "Not running on a batch worker.")
+
+	libc.longjmp(&worker.abort_jump, 1)
+}
+
+@(private="file")
+batch_start_worker :: proc(batch : ^Batch)
+{
+	worker := new(BatchWorker, batch.output_allocator)
+	worker.batch = batch
+	worker.thread = thread.create(batch_worker_proc)
+	worker.thread.init_context = batch.worker_context
+	worker.thread.data = worker
+	append(&batch.workers, worker)
+
+	thread.start(worker.thread)
+}
+
+@(private="file")
+batch_worker_proc :: proc(current_thread : ^thread.Thread)
+{
+	worker := cast(^BatchWorker) current_thread.data
+	batch_current_worker = worker
+
+	// the context is copied from the thread that started the batch, the temp allocator can't be shared with it
+	runtime.default_temp_allocator_init(&worker.temp, runtime.DEFAULT_TEMP_ALLOCATOR_BACKING_SIZE, runtime.heap_allocator())
+	defer runtime.default_temp_allocator_destroy(&worker.temp)
+	context.temp_allocator = runtime.default_temp_allocator(&worker.temp)
+
+	for {
+		worker.unit = sync.atomic_add(&worker.batch.next_unit, 1)
+		if worker.unit >= len(worker.batch.units) { break }
+
+		// setjmp returns again, non zero, when the unit aborts. Locals of this proc are not modified after this point, so they are still valid then.
+		if libc.setjmp(&worker.abort_jump) == 0 {
+			batch_convert_unit(worker.batch, worker.unit, &worker.unit_arena)
+		}
+		virtual.arena_destroy(&worker.unit_arena)
+		free_all(context.temp_allocator)
+	}
+}
+
+@(private="file")
+batch_convert_unit :: proc(batch : ^Batch, index : int, unit_arena : ^virtual.Arena)
+{
+	unit   := &batch.units[index]
+	result := &batch.results[index]
+
+	context.allocator = virtual.arena_allocator(unit_arena)
+	displayed_nodes = {} // would otherwise point into the arena of the previous unit
+
+	phase_start := time.tick_now()
+
+	input_map := make(map[string]Input, len(unit.files))
+	for file in unit.files {
+		tokens : []Token
+		if file.path != "" {
+			tokens = batch_tokenize_shared(batch.tokens, file.path)
+		}
+		else {
+			toks : [dynamic]Token
+			tokenize(&toks, file.content, file.name)
+			tokens = toks[:]
+		}
+		input_map[file.name] = { tokens, false }
+	}
+	result.timings[.Tokenize] = time.tick_lap_time(&phase_start)
+
+	preprocessed : [dynamic]Token
+	preprocess(&{ result = &preprocessed, inputs = input_map, ignored_identifiers = unit.ignored_identifiers, known_defines = unit.known_defines }, unit.entry_file)
+	result.timings[.Preprocess] = time.tick_lap_time(&phase_start)
+
+	ast : [dynamic]AstNode
+	ast_context : AstContext = { ast = &ast }
+	root_sequence := ast_parse_filescope_sequence(&ast_context, preprocessed[:])
+	result.timings[.Parse] = time.tick_lap_time(&phase_start)
+
+	converter_context : ConverterContext = { ast = ast, type_heap = ast_context.type_heap, root_sequence = root_sequence[:], record_xrefs = unit.record_xrefs }
+	{
+		allocations      = { backing = context.allocator }
+		temp_allocations = { backing = context.temp_allocator }
+		context.allocator      = { allocation_counter_proc, &allocations }
+		context.temp_allocator = { allocation_counter_proc, &temp_allocations }
+
+		convert_and_format(&converter_context, unit.implicit_names)
+	}
+	result.convert_bytes_allocated      = allocations.bytes
+	result.convert_temp_bytes_allocated = temp_allocations.bytes
+	result.timings[.Convert] = time.tick_lap_time(&phase_start)
+
+	if unit.finish != nil { unit.finish(unit, &converter_context) }
+	result.output = str.clone(str.to_string(converter_context.result), batch.output_allocator)
+	result.timings[.Finish] = time.tick_lap_time(&phase_start)
+
+	result.done = true
+}
+
+@(private="file")
+batch_tokenize_shared :: proc(cache : ^BatchTokenCache, path : string) -> []Token
+{
+	sync.mutex_lock(&cache.mutex)
+	file, found := cache.files[path]
+	sync.mutex_unlock(&cache.mutex)
+	if found { return file.tokens }
+
+	// tokenize outside of the lock, if two units race for the same file the second result just gets dropped
+	{
+		context.allocator = cache.allocator
+
+		full_path := str.concatenate({ cache.root, path }, context.temp_allocator)
+		content, ok := os.read_entire_file(full_path)
+		if !ok { panic(fmt.tprintf("Failed to read %v from %v", path, full_path)) }
+
+		toks : [dynamic]Token
+		tokenize(&toks, cast(string) content, path)
+		file = { content, toks[:] }
+	}
+
+	sync.mutex_lock(&cache.mutex)
+	defer sync.mutex_unlock(&cache.mutex)
+
+	if existing, raced := cache.files[path]; raced {
+		delete(file.content, cache.allocator)
+		delete(file.tokens, cache.allocator)
+		return existing.tokens
+	}
+
+	if cache.files == nil { cache.files = make(map[string]BatchCachedFile, cache.allocator) }
+	cache.files[str.clone(path, cache.allocator)] = file
+	return file.tokens
+}
+
+// Drops a file from the cache so the next batch reads it again.
+batch_invalidate_file :: proc(cache : ^BatchTokenCache, path : string) -> (was_cached : bool)
+{
+	sync.mutex_lock(&cache.mutex)
+	defer sync.mutex_unlock(&cache.mutex)
+
+	key, file := delete_key(&cache.files, path)
+	if key == "" { return false }
+
+	delete(key, cache.allocator)
+	delete(file.content, cache.allocator)
+	delete(file.tokens, cache.allocator)
+	return true
+}
+
+
+// Counts how many bytes were requested during conversion, the counters have to outlive the unit because
+// ctx keeps allocating through whatever allocator it first saw.
+@(private="file", thread_local) allocations, temp_allocations : AllocationCounter
+
+AllocationCounter :: struct {
+	backing : mem.Allocator,
+	bytes : int,
+}
+
+allocation_counter_proc :: proc(allocator_data : rawptr, mode : mem.Allocator_Mode, size, alignment : int, old_memory : rawptr, old_size : int, loc := #caller_location) -> ([]byte, mem.Allocator_Error)
+{
+	counter := cast(^AllocationCounter) allocator_data
+	#partial switch mode {
+		case .Alloc, .Alloc_Non_Zeroed:
+			counter.bytes += size
+		case .Resize, .Resize_Non_Zeroed:
+			counter.bytes += max(0, size - old_size)
+	}
+	return counter.backing.procedure(counter.backing.data, mode, size, alignment, old_memory, old_size, loc)
+}
@@ -22,6 +22,10 @@ ConverterContext :: struct {
 	root_sequence : []AstNodeIndex,
 	overload_resolver : map[string][dynamic]string,
 	synthetic_struct_index : int,
+
+	record_xrefs : bool, // collect definitions and references for write_xref_index
+	xref_definitions : map[AstNodeIndex]int, // definition -> offset into result
+	xref_references : [dynamic]XrefRecordedReference,
 }
 
 convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string)
@@ -43,6 +47,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 
 
 
+		cvt_reserve_output(ctx)
 		str.write_string(&ctx.result, "package test\n\n")
 		_ = write_node_sequence(ctx, ctx.root_sequence, 0, "")
 	}
@@ -51,6 +56,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 	write_node :: proc(ctx : ^ConverterContext, current_node_index : AstNodeIndex, scope_node : AstNodeIndex, indent_str := "") -> (did_clobber : bool, requires_termination, requires_new_paragraph, swallow_paragraph : bool)
 	{
 		current_node := &ctx.ast[current_node_index]
+		cvt_record_definition(ctx, current_node_index)
 		node_kind_switch: #partial switch current_node.kind {
 			case .NewLine:
 				str.write_byte(&ctx.result, '\n')
@@ -185,8 +191,8 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 					if arg.kind != .Ellipsis {
 						if arg_count > 0 { str.write_string(&ctx.result, ", ") }
 						str.write_string(&ctx.result, arg.source)
-						str.write_string(&ctx.result, " : ")
-						fmt.sbprintf(&ctx.result, "$T%v", arg_count)
+						str.write_string(&ctx.result, " : $T")
+						str.write_int(&ctx.result, arg_count)
 
 						arg_count += 1
 					}
@@ -222,7 +228,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 
 				str.write_string(&ctx.result, ") //TODO @gen: Validate the parameters were not passed by reference.\n")
 				str.write_string(&ctx.result, indent_str); str.write_string(&ctx.result, "{\n")
-				current_member_indent_str := str.concatenate({ indent_str, ONE_INDENT }, context.temp_allocator)
+				current_member_indent_str := cvt_indent(indent_str)
 
 				for i in idents_to_stringify {
 					str.write_string(&ctx.result, current_member_indent_str)
@@ -304,7 +310,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 					}
 				}
 
-				member_indent_str := str.concatenate({ indent_str, ONE_INDENT }, context.temp_allocator)
+				member_indent_str := cvt_indent(indent_str)
 				clobber, swallow, new_para := write_struct_union(ctx, current_node, current_node_index, indent_str, member_indent_str)
 				did_clobber |= clobber
 				swallow_paragraph |= swallow
@@ -382,7 +388,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 
 				bleed_scope := structure.parent_structure != 0 ? structure.parent_structure : structure.parent_scope
 
-				member_indent_str := str.concatenate({ indent_str, ONE_INDENT }, context.temp_allocator)
+				member_indent_str := cvt_indent(indent_str)
 				last_was_newline := false
 				for cii := 0; cii < len(structure.members); cii += 1 {
 					ci := structure.members[cii]
@@ -456,13 +462,13 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 							str.write_byte(&ctx.result, '\n')
 
 							str.write_string(&ctx.result, indent_str); str.write_string(&ctx.result, "{")
-							body_indent_str := str.concatenate({ indent_str, ONE_INDENT }, context.temp_allocator)
+							body_indent_str := cvt_indent(indent_str)
 							did_clobber |= write_node_sequence(ctx, function.body_sequence[:], current_node_index, body_indent_str)
 							str.write_string(&ctx.result, indent_str); str.write_byte(&ctx.result, '}')
 					}
 				}
 				else {
-					member_indent_str := str.concatenate({ indent_str, ONE_INDENT }, context.temp_allocator)
+					member_indent_str := cvt_indent(indent_str)
 
 					captures_struct_name := "__l_0_captures" // TODO
 					function_name := "__l_0_function" // TODO
@@ -953,6 +959,14 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 						else {
 							expression_type_node := maybe_follow_typedef(ctx, scope_node /*@correctness wrong*/, expression_type_node)
 
+							if ctx.record_xrefs {
+								#partial switch ctx.ast[expression_type_node].kind {
+									case .Struct, .Union:
+										method, _ := try_find_definition_for_name(ctx, expression_type_node, member.function_call.expression, { .Function })
+										cvt_record_reference(ctx, method, fn_name_expr.identifier.token.location)
+								}
+							}
+
 							if containing_scope_idx := cvt_get_parent_scope(ctx, expression_type_node)^; containing_scope_idx != 0 {
 								containing_scope := ctx.ast[containing_scope_idx]
 								if containing_scope.kind == .Namespace {
@@ -998,6 +1012,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 
 
 					if member_definition_idx != 0 {
+						cvt_record_reference(ctx, member_definition_idx, member.identifier.token.location)
 						str.write_string(&ctx.result, get_simple_name_string(ctx, member_definition_idx))
 					}
 					else {
@@ -1029,6 +1044,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 				definition_index, parent_index := find_definition_for_name(ctx, scope_node, current_node_index)
 				definition := ctx.ast[definition_index]
 				parent := ctx.ast[parent_index]
+				cvt_record_reference(ctx, definition_index, current_node.identifier.token.location)
 
 				if definition.kind != .TemplateVariableDeclaration && (parent.kind == .Struct || parent.kind == .Union) && .Static not_in definition.var_declaration.flags {
 					str.write_string(&ctx.result, "this.")
@@ -1079,6 +1095,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 						case:
 							definition, _ = try_find_definition_for_name(ctx, scope_node, fncall.expression)
 							if definition != 0 {
+								cvt_record_reference(ctx, definition, expr.identifier.token.location)
 								write_complete_name_string(ctx, &ctx.result, definition)
 							}
 							else {
@@ -1117,7 +1134,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 				requires_termination = true
 
 			case .CompoundInitializer:
-				body_indent_str := str.concatenate({ indent_str, ONE_INDENT }, context.temp_allocator)
+				body_indent_str := cvt_indent(indent_str)
 
 				body := current_node.compound_initializer.values[:]
 				str.write_byte(&ctx.result, '{')
@@ -1195,7 +1212,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 					c, _, _, _ := write_node(ctx, loop.loop_statement[0], current_node_index); did_clobber |= c
 				}
 
-				body_indent_str := str.concatenate({ indent_str, ONE_INDENT }, context.temp_allocator)
+				body_indent_str := cvt_indent(indent_str)
 				if len(loop.condition) != 0 && current_node.kind == .Do {
 					assert_eq(len(loop.condition), 1)
 					switch len(loop.body_sequence) {
@@ -1346,7 +1363,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 	
 						case:
 							str.write_string(&ctx.result, " {")
-							body_indent_str = str.concatenate({ indent_str, ONE_INDENT }, context.temp_allocator)
+							body_indent_str = cvt_indent(indent_str)
 							did_clobber |= write_node_sequence(ctx, true_branch.sequence.members[:], branch.true_branch, body_indent_str)
 							if ctx.ast[last(true_branch.sequence.members[:])^].kind == .NewLine {
 								str.write_string(&ctx.result, indent_str);
@@ -1397,7 +1414,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 							str.write_byte(&ctx.result, '\n')
 							str.write_string(&ctx.result, indent_str)
 							str.write_string(&ctx.result, "else {")
-							if body_indent_str == "" { body_indent_str = str.concatenate({ indent_str, ONE_INDENT }, context.temp_allocator) }
+							if body_indent_str == "" { body_indent_str = cvt_indent(indent_str) }
 							did_clobber |= write_node_sequence(ctx, false_branch.sequence.members[:], branch.false_branch, body_indent_str)
 							str.write_string(&ctx.result, indent_str)
 							str.write_byte(&ctx.result, '}')
@@ -1413,7 +1430,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 
 				str.write_string(&ctx.result, " {\n")
 				
-				case_body_indent_str := str.concatenate({ indent_str, ONE_INDENT, ONE_INDENT }, context.temp_allocator)
+				case_body_indent_str := cvt_indent(indent_str, 2)
 				case_indent_str := case_body_indent_str[:len(case_body_indent_str) - len(ONE_INDENT)]
 
 				for case_, case_i in switch_.cases {
@@ -1469,7 +1486,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 				call := current_node.operator_call
 
 				str.write_string(&ctx.result, "operator_")
-				fmt.sbprint(&ctx.result, call.kind)
+				cvt_write_enum(&ctx.result, call.kind)
 				str.write_byte(&ctx.result, '(')
 				for aidx, i in call.parameters {
 					if i != 0 { str.write_string(&ctx.result, ", ") }
@@ -1706,7 +1723,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 			}
 
 			if node_kind == .Label { // :LabelConversion
-				member_indent_str := str.concatenate({ indent_str, ONE_INDENT }, context.temp_allocator)
+				member_indent_str := cvt_indent(indent_str)
 				
 				str.write_string(&ctx.result, ctx.ast[ci].label.source)
 				str.write_string(&ctx.result, ": for {\n")
@@ -2066,7 +2083,8 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 			str.write_byte(&ctx.result, '\n')
 			str.write_string(&ctx.result, member_indent_str)
 			str.write_string(&ctx.result, "using ")
-			str.write_string(&ctx.result, str.concatenate({ "__base_", str.to_lower(ctx.type_heap[structure.base_type].(AstTypeFragment).identifier.source, context.temp_allocator) }))
+			str.write_string(&ctx.result, "__base_")
+			cvt_write_lower(&ctx.result, ctx.type_heap[structure.base_type].(AstTypeFragment).identifier.source)
 			str.write_string(&ctx.result, " : ")
 			write_complete_name_string(ctx, &ctx.result, ctx.ast[base_type].structure.name)
 			str.write_string(&ctx.result, ",\n")
@@ -2086,7 +2104,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 		write_bitfield_subsection_and_reset :: proc(ctx : ^ConverterContext, subsection_data : ^SubsectionSectionData, scope_node : AstNodeIndex, indent_str : string) -> (did_clobber : bool)
 		{
 			if len(subsection_data.member_indent_str) == 0 {
-				subsection_data.member_indent_str = str.concatenate({ indent_str, ONE_INDENT }, context.temp_allocator)
+				subsection_data.member_indent_str = cvt_indent(indent_str)
 			}
 
 			slice := sa.slice(&subsection_data.member_stack)
@@ -2111,7 +2129,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 
 			str.write_string(&ctx.result, indent_str);
 			str.write_string(&ctx.result, "using _");
-			fmt.sbprint(&ctx.result, subsection_data.subsection_counter); subsection_data.subsection_counter += 1
+			str.write_int(&ctx.result, subsection_data.subsection_counter); subsection_data.subsection_counter += 1
 			str.write_string(&ctx.result, " : bit_field u");
 			str.write_int(&ctx.result, final_bit_width)
 			str.write_string(&ctx.result, " {\n");
@@ -2296,9 +2314,9 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 					else { str.write_byte(&ctx.result, ' ') }
 
 					str.write_string(&ctx.result, "using _")
-					fmt.sbprint(&ctx.result, subsection_data.subsection_counter); subsection_data.subsection_counter += 1
+					str.write_int(&ctx.result, subsection_data.subsection_counter); subsection_data.subsection_counter += 1
 					str.write_string(&ctx.result, " : ")
-					inner_member_indent_str :=  str.concatenate({ member_indent_str, ONE_INDENT }, context.temp_allocator)
+					inner_member_indent_str :=  cvt_indent(member_indent_str)
 					did_clobber, _ = write_struct_union_type(ctx, member, ci, member_indent_str, inner_member_indent_str)
 					str.write_byte(&ctx.result, ',')
 					
@@ -2807,7 +2825,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 				str.write_byte(&ctx.result, '\n')
 
 				str.write_string(&ctx.result, indent_str); str.write_string(&ctx.result, "{")
-				body_indent_str := str.concatenate({ indent_str, ONE_INDENT }, context.temp_allocator)
+				body_indent_str := cvt_indent(indent_str)
 
 				if len(initializations) != 0 {
 					for mi in initializations {
@@ -2901,6 +2919,7 @@ convert_and_format :: proc(ctx : ^ConverterContext, implicit_names : [][2]string
 						case:
 							type_name_idx := try_find_definition_for(ctx, scope_node, type)
 							if type_name_idx != 0 {
+								cvt_record_reference(ctx, type_name_idx, frag.identifier.location)
 								write_complete_name_string(ctx, &ctx.result, type_name_idx)
 							}
 							else {
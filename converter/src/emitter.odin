@@ -0,0 +1,39 @@
+package program
+
+import "core:fmt"
+import str "core:strings"
+
+// Helpers for the write path in convert_and_format. Everything in there should write straight into ctx.result
+// through these or str.write_*, without going through fmt or building temporary strings.
+
+// Indentation only ever consists of tabs, so each level is just a longer slice of this.
+@(private="file")
+INDENTS :: "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"
+
+cvt_indent :: #force_inline proc(indent_str : string, levels := 1) -> string
+{
+	depth := len(indent_str) + levels
+	if depth <= len(INDENTS) { return INDENTS[:depth] }
+	return str.concatenate({ indent_str, INDENTS[:levels] }, context.temp_allocator)
+}
+
+// Reserves the output buffer up front so it doesn't keep reallocating while growing to a few MB.
+cvt_reserve_output :: proc(ctx : ^ConverterContext)
+{
+	BYTES_PER_NODE_GUESS :: 16 // only a guess, the builder still grows past this if needed
+	reserve(&ctx.result.buf, len(ctx.result.buf) + len(ctx.ast) * BYTES_PER_NODE_GUESS)
+}
+
+// Lowercases ascii only, identifiers don't contain anything else.
+cvt_write_lower :: proc(sb : ^str.Builder, identifier : string)
+{
+	for c in transmute([]u8) identifier {
+		str.write_byte(sb, 'A' <= c && c <= 'Z' ? c + ('a' - 'A') : c)
+	}
+}
+
+cvt_write_enum :: #force_inline proc(sb : ^str.Builder, value : $E)
+{
+	name, _ := fmt.enum_value_to_string(value)
+	str.write_string(sb, name)
+}
@@ -1,389 +1,295 @@
 package program
 
 import "core:os"
-import "core:fmt"
 import "core:log"
+import "core:time"
+import "core:slice"
 import str "core:strings"
 
 
 IMGUI_PATH :: #directory + "../../imgui/"
 
-main :: proc()
-{
-	context.logger = log.create_console_logger()
+ConversionJob :: struct {
+	name : string,
+	output : string, // relative to imgui/out, without extension
+	unit : proc() -> BatchUnit,
+	write_shim : bool,
+}
 
-	process_main_files()
-	process_dx11_backend()
-	process_win32_backend()
+conversion_jobs := [?]ConversionJob {
+	{ name = "main files", output = "imgui_gen", write_shim = true, unit = main_files_unit },
+	{ name = "dx11 backend", output = "backends/dx11/backend", unit = dx11_backend_unit },
+	{ name = "win32 backend", output = "backends/win32/backend", unit = win32_backend_unit },
+}
 
-	log.info("Done!")
+main_files := []BatchFile {
+	{ name = "imgui.h", path = "imgui.h" },
+	{ name = "imgui.cpp", path = "imgui.cpp" },
+	{ name = "imgui_internal.h", path = "imgui_internal.h" },
+	{ name = "imgui_draw.cpp", path = "imgui_draw.cpp" },
+	{ name = "imgui_tables.cpp", path = "imgui_tables.cpp" },
+	{ name = "imgui_widgets.cpp", path = "imgui_widgets.cpp" },
+	{ name = "imstb_textedit.h", path = "imstb_textedit.h" },
+	{ name = "misc/freetype/imgui_freetype.h", path = "misc/freetype/imgui_freetype.h" },
+	{ name = "misc/freetype/imgui_freetype.cpp", path = "misc/freetype/imgui_freetype.cpp" },
+	{ name = "imconfig.h" }, // { name = "imconfig.h", path = "imconfig.h" },
+	{ name = "win32_type_shim.cpp", content = #load(IMGUI_PATH + "/win32_type_shim.cpp") },
+	{ name = "init_shim.cpp", content = `
+		//
+		// shim
+		//
+		#define int int
+		#define bool bool
+		//
+		// win32
+		//
+		#include "win32_type_shim.cpp"
+		//
+		// imgui.cpp
+		//
+		#include "imgui.cpp"
+		//
+		// imgui_draw.cpp
+		//
+		#include "imgui_draw.cpp"
+		//
+		// imgui_widgets.cpp
+		//
+		#include "imgui_widgets.cpp"
+		//
+		// imgui_tables.cpp
+		//
+		#include "imgui_tables.cpp"
+
+	` },
 }
 
-tokenize_file :: proc(map_ :  ^map[string]Input, path : string, alias : string = "")
+main_files_unit :: proc() -> BatchUnit
 {
-	full_path := str.concatenate({ IMGUI_PATH + "in/", path }, context.temp_allocator)
-	content, ok := os.read_entire_file(full_path)
-	if !ok { panic(fmt.tprintf("Failed to read %v from %v", path, full_path)) }
-
-	toks : [dynamic]Token
-	tokenize(&toks, cast(string) content, path)
+	return {
+		entry_file = "init_shim.cpp",
+		files = main_files,
+		ignored_identifiers = ignored_identifiers,
+		known_defines = known_defines,
+		implicit_names = replaced_names,
+		record_xrefs = true,
+	}
+}
 
-	map_[alias == "" ? path : alias] = { toks[:], false }
+dx11_backend_files := []BatchFile {
+	{ name = "imgui.h", path = "imgui.h" },
+	{ name = "imgui_impl_dx11.h", path = "backends/imgui_impl_dx11.h" },
+	{ name = "imgui_impl_dx11.cpp", path = "backends/imgui_impl_dx11.cpp" },
+	{ name = "imconfig.h" }, // { name = "imconfig.h", path = "imconfig.h" },
+	{ name = "win32_type_shim.cpp", content = #load(IMGUI_PATH + "/win32_type_shim.cpp") },
+	{ name = "d3d11_type_shim.cpp", content = #load(IMGUI_PATH + "/d3d11_type_shim.cpp") },
+	{ name = "init_shim.cpp", content = `
+		//
+		// shim
+		//
+		#define int int
+		#define bool bool
+		//
+		// win32
+		//
+		#include "win32_type_shim.cpp"
+		//
+		// D3D11
+		//
+		#include "d3d11_type_shim.cpp"
+		//
+		// impl
+		//
+		#include "imgui_impl_dx11.cpp"
+	` },
 }
 
-process_main_files :: proc()
+dx11_backend_unit :: proc() -> BatchUnit
 {
-	input_map : map[string]Input
-
-	tokenize_file(&input_map, "imgui.h")
-	tokenize_file(&input_map, "imgui.cpp")
-	tokenize_file(&input_map, "imgui_internal.h")
-	tokenize_file(&input_map, "imgui_draw.cpp")
-	tokenize_file(&input_map, "imgui_tables.cpp")
-	tokenize_file(&input_map, "imgui_widgets.cpp")
-	tokenize_file(&input_map, "imstb_textedit.h")
-	tokenize_file(&input_map, "misc/freetype/imgui_freetype.h")
-	tokenize_file(&input_map, "misc/freetype/imgui_freetype.cpp")
-	
-	{
-		//tokenize_file(&input_map, "imconfig.h")
-		input_map["imconfig.h"] = { {}, false}
+	return {
+		entry_file = "init_shim.cpp",
+		files = dx11_backend_files,
+		ignored_identifiers = ignored_identifiers,
+		known_defines = known_defines,
+		implicit_names = replaced_names,
+		record_xrefs = true,
 	}
+}
 
-	{
-		toks : [dynamic]Token
-		tokenize(&toks, `
-			//
-			// shim
-			//
-			#define int int
-			#define bool bool
-			//
-			// win32
-			//
-			#include "win32_type_shim.cpp"
-			//
-			// imgui.cpp
-			//
-			#include "imgui.cpp"
-			//
-			// imgui_draw.cpp
-			//
-			#include "imgui_draw.cpp"
-			//
-			// imgui_widgets.cpp
-			//
-			#include "imgui_widgets.cpp"
-			//
-			// imgui_tables.cpp
-			//
-			#include "imgui_tables.cpp"
-
-		`, "init_shim.cpp")
-		input_map["init_shim.cpp"] = { toks[:], false}
-	}
-	{
-		toks : [dynamic]Token
-		tokenize(&toks, #load(IMGUI_PATH + "/win32_type_shim.cpp"), "win32_type_shim.cpp")
-		input_map["win32_type_shim.cpp"] = { toks[:], false}
-	}
+win32_backend_files := []BatchFile {
+	{ name = "imgui.h", path = "imgui.h" },
+	{ name = "imgui_impl_win32.h", path = "backends/imgui_impl_win32.h" },
+	{ name = "imgui_impl_win32.cpp", path = "backends/imgui_impl_win32.cpp" },
+	{ name = "imconfig.h" }, // { name = "imconfig.h", path = "imconfig.h" },
+	{ name = "win32_type_shim.cpp", content = #load(IMGUI_PATH + "/win32_type_shim.cpp") },
+	{ name = "init_shim.cpp", content = `
+		//
+		// shim
+		//
+		#define int int
+		#define bool bool
+		//
+		// win32
+		//
+		#include "win32_type_shim.cpp"
+		//
+		// impl
+		//
+		#include "imgui_impl_win32.cpp"
+	` },
+}
 
-	ignored_identifiers := []string {
-		"IM_MSVC_RUNTIME_CHECKS_OFF",
-		"IM_MSVC_RUNTIME_CHECKS_RESTORE",
-		"IMGUI_API",
-		"IMGUI_CDECL",
+win32_backend_unit :: proc() -> BatchUnit
+{
+	return {
+		entry_file = "init_shim.cpp",
+		files = win32_backend_files,
+		ignored_identifiers = win32_ignored_identifiers,
+		known_defines = known_defines,
+		implicit_names = replaced_names,
+		record_xrefs = true,
 	}
+}
 
-	removed_ifs := []PreProcRemoveIfData {
-		{ "IMGUI_DISABLE_OBSOLETE_FUNCTIONS", true },
-		{ "IM_VEC2_CLASS_EXTRA", false },
-		{ "IM_VEC4_CLASS_EXTRA", false },
-		{ "0", false },
-		{ "false", false },
-		{ "true", true },
-	}
 
-	preprocessed : [dynamic]Token
-	preprocess(&{ result = &preprocessed, inputs = input_map, ignored_identifiers = ignored_identifiers, removed_ifs = removed_ifs }, "init_shim.cpp")
-
-	ast  : [dynamic]AstNode
-	ast_context : AstContext = { ast = &ast }
-	root_sequence := ast_parse_filescope_sequence(&ast_context, preprocessed[:])
-
-	converter_context : ConverterContext = { ast = ast, type_heap = ast_context.type_heap, root_sequence = root_sequence[:] }
-	replaced_names := [][2]string {
-		{ "INT_MAX", "max(i32)" },
-		{ "INT_MIN", "min(i32)" },
-		{ "UINT_MAX", "max(u32)" },
-		{ "UINT_MIN", "min(u32)" },
-		{ "LLONG_MAX", "max(i64)" },
-		{ "LLONG_MIN", "min(i64)" },
-		{ "ULLONG_MAX", "max(u64)" },
-		{ "FLT_MAX", "max(f32)" },
-		{ "FLT_MIN", "min(f32)" },
-		{ "DBL_MAX", "max(f64)" },
-		{ "DBL_MIN", "min(f64)" },
-		{ "CP_UTF8", "win32.CP_UTF8" },
-		{ "FILENAME_MAX", "win32.FILENAME_MAX" },
-		{ "CF_UNICODETEXT", "win32.CF_UNICODETEXT" },
-		{ "GMEM_MOVEABLE", "win32.GMEM_MOVEABLE" },
-		{ "SW_SHOWDEFAULT", "win32.SW_SHOWDEFAULT" },
-		{ "CFS_FORCE_POSITION", "win32.CFS_FORCE_POSITION" },
-		{ "CFS_CANDIDATEPOS", "win32.CFS_CANDIDATEPOS" },
-
-		// { "stbrp_rect", "stbrp.rect" },
-		// { "stbrp_coord", "stbrp.coord" },
-		// { "stbrp_context", "stbrp.context" },
-
-		// { "stbtt_pack_context", "stbtt.pack_context" },
-		// { "stbtt_aligned_quad", "stbtt.aligned_quad" },
-		// { "stbtt_fontinfo", "stbtt.fontinfo" },
-		// { "stbtt_pack_range", "stbtt.pack_range" },
-		// { "stbtt_packedchar", "stbtt.packedchar" },
-		{ "stbtt_GetFontOffsetForIndex", "stbtt.GetFontOffsetForIndex" },
-
-		{ "kPasteboardClipboard", "ios.kPasteboardClipboard" },
-		{ "kCFAllocatorDefault", "ios.kCFAllocatorDefault" },
-		{ "noErr", "ios.noErr" },
-
-		{ "stdout", "stdout" }, // TODO
-		{ "stdin" , "stdin"  }, // TODO
-		{ "stderr", "stderr" }, // TODO
-		{ "SEEK_END", "SEEK_END" }, // TODO
-		{ "SEEK_SET", "SEEK_SET" }, // TODO
-	}
-	convert_and_format(&converter_context, replaced_names)
-	os.write_entire_file(IMGUI_PATH + "out/imgui_gen.odin", converter_context.result.buf[:])
+ignored_identifiers := []string {
+	"IM_MSVC_RUNTIME_CHECKS_OFF",
+	"IM_MSVC_RUNTIME_CHECKS_RESTORE",
+	"IMGUI_API",
+	"IMGUI_CDECL",
+}
 
-	str.builder_reset(&converter_context.result)
-	write_shim(&converter_context)
-	os.write_entire_file(IMGUI_PATH + "out/shim.odin", converter_context.result.buf[:])
+win32_ignored_identifiers := []string {
+	"IM_MSVC_RUNTIME_CHECKS_OFF",
+	"IM_MSVC_RUNTIME_CHECKS_RESTORE",
+	"IMGUI_API",
+	"IMGUI_CDECL",
+	"WINAPI",
+	"CALLBACK",
+	"IMGUI_IMPL_API",
 }
 
+known_defines := []PreProcKnownDefine {
+	{ "IMGUI_DISABLE_OBSOLETE_FUNCTIONS", 1 },
+	{ "IMGUI_DISABLE", nil },
+	{ "IMGUI_DISABLE_SSE", 1 },
+	{ "IMGUI_DISABLE_NEON", 1 },
+	{ "IMGUI_ENABLE_NEON", nil },
+	{ "IMGUI_DISABLE_SIMD_POLYLINE", 1 },
+	{ "IMGUI_ENABLE_SIMD_POLYLINE", nil },
+	{ "IMGUI_DISABLE_SIMD_TEXT", 1 },
+	{ "IMGUI_ENABLE_SIMD_TEXT", nil },
+	{ "IMGUI_DISABLE_DRAWLIST_SHAPE_TEMPLATES", nil },
+	{ "IMGUI_DISABLE_TEXT_LAYOUT_CACHE", nil },
+	{ "IMGUI_ENABLE_TEST_ENGINE", nil },
+	{ "IM_VEC2_CLASS_EXTRA", nil },
+	{ "IM_VEC4_CLASS_EXTRA", nil },
+	{ "__clang__", nil },
+	{ "__GNUC__", nil },
+	{ "__APPLE__", nil },
+	{ "__EMSCRIPTEN__", nil },
+}
 
-process_dx11_backend :: proc()
+replaced_names := [][2]string {
+	{ "INT_MAX", "max(i32)" },
+	{ "INT_MIN", "min(i32)" },
+	{ "UINT_MAX", "max(u32)" },
+	{ "UINT_MIN", "min(u32)" },
+	{ "LLONG_MAX", "max(i64)" },
+	{ "LLONG_MIN", "min(i64)" },
+	{ "ULLONG_MAX", "max(u64)" },
+	{ "FLT_MAX", "max(f32)" },
+	{ "FLT_MIN", "min(f32)" },
+	{ "DBL_MAX", "max(f64)" },
+	{ "DBL_MIN", "min(f64)" },
+	{ "CP_UTF8", "win32.CP_UTF8" },
+	{ "FILENAME_MAX", "win32.FILENAME_MAX" },
+	{ "CF_UNICODETEXT", "win32.CF_UNICODETEXT" },
+	{ "GMEM_MOVEABLE", "win32.GMEM_MOVEABLE" },
+	{ "SW_SHOWDEFAULT", "win32.SW_SHOWDEFAULT" },
+	{ "CFS_FORCE_POSITION", "win32.CFS_FORCE_POSITION" },
+	{ "CFS_CANDIDATEPOS", "win32.CFS_CANDIDATEPOS" },
+
+	// { "stbrp_rect", "stbrp.rect" },
+	// { "stbrp_coord", "stbrp.coord" },
+	// { "stbrp_context", "stbrp.context" },
+
+	// { "stbtt_pack_context", "stbtt.pack_context" },
+	// { "stbtt_aligned_quad", "stbtt.aligned_quad" },
+	// { "stbtt_fontinfo", "stbtt.fontinfo" },
+	// { "stbtt_pack_range", "stbtt.pack_range" },
+	// { "stbtt_packedchar", "stbtt.packedchar" },
+	{ "stbtt_GetFontOffsetForIndex", "stbtt.GetFontOffsetForIndex" },
+
+	{ "kPasteboardClipboard", "ios.kPasteboardClipboard" },
+	{ "kCFAllocatorDefault", "ios.kCFAllocatorDefault" },
+	{ "noErr", "ios.noErr" },
+
+	{ "stdout", "stdout" }, // TODO
+	{ "stdin" , "stdin"  }, // TODO
+	{ "stderr", "stderr" }, // TODO
+	{ "SEEK_END", "SEEK_END" }, // TODO
+	{ "SEEK_SET", "SEEK_SET" }, // TODO
+}
+
+main :: proc()
 {
-	input_map : map[string]Input
-
-	tokenize_file(&input_map, "imgui.h")
-	tokenize_file(&input_map, "backends/imgui_impl_dx11.h", "imgui_impl_dx11.h")
-	tokenize_file(&input_map, "backends/imgui_impl_dx11.cpp", "imgui_impl_dx11.cpp")
-	
-	{
-		//tokenize_file(&input_map, "imconfig.h")
-		input_map["imconfig.h"] = { {}, false}
-	}
+	context.logger = log.create_console_logger()
 
-	{
-		toks : [dynamic]Token
-		tokenize(&toks, `
-			//
-			// shim
-			//
-			#define int int
-			#define bool bool
-			//
-			// win32
-			//
-			#include "win32_type_shim.cpp"
-			//
-			// D3D11
-			//
-			#include "d3d11_type_shim.cpp"
-			//
-			// impl
-			//
-			#include "imgui_impl_dx11.cpp"
-		`, "init_shim.cpp")
-		input_map["init_shim.cpp"] = { toks[:], false }
-	}
-	{
-		toks : [dynamic]Token
-		tokenize(&toks, #load(IMGUI_PATH + "/win32_type_shim.cpp"), "win32_type_shim.cpp")
-		input_map["win32_type_shim.cpp"] = { toks[:], false }
-	}
-	{
-		toks : [dynamic]Token
-		tokenize(&toks, #load(IMGUI_PATH + "/d3d11_type_shim.cpp"), "d3d11_type_shim.cpp")
-		input_map["d3d11_type_shim.cpp"] = { toks[:], false }
+	if slice.contains(os.args[1:], "--watch") {
+		watch()
+		return
 	}
 
-	ignored_identifiers := []string {
-		"IM_MSVC_RUNTIME_CHECKS_OFF",
-		"IM_MSVC_RUNTIME_CHECKS_RESTORE",
-		"IMGUI_API",
-		"IMGUI_CDECL",
-	}
+	all_jobs : [len(conversion_jobs)]^ConversionJob
+	for &job, i in conversion_jobs { all_jobs[i] = &job }
 
-	removed_ifs := []PreProcRemoveIfData {
-		{ "IMGUI_DISABLE_OBSOLETE_FUNCTIONS", true },
-		{ "IM_VEC2_CLASS_EXTRA", false },
-		{ "IM_VEC4_CLASS_EXTRA", false },
-		{ "0", false },
-		{ "false", false },
-		{ "true", true },
-	}
+	tokens := BatchTokenCache { root = IMGUI_PATH + "in/", allocator = context.allocator }
+	run_conversion_jobs(all_jobs[:], &tokens)
 
-	preprocessed : [dynamic]Token
-	preprocess(&{ result = &preprocessed, inputs = input_map, ignored_identifiers = ignored_identifiers, removed_ifs = removed_ifs }, "init_shim.cpp")
-
-	ast  : [dynamic]AstNode
-	ast_context : AstContext = { ast = &ast }
-	root_sequence := ast_parse_filescope_sequence(&ast_context, preprocessed[:])
-
-	converter_context : ConverterContext = { ast = ast, type_heap = ast_context.type_heap, root_sequence = root_sequence[:] }
-	replaced_names := [][2]string {
-		{ "INT_MAX", "max(i32)" },
-		{ "INT_MIN", "min(i32)" },
-		{ "UINT_MAX", "max(u32)" },
-		{ "UINT_MIN", "min(u32)" },
-		{ "LLONG_MAX", "max(i64)" },
-		{ "LLONG_MIN", "min(i64)" },
-		{ "ULLONG_MAX", "max(u64)" },
-		{ "FLT_MAX", "max(f32)" },
-		{ "FLT_MIN", "min(f32)" },
-		{ "DBL_MAX", "max(f64)" },
-		{ "DBL_MIN", "min(f64)" },
-		{ "CP_UTF8", "win32.CP_UTF8" },
-		{ "FILENAME_MAX", "win32.FILENAME_MAX" },
-		{ "CF_UNICODETEXT", "win32.CF_UNICODETEXT" },
-		{ "GMEM_MOVEABLE", "win32.GMEM_MOVEABLE" },
-		{ "SW_SHOWDEFAULT", "win32.SW_SHOWDEFAULT" },
-		{ "CFS_FORCE_POSITION", "win32.CFS_FORCE_POSITION" },
-		{ "CFS_CANDIDATEPOS", "win32.CFS_CANDIDATEPOS" },
-
-		// { "stbrp_rect", "stbrp.rect" },
-		// { "stbrp_coord", "stbrp.coord" },
-		// { "stbrp_context", "stbrp.context" },
-
-		// { "stbtt_pack_context", "stbtt.pack_context" },
-		// { "stbtt_aligned_quad", "stbtt.aligned_quad" },
-		// { "stbtt_fontinfo", "stbtt.fontinfo" },
-		// { "stbtt_pack_range", "stbtt.pack_range" },
-		// { "stbtt_packedchar", "stbtt.packedchar" },
-		{ "stbtt_GetFontOffsetForIndex", "stbtt.GetFontOffsetForIndex" },
-
-		{ "kPasteboardClipboard", "ios.kPasteboardClipboard" },
-		{ "kCFAllocatorDefault", "ios.kCFAllocatorDefault" },
-		{ "noErr", "ios.noErr" },
-
-		{ "stdout", "stdout" }, // TODO
-		{ "stdin" , "stdin"  }, // TODO
-		{ "stderr", "stderr" }, // TODO
-		{ "SEEK_END", "SEEK_END" }, // TODO
-		{ "SEEK_SET", "SEEK_SET" }, // TODO
-	}
-	convert_and_format(&converter_context, replaced_names)
-	os.write_entire_file(IMGUI_PATH + "out/backends/dx11/backend.odin", converter_context.result.buf[:])
+	log.info("Done!")
 }
 
-process_win32_backend :: proc()
+run_conversion_jobs :: proc(jobs : []^ConversionJob, tokens : ^BatchTokenCache)
 {
-	input_map : map[string]Input
-
-	tokenize_file(&input_map, "imgui.h")
-	tokenize_file(&input_map, "backends/imgui_impl_win32.h", "imgui_impl_win32.h")
-	tokenize_file(&input_map, "backends/imgui_impl_win32.cpp", "imgui_impl_win32.cpp")
-	
-	{
-		//tokenize_file(&input_map, "imconfig.h")
-		input_map["imconfig.h"] = { {}, false}
+	units := make([]BatchUnit, len(jobs), context.temp_allocator)
+	for job, i in jobs {
+		units[i] = job.unit()
+		units[i].name = job.name
+		units[i].user_data = job
+		units[i].finish = write_job_output
 	}
 
-	{
-		toks : [dynamic]Token
-		tokenize(&toks, `
-			//
-			// shim
-			//
-			#define int int
-			#define bool bool
-			//
-			// win32
-			//
-			#include "win32_type_shim.cpp"
-			//
-			// impl
-			//
-			#include "imgui_impl_win32.cpp"
-		`, "init_shim.cpp")
-		input_map["init_shim.cpp"] = { toks[:], false }
-	}
-	{
-		toks : [dynamic]Token
-		tokenize(&toks, #load(IMGUI_PATH + "/win32_type_shim.cpp"), "win32_type_shim.cpp")
-		input_map["win32_type_shim.cpp"] = { toks[:], false }
+	results := convert_batch(units, 0, tokens)
+	defer {
+		for result in results { delete(result.output) }
+		delete(results)
 	}
 
-	ignored_identifiers := []string {
-		"IM_MSVC_RUNTIME_CHECKS_OFF",
-		"IM_MSVC_RUNTIME_CHECKS_RESTORE",
-		"IMGUI_API",
-		"IMGUI_CDECL",
-		"WINAPI",
-		"CALLBACK",
-		"IMGUI_IMPL_API",
-	}
+	for result, i in results {
+		if !result.done { log.errorf("%v failed.", units[i].name); continue }
 
-	removed_ifs := []PreProcRemoveIfData {
-		{ "IMGUI_DISABLE_OBSOLETE_FUNCTIONS", true },
-		{ "IM_VEC2_CLASS_EXTRA", false },
-		{ "IM_VEC4_CLASS_EXTRA", false },
-		{ "0", false },
-		{ "false", false },
-		{ "true", true },
+		t := result.timings
+		megabytes := f64(len(result.output)) / (1024 * 1024)
+		log.infof("%v: tokenize %v, preprocess %v, parse %v, convert %v, write %v", units[i].name, t[.Tokenize], t[.Preprocess], t[.Parse], t[.Convert], t[.Finish])
+		log.infof("  emitted %.2fMB (%.1fms/MB), allocated %v bytes (%v temp) while converting",
+			megabytes, megabytes > 0 ? time.duration_milliseconds(t[.Convert]) / megabytes : 0,
+			result.convert_bytes_allocated, result.convert_temp_bytes_allocated)
 	}
+}
 
-	preprocessed : [dynamic]Token
-	preprocess(&{ result = &preprocessed, inputs = input_map, ignored_identifiers = ignored_identifiers, removed_ifs = removed_ifs }, "init_shim.cpp")
-
-	ast  : [dynamic]AstNode
-	ast_context : AstContext = { ast = &ast }
-	root_sequence := ast_parse_filescope_sequence(&ast_context, preprocessed[:])
-
-	converter_context : ConverterContext = { ast = ast, type_heap = ast_context.type_heap, root_sequence = root_sequence[:] }
-	replaced_names := [][2]string {
-		{ "INT_MAX", "max(i32)" },
-		{ "INT_MIN", "min(i32)" },
-		{ "UINT_MAX", "max(u32)" },
-		{ "UINT_MIN", "min(u32)" },
-		{ "LLONG_MAX", "max(i64)" },
-		{ "LLONG_MIN", "min(i64)" },
-		{ "ULLONG_MAX", "max(u64)" },
-		{ "FLT_MAX", "max(f32)" },
-		{ "FLT_MIN", "min(f32)" },
-		{ "DBL_MAX", "max(f64)" },
-		{ "DBL_MIN", "min(f64)" },
-		{ "CP_UTF8", "win32.CP_UTF8" },
-		{ "FILENAME_MAX", "win32.FILENAME_MAX" },
-		{ "CF_UNICODETEXT", "win32.CF_UNICODETEXT" },
-		{ "GMEM_MOVEABLE", "win32.GMEM_MOVEABLE" },
-		{ "SW_SHOWDEFAULT", "win32.SW_SHOWDEFAULT" },
-		{ "CFS_FORCE_POSITION", "win32.CFS_FORCE_POSITION" },
-		{ "CFS_CANDIDATEPOS", "win32.CFS_CANDIDATEPOS" },
-
-		// { "stbrp_rect", "stbrp.rect" },
-		// { "stbrp_coord", "stbrp.coord" },
-		// { "stbrp_context", "stbrp.context" },
-
-		// { "stbtt_pack_context", "stbtt.pack_context" },
-		// { "stbtt_aligned_quad", "stbtt.aligned_quad" },
-		// { "stbtt_fontinfo", "stbtt.fontinfo" },
-		// { "stbtt_pack_range", "stbtt.pack_range" },
-		// { "stbtt_packedchar", "stbtt.packedchar" },
-		{ "stbtt_GetFontOffsetForIndex", "stbtt.GetFontOffsetForIndex" },
-
-		{ "kPasteboardClipboard", "ios.kPasteboardClipboard" },
-		{ "kCFAllocatorDefault", "ios.kCFAllocatorDefault" },
-		{ "noErr", "ios.noErr" },
-
-		{ "stdout", "stdout" }, // TODO
-		{ "stdin" , "stdin"  }, // TODO
-		{ "stderr", "stderr" }, // TODO
-		{ "SEEK_END", "SEEK_END" }, // TODO
-		{ "SEEK_SET", "SEEK_SET" }, // TODO
+write_job_output :: proc(unit : ^BatchUnit, ctx : ^ConverterContext)
+{
+	job := cast(^ConversionJob) unit.user_data
+
+	os.write_entire_file(str.concatenate({ IMGUI_PATH + "out/", job.output, ".odin" }, context.temp_allocator), ctx.result.buf[:])
+	write_xref_index(ctx, str.concatenate({ IMGUI_PATH + "out/", job.output, ".xref" }, context.temp_allocator), str.concatenate({ job.output, ".odin" }, context.temp_allocator))
+
+	if job.write_shim {
+		converted := ctx.result
+		ctx.result = {}
+		write_shim(ctx)
+		os.write_entire_file(IMGUI_PATH + "out/shim.odin", ctx.result.buf[:])
+		ctx.result = converted
 	}
-	convert_and_format(&converter_context, replaced_names)
-	os.write_entire_file(IMGUI_PATH + "out/backends/win32/backend.odin", converter_context.result.buf[:])
-}
\ No newline at end of file
+}
@@ -3,6 +3,7 @@ package program
 import "core:mem"
 import "core:fmt"
 import "core:strings"
+import "core:strconv"
 import "core:log"
 
 Input :: struct {
@@ -10,21 +11,33 @@ Input :: struct {
 	used : bool,
 }
 
-PreProcRemoveIfData :: struct {
+// Value a define is known to have before preprocessing starts. A nil value marks the define as known to be undefined.
+PreProcKnownDefine :: struct {
 	name : string,
-	inverted : bool,
+	value : Maybe(i64),
 }
 
 PreProcContext :: struct {
 	result  : ^[dynamic]Token,
 	inputs  : map[string]Input,
-	defines : map[string]Token,
+	defines : map[string]Maybe(i64), // seeded from known_defines, names redefined by the source get removed again
 	ignored_identifiers : []string,
-	removed_ifs : []PreProcRemoveIfData,  //TODO(Rennorb) @brittle: Only works for simple ifs for now.
+	known_defines : []PreProcKnownDefine,
+}
+
+PreProcConditional :: struct {
+	parent_live : bool, // the region containing the conditional is written to the output
+	live        : bool, // the current branch is written to the output
+	resolved    : bool, // a branch is known to be taken, all following ones are dead
+	emitted     : bool, // a condition could not be evaluated and got written out as PreprocIf, the endif has to be written as well
 }
 
 preprocess :: proc(ctx : ^PreProcContext, entry_file : string)
 {
+	for known in ctx.known_defines {
+		ctx.defines[known.name] = known.value
+	}
+
 	err := do_preprocess(ctx, &ctx.inputs[entry_file])
 	if(err != nil) { panic(fmt.tprint("Preprocess failed at", err.?)) }
 	do_preprocess :: proc(ctx : ^PreProcContext, input : ^Input) -> Maybe(AstErrorFrame)
@@ -32,15 +45,17 @@ preprocess :: proc(ctx : ^PreProcContext, entry_file : string)
 		tokens := input.tokens
 		reserve(ctx.result, len(tokens))
 
-		current_branch_depth := 0
-		skip_until_branch_depth_returns_to := -1
+		conditionals : [dynamic]PreProcConditional
+		defer delete(conditionals)
 
 		loop: for len(tokens) > 0 {
 			current_token := tokens[0]
 			tokens = tokens[1:]
 
+			live := len(conditionals) == 0 || last(conditionals).live
+
 			if current_token.kind != .Pound {
-				if skip_until_branch_depth_returns_to != -1 { continue loop }
+				if !live { continue loop }
 
 				if current_token.kind == .Identifier {
 					for ignored in ctx.ignored_identifiers {
@@ -57,79 +72,117 @@ preprocess :: proc(ctx : ^PreProcContext, entry_file : string)
 			ident := eat_token(&tokens) // cleanup
 
 			switch ident.source {
-				case "if":
-					current_branch_depth += 1
-
-					n, ns := peek_token(&tokens, false)
-					if nn, nns := peek_token(&ns, false); nn.kind == .NewLine {
-						for to_remove in ctx.removed_ifs {
-							if !to_remove.inverted && n.source == to_remove.name {
-								tokens = nns
-								skip_until_branch_depth_returns_to = current_branch_depth - 1
-								continue loop
-							}
-						}
+				case "if", "ifdef", "ifndef":
+					conditional := PreProcConditional{ parent_live = live }
+
+					remaining := tokens
+					line, _ := preproc_eat_line(&remaining)
+
+					if !live {
+						append(&conditionals, conditional)
+						tokens = remaining
+						continue loop
+					}
+
+					value : i64
+					known : bool
+					if ident.source == "if" {
+						value, known = preproc_evaluate(ctx, line)
+					}
+					else if len(line) > 0 {
+						defined_value, is_known := ctx.defines[line[0].source]
+						known = is_known
+						if (defined_value != nil) == (ident.source == "ifdef") { value = 1 }
 					}
 
+					if known {
+						conditional.live = value != 0
+						conditional.resolved = conditional.live
+						append(&conditionals, conditional)
+						tokens = remaining
+						continue loop
+					}
+
+					conditional.live = true
+					conditional.emitted = true
+					append(&conditionals, conditional)
+
 					append(ctx.result, Token{ kind = .PreprocIf, location = ident.location })
+					switch ident.source {
+						case "ifdef":
+							defined_identifier := eat_token_expect_direct(&tokens, .Identifier, false) or_return
+							append(ctx.result, defined_identifier)
+							append(ctx.result, Token{ kind = .Comment, source = "/* @gen ifdef */", location = ident.location })
 
-				case "ifdef":
-					current_branch_depth += 1
+						case "ifndef":
+							append(ctx.result, Token{ kind = .Exclamationmark, source = "!", location = ident.location })
+							defined_identifier := eat_token_expect_direct(&tokens, .Identifier, false) or_return
+							append(ctx.result, defined_identifier)
+							append(ctx.result, Token{ kind = .Comment, source = "/* @gen ifndef */", location = ident.location })
+					}
 
-					n, ns := peek_token(&tokens, false)
-					if nn, nns := peek_token(&ns, false); nn.kind == .NewLine {
-						for to_remove in ctx.removed_ifs {
-							if !to_remove.inverted && n.source == to_remove.name {
-								skip_until_branch_depth_returns_to = current_branch_depth - 1
-								continue loop
-							}
-						}
+				case "elif", "else":
+					if len(conditionals) == 0 { panic(fmt.tprintf("Unexpected #%v at %v", ident.source, ident.location)) }
+					conditional := last(conditionals)
+
+					remaining := tokens
+					line, line_end := preproc_eat_line(&remaining)
+
+					if !conditional.parent_live || conditional.resolved {
+						conditional.live = false
+						tokens = remaining
+						continue loop
 					}
 
-					append(ctx.result, Token{ kind = .PreprocIf, location = ident.location })
-					defined_identifier := eat_token_expect_direct(&tokens, .Identifier, false) or_return
-					append(ctx.result, defined_identifier)
-					append(ctx.result, Token{ kind = .Comment, source = "/* @gen ifdef */", location = ident.location })
-
-				case "ifndef":
-					current_branch_depth += 1
-
-					n, ns := peek_token(&tokens, false)
-					if nn, nns := peek_token(&ns, false); nn.kind == .NewLine {
-						for to_remove in ctx.removed_ifs {
-							if to_remove.inverted && n.source == to_remove.name {
-								tokens = nns
-								skip_until_branch_depth_returns_to = current_branch_depth - 1
-								continue loop
-							}
+					conditional.live = true
+					if ident.source == "else" {
+						conditional.resolved = true
+						if !conditional.emitted {
+							tokens = remaining
+							continue loop
 						}
+
+						append(ctx.result, Token{ kind = .PreprocElse, location = ident.location })
+						break
 					}
 
-					append(ctx.result, Token{ kind = .PreprocIf, location = ident.location })
-					append(ctx.result, Token{ kind = .Exclamationmark, source = "!", location = ident.location })
-					defined_identifier := eat_token_expect_direct(&tokens, .Identifier, false) or_return
-					append(ctx.result, defined_identifier)
-					append(ctx.result, Token{ kind = .Comment, source = "/* @gen ifndef */", location = ident.location })
+					value, known := preproc_evaluate(ctx, line)
+					if known {
+						conditional.live = value != 0
+						conditional.resolved = conditional.live
+						tokens = remaining
 
-				case "else":
-					append(ctx.result, Token{ kind = .PreprocElse, location = ident.location })
+						if conditional.live && conditional.emitted {
+							// the condition no longer matters, this is just the else branch of the emitted conditional
+							append(ctx.result, Token{ kind = .PreprocElse, location = ident.location })
+							if line_end.kind == .NewLine { append(ctx.result, line_end) }
+						}
+						continue loop
+					}
 
-				case "elif":
-					append(ctx.result, Token{ kind = .PreprocElse, location = ident.location })
+					if conditional.emitted {
+						append(ctx.result, Token{ kind = .PreprocElse, location = ident.location })
+					}
+					else {
+						// all previous branches were dead, so this is the first one that actually gets written
+						conditional.emitted = true
+						append(ctx.result, Token{ kind = .PreprocIf, location = ident.location })
+					}
 
 				case "endif":
-					current_branch_depth -= 1
+					if len(conditionals) == 0 { panic(fmt.tprintf("Unexpected #endif at %v", ident.location)) }
+					conditional := pop(&conditionals)
 
-					if skip_until_branch_depth_returns_to != -1 {
-						if current_branch_depth > skip_until_branch_depth_returns_to { continue loop }
-						skip_until_branch_depth_returns_to = -1
-						continue loop // dont write the endif even if we are good now
+					if !conditional.emitted {
+						preproc_eat_line(&tokens)
+						continue loop
 					}
 
 					append(ctx.result, Token{ kind = .PreprocEndif, location = ident.location })
 
 				case:
-					if skip_until_branch_depth_returns_to != -1 { continue loop }
+					if !live { continue loop }
+
 
 					switch ident.source {
 						case "include":
@@ -216,9 +269,12 @@ preprocess :: proc(ctx : ^PreProcContext, entry_file : string)
 							}
 		
 						case "define":
+							// the source changes the define, so the assumed value can no longer be relied upon
+							if n, _ := peek_token(&tokens, false); n.kind == .Identifier { delete_key(&ctx.defines, n.source) }
 							append(ctx.result, Token{ kind = .PreprocDefine, location = ident.location })
 		
 						case "undef":
+							if n, _ := peek_token(&tokens, false); n.kind == .Identifier { delete_key(&ctx.defines, n.source) }
 							append(ctx.result, Token{ kind = .PreprocUndefine, location = ident.location })
 		
 						case "error":
@@ -256,3 +312,236 @@ preprocess :: proc(ctx : ^PreProcContext, entry_file : string)
 		return nil
 	}
 }
+
+// Consumes the remainder of a preprocessor line including line continuations. The terminating newline is returned separately.
+preproc_eat_line :: proc(tokens : ^[]Token) -> (line : []Token, line_end : Token)
+{
+	i := 0
+	for ; i < len(tokens); i += 1 {
+		if tokens[i].kind == .NewLine && (i == 0 || tokens[i - 1].kind != .BackwardSlash) { break }
+	}
+
+	line = tokens[:i]
+	if i < len(tokens) {
+		line_end = tokens[i]
+		i += 1
+	}
+	tokens^ = tokens[i:]
+	return
+}
+
+PreProcValue :: struct {
+	value : i64,
+	known : bool, // false if the value depends on a define that is not part of the environment
+}
+
+// Evaluates the condition of an #if or #elif. Anything that cannot be evaluated (unknown defines, builtins, malformed expressions) results in known = false,
+// in which case the condition has to be left in for the converter.
+preproc_evaluate :: proc(ctx : ^PreProcContext, line : []Token) -> (value : i64, known : bool)
+{
+	expression := make([dynamic]Token, 0, len(line), context.temp_allocator)
+	for t in line {
+		#partial switch t.kind {
+			case .Comment, .NewLine, .BackwardSlash:
+				/* not part of the expression */
+			case:
+				append(&expression, t)
+		}
+	}
+
+	tokens := expression[:]
+	result, ok := preproc_evaluate_binary(ctx, &tokens, 1)
+	if !ok || len(tokens) != 0 { return 0, false }
+
+	return result.value, result.known
+}
+
+@(private="file")
+preproc_binary_precedence :: proc(kind : TokenKind) -> int
+{
+	#partial switch kind {
+		case .Questionmark                                                 : return 1
+		case .DoublePipe                                                   : return 2
+		case .DoubleAmpersand                                              : return 3
+		case .Pipe                                                         : return 4
+		case .Circumflex                                                   : return 5
+		case .Ampersand                                                    : return 6
+		case .Equals, .NotEquals                                           : return 7
+		case .BracketTriangleOpen, .LessEq, .BracketTriangleClose, .GreaterEq : return 8
+		case .ShiftLeft, .ShiftRight                                       : return 9
+		case .Plus, .Minus                                                 : return 10
+		case .Star, .ForwardSlash, .Percent                                : return 11
+	}
+	return 0
+}
+
+@(private="file")
+preproc_evaluate_binary :: proc(ctx : ^PreProcContext, tokens : ^[]Token, min_precedence : int) -> (lhs : PreProcValue, ok : bool)
+{
+	lhs = preproc_evaluate_unary(ctx, tokens) or_return
+
+	for len(tokens) > 0 {
+		op := tokens[0].kind
+		precedence := preproc_binary_precedence(op)
+		if precedence == 0 || precedence < min_precedence { break }
+		tokens^ = tokens[1:]
+
+		if op == .Questionmark {
+			if_true := preproc_evaluate_binary(ctx, tokens, 1) or_return
+			if len(tokens) == 0 || tokens[0].kind != .Colon { return {}, false }
+			tokens^ = tokens[1:]
+			if_false := preproc_evaluate_binary(ctx, tokens, precedence) or_return
+
+			if lhs.known { lhs = lhs.value != 0 ? if_true : if_false }
+			else { lhs = { value = if_true.value, known = if_true.known && if_false.known && if_true.value == if_false.value } }
+			continue
+		}
+
+		rhs := preproc_evaluate_binary(ctx, tokens, precedence + 1) or_return
+		lhs = preproc_apply_binary(op, lhs, rhs)
+	}
+
+	return lhs, true
+}
+
+@(private="file")
+preproc_apply_binary :: proc(op : TokenKind, lhs, rhs : PreProcValue) -> (result : PreProcValue)
+{
+	// logical operators can be decided by one known side, even if the other one is unknown
+	#partial switch op {
+		case .DoublePipe:
+			if (lhs.known && lhs.value != 0) || (rhs.known && rhs.value != 0) { return { value = 1, known = true } }
+			return { value = 0, known = lhs.known && rhs.known }
+
+		case .DoubleAmpersand:
+			if (lhs.known && lhs.value == 0) || (rhs.known && rhs.value == 0) { return { value = 0, known = true } }
+			return { value = 1, known = lhs.known && rhs.known }
+	}
+
+	if !lhs.known || !rhs.known { return }
+
+	result.known = true
+	#partial switch op {
+		case .Pipe                : result.value = lhs.value | rhs.value
+		case .Circumflex          : result.value = lhs.value ~ rhs.value
+		case .Ampersand           : result.value = lhs.value & rhs.value
+		case .Equals              : result.value = lhs.value == rhs.value ? 1 : 0
+		case .NotEquals           : result.value = lhs.value != rhs.value ? 1 : 0
+		case .BracketTriangleOpen : result.value = lhs.value <  rhs.value ? 1 : 0
+		case .LessEq              : result.value = lhs.value <= rhs.value ? 1 : 0
+		case .BracketTriangleClose: result.value = lhs.value >  rhs.value ? 1 : 0
+		case .GreaterEq           : result.value = lhs.value >= rhs.value ? 1 : 0
+		case .ShiftLeft           : result.value = lhs.value << u64(rhs.value)
+		case .ShiftRight          : result.value = lhs.value >> u64(rhs.value)
+		case .Plus                : result.value = lhs.value + rhs.value
+		case .Minus               : result.value = lhs.value - rhs.value
+		case .Star                : result.value = lhs.value * rhs.value
+		case .ForwardSlash, .Percent:
+			if rhs.value == 0 { return {} } // leave the error to the compiler
+			result.value = op == .ForwardSlash ? lhs.value / rhs.value : lhs.value % rhs.value
+	}
+	return
+}
+
+@(private="file")
+preproc_evaluate_unary :: proc(ctx : ^PreProcContext, tokens : ^[]Token) -> (result : PreProcValue, ok : bool)
+{
+	if len(tokens) == 0 { return {}, false }
+	token := tokens[0]
+	tokens^ = tokens[1:]
+
+	#partial switch token.kind {
+		case .Exclamationmark:
+			operand := preproc_evaluate_unary(ctx, tokens) or_return
+			return { value = operand.value == 0 ? 1 : 0, known = operand.known }, true
+
+		case .Tilde:
+			operand := preproc_evaluate_unary(ctx, tokens) or_return
+			return { value = ~operand.value, known = operand.known }, true
+
+		case .Minus:
+			operand := preproc_evaluate_unary(ctx, tokens) or_return
+			return { value = -operand.value, known = operand.known }, true
+
+		case .Plus:
+			return preproc_evaluate_unary(ctx, tokens)
+
+		case .BracketRoundOpen:
+			result = preproc_evaluate_binary(ctx, tokens, 1) or_return
+			if len(tokens) == 0 || tokens[0].kind != .BracketRoundClose { return {}, false }
+			tokens^ = tokens[1:]
+			return result, true
+
+		case .LiteralBool:
+			return { value = token.source == "true" ? 1 : 0, known = true }, true
+
+		case .LiteralInteger:
+			value, parsed := preproc_parse_integer(token.source)
+			return { value = value, known = parsed }, true
+
+		case .LiteralCharacter:
+			if len(token.source) != 3 { return {}, true } // escape sequences are not worth handling here
+			return { value = i64(token.source[1]), known = true }, true
+
+		case .Identifier:
+			if token.source == "defined" {
+				has_brackets := len(tokens) > 0 && tokens[0].kind == .BracketRoundOpen
+				if has_brackets { tokens^ = tokens[1:] }
+
+				if len(tokens) == 0 || tokens[0].kind != .Identifier { return {}, false }
+				name := tokens[0].source
+				tokens^ = tokens[1:]
+
+				if has_brackets {
+					if len(tokens) == 0 || tokens[0].kind != .BracketRoundClose { return {}, false }
+					tokens^ = tokens[1:]
+				}
+
+				value, is_known := ctx.defines[name]
+				return { value = value != nil ? 1 : 0, known = is_known }, true
+			}
+
+			if len(tokens) > 0 && tokens[0].kind == .BracketRoundOpen {
+				// function like macro or compiler builtin such as __has_include, skip the arguments
+				depth := 0
+				for len(tokens) > 0 {
+					kind := tokens[0].kind
+					tokens^ = tokens[1:]
+					if kind == .BracketRoundOpen { depth += 1 }
+					else if kind == .BracketRoundClose {
+						depth -= 1
+						if depth == 0 { break }
+					}
+				}
+				return {}, depth == 0
+			}
+
+			value, is_known := ctx.defines[token.source]
+			if !is_known { return {}, true }
+
+			return { value = value.? or_else 0, known = true }, true // known undefined names evaluate to 0, same as in c
+	}
+
+	return {}, false
+}
+
+@(private="file")
+preproc_parse_integer :: proc(source : string) -> (value : i64, ok : bool)
+{
+	digits := strings.trim_right(source, "uUlL")
+	base := 10
+	if strings.has_prefix(digits, "0x") || strings.has_prefix(digits, "0X") {
+		base = 16
+		digits = digits[2:]
+	}
+	else if strings.has_prefix(digits, "0b") || strings.has_prefix(digits, "0B") {
+		base = 2
+		digits = digits[2:]
+	}
+	else if len(digits) > 1 && digits[0] == '0' {
+		base = 8
+		digits = digits[1:]
+	}
+
+	return strconv.parse_i64_of_base(digits, base)
+}
@@ -0,0 +1,128 @@
+package program
+
+import "core:fmt"
+import "core:log"
+import "core:time"
+import "core:slice"
+import "base:runtime"
+import "core:mem/virtual"
+import str "core:strings"
+import win32 "core:sys/windows"
+
+// Resident mode (--watch):
+// The converter keeps running and waits for changes in imgui/in. Token streams of unchanged files are kept between cycles
+// in a batch token cache, and only the jobs that actually include a changed file get preprocessed, parsed and written again.
+// Everything else a cycle allocates lives in an arena that gets dropped once the cycle is done.
+//
+// Headers are pasted into the translation unit by the preprocessor before parsing, so there are no per header asts that could be kept around.
+// A failing conversion (assertion or panic on a batch worker) is logged and aborts only its unit, the watcher keeps going and the unit
+// is converted again on its next change. Failures setting up the watch itself still panic.
+
+resident_tokens : BatchTokenCache
+
+watch :: proc()
+{
+	resident_tokens = { root = IMGUI_PATH + "in/", allocator = context.allocator }
+
+	all_jobs : [len(conversion_jobs)]^ConversionJob
+	for &job, i in conversion_jobs { all_jobs[i] = &job }
+	run_conversion_cycle(all_jobs[:])
+
+	directory_path := win32.utf8_to_wstring(IMGUI_PATH + "in")
+	directory := win32.CreateFileW(directory_path, FILE_LIST_DIRECTORY, win32.FILE_SHARE_READ | win32.FILE_SHARE_WRITE | win32.FILE_SHARE_DELETE, nil, win32.OPEN_EXISTING, win32.FILE_FLAG_BACKUP_SEMANTICS, nil)
+	if directory == win32.INVALID_HANDLE_VALUE { panic(fmt.tprintf("Failed to open %v for watching: %v", IMGUI_PATH + "in", win32.GetLastError())) }
+	defer win32.CloseHandle(directory)
+
+	log.info("Watching", IMGUI_PATH + "in", "for changes.")
+
+	notifications : [4096]u32 // FILE_NOTIFY_INFORMATION needs to be dword aligned
+	for {
+		bytes_returned : win32.DWORD
+		if !ReadDirectoryChangesW(directory, &notifications, size_of(notifications), true, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE, &bytes_returned, nil, nil) {
+			panic(fmt.tprintf("Failed to wait for directory changes: %v", win32.GetLastError()))
+		}
+
+		changed_files : [dynamic]string
+		changed_files.allocator = context.temp_allocator
+
+		if bytes_returned == 0 {
+			// the notification buffer overflowed, we don't know what changed
+			for path in resident_tokens.files { append(&changed_files, str.clone(path, context.temp_allocator)) }
+		}
+
+		for offset := 0; bytes_returned != 0; {
+			info := cast(^FILE_NOTIFY_INFORMATION) &(cast([^]u8) &notifications)[offset]
+			wide_name := (cast([^]u16) &info.FileName)[:info.FileNameLength / size_of(u16)]
+			name, _ := win32.utf16_to_utf8(wide_name, context.temp_allocator)
+			name, _ = str.replace_all(name, "\\", "/", context.temp_allocator) // inputs use forward slashes
+
+			if !slice.contains(changed_files[:], name) { append(&changed_files, name) }
+
+			if info.NextEntryOffset == 0 { break }
+			offset += int(info.NextEntryOffset)
+		}
+
+		affected_jobs : [dynamic]^ConversionJob
+		affected_jobs.allocator = context.temp_allocator
+
+		for path in changed_files {
+			batch_invalidate_file(&resident_tokens, path)
+
+			for &job in conversion_jobs {
+				if slice.contains(affected_jobs[:], &job) { continue }
+				for file in job.unit().files {
+					if file.path == path { append(&affected_jobs, &job); break }
+				}
+			}
+		}
+
+		if len(affected_jobs) > 0 {
+			log.info("Changed:", changed_files[:])
+			run_conversion_cycle(affected_jobs[:])
+		}
+
+		free_all(context.temp_allocator)
+	}
+}
+
+run_conversion_cycle :: proc(jobs : []^ConversionJob)
+{
+	start := time.tick_now()
+
+	cycle_arena : virtual.Arena
+	defer virtual.arena_destroy(&cycle_arena)
+	context.allocator = virtual.arena_allocator(&cycle_arena)
+	context.assertion_failure_proc = watch_assertion_failure // copied to the batch workers
+
+	run_conversion_jobs(jobs, &resident_tokens)
+
+	log.infof("Conversion cycle took %v.", time.tick_since(start))
+}
+
+@(private="file")
+watch_assertion_failure :: proc(prefix, message : string, loc : runtime.Source_Code_Location) -> !
+{
+	unit := batch_current_unit()
+	if unit == nil { runtime.default_assertion_failure_proc(prefix, message, loc) }
+
+	log.errorf("%v: %v %v: %v", unit.name, loc, prefix, message)
+	batch_abort_current_unit()
+}
+
+FILE_LIST_DIRECTORY           :: 0x0001
+FILE_NOTIFY_CHANGE_FILE_NAME  :: 0x0001
+FILE_NOTIFY_CHANGE_LAST_WRITE :: 0x0010
+
+FILE_NOTIFY_INFORMATION :: struct {
+	NextEntryOffset : win32.DWORD,
+	Action          : win32.DWORD,
+	FileNameLength  : win32.DWORD,
+	FileName        : [1]win32.WCHAR,
+}
+
+foreign import kernel32 "system:Kernel32.lib"
+
+@(default_calling_convention="system")
+foreign kernel32 {
+	ReadDirectoryChangesW :: proc(hDirectory : win32.HANDLE, lpBuffer : win32.LPVOID, nBufferLength : win32.DWORD, bWatchSubtree : win32.BOOL, dwNotifyFilter : win32.DWORD, lpBytesReturned : win32.LPDWORD, lpOverlapped : win32.LPOVERLAPPED, lpCompletionRoutine : rawptr) -> win32.BOOL ---
+}
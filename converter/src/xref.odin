@@ -0,0 +1,245 @@
+package program
+
+import "core:os"
+import "core:slice"
+
+// Cross reference index, written next to the converted output so definitions and references can be looked up
+// without running the converter again. converter/xref contains the query tool.
+//
+// Layout, all little endian and tightly packed:
+//   XrefHeader
+//   [symbol_count]XrefSymbol       sorted by name
+//   [reference_count]XrefReference grouped by symbol, each group sorted by c++ location
+//   [file_count]XrefString         file 0 is the converted odin file, the rest are c++ inputs
+//   [strings_size]u8               string blob all XrefStrings point into
+
+XREF_MAGIC   :: u32(0x46455258) // "XREF"
+XREF_VERSION :: u32(1)
+
+XrefHeader :: struct #packed {
+	magic, version : u32,
+	symbol_count, reference_count, file_count, strings_size : u32,
+}
+
+XrefString :: struct #packed {
+	offset, length : u32,
+}
+
+XrefLocation :: struct #packed {
+	file, row, column : u32, // row 0 means the location is unknown
+}
+
+XrefSymbol :: struct #packed {
+	name : XrefString,
+	kind : u32, // AstNodeKind
+	cpp, odin : XrefLocation,
+	first_reference, reference_count : u32,
+}
+
+XrefReference :: struct #packed {
+	cpp, odin : XrefLocation,
+}
+
+XrefRecordedReference :: struct {
+	definition : AstNodeIndex,
+	location : SourceLocation,
+	offset : int, // into ConverterContext.result
+}
+
+cvt_record_definition :: #force_inline proc(ctx : ^ConverterContext, node : AstNodeIndex)
+{
+	if !ctx.record_xrefs { return }
+
+	definition := &ctx.ast[node]
+	#partial switch definition.kind {
+		case .Struct, .Union, .Enum:
+			if .IsForwardDeclared in definition.structure.flags { return }
+
+		case .FunctionDefinition:
+			if .IsForwardDeclared in definition.function_def.flags { return }
+
+		case .VariableDeclaration, .Typedef, .PreprocDefine, .PreprocMacro:
+			/**/
+
+		case:
+			return
+	}
+
+	ctx.xref_definitions[node] = len(ctx.result.buf)
+}
+
+cvt_record_reference :: #force_inline proc(ctx : ^ConverterContext, definition : AstNodeIndex, location : SourceLocation)
+{
+	if !ctx.record_xrefs || definition == 0 { return }
+
+	append(&ctx.xref_references, XrefRecordedReference{ definition, location, len(ctx.result.buf) })
+}
+
+// Writes the index for everything recorded while converting into ctx.result. odin_file_name is stored as the name of the output file.
+write_xref_index :: proc(ctx : ^ConverterContext, path : string, odin_file_name : string) -> bool
+{
+	context.allocator = context.temp_allocator
+
+	line_starts := make([dynamic]int, 0, 1024)
+	append(&line_starts, 0)
+	for c, i in ctx.result.buf {
+		if c == '\n' { append(&line_starts, i + 1) }
+	}
+
+	odin_location :: proc(line_starts : []int, offset : int) -> XrefLocation
+	{
+		// last line starting at or before the offset
+		lo, hi := 0, len(line_starts)
+		for lo + 1 < hi {
+			mid := (lo + hi) / 2
+			if line_starts[mid] <= offset { lo = mid } else { hi = mid }
+		}
+		return { 0, u32(lo + 1), u32(offset - line_starts[lo] + 1) }
+	}
+
+	strings : [dynamic]u8
+	files : [dynamic]XrefString
+	file_indices : map[string]u32
+
+	intern :: proc(strings : ^[dynamic]u8, s : string) -> XrefString
+	{
+		offset := len(strings)
+		append(strings, s)
+		return { u32(offset), u32(len(s)) }
+	}
+
+	append(&files, intern(&strings, odin_file_name))
+
+	cpp_location :: proc(strings : ^[dynamic]u8, files : ^[dynamic]XrefString, file_indices : ^map[string]u32, location : SourceLocation) -> XrefLocation
+	{
+		if location.file_path == "" { return {} }
+
+		file, found := file_indices[location.file_path]
+		if !found {
+			file = u32(len(files))
+			append(files, intern(strings, location.file_path))
+			file_indices[location.file_path] = file
+		}
+		return { file, u32(location.row), u32(location.column) }
+	}
+
+	// every definition that was either written or referenced becomes a symbol
+	NamedNode :: struct { name : string, node : AstNodeIndex }
+	symbol_nodes : [dynamic]NamedNode
+	seen : map[AstNodeIndex]struct{}
+	for definition in ctx.xref_definitions {
+		seen[definition] = {}
+		append(&symbol_nodes, NamedNode{ get_complete_name_string(ctx, definition), definition })
+	}
+	for reference in ctx.xref_references {
+		if reference.definition in seen { continue }
+		seen[reference.definition] = {}
+		append(&symbol_nodes, NamedNode{ get_complete_name_string(ctx, reference.definition), reference.definition })
+	}
+	slice.sort_by(symbol_nodes[:], proc(a, b : NamedNode) -> bool {
+		if a.name != b.name { return a.name < b.name }
+		return a.node < b.node
+	})
+
+	references := slice.clone(ctx.xref_references[:])
+	slice.sort_by(references, proc(a, b : XrefRecordedReference) -> bool {
+		if a.definition != b.definition { return a.definition < b.definition }
+		if a.location.file_path != b.location.file_path { return a.location.file_path < b.location.file_path }
+		if a.location.row != b.location.row { return a.location.row < b.location.row }
+		return a.location.column < b.location.column
+	})
+
+	symbols := make([dynamic]XrefSymbol, 0, len(symbol_nodes))
+	serialized_references := make([dynamic]XrefReference, 0, len(references))
+
+	for named in symbol_nodes {
+		node := named.node
+		if named.name == "" { continue }
+
+		symbol := XrefSymbol {
+			name = intern(&strings, named.name),
+			kind = u32(ctx.ast[node].kind),
+			cpp  = cpp_location(&strings, &files, &file_indices, cvt_get_location(ctx, node)),
+			first_reference = u32(len(serialized_references)),
+		}
+		if offset, written := ctx.xref_definitions[node]; written {
+			symbol.odin = odin_location(line_starts[:], offset)
+		}
+
+		// references are sorted by definition, find the group for this one
+		lo, hi := 0, len(references)
+		for lo < hi {
+			mid := (lo + hi) / 2
+			if references[mid].definition < node { lo = mid + 1 } else { hi = mid }
+		}
+		for r := lo; r < len(references) && references[r].definition == node; r += 1 {
+			append(&serialized_references, XrefReference{
+				cpp  = cpp_location(&strings, &files, &file_indices, references[r].location),
+				odin = odin_location(line_starts[:], references[r].offset),
+			})
+		}
+		symbol.reference_count = u32(len(serialized_references)) - symbol.first_reference
+
+		append(&symbols, symbol)
+	}
+
+	header := XrefHeader {
+		magic = XREF_MAGIC,
+		version = XREF_VERSION,
+		symbol_count = u32(len(symbols)),
+		reference_count = u32(len(serialized_references)),
+		file_count = u32(len(files)),
+		strings_size = u32(len(strings)),
+	}
+
+	out : [dynamic]u8
+	append(&out, ..slice.bytes_from_ptr(&header, size_of(header)))
+	append(&out, ..slice.to_bytes(symbols[:]))
+	append(&out, ..slice.to_bytes(serialized_references[:]))
+	append(&out, ..slice.to_bytes(files[:]))
+	append(&out, ..strings[:])
+
+	return os.write_entire_file(path, out[:])
+}
+
+// Returns the symbols named exactly name. index has to be a complete index file as written by write_xref_index.
+xref_find_symbols :: proc(index : []u8, name : string) -> (symbols : []XrefSymbol, ok : bool)
+{
+	header, symbol_table, _, _, strings := xref_split(index) or_return
+
+	// lower bound
+	lo, hi := 0, int(header.symbol_count)
+	for lo < hi {
+		mid := (lo + hi) / 2
+		if xref_string(strings, symbol_table[mid].name) < name { lo = mid + 1 } else { hi = mid }
+	}
+	end := lo
+	for end < len(symbol_table) && xref_string(strings, symbol_table[end].name) == name { end += 1 }
+
+	return symbol_table[lo:end], true
+}
+
+xref_split :: proc(index : []u8) -> (header : XrefHeader, symbols : []XrefSymbol, references : []XrefReference, files : []XrefString, strings : []u8, ok : bool)
+{
+	if len(index) < size_of(XrefHeader) { return }
+	header = (cast(^XrefHeader) raw_data(index))^
+	if header.magic != XREF_MAGIC || header.version != XREF_VERSION { return }
+
+	symbols_size    := int(header.symbol_count)    * size_of(XrefSymbol)
+	references_size := int(header.reference_count) * size_of(XrefReference)
+	files_size      := int(header.file_count)      * size_of(XrefString)
+	if len(index) != size_of(XrefHeader) + symbols_size + references_size + files_size + int(header.strings_size) { return }
+
+	rest := index[size_of(XrefHeader):]
+	symbols    = slice.reinterpret([]XrefSymbol, rest[:symbols_size]);    rest = rest[symbols_size:]
+	references = slice.reinterpret([]XrefReference, rest[:references_size]); rest = rest[references_size:]
+	files      = slice.reinterpret([]XrefString, rest[:files_size]);      rest = rest[files_size:]
+	strings    = rest
+	ok = true
+	return
+}
+
+xref_string :: #force_inline proc(strings : []u8, s : XrefString) -> string
+{
+	return string(strings[s.offset:][:s.length])
+}
@@ -0,0 +1,17 @@
+#if defined(REMOVED_IF) || 0
+int a3211;
+#elif (1 + 2) * 3 == 9 && !REMOVED_IF
+int b3211;
+#else
+int c3211;
+#endif
+#if UNKNOWN3211 && defined(REMOVED_IF)
+int d3211;
+#endif
+#if REMOVED_IF
+int e3211;
+#elif UNKNOWN3211
+int f3211;
+#else
+int g3211;
+#endif
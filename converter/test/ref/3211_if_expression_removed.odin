@@ -0,0 +1,8 @@
+package test
+
+b3211 : i32
+when UNKNOWN3211 {
+f3211 : i32
+} else { // preproc else
+g3211 : i32
+} // preproc endif
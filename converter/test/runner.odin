@@ -6,7 +6,6 @@ import "core:os"
 import str "core:strings"
 import converter "../src/"
 import "core:testing"
-import "core:thread"
 import "base:runtime"
 import "core:log"
 import "core:time"
@@ -25,155 +24,93 @@ test :: proc(t : ^testing.T)
 
 	//testing.set_fail_timeout(t, 5 * time.Second)
 
-	test_ctx := context
-
-	test_ctx.assertion_failure_proc = proc(prefix, message : string, loc := #caller_location) -> ! {
-		current_thread := transmute(^thread.Thread) context.user_ptr
-		t  := transmute(^testing.T) current_thread.user_args[0]
-		fi := transmute(^os.File_Info) current_thread.user_args[1]
-		log.errorf("[%v]: Failed [%v]: %v", fi.name, prefix, message, location = loc)
-		thread.terminate(current_thread, 1)
-		unreachable()
+	context.assertion_failure_proc = proc(prefix, message : string, loc := #caller_location) -> ! {
+		unit := converter.batch_current_unit()
+		log.errorf("[%v]: Failed [%v]: %v", unit != nil ? unit.name : "?", prefix, message, location = loc)
+		converter.batch_abort_current_unit()
 	}
 
-	a := os.args
+	units : [dynamic]converter.BatchUnit
+
 	if len(os.args) > 1 {
 		for &file in files_in {
 			if str.starts_with(file.name, os.args[1]) {
-				tr := thread.create(thread_proc)
-				test_ctx.user_ptr = tr
-				tr.init_context = test_ctx
-				tr.user_args[0] = t
-				tr.user_args[1] = &file
-				thread.start(tr)
-
-				thread.join_multiple(tr)
-				return
+				append(&units, make_test_unit(&file))
+				break
 			}
 		}
-		panic(fmt.tprintf("Failed to match '%v' to any test file in '%v'.", os.args[1], BASEDIR))
+		if len(units) == 0 { panic(fmt.tprintf("Failed to match '%v' to any test file in '%v'.", os.args[1], BASEDIR)) }
 	}
+	else {
+		for &file in files_in {
+			if str.contains(file.name, ".disabled") {
+				log.warn("Disabled", location = { file_path = file.name })
+				continue
+			}
 
-	threads : [dynamic]^thread.Thread
-
-	for &file in files_in {
-		if str.contains(file.name, ".disabled") {
-			log.warn("Disabled", location = { file_path = file.name })
-			continue
+			append(&units, make_test_unit(&file))
 		}
+	}
+
+	tokens := converter.BatchTokenCache { root = BASEDIR + "in/", allocator = context.allocator }
+	results := converter.convert_batch(units[:], SEQUENTIAL ? 1 : 0, &tokens)
+
+	for result, i in results {
+		file := cast(^os.File_Info) units[i].user_data
+		loc := runtime.Source_Code_Location { file_path = file.name, procedure = "test.validate" }
+
+		if !result.done { continue } // already reported by the assertion proc
 
-		tr := thread.create(thread_proc)
-		test_ctx.user_ptr = tr
-		tr.init_context = test_ctx
-		tr.user_args[0] = t
-		tr.user_args[1] = &file
-		thread.start(tr)
+		ref, err2 := os.read_entire_file(fmt.tprintf(BASEDIR + "ref/%v.odin", path.stem(file.name)))
+		if !err2 { log.error("Missing ref file?", location = loc); continue }
 
-		when !SEQUENTIAL {
-			append(&threads, tr)
+		os.write_entire_file(fmt.tprintf(BASEDIR + "out/%v.odin", path.stem(file.name)), transmute([]u8) result.output)
+
+		if result.output == string(ref) {
+			loc.procedure = ""
+			log.info("OK", location = loc)
 		}
 		else {
-			thread.join_multiple(tr)
+			log.errorf("expected\n---\n%v\n---\n\ngot\n---\n%v\n---", string(ref), result.output, location=loc)
 		}
 	}
-
-	when !SEQUENTIAL {
-		thread.join_multiple(..threads[:])
-	}
 }
 
-thread_proc :: proc(current_thread : ^thread.Thread)
-{
-	t    := transmute(^testing.T) current_thread.user_args[0]
-	file := transmute(^os.File_Info) current_thread.user_args[1]
-
-	test_proc(t, file)
+known_defines := []converter.PreProcKnownDefine {
+	{ "REMOVED_IF", nil },
 }
 
-test_proc :: proc(t : ^testing.T, file : ^os.File_Info) {
-	defer runtime.default_temp_allocator_destroy(transmute(^runtime.Default_Temp_Allocator) context.temp_allocator.data)
-
-	loc := runtime.Source_Code_Location {
-		file_path = file.name,
-		column = 0,
-		line = 0,
-	}
-
-	inputs : []os.File_Info
+make_test_unit :: proc(file : ^os.File_Info) -> converter.BatchUnit
+{
+	files : [dynamic]converter.BatchFile
 
 	if !file.is_dir {
-		inputs = { file^ }
+		append(&files, converter.BatchFile{ name = file.name, path = file.name })
 	}
 	else {
 		// use whole directory of files as test input
 		dir, err1 := os.open(file.fullpath)
 		assert(err1 == nil)
 
-		err : os.Error
-		inputs, err = os.read_dir(dir, 0)
+		inputs, err := os.read_dir(dir, 0)
 		assert(err == nil)
-	}
 
-	input_map : map[string]converter.Input
-	preprocessed : [dynamic]converter.Token
-	ast  : [dynamic]converter.AstNode
-	result : str.Builder
-
-	ref, err2 := os.read_entire_file(fmt.tprintf(BASEDIR + "ref/%v.odin", path.stem(file.name)))
-	assert(err2, "Missing ref file?", loc)
-
-	for _, stream in input_map { delete(stream.tokens) }
-	clear(&input_map)
-	for file in inputs {
-		loc.file_path = file.name
-
-		loc.procedure = "os.read_entire_file"
-		content, err1 := os.read_entire_file(file.fullpath)
-		assert(err1, loc = loc)
-
-		toks : [dynamic]converter.Token
-		loc.procedure = "converter.tokenize"
-		converter.tokenize(&toks, cast(string) content, file.name)
-
-		input_map[file.name] = { toks[:], false }
-	}
-
-	loc.file_path = file.name
-
-	initial_file_name := str.ends_with(file.name, ".cpp") ? file.name : str.concatenate({ file.name, ".cpp" }, context.temp_allocator)
-
-	removed_ifs := []converter.PreProcRemoveIfData {
-		{ "REMOVED_IF", false },
-	}
-
-	clear(&preprocessed)
-	loc.procedure = "converter.preprocess"
-	converter.preprocess(&{ result = &preprocessed, inputs = input_map, removed_ifs = removed_ifs }, initial_file_name)
-
-	clear(&ast)
-	loc.procedure = "converter.ast_parse_filescope_sequence"
-	ast_context : converter.AstContext = { ast = &ast }
-	root_sequence := converter.ast_parse_filescope_sequence(&ast_context, preprocessed[:])
-
-	clear(&result.buf)
-	loc.procedure = "converter.convert_and_format"
-	converter_context : converter.ConverterContext = { result = result, ast = ast, type_heap = ast_context.type_heap, root_sequence = root_sequence[:] }
-	converter.convert_and_format(&converter_context, {})
-
-	if len(converter_context.overload_resolver) > 0 {
-		str.write_string(&converter_context.result, "\n\n")
-		converter.write_overloads(&converter_context)
+		for input in inputs {
+			append(&files, converter.BatchFile{ name = input.name, path = str.concatenate({ file.name, "/", input.name }) })
+		}
 	}
 
-	os.write_entire_file(fmt.tprintf(BASEDIR + "out/%v.odin", path.stem(file.name)), converter_context.result.buf[:])
-
-	loc.procedure = "test.validate"
-
-	if(str.to_string(converter_context.result) == string(ref)) {
-		loc.procedure = ""
-		log.info("OK", location = loc)
-	}
-	else {
-		log.errorf("expected\n---\n%v\n---\n\ngot\n---\n%v\n---", string(ref), str.to_string(converter_context.result), location=loc)
+	return {
+		name = file.name,
+		entry_file = str.ends_with(file.name, ".cpp") ? file.name : str.concatenate({ file.name, ".cpp" }),
+		files = files[:],
+		known_defines = known_defines,
+		finish = proc(unit : ^converter.BatchUnit, ctx : ^converter.ConverterContext) {
+			if len(ctx.overload_resolver) > 0 {
+				str.write_string(&ctx.result, "\n\n")
+				converter.write_overloads(ctx)
+			}
+		},
+		user_data = file,
 	}
 }
@@ -0,0 +1,65 @@
+package xref_program
+
+import "core:fmt"
+import "core:os"
+import "core:time"
+import converter "../src/"
+
+// Looks up symbols in a .xref index written by the converter.
+//   odin run converter/xref -- <index.xref> def  <name>
+//   odin run converter/xref -- <index.xref> refs <name>
+// names are the complete odin names, e.g. ImGui_Begin or ImVec2.
+
+main :: proc()
+{
+	if len(os.args) != 4 || (os.args[2] != "def" && os.args[2] != "refs") {
+		fmt.eprintln("usage: xref <index.xref> def|refs <name>")
+		os.exit(1)
+	}
+
+	index, read_ok := os.read_entire_file(os.args[1])
+	if !read_ok {
+		fmt.eprintfln("Failed to read '%v'.", os.args[1])
+		os.exit(1)
+	}
+
+	start := time.tick_now()
+	symbols, ok := converter.xref_find_symbols(index, os.args[3])
+	lookup_time := time.tick_since(start)
+	if !ok {
+		fmt.eprintfln("'%v' is not a valid index.", os.args[1])
+		os.exit(1)
+	}
+
+	_, _, references, files, strings, _ := converter.xref_split(index)
+
+	print_location :: proc(files : []converter.XrefString, strings : []u8, location : converter.XrefLocation)
+	{
+		if location.row == 0 { fmt.print("<unknown>"); return }
+		fmt.printf("%v:%v:%v", converter.xref_string(strings, files[location.file]), location.row, location.column)
+	}
+
+	for symbol in symbols {
+		kind := converter.AstNodeKind(symbol.kind)
+		if os.args[2] == "def" {
+			fmt.printf("%v (%v)\n  c++:  ", converter.xref_string(strings, symbol.name), kind)
+			print_location(files, strings, symbol.cpp)
+			fmt.print("\n  odin: ")
+			print_location(files, strings, symbol.odin)
+			fmt.println()
+		}
+		else {
+			fmt.printf("%v (%v), %v references\n", converter.xref_string(strings, symbol.name), kind, symbol.reference_count)
+			for reference in references[symbol.first_reference:][:symbol.reference_count] {
+				fmt.print("  ")
+				print_location(files, strings, reference.cpp)
+				fmt.print(" -> ")
+				print_location(files, strings, reference.odin)
+				fmt.println()
+			}
+		}
+	}
+
+	if len(symbols) == 0 { fmt.eprintfln("No symbol named '%v'.", os.args[3]) }
+	fmt.eprintfln("lookup took %v", lookup_time)
+}
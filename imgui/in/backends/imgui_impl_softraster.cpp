@@ -0,0 +1,840 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer (no GPU API)
+// This can be used along with a Platform Backend, or without any to render headless (e.g. report snapshots, CI golden images).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftRaster_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
+//  [X] Renderer: Multi-threading. Triangles are binned into screen tiles, tiles are rasterized in parallel on a small thread pool.
+//  [X] Renderer: Font texture updates for glyphs rasterized on demand (ImGuiBackendFlags_RendererHasTexDirtyRects, ImFontAtlasFlags_DynamicGlyphs).
+//  [X] Renderer: Signed distance field text (ImGuiBackendFlags_RendererHasTextSdf, fonts with ImFontConfig::SdfPadding > 0).
+// Missing features or Issues:
+//  [ ] Renderer: Multi-viewport support (multiple windows).
+//  [ ] Renderer: Draw callbacks are called while triangles are set up, before any pixel of the frame is written.
+
+// You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// Learn about Dear ImGui:
+// - FAQ                  https://dearimgui.com/faq
+// - Getting Started      https://dearimgui.com/getting-started
+// - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
+// - Introduction, links and more at the top of imgui.cpp
+
+// CHANGELOG
+// (minor and older changes stripped away, please see git history for details)
+//  2025-XX-XX: Initial version.
+
+// How it works:
+// - ImGui_ImplSoftRaster_RenderDrawData() sets up every triangle of the frame on the calling thread (edge functions, attribute
+//   planes, scissored bounds) and bins it into the 64x64 pixel tiles its bounds overlap, in submission order.
+// - Tiles are then rasterized in parallel: each thread takes the next tile from a shared counter and draws its triangles in order.
+//   Tiles don't share pixels, so the output is the same for any number of threads.
+// - Edge functions are evaluated at pixel centers with a top-left fill rule, 4 pixels at a time with SSE2 when available.
+//   An edge shared by two triangles is always evaluated from the same end point, so its pixels are covered exactly once.
+// - Blending and color modulation are computed on 8-bit integers with the same rounding in the SSE2 and scalar paths.
+// - Signed distance field texels get their alpha turned into coverage, with a ramp one pixel wide derived from the texel coordinate
+//   gradients of the triangle: text of any size is anti-aliased the same.
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_softraster.h"
+#include <math.h>       // floorf, ceilf, sqrtf
+#include <stdint.h>     // intptr_t
+#include <string.h>     // memcpy
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(IMGUI_IMPL_SOFTRASTER_DISABLE_SSE2)
+#define IMGUI_IMPL_SOFTRASTER_SSE2
+#include <emmintrin.h>
+#endif
+
+#define IMGUI_IMPL_SOFTRASTER_TILE_SIZE     64      // Pixels, multiple of 4
+#define IMGUI_IMPL_SOFTRASTER_MAX_THREADS   64
+
+enum ImGui_ImplSoftRaster_Shade
+{
+    ImGui_ImplSoftRaster_Shade_Flat,                // One color
+    ImGui_ImplSoftRaster_Shade_Gouraud,             // Interpolated color
+    ImGui_ImplSoftRaster_Shade_Textured,            // Texture * one color
+    ImGui_ImplSoftRaster_Shade_TexturedGouraud,     // Texture * interpolated color
+};
+
+struct ImGui_ImplSoftRaster_Triangle
+{
+    float       EdgeA[3], EdgeB[3], EdgeC[3];   // Edge functions E(x, y) = A * x + B * y + C, pixel covered when E > 0 on all edges (E >= 0 on top-left edges)
+    float       EdgeInvA[3];                    // 1 / A, 0.0f when A is too small to be used for spans
+    int         TopLeftMask;                    // (1 << n) for each top-left edge
+    ImS16       MinX, MinY, MaxX, MaxY;         // Pixel bounds, scissored, max exclusive
+    ImU32       Color;                          // _Flat and _Textured
+    int         Shade;                          // ImGui_ImplSoftRaster_Shade
+    int         PlaneOffset;                    // First attribute plane in bd->Planes: 4 color planes (_Gouraud), 2 texel coordinate planes (_Textured), both (_TexturedGouraud)
+    const ImGui_ImplSoftRaster_Texture* Texture;
+    float       SdfScale, SdfBias;              // Signed distance field texture (ImDrawCmd::SdfThreshold > 0.0f): coverage = texel alpha * SdfScale + SdfBias. SdfScale is 0.0f otherwise.
+};
+
+// Attribute linearly interpolated over a triangle: value = DX * x + DY * y + C
+struct ImGui_ImplSoftRaster_Plane
+{
+    float       DX, DY, C;
+};
+
+struct ImGui_ImplSoftRaster_Data
+{
+    ImGui_ImplSoftRaster_Texture            FontTexture;
+    ImVector<ImU32>                         FontPixels;
+
+    // Current frame
+    ImVector<ImGui_ImplSoftRaster_Triangle> Triangles;
+    ImVector<ImGui_ImplSoftRaster_Plane>    Planes;
+    ImVector<int>                           TileBinOffsets;     // TilesX * TilesY + 1 offsets into TileBins
+    ImVector<int>                           TileBins;           // Triangle indices of every tile, in submission order
+    int                                     TilesX, TilesY;
+    unsigned char*                          Target;
+    int                                     TargetPitch;
+    int                                     TargetWidth, TargetHeight;
+    std::atomic<int>                        NextTile;
+
+    // Thread pool
+    std::thread                             Workers[IMGUI_IMPL_SOFTRASTER_MAX_THREADS - 1];
+    int                                     WorkersCount;
+    std::mutex                              WorkersMutex;
+    std::condition_variable                 WorkersWake;
+    std::condition_variable                 WorkersDone;
+    int                                     WorkersJob;         // Incremented for every frame
+    int                                     WorkersBusy;
+    bool                                    WorkersQuit;
+
+    ImGui_ImplSoftRaster_Data() : FontTexture(), TilesX(0), TilesY(0), Target(nullptr), TargetPitch(0), TargetWidth(0), TargetHeight(0), NextTile(0), WorkersCount(0), WorkersJob(0), WorkersBusy(0), WorkersQuit(false) {}
+};
+
+// Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
+// It is STRONGLY preferred that you use docking branch with multi-viewports (== single Dear ImGui context + multiple windows) instead of multiple Dear ImGui contexts.
+static ImGui_ImplSoftRaster_Data* ImGui_ImplSoftRaster_GetBackendData()
+{
+    return ImGui::GetCurrentContext() ? (ImGui_ImplSoftRaster_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
+}
+
+static void ImGui_ImplSoftRaster_WorkerMain(ImGui_ImplSoftRaster_Data* bd);
+
+// Functions
+bool    ImGui_ImplSoftRaster_Init(int thread_count)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IMGUI_CHECKVERSION();
+    IM_ASSERT(io.BackendRendererUserData == nullptr && "Already initialized a renderer backend!");
+
+    // Setup backend capabilities flags
+    ImGui_ImplSoftRaster_Data* bd = IM_NEW(ImGui_ImplSoftRaster_Data)();
+    io.BackendRendererUserData = (void*)bd;
+    io.BackendRendererName = "imgui_impl_softraster";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextSdf;    // We can honor the ImDrawCmd::SdfThreshold/SdfAlphaPerTexel fields, allowing for signed distance field fonts.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexDirtyRects; // We re-upload ImFontAtlas::TexDirtyRects, allowing for glyphs rasterized on demand.
+
+    if (thread_count <= 0)
+        thread_count = (int)std::thread::hardware_concurrency();
+    thread_count = thread_count < 1 ? 1 : thread_count > IMGUI_IMPL_SOFTRASTER_MAX_THREADS ? IMGUI_IMPL_SOFTRASTER_MAX_THREADS : thread_count;
+    bd->WorkersCount = thread_count - 1;    // The thread calling RenderDrawData() takes part
+    for (int n = 0; n < bd->WorkersCount; n++)
+        bd->Workers[n] = std::thread(ImGui_ImplSoftRaster_WorkerMain, bd);
+
+    return true;
+}
+
+void    ImGui_ImplSoftRaster_Shutdown()
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    ImGui_ImplSoftRaster_DestroyDeviceObjects();
+    {
+        std::lock_guard<std::mutex> lock(bd->WorkersMutex);
+        bd->WorkersQuit = true;
+    }
+    bd->WorkersWake.notify_all();
+    for (int n = 0; n < bd->WorkersCount; n++)
+        bd->Workers[n].join();
+
+    io.BackendRendererName = nullptr;
+    io.BackendRendererUserData = nullptr;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextSdf | ImGuiBackendFlags_RendererHasTexDirtyRects);
+    IM_DELETE(bd);
+}
+
+void    ImGui_ImplSoftRaster_NewFrame()
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoftRaster_Init()?");
+
+    if (!bd->FontTexture.Pixels)
+        ImGui_ImplSoftRaster_CreateDeviceObjects();
+}
+
+//-----------------------------------------------------------------------------
+// Pixel operations
+//-----------------------------------------------------------------------------
+
+// x / 255 rounded to nearest, for x <= 255 * 255
+static inline ImU32 ImGui_ImplSoftRaster_Div255(ImU32 x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Component-wise a * b / 255
+static inline ImU32 ImGui_ImplSoftRaster_Modulate(ImU32 a, ImU32 b)
+{
+    if (a == 0xFFFFFFFF)
+        return b;
+    if (b == 0xFFFFFFFF)
+        return a;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        out |= ImGui_ImplSoftRaster_Div255(((a >> shift) & 0xFF) * ((b >> shift) & 0xFF)) << shift;
+    return out;
+}
+
+// src over dst: (SRC_ALPHA, ONE_MINUS_SRC_ALPHA) for colors, (ONE, ONE_MINUS_SRC_ALPHA) for alpha
+static inline ImU32 ImGui_ImplSoftRaster_Blend(ImU32 src, ImU32 dst)
+{
+    const ImU32 src_a = src >> IM_COL32_A_SHIFT;
+    if (src_a == 255)
+        return src;
+    if (src_a == 0)
+        return dst;
+    const ImU32 inv_a = 255 - src_a;
+    ImU32 out = ImGui_ImplSoftRaster_Div255(src_a * 255 + (dst >> IM_COL32_A_SHIFT) * inv_a) << IM_COL32_A_SHIFT;
+    for (int shift = 0; shift < 24; shift += 8)
+        out |= ImGui_ImplSoftRaster_Div255(((src >> shift) & 0xFF) * src_a + ((dst >> shift) & 0xFF) * inv_a) << shift;
+    return out;
+}
+
+// (a * (256 - f) + b * f) / 256 on all components, f in [0, 256]
+static inline ImU32 ImGui_ImplSoftRaster_Lerp(ImU32 a, ImU32 b, ImU32 f)
+{
+    const ImU32 rb = (((a & 0x00FF00FF) * (256 - f) + (b & 0x00FF00FF) * f) >> 8) & 0x00FF00FF;
+    const ImU32 ga = (((a >> 8) & 0x00FF00FF) * (256 - f) + ((b >> 8) & 0x00FF00FF) * f) & 0xFF00FF00;
+    return rb | ga;
+}
+
+// Bilinear sample, clamped to edge. (tx, ty) in texels, with texel centers on integers.
+static inline ImU32 ImGui_ImplSoftRaster_Sample(const ImGui_ImplSoftRaster_Texture* tex, float tx, float ty)
+{
+    const float max_x = (float)(tex->Width - 1);
+    const float max_y = (float)(tex->Height - 1);
+    tx = tx > 0.0f ? (tx < max_x ? tx : max_x) : 0.0f;     // Also turns NaN into 0.0f
+    ty = ty > 0.0f ? (ty < max_y ? ty : max_y) : 0.0f;
+    const int x0 = (int)tx;
+    const int y0 = (int)ty;
+    const ImU32 fx = (ImU32)((tx - (float)x0) * 256.0f);
+    const ImU32 fy = (ImU32)((ty - (float)y0) * 256.0f);
+    const ImU32* row0 = tex->Pixels + (size_t)y0 * tex->Width + x0;
+    if (fx == 0 && fy == 0)
+        return row0[0];
+    const ImU32* row1 = fy != 0 ? row0 + tex->Width : row0;
+    const int dx = fx != 0 ? 1 : 0;
+    return ImGui_ImplSoftRaster_Lerp(ImGui_ImplSoftRaster_Lerp(row0[0], row0[dx], fx), ImGui_ImplSoftRaster_Lerp(row1[0], row1[dx], fx), fy);
+}
+
+// Signed distance field texel: alpha (distance to the outline) turned into the coverage of the pixel
+static inline ImU32 ImGui_ImplSoftRaster_SdfCoverage(const ImGui_ImplSoftRaster_Triangle& tri, ImU32 texel)
+{
+    const float a = (float)(texel >> IM_COL32_A_SHIFT) * tri.SdfScale + tri.SdfBias;
+    return (texel & ~IM_COL32_A_MASK) | ((ImU32)((a > 0.0f ? (a < 255.0f ? a : 255.0f) : 0.0f) + 0.5f) << IM_COL32_A_SHIFT);
+}
+
+static inline float ImGui_ImplSoftRaster_Min(float a, float b) { return a < b ? a : b; }
+static inline float ImGui_ImplSoftRaster_Max(float a, float b) { return a > b ? a : b; }
+
+static inline ImU32 ImGui_ImplSoftRaster_PackColor(float c0, float c1, float c2, float c3)
+{
+    const float c[4] = { c0, c1, c2, c3 };
+    ImU32 out = 0;
+    for (int n = 0; n < 4; n++)
+        out |= (ImU32)((c[n] > 0.0f ? (c[n] < 255.0f ? c[n] : 255.0f) : 0.0f) + 0.5f) << (n * 8);
+    return out;
+}
+
+#ifdef IMGUI_IMPL_SOFTRASTER_SSE2
+// Same as ImGui_ImplSoftRaster_Div255(), on 16-bit lanes
+static inline __m128i ImGui_ImplSoftRaster_Div255x8(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Same as ImGui_ImplSoftRaster_Modulate() on 4 pixels
+static inline __m128i ImGui_ImplSoftRaster_Modulate4(__m128i a, __m128i b)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = ImGui_ImplSoftRaster_Div255x8(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)));
+    const __m128i hi = ImGui_ImplSoftRaster_Div255x8(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)));
+    return _mm_packus_epi16(lo, hi);
+}
+
+// Blend factors of 2 pixels unpacked to 16-bit lanes: src * src_f + dst * dst_f
+static inline void ImGui_ImplSoftRaster_BlendFactors2(__m128i src, __m128i* src_f, __m128i* dst_f)
+{
+    const __m128i alpha_lanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    const __m128i src_a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    *src_f = _mm_or_si128(_mm_andnot_si128(alpha_lanes, src_a), _mm_and_si128(alpha_lanes, _mm_set1_epi16(255)));
+    *dst_f = _mm_sub_epi16(_mm_set1_epi16(255), src_a);
+}
+
+// Same as ImGui_ImplSoftRaster_Blend() on 2 pixels unpacked to 16-bit lanes
+static inline __m128i ImGui_ImplSoftRaster_Blend2(__m128i src, __m128i dst)
+{
+    __m128i src_f, dst_f;
+    ImGui_ImplSoftRaster_BlendFactors2(src, &src_f, &dst_f);
+    return ImGui_ImplSoftRaster_Div255x8(_mm_add_epi16(_mm_mullo_epi16(src, src_f), _mm_mullo_epi16(dst, dst_f)));
+}
+
+static inline __m128i ImGui_ImplSoftRaster_Blend4(__m128i src, __m128i dst)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = ImGui_ImplSoftRaster_Blend2(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero));
+    const __m128i hi = ImGui_ImplSoftRaster_Blend2(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero));
+    return _mm_packus_epi16(lo, hi);
+}
+
+// Same as ImGui_ImplSoftRaster_Blend4() with the same source on all pixels, 'src_term' and 'dst_f' from ImGui_ImplSoftRaster_BlendFactors2()
+static inline __m128i ImGui_ImplSoftRaster_Blend4Const(__m128i src_term, __m128i dst_f, __m128i dst)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = ImGui_ImplSoftRaster_Div255x8(_mm_add_epi16(src_term, _mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), dst_f)));
+    const __m128i hi = ImGui_ImplSoftRaster_Div255x8(_mm_add_epi16(src_term, _mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), dst_f)));
+    return _mm_packus_epi16(lo, hi);
+}
+
+// Same as ImGui_ImplSoftRaster_PackColor() on 4 pixels
+static inline __m128i ImGui_ImplSoftRaster_PackColor4(const __m128 c[4])
+{
+    __m128i out = _mm_setzero_si128();
+    for (int n = 0; n < 4; n++)
+    {
+        const __m128 v = _mm_add_ps(_mm_min_ps(_mm_max_ps(c[n], _mm_setzero_ps()), _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+        out = _mm_or_si128(out, _mm_slli_epi32(_mm_cvttps_epi32(v), n * 8));
+    }
+    return out;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Rasterization
+//-----------------------------------------------------------------------------
+
+// Draw the part of a triangle inside [x0, x1) x [y0, y1) of the target
+static void ImGui_ImplSoftRaster_RasterizeTriangle(const ImGui_ImplSoftRaster_Data* bd, const ImGui_ImplSoftRaster_Triangle& tri, int x0, int y0, int x1, int y1)
+{
+    if (tri.MinX > x0) x0 = tri.MinX;
+    if (tri.MinY > y0) y0 = tri.MinY;
+    if (tri.MaxX < x1) x1 = tri.MaxX;
+    if (tri.MaxY < y1) y1 = tri.MaxY;
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    const ImGui_ImplSoftRaster_Plane* color_planes = (tri.Shade == ImGui_ImplSoftRaster_Shade_Gouraud || tri.Shade == ImGui_ImplSoftRaster_Shade_TexturedGouraud) ? &bd->Planes[tri.PlaneOffset] : nullptr;
+    const ImGui_ImplSoftRaster_Plane* uv_planes = (tri.Shade == ImGui_ImplSoftRaster_Shade_Textured) ? &bd->Planes[tri.PlaneOffset] : (tri.Shade == ImGui_ImplSoftRaster_Shade_TexturedGouraud) ? &bd->Planes[tri.PlaneOffset + 4] : nullptr;
+    const bool opaque = tri.Shade == ImGui_ImplSoftRaster_Shade_Flat && (tri.Color & IM_COL32_A_MASK) == IM_COL32_A_MASK;
+
+#ifdef IMGUI_IMPL_SOFTRASTER_SSE2
+    const __m128 lane_offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+    const __m128i lane_indices = _mm_set_epi32(3, 2, 1, 0);
+    const __m128i scissor_min = _mm_set1_epi32(x0 - 1);
+    const __m128i scissor_max = _mm_set1_epi32(x1);
+    const __m128i flat_color = _mm_set1_epi32((int)tri.Color);
+    const bool flat_blend = !opaque && tri.Shade == ImGui_ImplSoftRaster_Shade_Flat;
+    __m128i flat_src_term, flat_dst_f;
+    {
+        const __m128i flat_color16 = _mm_unpacklo_epi8(flat_color, _mm_setzero_si128());
+        __m128i flat_src_f;
+        ImGui_ImplSoftRaster_BlendFactors2(flat_color16, &flat_src_f, &flat_dst_f);
+        flat_src_term = _mm_mullo_epi16(flat_color16, flat_src_f);
+    }
+    __m128 edge_a[3];
+    __m128i edge_top_left[3];
+    for (int e = 0; e < 3; e++)
+    {
+        edge_a[e] = _mm_set1_ps(tri.EdgeA[e]);
+        edge_top_left[e] = _mm_set1_epi32((tri.TopLeftMask & (1 << e)) ? -1 : 0);
+    }
+#endif
+
+    for (int y = y0; y < y1; y++)
+    {
+        // Edge functions along the row, the span of pixels possibly covered (with 1 pixel of margin for rounding),
+        // and the inner span of pixels surely covered (with a margin larger than the rounding error of the edge functions).
+        const float py = (float)y + 0.5f;
+        float edge_row[3];
+        float span_x0 = (float)x0, span_x1 = (float)x1;
+        float inner_x0 = (float)x0, inner_x1 = (float)x1;
+        bool empty = false;
+        for (int e = 0; e < 3; e++)
+        {
+            const float a = tri.EdgeA[e], b = tri.EdgeB[e], c = tri.EdgeC[e], inv_a = tri.EdgeInvA[e];
+            edge_row[e] = b * py + c;
+            const float x_cross = -edge_row[e] * inv_a;
+            const float inner_margin = 2.0f + ((a > 0.0f ? a : -a) * (float)x1 + (b > 0.0f ? b : -b) * py + (c > 0.0f ? c : -c)) * 1e-6f * (inv_a > 0.0f ? inv_a : -inv_a);
+            if (inv_a > 0.0f)
+            {
+                span_x0 = ImGui_ImplSoftRaster_Max(span_x0, x_cross - 1.5f);
+                inner_x0 = ImGui_ImplSoftRaster_Max(inner_x0, x_cross + inner_margin);
+            }
+            else if (inv_a < 0.0f)
+            {
+                span_x1 = ImGui_ImplSoftRaster_Min(span_x1, x_cross + 1.5f);
+                inner_x1 = ImGui_ImplSoftRaster_Min(inner_x1, x_cross - inner_margin);
+            }
+            else if (a != 0.0f || edge_row[e] == 0.0f)
+                inner_x1 = inner_x0;
+            if (a == 0.0f && (edge_row[e] < 0.0f || (edge_row[e] == 0.0f && !(tri.TopLeftMask & (1 << e)))))
+                empty = true;
+        }
+        if (empty || span_x0 >= span_x1)
+            continue;
+        int span_begin = (int)span_x0;
+        int span_end = (int)span_x1 + 1;
+        if (span_end > x1)
+            span_end = x1;
+        const int inner_begin = (int)inner_x0 + 1;
+        const int inner_end = inner_x1 > inner_x0 ? (int)inner_x1 : inner_begin;
+
+        float color_row[4] = {};
+        float uv_row[2] = {};
+        if (color_planes)
+            for (int n = 0; n < 4; n++)
+                color_row[n] = color_planes[n].DY * py + color_planes[n].C;
+        if (uv_planes)
+            for (int n = 0; n < 2; n++)
+                uv_row[n] = uv_planes[n].DY * py + uv_planes[n].C;
+
+        ImU32* row_pixels = (ImU32*)(void*)(bd->Target + (size_t)y * bd->TargetPitch);
+
+#ifdef IMGUI_IMPL_SOFTRASTER_SSE2
+        // 4 pixels at a time. Blocks are aligned so they never straddle two tiles, as another thread may be writing the other one.
+        span_begin &= ~3;
+        const __m128 edge_row4[3] = { _mm_set1_ps(edge_row[0]), _mm_set1_ps(edge_row[1]), _mm_set1_ps(edge_row[2]) };
+        for (int x = span_begin; x < span_end; x += 4)
+        {
+            const __m128 px = _mm_add_ps(_mm_set1_ps((float)x), lane_offsets);
+            const __m128i lanes = _mm_add_epi32(_mm_set1_epi32(x), lane_indices);
+            __m128i mask = _mm_and_si128(_mm_cmpgt_epi32(lanes, scissor_min), _mm_cmplt_epi32(lanes, scissor_max));
+            for (int e = (x >= inner_begin && x + 4 <= inner_end) ? 3 : 0; e < 3; e++)
+            {
+                const __m128 edge = _mm_add_ps(_mm_mul_ps(edge_a[e], px), edge_row4[e]);
+                const __m128i inside = _mm_or_si128(_mm_castps_si128(_mm_cmpgt_ps(edge, _mm_setzero_ps())), _mm_and_si128(_mm_castps_si128(_mm_cmpeq_ps(edge, _mm_setzero_ps())), edge_top_left[e]));
+                mask = _mm_and_si128(mask, inside);
+            }
+            const int lane_mask = _mm_movemask_ps(_mm_castsi128_ps(mask));
+            if (lane_mask == 0)
+                continue;
+
+            __m128i src;
+            if (color_planes)
+            {
+                __m128 c[4];
+                for (int n = 0; n < 4; n++)
+                    c[n] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(color_planes[n].DX), px), _mm_set1_ps(color_row[n]));
+                src = ImGui_ImplSoftRaster_PackColor4(c);
+            }
+            else
+            {
+                src = flat_color;
+            }
+            if (uv_planes)
+            {
+                float u[4], v[4];
+                _mm_storeu_ps(u, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(uv_planes[0].DX), px), _mm_set1_ps(uv_row[0])));
+                _mm_storeu_ps(v, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(uv_planes[1].DX), px), _mm_set1_ps(uv_row[1])));
+                ImU32 texels[4] = {};
+                for (int n = 0; n < 4; n++)
+                    if (lane_mask & (1 << n))
+                        texels[n] = ImGui_ImplSoftRaster_Sample(tri.Texture, u[n], v[n]);
+                if (tri.SdfScale != 0.0f)
+                    for (int n = 0; n < 4; n++)
+                        texels[n] = ImGui_ImplSoftRaster_SdfCoverage(tri, texels[n]);
+                const __m128i texels4 = _mm_loadu_si128((const __m128i*)(const void*)texels);
+                src = (color_planes || tri.Color != 0xFFFFFFFF) ? ImGui_ImplSoftRaster_Modulate4(src, texels4) : texels4;
+            }
+
+            // The last block of a row may go past the right of the target
+            ImU32 partial[4];
+            ImU32* dst_pixels = row_pixels + x;
+            const int dst_count = bd->TargetWidth - x;
+            if (dst_count < 4)
+            {
+                memcpy(partial, dst_pixels, (size_t)dst_count * sizeof(ImU32));
+                dst_pixels = partial;
+            }
+            const __m128i dst = _mm_loadu_si128((const __m128i*)(const void*)dst_pixels);
+            const __m128i out = opaque ? src : flat_blend ? ImGui_ImplSoftRaster_Blend4Const(flat_src_term, flat_dst_f, dst) : ImGui_ImplSoftRaster_Blend4(src, dst);
+            _mm_storeu_si128((__m128i*)(void*)dst_pixels, _mm_or_si128(_mm_and_si128(mask, out), _mm_andnot_si128(mask, dst)));
+            if (dst_count < 4)
+                memcpy(row_pixels + x, partial, (size_t)dst_count * sizeof(ImU32));
+        }
+#else
+        if (span_begin < x0)
+            span_begin = x0;
+        for (int x = span_begin; x < span_end; x++)
+        {
+            const float px = (float)x + 0.5f;
+            bool inside = true;
+            for (int e = (x >= inner_begin && x < inner_end) ? 3 : 0; e < 3 && inside; e++)
+            {
+                const float edge = tri.EdgeA[e] * px + edge_row[e];
+                inside = edge > 0.0f || (edge == 0.0f && (tri.TopLeftMask & (1 << e)));
+            }
+            if (!inside)
+                continue;
+            ImU32 src = tri.Color;
+            if (color_planes)
+                src = ImGui_ImplSoftRaster_PackColor(color_planes[0].DX * px + color_row[0], color_planes[1].DX * px + color_row[1], color_planes[2].DX * px + color_row[2], color_planes[3].DX * px + color_row[3]);
+            if (uv_planes)
+            {
+                ImU32 texel = ImGui_ImplSoftRaster_Sample(tri.Texture, uv_planes[0].DX * px + uv_row[0], uv_planes[1].DX * px + uv_row[1]);
+                if (tri.SdfScale != 0.0f)
+                    texel = ImGui_ImplSoftRaster_SdfCoverage(tri, texel);
+                src = ImGui_ImplSoftRaster_Modulate(src, texel);
+            }
+            row_pixels[x] = opaque ? src : ImGui_ImplSoftRaster_Blend(src, row_pixels[x]);
+        }
+#endif
+    }
+}
+
+// Rasterize tiles until there are none left. Called by the thread rendering the frame and by every worker.
+static void ImGui_ImplSoftRaster_RasterizeTiles(ImGui_ImplSoftRaster_Data* bd)
+{
+    const int tile_count = bd->TilesX * bd->TilesY;
+    for (int tile_n = bd->NextTile.fetch_add(1); tile_n < tile_count; tile_n = bd->NextTile.fetch_add(1))
+    {
+        const int bin_begin = bd->TileBinOffsets[tile_n];
+        const int bin_end = bd->TileBinOffsets[tile_n + 1];
+        if (bin_begin == bin_end)
+            continue;
+        const int x0 = (tile_n % bd->TilesX) * IMGUI_IMPL_SOFTRASTER_TILE_SIZE;
+        const int y0 = (tile_n / bd->TilesX) * IMGUI_IMPL_SOFTRASTER_TILE_SIZE;
+        const int x1 = x0 + IMGUI_IMPL_SOFTRASTER_TILE_SIZE < bd->TargetWidth ? x0 + IMGUI_IMPL_SOFTRASTER_TILE_SIZE : bd->TargetWidth;
+        const int y1 = y0 + IMGUI_IMPL_SOFTRASTER_TILE_SIZE < bd->TargetHeight ? y0 + IMGUI_IMPL_SOFTRASTER_TILE_SIZE : bd->TargetHeight;
+        for (int bin_n = bin_begin; bin_n < bin_end; bin_n++)
+            ImGui_ImplSoftRaster_RasterizeTriangle(bd, bd->Triangles[bd->TileBins[bin_n]], x0, y0, x1, y1);
+    }
+}
+
+static void ImGui_ImplSoftRaster_WorkerMain(ImGui_ImplSoftRaster_Data* bd)
+{
+    int last_job = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(bd->WorkersMutex);
+            bd->WorkersWake.wait(lock, [&]() { return bd->WorkersQuit || bd->WorkersJob != last_job; });
+            if (bd->WorkersQuit)
+                return;
+            last_job = bd->WorkersJob;
+        }
+        ImGui_ImplSoftRaster_RasterizeTiles(bd);
+        {
+            std::lock_guard<std::mutex> lock(bd->WorkersMutex);
+            if (--bd->WorkersBusy == 0)
+                bd->WorkersDone.notify_one();
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Setup
+//-----------------------------------------------------------------------------
+
+// Edge function of the edge going from p to q, positive on its right side on screen.
+// Always computed from the lowest end point then negated as needed, so that both triangles sharing an edge get exactly opposite values.
+static void ImGui_ImplSoftRaster_SetupEdge(ImGui_ImplSoftRaster_Triangle* tri, int e, const ImVec2& p, const ImVec2& q)
+{
+    const bool flip = (p.y > q.y) || (p.y == q.y && p.x > q.x);
+    const ImVec2& from = flip ? q : p;
+    const ImVec2& to = flip ? p : q;
+    float a = from.y - to.y;
+    float b = to.x - from.x;
+    float c = -(a * from.x + b * from.y);
+    if (flip)
+    {
+        a = -a;
+        b = -b;
+        c = -c;
+    }
+    tri->EdgeA[e] = a;
+    tri->EdgeB[e] = b;
+    tri->EdgeC[e] = c;
+    tri->EdgeInvA[e] = (a > 1e-6f || a < -1e-6f) ? 1.0f / a : 0.0f;
+    if (a > 0.0f || (a == 0.0f && b > 0.0f))
+        tri->TopLeftMask |= 1 << e;
+}
+
+static void ImGui_ImplSoftRaster_SetupPlane(ImGui_ImplSoftRaster_Data* bd, const ImGui_ImplSoftRaster_Triangle& tri, float inv_area, float v0, float v1, float v2)
+{
+    // Edge n is opposite to vertex n: its function is 0 on the two other vertices, and 'area' on vertex n.
+    ImGui_ImplSoftRaster_Plane plane;
+    plane.DX = (tri.EdgeA[0] * v0 + tri.EdgeA[1] * v1 + tri.EdgeA[2] * v2) * inv_area;
+    plane.DY = (tri.EdgeB[0] * v0 + tri.EdgeB[1] * v1 + tri.EdgeB[2] * v2) * inv_area;
+    plane.C = (tri.EdgeC[0] * v0 + tri.EdgeC[1] * v1 + tri.EdgeC[2] * v2) * inv_area;
+    bd->Planes.push_back(plane);
+}
+
+static void ImGui_ImplSoftRaster_SetupTriangle(ImGui_ImplSoftRaster_Data* bd, const ImDrawVert* v0, const ImDrawVert* v1, const ImDrawVert* v2, const ImVec2& clip_off, const ImVec2& clip_scale, const int scissor[4], const ImGui_ImplSoftRaster_Texture* texture, const ImDrawCmd* cmd)
+{
+    const ImDrawVert* verts[3] = { v0, v1, v2 };
+    ImVec2 pos[3];
+    for (int n = 0; n < 3; n++)
+        pos[n] = ImVec2((verts[n]->pos.x - clip_off.x) * clip_scale.x, (verts[n]->pos.y - clip_off.y) * clip_scale.y);
+
+    // Make all triangles clockwise on screen
+    const float area = (pos[0].y - pos[1].y) * (pos[2].x - pos[0].x) + (pos[1].x - pos[0].x) * (pos[2].y - pos[0].y);
+    if (!(area > 0.0f || area < 0.0f))
+        return;
+    if (area < 0.0f)
+    {
+        const ImDrawVert* tmp_vert = verts[1]; verts[1] = verts[2]; verts[2] = tmp_vert;
+        const ImVec2 tmp_pos = pos[1]; pos[1] = pos[2]; pos[2] = tmp_pos;
+    }
+
+    // Bounds
+    float min_x = pos[0].x, min_y = pos[0].y, max_x = pos[0].x, max_y = pos[0].y;
+    for (int n = 1; n < 3; n++)
+    {
+        min_x = pos[n].x < min_x ? pos[n].x : min_x;
+        min_y = pos[n].y < min_y ? pos[n].y : min_y;
+        max_x = pos[n].x > max_x ? pos[n].x : max_x;
+        max_y = pos[n].y > max_y ? pos[n].y : max_y;
+    }
+    min_x = floorf(min_x > (float)scissor[0] ? min_x : (float)scissor[0]);
+    min_y = floorf(min_y > (float)scissor[1] ? min_y : (float)scissor[1]);
+    max_x = ceilf(max_x < (float)scissor[2] ? max_x : (float)scissor[2]);
+    max_y = ceilf(max_y < (float)scissor[3] ? max_y : (float)scissor[3]);
+    if (!(min_x < max_x && min_y < max_y))
+        return;
+
+    // Texture sampled at a single point: fold it into the vertex colors
+    const bool sdf = texture != nullptr && cmd->SdfThreshold > 0.0f;
+    ImU32 cols[3] = { verts[0]->col, verts[1]->col, verts[2]->col };
+    if (texture != nullptr && !sdf && verts[0]->uv.x == verts[1]->uv.x && verts[0]->uv.x == verts[2]->uv.x && verts[0]->uv.y == verts[1]->uv.y && verts[0]->uv.y == verts[2]->uv.y)
+    {
+        const ImU32 texel = ImGui_ImplSoftRaster_Sample(texture, verts[0]->uv.x * texture->Width - 0.5f, verts[0]->uv.y * texture->Height - 0.5f);
+        for (int n = 0; n < 3; n++)
+            cols[n] = ImGui_ImplSoftRaster_Modulate(cols[n], texel);
+        texture = nullptr;
+    }
+    if (((cols[0] | cols[1] | cols[2]) & IM_COL32_A_MASK) == 0)
+        return;
+
+    ImGui_ImplSoftRaster_Triangle tri;
+    tri.TopLeftMask = 0;
+    ImGui_ImplSoftRaster_SetupEdge(&tri, 0, pos[1], pos[2]);
+    ImGui_ImplSoftRaster_SetupEdge(&tri, 1, pos[2], pos[0]);
+    ImGui_ImplSoftRaster_SetupEdge(&tri, 2, pos[0], pos[1]);
+    tri.MinX = (ImS16)min_x;
+    tri.MinY = (ImS16)min_y;
+    tri.MaxX = (ImS16)max_x;
+    tri.MaxY = (ImS16)max_y;
+    tri.Color = cols[0];
+    tri.Texture = texture;
+    tri.PlaneOffset = bd->Planes.Size;
+    tri.SdfScale = tri.SdfBias = 0.0f;
+
+    const bool gouraud = cols[0] != cols[1] || cols[0] != cols[2];
+    const float inv_area = 1.0f / (area > 0.0f ? area : -area);
+    if (gouraud)
+        for (int shift = 0; shift < 32; shift += 8)
+            ImGui_ImplSoftRaster_SetupPlane(bd, tri, inv_area, (float)((cols[0] >> shift) & 0xFF), (float)((cols[1] >> shift) & 0xFF), (float)((cols[2] >> shift) & 0xFF));
+    if (texture != nullptr)
+    {
+        // Texel coordinates, with texel centers on integers
+        const float w = (float)texture->Width, h = (float)texture->Height;
+        ImGui_ImplSoftRaster_SetupPlane(bd, tri, inv_area, verts[0]->uv.x * w - 0.5f, verts[1]->uv.x * w - 0.5f, verts[2]->uv.x * w - 0.5f);
+        ImGui_ImplSoftRaster_SetupPlane(bd, tri, inv_area, verts[0]->uv.y * h - 0.5f, verts[1]->uv.y * h - 0.5f, verts[2]->uv.y * h - 0.5f);
+
+        // Signed distance field: alpha changes by 'alpha_per_pixel' (0..255) per pixel, the outline is anti-aliased over one pixel
+        if (sdf)
+        {
+            const ImGui_ImplSoftRaster_Plane* uv_planes = &bd->Planes[bd->Planes.Size - 2];
+            const float texels_per_pixel = sqrtf(0.5f * (uv_planes[0].DX * uv_planes[0].DX + uv_planes[0].DY * uv_planes[0].DY + uv_planes[1].DX * uv_planes[1].DX + uv_planes[1].DY * uv_planes[1].DY));
+            const float alpha_per_pixel = ImGui_ImplSoftRaster_Max(cmd->SdfAlphaPerTexel * 255.0f * texels_per_pixel, 1.0f);
+            tri.SdfScale = 255.0f / alpha_per_pixel;
+            tri.SdfBias = 127.5f - cmd->SdfThreshold * 255.0f * tri.SdfScale;
+        }
+    }
+    tri.Shade = texture ? (gouraud ? ImGui_ImplSoftRaster_Shade_TexturedGouraud : ImGui_ImplSoftRaster_Shade_Textured) : (gouraud ? ImGui_ImplSoftRaster_Shade_Gouraud : ImGui_ImplSoftRaster_Shade_Flat);
+    bd->Triangles.push_back(tri);
+}
+
+// Target: 'width * height' pixels in IM_COL32 layout, rows 'pitch' bytes apart. Rendering is clipped to the smallest of the target and draw_data sizes.
+void    ImGui_ImplSoftRaster_RenderDrawData(ImDrawData* draw_data, void* pixels, int width, int height, int pitch)
+{
+    // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
+    int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    fb_width = fb_width < width ? fb_width : width;
+    fb_height = fb_height < height ? fb_height : height;
+    if (fb_width <= 0 || fb_height <= 0 || pixels == nullptr)
+        return;
+    IM_ASSERT(fb_width <= 32767 && fb_height <= 32767);
+
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    ImGui_ImplSoftRaster_UpdateFontsTexture();
+    bd->Target = (unsigned char*)pixels;
+    bd->TargetPitch = pitch;
+    bd->TargetWidth = fb_width;
+    bd->TargetHeight = fb_height;
+    bd->Triangles.resize(0);
+    bd->Planes.resize(0);
+
+    // Will project scissor/clipping rectangles into framebuffer space
+    ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+    ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+
+    // Set up triangles
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        const ImDrawVert* vtx_buffer = draw_list->VtxBuffer.Data;
+        const ImDrawIdx* idx_buffer = draw_list->IdxBuffer.Data;
+        for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(draw_list, pcmd);
+                continue;
+            }
+
+            // Project scissor/clipping rectangles into framebuffer space
+            ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+            ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+            int scissor[4];
+            scissor[0] = clip_min.x > 0.0f ? (int)clip_min.x : 0;
+            scissor[1] = clip_min.y > 0.0f ? (int)clip_min.y : 0;
+            scissor[2] = clip_max.x < (float)fb_width ? (int)clip_max.x : fb_width;
+            scissor[3] = clip_max.y < (float)fb_height ? (int)clip_max.y : fb_height;
+            if (scissor[2] <= scissor[0] || scissor[3] <= scissor[1])
+                continue;
+
+            const ImGui_ImplSoftRaster_Texture* texture = (const ImGui_ImplSoftRaster_Texture*)(intptr_t)pcmd->GetTexID();
+            const ImDrawVert* cmd_vtx = vtx_buffer + pcmd->VtxOffset;
+            const ImDrawIdx* cmd_idx = idx_buffer + pcmd->IdxOffset;
+            for (unsigned int idx_n = 0; idx_n + 2 < pcmd->ElemCount; idx_n += 3)
+                ImGui_ImplSoftRaster_SetupTriangle(bd, &cmd_vtx[cmd_idx[idx_n]], &cmd_vtx[cmd_idx[idx_n + 1]], &cmd_vtx[cmd_idx[idx_n + 2]], clip_off, clip_scale, scissor, texture, pcmd);
+        }
+    }
+
+    // Bin triangles into tiles: count, then fill in submission order
+    bd->TilesX = (fb_width + IMGUI_IMPL_SOFTRASTER_TILE_SIZE - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE;
+    bd->TilesY = (fb_height + IMGUI_IMPL_SOFTRASTER_TILE_SIZE - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE;
+    const int tile_count = bd->TilesX * bd->TilesY;
+    bd->TileBinOffsets.resize(tile_count + 1);
+    memset(bd->TileBinOffsets.Data, 0, (size_t)bd->TileBinOffsets.size_in_bytes());
+    int* counts = bd->TileBinOffsets.Data + 1;
+    for (const ImGui_ImplSoftRaster_Triangle& tri : bd->Triangles)
+        for (int ty = tri.MinY / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; ty <= (tri.MaxY - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; ty++)
+            for (int tx = tri.MinX / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; tx <= (tri.MaxX - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; tx++)
+                counts[ty * bd->TilesX + tx]++;
+    for (int tile_n = 0; tile_n < tile_count; tile_n++)
+        bd->TileBinOffsets[tile_n + 1] += bd->TileBinOffsets[tile_n];
+    bd->TileBins.resize(bd->TileBinOffsets[tile_count]);
+    for (int tri_n = 0; tri_n < bd->Triangles.Size; tri_n++)
+    {
+        const ImGui_ImplSoftRaster_Triangle& tri = bd->Triangles[tri_n];
+        for (int ty = tri.MinY / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; ty <= (tri.MaxY - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; ty++)
+            for (int tx = tri.MinX / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; tx <= (tri.MaxX - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; tx++)
+                bd->TileBins[bd->TileBinOffsets[ty * bd->TilesX + tx]++] = tri_n;
+    }
+    for (int tile_n = tile_count; tile_n > 0; tile_n--)     // Filling moved every offset to the next tile
+        bd->TileBinOffsets[tile_n] = bd->TileBinOffsets[tile_n - 1];
+    bd->TileBinOffsets[0] = 0;
+
+    // Rasterize tiles on all threads
+    bd->NextTile = 0;
+    const bool use_workers = bd->WorkersCount > 0 && tile_count > 1;
+    if (use_workers)
+    {
+        {
+            std::lock_guard<std::mutex> lock(bd->WorkersMutex);
+            bd->WorkersBusy = bd->WorkersCount;
+            bd->WorkersJob++;
+        }
+        bd->WorkersWake.notify_all();
+    }
+    ImGui_ImplSoftRaster_RasterizeTiles(bd);
+    if (use_workers)
+    {
+        std::unique_lock<std::mutex> lock(bd->WorkersMutex);
+        bd->WorkersDone.wait(lock, [&]() { return bd->WorkersBusy == 0; });
+    }
+}
+
+bool ImGui_ImplSoftRaster_CreateFontsTexture()
+{
+    // Build texture atlas
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
+
+    // Copy texture, the atlas may release its own pixels
+    bd->FontPixels.resize(width * height);
+    memcpy(bd->FontPixels.Data, pixels, (size_t)bd->FontPixels.size_in_bytes());
+    bd->FontTexture.Pixels = bd->FontPixels.Data;
+    bd->FontTexture.Width = width;
+    bd->FontTexture.Height = height;
+
+    // Store our identifier
+    io.Fonts->SetTexID((ImTextureID)(intptr_t)&bd->FontTexture);
+
+    return true;
+}
+
+// Copy the areas of the atlas which changed since the texture was created (glyphs rasterized on demand with ImFontAtlasFlags_DynamicGlyphs)
+void ImGui_ImplSoftRaster_UpdateFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    ImFontAtlas* atlas = io.Fonts;
+    if (atlas->TexDirtyRects.Size == 0)
+        return;
+    if (bd->FontTexture.Pixels && atlas->TexPixelsRGBA32 && atlas->TexWidth == bd->FontTexture.Width && atlas->TexHeight == bd->FontTexture.Height)
+        for (const ImFontAtlasRect& r : atlas->TexDirtyRects)
+            for (int y = r.Y; y < r.Y + r.Height; y++)
+                memcpy(bd->FontPixels.Data + r.X + y * bd->FontTexture.Width, atlas->TexPixelsRGBA32 + r.X + y * atlas->TexWidth, (size_t)r.Width * sizeof(ImU32));
+    atlas->TexDirtyRects.resize(0);
+}
+
+void ImGui_ImplSoftRaster_DestroyFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    if (bd->FontTexture.Pixels)
+    {
+        io.Fonts->SetTexID(0);
+        bd->FontPixels.clear();
+        bd->FontTexture.Pixels = nullptr;
+        bd->FontTexture.Width = bd->FontTexture.Height = 0;
+    }
+}
+
+bool    ImGui_ImplSoftRaster_CreateDeviceObjects()
+{
+    return ImGui_ImplSoftRaster_CreateFontsTexture();
+}
+
+void    ImGui_ImplSoftRaster_DestroyDeviceObjects()
+{
+    ImGui_ImplSoftRaster_DestroyFontsTexture();
+}
+
+//-----------------------------------------------------------------------------
+
+#endif // #ifndef IMGUI_DISABLE
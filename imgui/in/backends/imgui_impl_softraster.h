@@ -0,0 +1,52 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer (no GPU API)
+// This can be used along with a Platform Backend, or without any to render headless (e.g. report snapshots, CI golden images).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftRaster_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
+//  [X] Renderer: Multi-threading. Triangles are binned into screen tiles, tiles are rasterized in parallel on a small thread pool.
+//  [X] Renderer: Font texture updates for glyphs rasterized on demand (ImGuiBackendFlags_RendererHasTexDirtyRects, ImFontAtlasFlags_DynamicGlyphs).
+//  [X] Renderer: Signed distance field text (ImGuiBackendFlags_RendererHasTextSdf, fonts with ImFontConfig::SdfPadding > 0).
+// Missing features or Issues:
+//  [ ] Renderer: Multi-viewport support (multiple windows).
+//  [ ] Renderer: Draw callbacks are called while triangles are set up, before any pixel of the frame is written.
+
+// Output is 8-bit RGBA in IM_COL32 layout (bytes R,G,B,A in memory), blended over the existing content of the target
+// with (SRC_ALPHA, ONE_MINUS_SRC_ALPHA) for colors and (ONE, ONE_MINUS_SRC_ALPHA) for alpha, as imgui_impl_opengl3 does.
+// Clear the target yourself before rendering a frame. Textures are sampled with bilinear filtering, clamped to edge.
+// The output doesn't depend on the number of threads.
+
+// You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// Learn about Dear ImGui:
+// - FAQ                  https://dearimgui.com/faq
+// - Getting Started      https://dearimgui.com/getting-started
+// - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
+// - Introduction, links and more at the top of imgui.cpp
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+#ifndef IMGUI_DISABLE
+
+// Texture, use a pointer to it as ImTextureID.
+struct ImGui_ImplSoftRaster_Texture
+{
+    const ImU32*    Pixels;     // Width * Height pixels, IM_COL32 layout, not premultiplied
+    int             Width;
+    int             Height;
+};
+
+// Follow "Getting Started" link and check examples/ folder to learn about using backends!
+IMGUI_IMPL_API bool     ImGui_ImplSoftRaster_Init(int thread_count = 0);    // Number of threads rasterizing, including the one calling RenderDrawData(). 0: one per hardware thread.
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_NewFrame();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_RenderDrawData(ImDrawData* draw_data, void* pixels, int width, int height, int pitch);   // 'pitch' in bytes
+
+// Called by Init/NewFrame/Shutdown
+IMGUI_IMPL_API bool     ImGui_ImplSoftRaster_CreateFontsTexture();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_DestroyFontsTexture();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_UpdateFontsTexture();      // Called by RenderDrawData(): copy the areas listed in ImFontAtlas::TexDirtyRects
+IMGUI_IMPL_API bool     ImGui_ImplSoftRaster_CreateDeviceObjects();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_DestroyDeviceObjects();
+
+#endif // #ifndef IMGUI_DISABLE
@@ -50,6 +50,11 @@
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_DEFAULT_FONT                        // Disable default embedded font (ProggyClean.ttf), remove ~9.5 KB from output binary. AddFontDefault() will assert.
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
+//#define IMGUI_DISABLE_NEON                                // Disable use of NEON intrinsics even if available (AArch64)
+//#define IMGUI_DISABLE_SIMD_POLYLINE                       // Use the scalar loops in AddPolyline() even when SSE/NEON is enabled (e.g. to compare against them)
+//#define IMGUI_DISABLE_SIMD_TEXT                           // Decode text one codepoint at a time in CalcTextSizeA()/RenderText() even when SSE/NEON is enabled (e.g. to compare against it)
+//#define IMGUI_DISABLE_DRAWLIST_SHAPE_TEMPLATES            // Tessellate AddRect()/AddCircle() etc. on every call instead of copying cached meshes (e.g. to compare against them)
+//#define IMGUI_DISABLE_TEXT_LAYOUT_CACHE                   // Measure and word-wrap text on every CalcTextSize()/RenderText() call instead of reusing layouts from previous frames (e.g. to compare against them)
 
 //---- Enable Test Engine / Automation features.
 //#define IMGUI_ENABLE_TEST_ENGINE                          // Enable imgui_test_engine hooks. Generally set automatically by include "imgui_te_config.h", see Test Engine for details.
@@ -1186,6 +1186,12 @@ static const ImVec2 TOOLTIP_DEFAULT_OFFSET_MOUSE = ImVec2(16, 10);      // Multi
 static const ImVec2 TOOLTIP_DEFAULT_OFFSET_TOUCH = ImVec2(0, -20);      // Multiplied by g.Style.MouseCursorScale
 static const ImVec2 TOOLTIP_DEFAULT_PIVOT_TOUCH = ImVec2(0.5f, 1.0f);   // Multiplied by g.Style.MouseCursorScale
 
+// Idle tracking (when io.ConfigIdleSkipFrames is set)
+static const int   IDLE_SETTLE_FRAMES                       = 2;        // Frames still produced after the last busy frame (e.g. hovered state catching up with a mouse move).
+
+// Damage tracking (when ImGuiBackendFlags_RendererHasDamageRects is set)
+static const int   DAMAGE_RECTS_MAX                         = 8;        // Above this amount, damage rectangles are merged into a single one.
+
 // Docking
 static const float DOCKING_TRANSPARENT_PAYLOAD_ALPHA        = 0.50f;    // For use with io.ConfigDockingTransparentPayload. Apply to Viewport _or_ WindowBg in host viewport.
 
@@ -1483,6 +1489,7 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsCopyContentsWithCtrlC = false;
     ConfigScrollbarScrollByPage = true;
     ConfigMemoryCompactTimer = 60.0f;
+    ConfigIdleSkipFrames = false;
     ConfigDebugIsDebuggerPresent = false;
     ConfigDebugHighlightIdConflicts = true;
     ConfigDebugBeginReturnValueOnce = false;
@@ -2289,6 +2296,24 @@ ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
 #endif
 }
 
+// 64-bit hash, 8 bytes at a time: with ImHashData() (CRC32, one byte at a time), hashing a label costs about as much as measuring it,
+// and hashing a large font file or a draw list's vertices could cost more than building or rendering them.
+ImU64 ImHashData64(const void* data_p, size_t data_size, ImU64 seed)
+{
+    const unsigned char* data = (const unsigned char*)data_p;
+    ImU64 hash = 0xCBF29CE484222325ull ^ seed ^ data_size;
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 word;
+        memcpy(&word, data, 8);
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+    }
+    for (; data_size > 0; data++, data_size--)
+        hash = (hash ^ *data) * 0x9E3779B97F4A7C15ull;
+    return hash;
+}
+
 // Zero-terminated string hash, with support for ### to reset back to seed value
 // We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
 // Because this syntax is rarely used we are optimizing for the common case.
@@ -4088,6 +4113,8 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
     TablesTempDataStacked = 0;
     CurrentTabBar = NULL;
     CurrentMultiSelect = NULL;
+    CurrentRetained = NULL;
+    RetainedStyleHash = 0;
     MultiSelectTempDataStacked = 0;
 
     HoverItemDelayId = HoverItemDelayIdPreviousFrame = HoverItemUnlockedStationaryId = HoverWindowUnlockedStationaryId = 0;
@@ -4167,6 +4194,10 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
     DebugBreakKeyChord = ImGuiKey_Pause;
     DebugBreakInShortcutRouting = ImGuiKey_None;
 
+    IdleLastBusyFrame = 0;
+    IdleWakeUpTime = IdleWakeUpRequestTime = DBL_MAX;
+    IdleBusyReason = NULL;
+
     memset(FramerateSecPerFrame, 0, sizeof(FramerateSecPerFrame));
     FramerateSecPerFrameIdx = FramerateSecPerFrameCount = 0;
     FramerateSecPerFrameAccum = 0.0f;
@@ -4298,6 +4329,8 @@ void ImGui::Shutdown()
     g.MultiSelectStorage.Clear();
     g.MultiSelectTempData.clear_destruct();
 
+    g.RetainedRegions.Clear();
+
     g.ClipboardHandlerData.clear();
     g.MenusIdSubmittedThisFrame.clear();
     g.InputTextState.ClearFreeMemory();
@@ -4978,6 +5011,34 @@ ImDrawListSharedData* ImGui::GetDrawListSharedData()
     return &GImGui->DrawListSharedData;
 }
 
+ImDrawListSharedData* ImGui::CreateDrawListSharedDataSnapshot()
+{
+    ImGuiContext& g = *GImGui;
+
+    // Left out of the copy:
+    // - TempBuffer: scratch buffer, owned by the recording thread.
+    // - Text layouts (up to a few MB): the copy would never be updated by UpdateTextLayouts() so it couldn't be used anyway.
+    ImDrawListSharedData& src = g.DrawListSharedData;
+    ImVector<ImVec2> temp_buffer;
+    ImVector<ImDrawTextLayout> text_layouts;
+    ImVector<int> text_layout_wrap_breaks;
+    temp_buffer.swap(src.TempBuffer);
+    text_layouts.swap(src.TextLayouts);
+    text_layout_wrap_breaks.swap(src.TextLayoutWrapBreaks);
+    ImDrawListSharedData* shared_data = IM_NEW(ImDrawListSharedData)(src);
+    src.TempBuffer.swap(temp_buffer);
+    src.TextLayouts.swap(text_layouts);
+    src.TextLayoutWrapBreaks.swap(text_layout_wrap_breaks);
+    shared_data->ClearTextLayouts();
+    return shared_data;
+}
+
+void ImGui::DestroyDrawListSharedDataSnapshot(ImDrawListSharedData* shared_data)
+{
+    IM_ASSERT(GImGui == NULL || shared_data != &GImGui->DrawListSharedData); // Snapshots may outlive the context
+    IM_DELETE(shared_data);
+}
+
 void ImGui::StartMouseMovingWindow(ImGuiWindow* window)
 {
     // Set ActiveId even if the _NoMove flag is set. Without it, dragging away from a window with _NoMove would activate hover on other windows.
@@ -5281,6 +5342,7 @@ static void SetupDrawListSharedData()
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
+    g.DrawListSharedData.UpdateTextLayouts();
 }
 
 void ImGui::NewFrame()
@@ -5325,6 +5387,10 @@ void ImGui::NewFrame()
     // Update viewports (after processing input queue, so io.MouseHoveredViewport is set)
     UpdateViewportsNewFrame();
 
+    // Rasterize glyphs missed during the previous frame (ImFontAtlasFlags_DynamicGlyphs)
+    if (g.IO.Fonts->DynamicGlyphs != NULL)
+        ImFontAtlasUpdateDynamicGlyphs(g.IO.Fonts);
+
     // Setup current font and draw list shared data
     // FIXME-VIEWPORT: the concept of a single ClipRectFullscreen is not ideal!
     g.IO.Fonts->Locked = true;
@@ -5499,6 +5565,14 @@ void ImGui::NewFrame()
     for (ImGuiTableTempData& table_temp_data : g.TablesTempData)
         if (table_temp_data.LastTimeActive >= 0.0f && table_temp_data.LastTimeActive < memory_compact_start_time)
             TableGcCompactTransientBuffers(&table_temp_data);
+
+    // Garbage collect retained regions which haven't been submitted for a while
+    // (unlike transient buffers, the whole region goes away and is recorded again: never with the timer disabled, all of them on a GcCompactAll request)
+    if (g.GcCompactAll || g.IO.ConfigMemoryCompactTimer >= 0.0f)
+        for (int i = 0; i < g.RetainedRegions.GetMapSize(); i++)
+            if (ImGuiRetainedRegion* region = g.RetainedRegions.TryGetMapData(i))
+                if (region->LastTimeActive < memory_compact_start_time)
+                    g.RetainedRegions.Remove(region->ID, region);
     if (g.GcCompactAll)
         GcCompactTransientMiscBuffers();
     g.GcCompactAll = false;
@@ -5515,6 +5589,7 @@ void ImGui::NewFrame()
     g.ItemFlagsStack.push_back(ImGuiItemFlags_AutoClosePopups); // Default flags
     g.CurrentItemFlags = g.ItemFlagsStack.back();
     g.GroupStack.resize(0);
+    g.CurrentRetained = NULL;
 
     // Docking
     DockContextNewFrameUpdateDocking(&g);
@@ -5657,6 +5732,152 @@ static void InitViewportDrawData(ImGuiViewportP* viewport)
     draw_data->DisplaySize = is_minimized ? ImVec2(0.0f, 0.0f) : viewport->Size;
     draw_data->FramebufferScale = io.DisplayFramebufferScale; // FIXME-VIEWPORT: This may vary on a per-monitor/viewport basis?
     draw_data->OwnerViewport = viewport;
+    draw_data->DamageRects.resize(0);
+}
+
+// Hash everything which affects the pixels output by a draw list.
+// Lists with user callbacks return 0 (never equal to the previous frame) as callbacks may render anything within their clip rectangle.
+static ImU64 CalcDrawListDamageHash(const ImDrawList* draw_list)
+{
+    ImU64 hash = 0;
+    for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+    {
+        if (cmd.UserCallback != NULL)
+        {
+            if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                return 0;
+            continue;
+        }
+        if (cmd.ElemCount == 0)
+            continue;
+        hash = ImHashData64(&cmd, offsetof(ImDrawCmd, ElemCount) + sizeof(cmd.ElemCount), hash); // ClipRect, TextureId, VtxOffset, Sdf parameters, IdxOffset, ElemCount
+    }
+    hash = ImHashData64(draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.Size * sizeof(ImDrawVert), hash);
+    hash = ImHashData64(draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.Size * sizeof(ImDrawIdx), hash);
+    return (hash != 0) ? hash : 1;
+}
+
+// Compute the area covered by a draw list: vertices bounding box clipped by the commands clip rectangles, plus the clip rectangles of user callbacks.
+static ImRect CalcDrawListDamageBounds(const ImDrawList* draw_list)
+{
+    bool has_callback = false;
+    ImRect clip_bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    ImRect callback_bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+    {
+        if (cmd.UserCallback != NULL)
+        {
+            if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+            {
+                has_callback = true;
+                callback_bounds.Add(ImRect(cmd.ClipRect));
+            }
+            continue;
+        }
+        if (cmd.ElemCount != 0)
+            clip_bounds.Add(ImRect(cmd.ClipRect));
+    }
+
+    ImRect bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (const ImDrawVert& vtx : draw_list->VtxBuffer)
+        bounds.Add(vtx.pos);
+    bounds.ClipWithFull(clip_bounds);
+    if (bounds.IsInverted())
+        bounds = callback_bounds;
+    else if (has_callback)
+        bounds.Add(callback_bounds);
+    return bounds;
+}
+
+// Add a rectangle rounded outward to whole pixels, merging it with any damage rectangle it overlaps.
+static void AddViewportDamageRect(ImVector<ImVec4>* rects, const ImRect& viewport_rect, const ImRect& rect)
+{
+    ImRect r(ImFloor(rect.Min.x), ImFloor(rect.Min.y), ImCeil(rect.Max.x), ImCeil(rect.Max.y));
+    r.ClipWithFull(viewport_rect);
+    if (r.Min.x >= r.Max.x || r.Min.y >= r.Max.y)
+        return;
+    for (int n = 0; n < rects->Size; )
+    {
+        ImRect other((*rects)[n]);
+        if (other.Overlaps(r))
+        {
+            r.Add(other);
+            rects->erase(rects->Data + n);
+            n = 0;
+        }
+        else
+        {
+            n++;
+        }
+    }
+    rects->push_back(r.ToVec4());
+}
+
+// Fill draw_data->DamageRects by comparing this frame's draw lists with the previous frame, slot by slot in display order.
+// Any difference in a slot damages both the previous and the current bounds of that slot. A draw list appearing, disappearing
+// or changing order shifts the following slots and (conservatively) damages them as well.
+// - Texture contents are not tracked: backends should redraw everything after updating a texture (e.g. font atlas rebuild).
+static void UpdateViewportDamageRects(ImGuiViewportP* viewport)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawData* draw_data = &viewport->DrawDataP;
+    const ImRect viewport_rect = viewport->GetMainRect();
+    draw_data->DamageRects.resize(0);
+    if (draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f)
+    {
+        viewport->DamageEntriesValid = false;
+        return;
+    }
+    if ((g.IO.BackendFlags & ImGuiBackendFlags_RendererHasDamageRects) == 0)
+    {
+        viewport->DamageEntriesValid = false;
+        viewport->DamageEntries.clear();
+        draw_data->DamageRects.push_back(viewport_rect.ToVec4());
+        return;
+    }
+
+    const bool full_damage = !viewport->DamageEntriesValid || viewport->DamageLastRect.Min != viewport_rect.Min || viewport->DamageLastRect.Max != viewport_rect.Max || viewport->DamageLastFramebufferScale != draw_data->FramebufferScale;
+    ImVector<ImGuiViewportDamageEntry>& entries = viewport->DamageEntries;
+    const int prev_count = entries.Size;
+    const int curr_count = draw_data->CmdLists.Size;
+    for (int n = 0; n < ImMax(prev_count, curr_count); n++)
+    {
+        ImGuiViewportDamageEntry curr_entry;
+        curr_entry.DrawList = NULL;
+        curr_entry.Hash = 0;
+        if (n < curr_count)
+        {
+            curr_entry.DrawList = draw_data->CmdLists[n];
+            curr_entry.Hash = CalcDrawListDamageHash(curr_entry.DrawList);
+        }
+        const bool unchanged = (n < prev_count && n < curr_count && entries[n].DrawList == curr_entry.DrawList && entries[n].Hash == curr_entry.Hash && curr_entry.Hash != 0);
+        if (n < curr_count)
+            curr_entry.Bounds = unchanged ? entries[n].Bounds : CalcDrawListDamageBounds(curr_entry.DrawList); // Same contents: skip the vertices loop
+        if (!full_damage)
+        {
+            if (!unchanged && n < prev_count)
+                AddViewportDamageRect(&draw_data->DamageRects, viewport_rect, entries[n].Bounds);
+            if (!unchanged && n < curr_count)
+                AddViewportDamageRect(&draw_data->DamageRects, viewport_rect, curr_entry.Bounds);
+        }
+        if (n < prev_count)
+            entries[n] = curr_entry;
+        else
+            entries.push_back(curr_entry);
+    }
+    entries.resize(curr_count);
+
+    if (full_damage || draw_data->DamageRects.Size > DAMAGE_RECTS_MAX)
+    {
+        ImRect merged = full_damage ? viewport_rect : ImRect(draw_data->DamageRects[0]);
+        for (const ImVec4& rect : draw_data->DamageRects)
+            merged.Add(ImRect(rect));
+        draw_data->DamageRects.resize(0);
+        draw_data->DamageRects.push_back(merged.ToVec4());
+    }
+    viewport->DamageLastRect = viewport_rect;
+    viewport->DamageLastFramebufferScale = draw_data->FramebufferScale;
+    viewport->DamageEntriesValid = true;
 }
 
 // Push a clipping rectangle for both ImGui logic (hit-testing etc.) and low-level ImDrawList rendering.
@@ -5804,6 +6025,118 @@ static void ImGui::RenderDimmedBackgrounds()
     }
 }
 
+// Decide whether the next frame is needed right away (busy) or only after an input event or a timer (idle).
+// Everything which changes the output without an input event must be either flagged busy here or have its deadline folded into IdleWakeUpTime.
+static void UpdateIdleState()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiIO& io = g.IO;
+    const char* busy_reason = NULL;
+    double wake_up_time = g.IdleWakeUpRequestTime;
+    g.IdleWakeUpRequestTime = DBL_MAX;
+
+    // Inputs
+    if (g.InputEventsTrail.Size > 0)
+        busy_reason = "input events";
+    for (int key = ImGuiKey_NamedKey_BEGIN; key < ImGuiKey_NamedKey_END && busy_reason == NULL; key++)
+        if (ImGui::GetKeyData((ImGuiKey)key)->Down)
+            busy_reason = "key or mouse button held"; // Key repeat, dragging etc.
+    if (io.WantSetMousePos)
+        busy_reason = "mouse position request";
+
+    // Active item. The text cursor blink is the only timer-based change of an active text input.
+    if (g.ActiveId != 0 && g.ActiveId == g.InputTextState.ID)
+    {
+        if (io.ConfigInputTextCursorBlink)
+        {
+            const float anim = g.InputTextState.CursorAnim;
+            const float anim_mod = (anim <= 0.0f) ? anim : ImFmod(anim, 1.20f);
+            wake_up_time = ImMin(wake_up_time, g.Time + ((anim_mod <= 0.80f) ? 0.80f - anim_mod : 1.20f - anim_mod));
+        }
+    }
+    else if (g.ActiveId != 0)
+    {
+        busy_reason = "active item";
+    }
+    if (g.DragDropActive || g.MovingWindow != NULL)
+        busy_reason = "dragging";
+
+    // Navigation
+    if (g.NavAnyRequest || g.NavMoveSubmitted || g.NavMoveScoringItems || g.NavWindowingTarget != NULL || g.NavWindowingHighlightAlpha > 0.0f)
+        busy_reason = "navigation";
+    if (g.NavHighlightActivatedTimer > 0.0f)
+        wake_up_time = ImMin(wake_up_time, g.Time + g.NavHighlightActivatedTimer);
+
+    // Animations
+    const bool dim_bg_target = (ImGui::GetTopMostPopupModal() != NULL || (g.NavWindowingTarget != NULL && g.NavWindowingHighlightAlpha > 0.0f));
+    if (dim_bg_target ? (g.DimBgRatio < 1.0f) : (g.DimBgRatio > 0.0f))
+        busy_reason = "dimming background";
+    for (int n = 0; n < g.TabBars.GetMapSize() && busy_reason == NULL; n++)
+        if (ImGuiTabBar* tab_bar = g.TabBars.TryGetMapData(n))
+            if (tab_bar->PrevFrameVisible == g.FrameCount && tab_bar->ScrollingAnim != tab_bar->ScrollingTarget)
+                busy_reason = "tab bar scrolling";
+
+    // Windows settling over multiple frames (appearing, auto-fitting, scrolling requests)
+    for (ImGuiWindow* window : g.Windows)
+    {
+        if (!window->Active || busy_reason != NULL)
+            continue;
+        if (window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0 || window->HiddenFramesCanSkipItems > 0 || window->HiddenFramesCannotSkipItems > 0 || window->HiddenFramesForRenderOnly > 0)
+            busy_reason = "window layout";
+        else if (window->ScrollTarget.x != FLT_MAX || window->ScrollTarget.y != FLT_MAX)
+            busy_reason = "window scrolling";
+    }
+
+    // Timers
+    if (g.HoverItemDelayId != 0)
+    {
+        // Wake up when the next hover delay is reached, so e.g. tooltips appear on time
+        const float delays[] = { g.Style.HoverDelayShort, g.Style.HoverDelayNormal };
+        for (float delay : delays)
+            if (g.HoverItemDelayTimer < delay)
+                wake_up_time = ImMin(wake_up_time, g.Time + (delay - g.HoverItemDelayTimer));
+    }
+    if (g.HoveredWindow != NULL && g.MouseStationaryTimer < g.Style.HoverStationaryDelay)
+        wake_up_time = ImMin(wake_up_time, g.Time + (g.Style.HoverStationaryDelay - g.MouseStationaryTimer));
+    if (g.WheelingWindow != NULL)
+        wake_up_time = ImMin(wake_up_time, g.Time + ImMax(g.WheelingWindowReleaseTimer, 0.0f));
+    if (g.SettingsDirtyTimer > 0.0f)
+        wake_up_time = ImMin(wake_up_time, g.Time + g.SettingsDirtyTimer);
+
+    if (busy_reason != NULL)
+    {
+        g.IdleLastBusyFrame = g.FrameCount;
+        g.IdleBusyReason = busy_reason;
+    }
+    g.IdleWakeUpTime = wake_up_time;
+}
+
+bool ImGui::GetIdleState(float* out_wait_timeout)
+{
+    ImGuiContext& g = *GImGui;
+    float wait_timeout = 0.0f;
+    bool idle = g.IO.ConfigIdleSkipFrames && g.InputEventsQueue.Size == 0 && (g.FrameCount - g.IdleLastBusyFrame >= IDLE_SETTLE_FRAMES);
+    if (idle)
+    {
+        const double wake_up_time = ImMin(g.IdleWakeUpTime, g.IdleWakeUpRequestTime);
+        wait_timeout = (wake_up_time == DBL_MAX) ? FLT_MAX : (float)(wake_up_time - g.Time);
+        if (wait_timeout <= 0.0f)
+        {
+            wait_timeout = 0.0f;
+            idle = false;
+        }
+    }
+    if (out_wait_timeout)
+        *out_wait_timeout = wait_timeout;
+    return idle;
+}
+
+void ImGui::RequestIdleWakeUp(float delay)
+{
+    ImGuiContext& g = *GImGui;
+    g.IdleWakeUpRequestTime = ImMin(g.IdleWakeUpRequestTime, g.Time + (double)ImMax(delay, 0.0f));
+}
+
 // This is normally called by Render(). You may want to call it directly if you want to avoid calling Render() but the gain will be very minimal.
 void ImGui::EndFrame()
 {
@@ -5898,6 +6231,9 @@ void ImGui::EndFrame()
     // Unlock font atlas
     g.IO.Fonts->Locked = false;
 
+    if (g.IO.ConfigIdleSkipFrames)
+        UpdateIdleState();
+
     // Clear Input data for next frame
     g.IO.MousePosPrev = g.IO.MousePos;
     g.IO.AppFocusLost = false;
@@ -5968,6 +6304,7 @@ void ImGui::Render()
         IM_ASSERT(draw_data->CmdLists.Size == draw_data->CmdListsCount);
         for (ImDrawList* draw_list : draw_data->CmdLists)
             draw_list->_PopUnusedDrawCmd();
+        UpdateViewportDamageRects(viewport);
 
         g.IO.MetricsRenderVertices += draw_data->TotalVtxCount;
         g.IO.MetricsRenderIndices += draw_data->TotalIdxCount;
@@ -5992,7 +6329,7 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
-    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
+    ImVec2 text_size = g.DrawListSharedData.CalcTextLayoutSize(font, font_size, wrap_width, text, text_display_end);
 
     // Round
     // FIXME: This has been here since Dec 2015 (7b0bf230) but down the line we want this out.
@@ -8286,6 +8623,11 @@ void ImGui::End()
     // Error checking: verify that user doesn't directly call End() on a child window.
     if ((window->Flags & ImGuiWindowFlags_ChildWindow) && !(window->Flags & ImGuiWindowFlags_DockNodeHost) && !window->DockIsActive)
         IM_ASSERT_USER_ERROR(g.WithinEndChildID == window->ID, "Must call EndChild() and not End()!");
+    if (g.CurrentRetained != NULL && g.CurrentRetained->Window == window)
+    {
+        IM_ASSERT_USER_ERROR(0, "Missing EndRetained()");
+        g.CurrentRetained = NULL;
+    }
 
     // Close anything that is open
     if (window->DC.CurrentColumns)
@@ -10757,6 +11099,11 @@ static void ImGui::ErrorCheckNewFrameSanityChecks()
     IM_ASSERT((g.FrameCount == 0 || g.FrameCountEnded == g.FrameCount)  && "Forgot to call Render() or EndFrame() at the end of the previous frame?");
     IM_ASSERT(g.IO.DisplaySize.x >= 0.0f && g.IO.DisplaySize.y >= 0.0f  && "Invalid DisplaySize value!");
     IM_ASSERT(g.IO.Fonts->IsBuilt()                                     && "Font Atlas not built! Make sure you called ImGui_ImplXXXX_NewFrame() function for renderer backend, which should call io.Fonts->GetTexDataAsRGBA32() / GetTexDataAsAlpha8()");
+    if ((g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextSdf) == 0)
+        for (ImFont* font : g.IO.Fonts->Fonts)
+            IM_ASSERT(font->SdfThreshold == 0.0f                        && "Font built with ImFontConfig::SdfPadding > 0 but the renderer backend doesn't support ImGuiBackendFlags_RendererHasTextSdf!");
+    if ((g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTexDirtyRects) == 0)
+        IM_ASSERT((g.IO.Fonts->Flags & ImFontAtlasFlags_DynamicGlyphs) == 0 && "Font atlas built with ImFontAtlasFlags_DynamicGlyphs but the renderer backend doesn't support ImGuiBackendFlags_RendererHasTexDirtyRects!");
     IM_ASSERT(g.Style.CurveTessellationTol > 0.0f                       && "Invalid style setting!");
     IM_ASSERT(g.Style.CircleTessellationMaxError > 0.0f                 && "Invalid style setting!");
     IM_ASSERT(g.Style.Alpha >= 0.0f && g.Style.Alpha <= 1.0f            && "Invalid style setting!"); // Allows us to avoid a few clamps in color computations
@@ -11637,6 +11984,195 @@ void ImGui::EndGroup()
         window->DrawList->AddRect(group_bb.Min, group_bb.Max, IM_COL32(255,0,255,255));   // [Debug]
 }
 
+// Retained regions
+// - The cached output is a single block of vertices plus one entry per draw command it spans. Regions which use channels,
+//   callbacks or cross a VtxOffset boundary while recording aren't cached and get submitted every frame.
+// - Positions are stored absolute, the cursor position and clip rect are part of the fingerprint so moving/scrolling the window re-records.
+static ImGuiID RetainedRegionFingerprint(ImGuiWindow* window, ImGuiID id, ImGuiID content_hash)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawList* draw_list = window->DrawList;
+    const bool window_hovered = (g.HoveredWindow == window);
+    const bool window_active = (g.ActiveId != 0 && g.ActiveIdWindow == window);
+    ImGuiID fingerprint = ImHashData(&content_hash, sizeof(content_hash), id);
+    fingerprint = ImHashData(&window->DC.CursorPos, sizeof(window->DC.CursorPos), fingerprint);
+    fingerprint = ImHashData(&window->DC.Indent, sizeof(window->DC.Indent), fingerprint);
+    fingerprint = ImHashData(&window->DC.ItemWidth, sizeof(window->DC.ItemWidth), fingerprint);
+    fingerprint = ImHashData(&window->DC.TextWrapPos, sizeof(window->DC.TextWrapPos), fingerprint);
+    fingerprint = ImHashData(&draw_list->_CmdHeader, sizeof(draw_list->_CmdHeader.ClipRect) + sizeof(draw_list->_CmdHeader.TextureId), fingerprint);
+    fingerprint = ImHashData(&draw_list->Flags, sizeof(draw_list->Flags), fingerprint);
+    fingerprint = ImHashData(&draw_list->_FringeScale, sizeof(draw_list->_FringeScale), fingerprint);
+    fingerprint = ImHashData(&g.Font, sizeof(g.Font), fingerprint);
+    fingerprint = ImHashData(&g.FontSize, sizeof(g.FontSize), fingerprint);
+    if (g.RetainedStyleHash == 0 || memcmp(&g.RetainedStyle, &g.Style, sizeof(ImGuiStyle)) != 0)
+    {
+        memcpy(&g.RetainedStyle, &g.Style, sizeof(ImGuiStyle));
+        g.RetainedStyleHash = ImHashData(&g.Style, sizeof(g.Style));
+    }
+    fingerprint = ImHashData(&g.RetainedStyleHash, sizeof(g.RetainedStyleHash), fingerprint);
+    fingerprint = ImHashData(&window_hovered, sizeof(window_hovered), fingerprint);
+    fingerprint = ImHashData(&window_active, sizeof(window_active), fingerprint);
+    return fingerprint;
+}
+
+static void RetainedRegionReplay(ImGuiWindow* window, const ImGuiRetainedRegion* region)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawList* draw_list = window->DrawList;
+
+    // Vertices in one go, then the indices of each command rebased onto them
+    const int vtx_count = region->VtxBuffer.Size;
+    draw_list->PrimReserve(0, vtx_count);
+    if (vtx_count > 0)
+        memcpy(draw_list->_VtxWritePtr, region->VtxBuffer.Data, (size_t)vtx_count * sizeof(ImDrawVert));
+    const unsigned int vtx_base = draw_list->_VtxCurrentIdx;
+    draw_list->_VtxWritePtr += vtx_count;
+    draw_list->_VtxCurrentIdx += vtx_count;
+
+    const ImDrawIdx* src_idx = region->IdxBuffer.Data;
+    for (const ImGuiRetainedDrawCmd& cmd : region->Cmds)
+    {
+        const bool push_clip_rect = memcmp(&cmd.ClipRect, &draw_list->_CmdHeader.ClipRect, sizeof(ImVec4)) != 0;
+        const bool push_texture_id = cmd.TextureId != draw_list->_CmdHeader.TextureId;
+        if (push_clip_rect)
+            draw_list->PushClipRect(ImVec2(cmd.ClipRect.x, cmd.ClipRect.y), ImVec2(cmd.ClipRect.z, cmd.ClipRect.w));
+        if (push_texture_id)
+            draw_list->PushTextureID(cmd.TextureId);
+        draw_list->_SetTextSdf(cmd.SdfThreshold, cmd.SdfAlphaPerTexel);
+        draw_list->PrimReserve((int)cmd.ElemCount, 0);
+        for (unsigned int n = 0; n < cmd.ElemCount; n++)
+            draw_list->_IdxWritePtr[n] = (ImDrawIdx)(src_idx[n] + vtx_base);
+        draw_list->_IdxWritePtr += cmd.ElemCount;
+        src_idx += cmd.ElemCount;
+        draw_list->_SetTextSdf(0.0f, 0.0f);
+        if (push_texture_id)
+            draw_list->PopTextureID();
+        if (push_clip_rect)
+            draw_list->PopClipRect();
+    }
+
+    // Layout, as if the content had been submitted
+    window->DC.CursorPos = region->CursorPos;
+    window->DC.CursorPosPrevLine = region->CursorPosPrevLine;
+    window->DC.CursorMaxPos = ImMax(window->DC.CursorMaxPos, region->CursorMaxPos);
+    window->DC.IdealMaxPos = ImMax(window->DC.IdealMaxPos, region->IdealMaxPos);
+    window->DC.CurrLineSize = region->CurrLineSize;
+    window->DC.PrevLineSize = region->PrevLineSize;
+    window->DC.CurrLineTextBaseOffset = region->CurrLineTextBaseOffset;
+    window->DC.PrevLineTextBaseOffset = region->PrevLineTextBaseOffset;
+    window->DC.IsSameLine = region->IsSameLine;
+    window->DC.IsSetPos = region->IsSetPos;
+    g.LastItemData = region->LastItemData;
+}
+
+bool ImGui::BeginRetained(const char* str_id, ImGuiID content_hash)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    IM_ASSERT(g.CurrentRetained == NULL && "Retained regions can't be nested.");
+    if (window->SkipItems)
+        return false;
+
+    const ImGuiID id = window->GetID(str_id);
+    ImGuiRetainedRegion* region = g.RetainedRegions.GetOrAddByKey(id);
+    region->ID = id;
+    region->LastTimeActive = (float)g.Time;
+
+    const ImGuiID fingerprint = RetainedRegionFingerprint(window, id, content_hash);
+    if (region->Valid && region->Fingerprint == fingerprint)
+    {
+        RetainedRegionReplay(window, region);
+        return false;
+    }
+
+    // Record
+    ImDrawList* draw_list = window->DrawList;
+    region->Fingerprint = fingerprint;
+    region->Valid = false;
+    region->Window = window;
+    region->CmdStart = draw_list->CmdBuffer.Size - 1;
+    region->VtxStart = draw_list->VtxBuffer.Size;
+    region->IdxStart = draw_list->IdxBuffer.Size;
+    region->VtxCurrentIdxStart = draw_list->_VtxCurrentIdx;
+    region->VtxOffsetStart = draw_list->_CmdHeader.VtxOffset;
+    g.CurrentRetained = region;
+    return true;
+}
+
+void ImGui::EndRetained()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImGuiRetainedRegion* region = g.CurrentRetained;
+    IM_ASSERT(region != NULL && "Mismatched BeginRetained()/EndRetained() calls, or BeginRetained() returned false.");
+    IM_ASSERT(region->Window == window && "EndRetained() in wrong window?");
+    g.CurrentRetained = NULL;
+    region->Window = NULL;
+
+    ImDrawList* draw_list = window->DrawList;
+    bool cacheable = (draw_list->_Splitter._Count <= 1) && (draw_list->_CmdHeader.VtxOffset == region->VtxOffsetStart);
+    for (int cmd_n = region->CmdStart; cacheable && cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+        if (draw_list->CmdBuffer[cmd_n].UserCallback != NULL)
+            cacheable = false;
+    if (!cacheable)
+    {
+        region->Valid = false;
+        region->VtxBuffer.clear();
+        region->IdxBuffer.clear();
+        region->Cmds.clear();
+        return;
+    }
+
+    // Output
+    const int vtx_count = draw_list->VtxBuffer.Size - region->VtxStart;
+    const int idx_count = draw_list->IdxBuffer.Size - region->IdxStart;
+    region->VtxBuffer.resize(vtx_count);
+    if (vtx_count > 0)
+        memcpy(region->VtxBuffer.Data, draw_list->VtxBuffer.Data + region->VtxStart, (size_t)vtx_count * sizeof(ImDrawVert));
+    region->IdxBuffer.resize(idx_count);
+    for (int n = 0; n < idx_count; n++)
+        region->IdxBuffer.Data[n] = (ImDrawIdx)(draw_list->IdxBuffer.Data[region->IdxStart + n] - region->VtxCurrentIdxStart);
+    region->Cmds.resize(0);
+    const int idx_end = region->IdxStart + idx_count;
+    for (int cmd_n = ImMax(region->CmdStart - 1, 0); cmd_n < draw_list->CmdBuffer.Size; cmd_n++) // Start one earlier, the command active at BeginRetained() may have been merged into the previous one
+    {
+        const ImDrawCmd& cmd = draw_list->CmdBuffer[cmd_n];
+        const int cmd_idx_start = ImMax((int)cmd.IdxOffset, region->IdxStart);
+        const int cmd_idx_end = ImMin((int)(cmd.IdxOffset + cmd.ElemCount), idx_end);
+        if (cmd_idx_end <= cmd_idx_start)
+            continue;
+        ImGuiRetainedDrawCmd retained_cmd;
+        retained_cmd.ClipRect = cmd.ClipRect;
+        retained_cmd.TextureId = cmd.TextureId;
+        retained_cmd.SdfThreshold = cmd.SdfThreshold;
+        retained_cmd.SdfAlphaPerTexel = cmd.SdfAlphaPerTexel;
+        retained_cmd.ElemCount = (unsigned int)(cmd_idx_end - cmd_idx_start);
+        region->Cmds.push_back(retained_cmd);
+    }
+
+    // Layout
+    region->CursorPos = window->DC.CursorPos;
+    region->CursorPosPrevLine = window->DC.CursorPosPrevLine;
+    region->CursorMaxPos = window->DC.CursorMaxPos;
+    region->IdealMaxPos = window->DC.IdealMaxPos;
+    region->CurrLineSize = window->DC.CurrLineSize;
+    region->PrevLineSize = window->DC.PrevLineSize;
+    region->CurrLineTextBaseOffset = window->DC.CurrLineTextBaseOffset;
+    region->PrevLineTextBaseOffset = window->DC.PrevLineTextBaseOffset;
+    region->IsSameLine = window->DC.IsSameLine;
+    region->IsSetPos = window->DC.IsSetPos;
+    region->LastItemData = g.LastItemData;
+    region->Valid = true;
+}
+
+void ImGui::InvalidateRetained(const char* str_id)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    if (ImGuiRetainedRegion* region = g.RetainedRegions.GetByKey(window->GetID(str_id)))
+        region->Valid = false;
+}
+
 
 //-----------------------------------------------------------------------------
 // [SECTION] SCROLLING
@@ -21566,6 +22102,12 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         Text("ActiveIdUsing: AllKeyboardKeys: %d, NavDirMask: %X", g.ActiveIdUsingAllKeyboardKeys, g.ActiveIdUsingNavDirMask);
         Text("HoveredId: 0x%08X (%.2f sec), AllowOverlap: %d", g.HoveredIdPreviousFrame, g.HoveredIdTimer, g.HoveredIdAllowOverlap); // Not displaying g.HoveredId as it is update mid-frame
         Text("HoverItemDelayId: 0x%08X, Timer: %.2f, ClearTimer: %.2f", g.HoverItemDelayId, g.HoverItemDelayTimer, g.HoverItemDelayClearTimer);
+        if (g.IO.ConfigIdleSkipFrames)
+        {
+            float idle_wait_timeout;
+            const bool idle = GetIdleState(&idle_wait_timeout);
+            Text("Idle: %d, WaitTimeout: %.2f, LastBusyFrame: %d (%s)", idle, idle_wait_timeout == FLT_MAX ? -1.0f : idle_wait_timeout, g.IdleLastBusyFrame, g.IdleBusyReason ? g.IdleBusyReason : "N/A");
+        }
         Text("DragDrop: %d, SourceId = 0x%08X, Payload \"%s\" (%d bytes)", g.DragDropActive, g.DragDropPayload.SourceId, g.DragDropPayload.DataType, g.DragDropPayload.DataSize);
         DebugLocateItemOnHover(g.DragDropPayload.SourceId);
         Unindent();
@@ -21593,6 +22135,12 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         Text("NavWindowingTarget: '%s'", g.NavWindowingTarget ? g.NavWindowingTarget->Name : "NULL");
         Unindent();
 
+        Text("DRAWING");
+        Indent();
+        Text("ShapeTemplates: %d vtx, %d idx", g.DrawListSharedData.ShapeTemplateVtx.Size, g.DrawListSharedData.ShapeTemplateIdx.Size);
+        Text("TextLayouts: %d/%d slots, %d wrap breaks, %d hits, %d misses", g.DrawListSharedData.TextLayoutsCount, g.DrawListSharedData.TextLayouts.Size, g.DrawListSharedData.TextLayoutWrapBreaks.Size, g.DrawListSharedData.TextLayoutsHits, g.DrawListSharedData.TextLayoutsMisses);
+        Unindent();
+
         TreePop();
     }
 
@@ -21853,6 +22401,8 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
 
     if (window && !window->WasActive)
         TextDisabled("Warning: owning Window is inactive. This DrawList is not being rendered!");
+    if (draw_list->_CulledPrimCount > 0)
+        BulletText("Culled offscreen: %d primitives, saving %d vtx", draw_list->_CulledPrimCount, draw_list->_CulledVtxCount);
 
     for (const ImDrawCmd* pcmd = draw_list->CmdBuffer.Data; pcmd < draw_list->CmdBuffer.Data + cmd_count; pcmd++)
     {
@@ -22137,6 +22687,14 @@ void ImGui::DebugNodeViewport(ImGuiViewportP* viewport)
             (flags & ImGuiViewportFlags_NoAutoMerge) ? " NoAutoMerge" : "",
             (flags & ImGuiViewportFlags_TopMost) ? " TopMost" : "",
             (flags & ImGuiViewportFlags_CanHostOtherWindows) ? " CanHostOtherWindows" : "");
+        if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasDamageRects)
+        {
+            float damage_area = 0.0f;
+            for (const ImVec4& rect : viewport->DrawDataP.DamageRects)
+                damage_area += (rect.z - rect.x) * (rect.w - rect.y);
+            const float viewport_area = viewport->Size.x * viewport->Size.y;
+            BulletText("Damage: %d rects, %.1f%% of viewport", viewport->DrawDataP.DamageRects.Size, viewport_area > 0.0f ? damage_area * 100.0f / viewport_area : 0.0f);
+        }
         for (ImDrawList* draw_list : viewport->DrawDataP.CmdLists)
             DebugNodeDrawList(NULL, viewport, draw_list, "DrawList");
         TreePop();
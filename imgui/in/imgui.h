@@ -165,6 +165,8 @@ struct ImDrawListSplitter;          // Helper to split a draw list into differen
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
+struct ImFontAtlasDynamicGlyphs;    // Opaque builder data kept after building an atlas with ImFontAtlasFlags_DynamicGlyphs
+struct ImFontAtlasRect;             // A rectangle of the font atlas texture, in pixels
 struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_truetype or FreeType).
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
@@ -284,6 +286,8 @@ typedef int     (*ImGuiInputTextCallback)(ImGuiInputTextCallbackData* data);
 typedef void    (*ImGuiSizeCallback)(ImGuiSizeCallbackData* data);              // Callback function for ImGui::SetNextWindowSizeConstraints()
 typedef void*   (*ImGuiMemAllocFunc)(size_t sz, void* user_data);               // Function signature for ImGui::SetAllocatorFunctions()
 typedef void    (*ImGuiMemFreeFunc)(void* ptr, void* user_data);                // Function signature for ImGui::SetAllocatorFunctions()
+typedef void    (*ImFontAtlasJobFunc)(void* job_data, int job_index);         // Function signature for a job passed to ImFontAtlas::BuildParallelFor
+typedef void    (*ImFontAtlasParallelForFunc)(ImFontAtlasJobFunc job_func, void* job_data, int job_count, void* user_data); // Function signature for ImFontAtlas::BuildParallelFor
 
 // ImVec2: 2D vector used to store positions, sizes etc. [Compile-time configurable type]
 // - This is a frequently used type in the API. Consider using IM_VEC2_CLASS_EXTRA to create implicit cast from/to our preferred type.
@@ -926,6 +930,17 @@ namespace ImGui
     IMGUI_API void          PushClipRect(const ImVec2& clip_rect_min, const ImVec2& clip_rect_max, bool intersect_with_current_clip_rect);
     IMGUI_API void          PopClipRect();
 
+    // Retained regions [BETA API]
+    // - Cache the draw output of static content (text, plots, custom drawing) between frames. When nothing the region depends on changed,
+    //   BeginRetained() appends last frame's vertices/indices/commands to the window draw list, restores the layout and returns false: skip your content.
+    // - 'content_hash' is yours to compute from whatever the content depends on (data version, animation frame, hovered state...).
+    //   The region id, cursor position, clip rect, font, style and whether the window is hovered or active are mixed in automatically.
+    // - Content is not submitted on cached frames, so it can't contain interactive widgets, child windows or popups, and must only draw to the window draw list.
+    // - Only call EndRetained() if BeginRetained() returns true! Retained regions can't be nested.
+    IMGUI_API bool          BeginRetained(const char* str_id, ImGuiID content_hash);
+    IMGUI_API void          EndRetained();
+    IMGUI_API void          InvalidateRetained(const char* str_id);                            // force the region to be submitted again on its next BeginRetained() (in current window)
+
     // Focus, Activation
     IMGUI_API void          SetItemDefaultFocus();                                              // make last item the default focused item of of a newly appearing window.
     IMGUI_API void          SetKeyboardFocusHere(int offset = 0);                               // focus keyboard on the next widget. Use positive 'offset' to access sub components of a multiple component widget. Use -1 to access previous widget.
@@ -973,10 +988,21 @@ namespace ImGui
     IMGUI_API double        GetTime();                                                          // get global imgui time. incremented by io.DeltaTime every frame.
     IMGUI_API int           GetFrameCount();                                                    // get global imgui frame count. incremented by 1 every frame.
     IMGUI_API ImDrawListSharedData* GetDrawListSharedData();                                    // you may use this when creating your own ImDrawList instances.
+    IMGUI_API ImDrawListSharedData* CreateDrawListSharedDataSnapshot();                         // create a copy of the current draw list shared data (current font, atlas uvs, tessellation settings) for detached ImDrawList recorded on other threads. One per thread. See ImDrawList::ResetDetached().
+    IMGUI_API void          DestroyDrawListSharedDataSnapshot(ImDrawListSharedData* shared_data);
     IMGUI_API const char*   GetStyleColorName(ImGuiCol idx);                                    // get a string corresponding to the enum value (for display, saving, etc.).
     IMGUI_API void          SetStateStorage(ImGuiStorage* storage);                             // replace current window storage with our own (if you want to manipulate it yourself, typically clear subsection of it)
     IMGUI_API ImGuiStorage* GetStateStorage();
 
+    // Idle Utilities [BETA]
+    // - When io.ConfigIdleSkipFrames is set, the application may stop producing frames while nothing changes: call GetIdleState()
+    //   after Render() and when it returns true, wait for the next input event for at most *out_wait_timeout seconds
+    //   (e.g. SDL_WaitEventTimeout(), glfwWaitEventsTimeout(), MsgWaitForMultipleObjects()) before starting a new frame.
+    // - The timeout accounts for Dear ImGui's own timers (text cursor blink, tooltip delays, nav highlight, mouse wheel locking, .ini saving).
+    // - Call RequestIdleWakeUp() from code which changes without inputs (e.g. animations, progress bars, data polled from elsewhere).
+    IMGUI_API bool          GetIdleState(float* out_wait_timeout = NULL);                       // return true when no new frame is needed until the next input event or until *out_wait_timeout seconds elapsed (FLT_MAX: input only). Always false unless io.ConfigIdleSkipFrames is set.
+    IMGUI_API void          RequestIdleWakeUp(float delay = 0.0f);                              // request a new frame within 'delay' seconds even without inputs. 0.0f: keep producing frames.
+
     // Text Utilities
     IMGUI_API ImVec2        CalcTextSize(const char* text, const char* text_end = NULL, bool hide_text_after_double_hash = false, float wrap_width = -1.0f);
 
@@ -1669,6 +1695,9 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Backend Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if io.ConfigNavMoveSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasDamageRects= 1 << 4,   // Backend Renderer uses ImDrawData::DamageRects to only redraw/present changed regions. Enables the tracking of draw lists across frames (costs a hash of every vertex/index buffer).
+    ImGuiBackendFlags_RendererHasTextSdf    = 1 << 5,   // Backend Renderer supports ImDrawCmd::SdfThreshold/SdfAlphaPerTexel. Required to use fonts with ImFontConfig::SdfPadding > 0.
+    ImGuiBackendFlags_RendererHasTexDirtyRects=1 << 6,  // Backend Renderer re-uploads ImFontAtlas::TexDirtyRects and clears them before rendering. Required to use ImFontAtlasFlags_DynamicGlyphs.
 
     // [BETA] Viewports
     ImGuiBackendFlags_PlatformHasViewports  = 1 << 10,  // Backend Platform supports multiple viewports.
@@ -2338,6 +2367,7 @@ struct ImGuiIO
     bool        ConfigWindowsCopyContentsWithCtrlC; // = false      // [EXPERIMENTAL] CTRL+C copy the contents of focused window into the clipboard. Experimental because: (1) has known issues with nested Begin/End pairs (2) text output quality varies (3) text output is in submission order rather than spatial order.
     bool        ConfigScrollbarScrollByPage;    // = true           // Enable scrolling page by page when clicking outside the scrollbar grab. When disabled, always scroll to clicked location. When enabled, Shift+Click scrolls to clicked location.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
+    bool        ConfigIdleSkipFrames;           // = false          // [BETA] Track whether new frames are needed, so the application can sleep while idle. See GetIdleState().
 
     // Inputs Behaviors
     // (other variables, ones which are expected to be tweaked within UI code, are exposed in ImGuiStyle)
@@ -3055,12 +3085,17 @@ typedef void (*ImDrawCallback)(const ImDrawList* parent_list, const ImDrawCmd* c
 // - VtxOffset: When 'io.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset' is enabled,
 //   this fields allow us to render meshes larger than 64K vertices while keeping 16-bit indices.
 //   Backends made for <1.71. will typically ignore the VtxOffset fields.
-// - The ClipRect/TextureId/VtxOffset fields must be contiguous as we memcmp() them together (this is asserted for).
+// - SdfThreshold/SdfAlphaPerTexel: When 'io.BackendFlags & ImGuiBackendFlags_RendererHasTextSdf' is enabled, text of fonts built with
+//   ImFontConfig::SdfPadding > 0 is output in commands with SdfThreshold > 0.0f: the texture alpha is a distance to the glyph outline,
+//   the pixel coverage is ~ saturate((alpha - SdfThreshold) / (SdfAlphaPerTexel * texels_per_pixel) + 0.5f).
+// - The ClipRect/TextureId/VtxOffset/SdfThreshold/SdfAlphaPerTexel fields must be contiguous as we memcmp() them together (this is asserted for).
 struct ImDrawCmd
 {
     ImVec4          ClipRect;           // 4*4  // Clipping rectangle (x1, y1, x2, y2). Subtract ImDrawData->DisplayPos to get clipping rectangle in "viewport" coordinates
     ImTextureID     TextureId;          // 4-8  // User-provided texture ID. Set by user in ImfontAtlas::SetTexID() for fonts or passed to Image*() functions. Ignore if never using images or multiple fonts atlas.
     unsigned int    VtxOffset;          // 4    // Start offset in vertex buffer. ImGuiBackendFlags_RendererHasVtxOffset: always 0, otherwise may be >0 to support meshes larger than 64K vertices with 16-bit indices.
+    float           SdfThreshold;       // 4    // ImGuiBackendFlags_RendererHasTextSdf: > 0.0f when the texture alpha is a signed distance field, value of the outline (0.0f..1.0f). 0.0f for regular textures.
+    float           SdfAlphaPerTexel;   // 4    // ImGuiBackendFlags_RendererHasTextSdf: change of the texture alpha (0.0f..1.0f) per texel of distance, to anti-alias the outline over one pixel.
     unsigned int    IdxOffset;          // 4    // Start offset in index buffer.
     unsigned int    ElemCount;          // 4    // Number of indices (multiple of 3) to be rendered as triangles. Vertices are stored in the callee ImDrawList's vtx_buffer[] array, indices in idx_buffer[].
     ImDrawCallback  UserCallback;       // 4-8  // If != NULL, call the function instead of rendering the vertices. clip_rect and texture_id will be set normally.
@@ -3096,6 +3131,8 @@ struct ImDrawCmdHeader
     ImVec4          ClipRect;
     ImTextureID     TextureId;
     unsigned int    VtxOffset;
+    float           SdfThreshold;
+    float           SdfAlphaPerTexel;
 };
 
 // [Internal] For use by ImDrawListSplitter
@@ -3134,6 +3171,7 @@ enum ImDrawFlags_
     ImDrawFlags_RoundCornersBottomLeft      = 1 << 6, // AddRect(), AddRectFilled(), PathRect(): enable rounding bottom-left corner only (when rounding > 0.0f, we default to all corners). Was 0x04.
     ImDrawFlags_RoundCornersBottomRight     = 1 << 7, // AddRect(), AddRectFilled(), PathRect(): enable rounding bottom-right corner only (when rounding > 0.0f, we default to all corners). Wax 0x08.
     ImDrawFlags_RoundCornersNone            = 1 << 8, // AddRect(), AddRectFilled(), PathRect(): disable rounding on all corners (when rounding > 0.0f). This is NOT zero, NOT an implicit flag!
+    ImDrawFlags_TriangulateMonotone         = 1 << 9, // AddConcavePolyFilled(), PathFillConcave(): triangulate with a sweep-line monotone decomposition, O(N log N) instead of O(N^2) ear clipping. Recommended for polygons with more than a few dozen points.
     ImDrawFlags_RoundCornersTop             = ImDrawFlags_RoundCornersTopLeft | ImDrawFlags_RoundCornersTopRight,
     ImDrawFlags_RoundCornersBottom          = ImDrawFlags_RoundCornersBottomLeft | ImDrawFlags_RoundCornersBottomRight,
     ImDrawFlags_RoundCornersLeft            = ImDrawFlags_RoundCornersBottomLeft | ImDrawFlags_RoundCornersTopLeft,
@@ -3152,6 +3190,7 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering (NOT point/nearest filtering).
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
     ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_CullOffscreen           = 1 << 4,  // Skip shapes, images and text whose bounding box lies entirely outside the current clip rect before tessellating them. Opt-in, costs a bounding box pass over each path.
 };
 
 // Draw command list
@@ -3183,6 +3222,8 @@ struct ImDrawList
     ImVector<ImTextureID>   _TextureIdStack;    // [Internal]
     ImVector<ImU8>          _CallbacksDataBuf;  // [Internal]
     float                   _FringeScale;       // [Internal] anti-alias fringe is scaled by this value, this helps to keep things sharp while zooming at vertex buffer content
+    int                     _CulledPrimCount;   // [Internal] number of primitives rejected by ImDrawListFlags_CullOffscreen since the last reset
+    int                     _CulledVtxCount;    // [Internal] number of vertices those primitives would have emitted (for text: an upper bound)
     const char*             _OwnerName;         // Pointer to owner window's name for debugging
 
     // If you want to create ImDrawList instances, pass them ImGui::GetDrawListSharedData().
@@ -3227,9 +3268,18 @@ struct ImDrawList
     // General polygon
     // - Only simple polygons are supported by filling functions (no self-intersections, no holes).
     // - Concave polygon fill is more expensive than convex one: it has O(N^2) complexity. Provided as a convenience fo user but not used by main library.
+    //   Pass ImDrawFlags_TriangulateMonotone to AddConcavePolyFilled() for O(N log N) triangulation of polygons with many points (e.g. map outlines).
     IMGUI_API void  AddPolyline(const ImVec2* points, int num_points, ImU32 col, ImDrawFlags flags, float thickness);
     IMGUI_API void  AddConvexPolyFilled(const ImVec2* points, int num_points, ImU32 col);
-    IMGUI_API void  AddConcavePolyFilled(const ImVec2* points, int num_points, ImU32 col);
+    IMGUI_API void  AddConcavePolyFilled(const ImVec2* points, int num_points, ImU32 col, ImDrawFlags flags = 0);
+
+    // Batched primitives
+    // - Same geometry as calling AddRectFilled()/AddLine()/AddCircleFilled() once per element, but reserve once per batch and write in a tight loop.
+    // - 'cols' holds one color per element. Batches are split where individual calls would have started a new VtxOffset (ImDrawListFlags_AllowVtxOffset).
+    // - AddCircleFilledBatch() tessellates the circle once for the whole batch: AA fringe positions may differ from AddCircleFilled() in the last bit.
+    IMGUI_API void  AddRectFilledBatch(const ImVec2* p_min, const ImVec2* p_max, const ImU32* cols, int count);                     // no rounding
+    IMGUI_API void  AddLineBatch(const ImVec2* p1, const ImVec2* p2, const ImU32* cols, int count, float thickness = 1.0f);
+    IMGUI_API void  AddCircleFilledBatch(const ImVec2* centers, const ImU32* cols, int count, float radius, int num_segments = 0);
 
     // Image primitives
     // - Read FAQ to understand what ImTextureID is.
@@ -3246,7 +3296,7 @@ struct ImDrawList
     inline    void  PathLineTo(const ImVec2& pos)                               { _Path.push_back(pos); }
     inline    void  PathLineToMergeDuplicate(const ImVec2& pos)                 { if (_Path.Size == 0 || memcmp(&_Path.Data[_Path.Size - 1], &pos, 8) != 0) _Path.push_back(pos); }
     inline    void  PathFillConvex(ImU32 col)                                   { AddConvexPolyFilled(_Path.Data, _Path.Size, col); _Path.Size = 0; }
-    inline    void  PathFillConcave(ImU32 col)                                  { AddConcavePolyFilled(_Path.Data, _Path.Size, col); _Path.Size = 0; }
+    inline    void  PathFillConcave(ImU32 col, ImDrawFlags flags = 0)           { AddConcavePolyFilled(_Path.Data, _Path.Size, col, flags); _Path.Size = 0; }
     inline    void  PathStroke(ImU32 col, ImDrawFlags flags = 0, float thickness = 1.0f) { AddPolyline(_Path.Data, _Path.Size, col, flags, thickness); _Path.Size = 0; }
     IMGUI_API void  PathArcTo(const ImVec2& center, float radius, float a_min, float a_max, int num_segments = 0);
     IMGUI_API void  PathArcToFast(const ImVec2& center, float radius, int a_min_of_12, int a_max_of_12);                // Use precomputed angles for a 12 steps circle
@@ -3270,6 +3320,14 @@ struct ImDrawList
     IMGUI_API void  AddDrawCmd();                                               // This is useful if you need to forcefully create a new draw call (to allow for dependent rendering / blending). Otherwise primitives are merged into the same draw-call as much as possible
     IMGUI_API ImDrawList* CloneOutput() const;                                  // Create a clone of the CmdBuffer/IdxBuffer/VtxBuffer.
 
+    // Advanced: Detached draw lists (recording on other threads)
+    // - ImDrawList never accesses the Dear ImGui context, only its ImDrawListSharedData, which holds scratch buffers. So a draw list created with
+    //   its own ImGui::CreateDrawListSharedDataSnapshot() may be filled on a worker thread: call ResetDetached() then any primitive function.
+    //   Use one snapshot per thread. Don't modify the font atlas while worker threads are recording.
+    // - Back on the Dear ImGui thread, AddDrawList() appends the output into e.g. a window draw list, translated by 'offset' and clipped by the current clip rectangle.
+    IMGUI_API void  ResetDetached();                                            // Clear and start recording with a full-screen clip rectangle and the font texture.
+    IMGUI_API void  AddDrawList(const ImDrawList* src, const ImVec2& offset = ImVec2(0, 0));
+
     // Advanced: Channels
     // - Use to split render into layers. By switching channels to can render out-of-order (e.g. submit FG primitives before BG primitives)
     // - Use to minimize draw calls (e.g. if going back-and-forth between multiple clipping rectangles, prefer to append into separate channels then merge at the end)
@@ -3307,10 +3365,14 @@ struct ImDrawList
     IMGUI_API void  _OnChangedClipRect();
     IMGUI_API void  _OnChangedTextureID();
     IMGUI_API void  _OnChangedVtxOffset();
+    IMGUI_API void  _OnChangedTextSdf();
     IMGUI_API void  _SetTextureID(ImTextureID texture_id);
+    IMGUI_API void  _SetTextSdf(float sdf_threshold, float sdf_alpha_per_texel);
     IMGUI_API int   _CalcCircleAutoSegmentCount(float radius) const;
     IMGUI_API void  _PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step);
     IMGUI_API void  _PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments);
+    IMGUI_API int   _PrimReserveBatch(int item_count, int idx_per_item, int vtx_per_item);
+    IMGUI_API bool  _CullOffscreen(const ImVec2& bb_min, const ImVec2& bb_max, int vtx_count);
 };
 
 // All draw data to render a Dear ImGui frame
@@ -3327,6 +3389,7 @@ struct ImDrawData
     ImVec2              DisplaySize;        // Size of the viewport to render (== GetMainViewport()->Size for the main viewport, == io.DisplaySize in most single-viewport applications)
     ImVec2              FramebufferScale;   // Amount of pixels for each unit of DisplaySize. Based on io.DisplayFramebufferScale. Generally (1,1) on normal display, (2,2) on OSX with Retina display.
     ImGuiViewport*      OwnerViewport;      // Viewport carrying the ImDrawData instance, might be of use to the renderer (generally not).
+    ImVector<ImVec4>    DamageRects;        // Regions which changed since the previous Render() of this viewport, same coordinates as ImDrawCmd::ClipRect (x1,y1,x2,y2). Empty when nothing changed. Without ImGuiBackendFlags_RendererHasDamageRects this is always the whole display.
 
     // Functions
     ImDrawData()    { Clear(); }
@@ -3360,6 +3423,7 @@ struct ImFontConfig
     float           RasterizerMultiply;     // 1.0f     // Linearly brighten (>1.0f) or darken (<1.0f) font output. Brightening small fonts may be a good workaround to make them more readable. This is a silly thing we may remove in the future.
     float           RasterizerDensity;      // 1.0f     // DPI scale for rasterization, not altering other font metrics: make it easy to swap between e.g. a 100% and a 400% fonts for a zooming display. IMPORTANT: If you increase this it is expected that you increase font scale accordingly, otherwise quality may look lowered.
     ImWchar         EllipsisChar;           // 0        // Explicitly specify unicode codepoint of ellipsis character. When fonts are being merged first specified ellipsis will be used.
+    int             SdfPadding;             // 0        // > 0: rasterize signed distance fields spreading this many texels around the glyphs (e.g. 4), instead of coverage bitmaps. The font can then be drawn at any size/scale without blur and without rebuilding the atlas. Requires a backend with ImGuiBackendFlags_RendererHasTextSdf. Oversampling and RasterizerMultiply are ignored. Not supported by imgui_freetype nor ImFontAtlasFlags_DynamicGlyphs. Merged fonts must use the same SdfPadding.
 
     // [Internal]
     char            Name[40];               // Name (strictly to ease debugging)
@@ -3412,6 +3476,13 @@ struct ImFontAtlasCustomRect
     bool IsPacked() const           { return X != 0xFFFF; }
 };
 
+// See ImFontAtlas::TexDirtyRects
+struct ImFontAtlasRect
+{
+    unsigned short  X, Y;
+    unsigned short  Width, Height;
+};
+
 // Flags for ImFontAtlas build
 enum ImFontAtlasFlags_
 {
@@ -3419,6 +3490,7 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
     ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory, allow support for point/nearest filtering). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_DynamicGlyphs      = 1 << 3,   // Only bake GlyphRanges, rasterize any other glyph of the fonts on first use into a reserved area of the texture, recycling the least recently used ones. Requires the stb_truetype builder, keeping TexPixels/input data, and a backend uploading TexDirtyRects (ImGuiBackendFlags_RendererHasTexDirtyRects). See "Dynamic glyphs" below.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -3438,6 +3510,18 @@ enum ImFontAtlasFlags_
 //   You can set font_cfg->FontDataOwnedByAtlas=false to keep ownership of your data and it won't be freed,
 // - Even though many functions are suffixed with "TTF", OTF data is supported just as well.
 // - This is an old API and it is currently awkward for those and various other reasons! We will address them in the future!
+// Dynamic glyphs (ImFontAtlasFlags_DynamicGlyphs):
+// - ImFontConfig::GlyphRanges become the glyphs baked by Build(). When ImFont::FindGlyph() misses another codepoint, it returns the fallback
+//   glyph and queues the codepoint (ImFont::GetCharAdvance() too, so text measured before it is drawn also gets its width on next frame).
+//   ImGui::NewFrame() rasterizes queued glyphs (from the first source font of the ImFont that has them) into the bottom DynamicGlyphsTexHeight
+//   pixels of the texture, appends the changed areas to TexDirtyRects and the glyphs are used from that frame on.
+// - The dynamic area is split into rows of cells sized to the font bounding box, allocated to fonts on demand. Once it is full, a font
+//   replaces its least recently found glyph, as long as it wasn't used during the previous frame. Evicted glyphs are queued again on next use.
+// - The renderer backend must re-upload TexDirtyRects from TexPixelsAlpha8 or TexPixelsRGBA32 before rendering, then clear the list,
+//   and set ImGuiBackendFlags_RendererHasTexDirtyRects.
+//   Don't call ClearTexData() or ClearInputData() after building: glyphs are rasterized from the font data into the CPU side texture.
+// - FindGlyph() updates the queue and LRU stamps, so fonts with dynamic glyphs must not be used to record text in detached draw lists on
+//   worker threads (see ImDrawList::ResetDetached()). Use a separate atlas without dynamic glyphs for them.
 struct ImFontAtlas
 {
     IMGUI_API ImFontAtlas();
@@ -3464,6 +3548,15 @@ struct ImFontAtlas
     bool                        IsBuilt() const             { return Fonts.Size > 0 && TexReady; } // Bit ambiguous: used to detect when user didn't build texture but effectively we should check TexID != 0 except that would be backend dependent...
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
+    // Cache the output of Build() (e.g. in a file) to skip font loading, packing and rasterization on next start-up.
+    // - SaveToMemory(): builds if needed, then writes texture, glyphs, lookup tables, metrics and custom rectangles positions into 'out_data'.
+    //   The blob is meant to be read back by the same build of your application: it is tied to IMGUI_VERSION_NUM, native endianness and struct sizes.
+    // - LoadFromMemory(): call after adding the same fonts and custom rectangles, instead of Build() (which also adds the default font if none were added). Returns false, leaving the atlas unbuilt
+    //   (GetTexData*** functions will build it as usual), when the blob was saved for different font data, ImFontConfig settings, custom rectangles or atlas settings.
+    // - Both return false with ImFontAtlasFlags_DynamicGlyphs.
+    IMGUI_API bool              SaveToMemory(ImVector<unsigned char>* out_data);
+    IMGUI_API bool              LoadFromMemory(const void* data, size_t data_size);
+
     //-------------------------------------------
     // Glyph Ranges
     //-------------------------------------------
@@ -3511,6 +3604,15 @@ struct ImFontAtlas
     int                         TexGlyphPadding;    // FIXME: Should be called "TexPackPadding". Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0 (will also need to set AntiAliasedLinesUseTex = false).
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
+    int                         DynamicGlyphsTexHeight; // Height of the texture area reserved to glyphs rasterized on demand with ImFontAtlasFlags_DynamicGlyphs. Defaults to 512.
+    ImVector<ImFontAtlasRect>   TexDirtyRects;      // Areas of the texture modified after Build() by ImFontAtlasFlags_DynamicGlyphs. Backend re-uploads them and clears the list.
+
+    // Optional: parallel glyph rasterization during Build(). Leave NULL to rasterize on the calling thread.
+    // Set to a function calling job_func(job_data, n) for every n in [0, job_count), possibly concurrently from worker threads, and returning once all calls have returned.
+    // Each job renders a batch of glyphs into its own packed rectangles: the output is the same regardless of how jobs are scheduled.
+    // The functions set with SetAllocatorFunctions() may be called from the worker threads. The stb_truetype builder makes use of it, the FreeType builder ignores it.
+    ImFontAtlasParallelForFunc  BuildParallelFor;
+    void*                       BuildParallelForUserData;
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
@@ -3535,22 +3637,35 @@ struct ImFontAtlas
     int                         PackIdMouseCursors; // Custom texture rectangle ID for white pixel and mouse cursors
     int                         PackIdLines;        // Custom texture rectangle ID for baked anti-aliased lines
 
+    // [Internal] Dynamic glyphs
+    ImFontAtlasDynamicGlyphs*   DynamicGlyphs;      // Source fonts and texture area allocation kept after Build() with ImFontAtlasFlags_DynamicGlyphs
+    int                         DynamicGlyphsFrame; // Incremented by each ImFontAtlasUpdateDynamicGlyphs(), stored in ImFont::DynamicGlyphsLastUse[]
+
+    // [Internal] Text layouts
+    int                         GlyphsVersion;      // Incremented when glyphs or advances of the fonts change (lookup tables built or loaded, AddRemapChar(), dynamic glyphs). Text layouts cached by ImDrawListSharedData are dropped when it changes.
+
     // [Obsolete]
     //typedef ImFontAtlasCustomRect    CustomRect;         // OBSOLETED in 1.72+
     //typedef ImFontGlyphRangesBuilder GlyphRangesBuilder; // OBSOLETED in 1.67+
 };
 
+// Glyph lookup tables are paged: ImFont::IndexPages[] maps each block of IM_FONT_INDEX_PAGE_SIZE codepoints to a page of ImFont::IndexAdvanceX[]/IndexLookup[].
+// Page 0 always holds codepoints 0-255, so they can be indexed directly. Page 1 is shared by every block without glyphs.
+#define IM_FONT_INDEX_PAGE_SHIFT        8
+#define IM_FONT_INDEX_PAGE_SIZE         (1 << IM_FONT_INDEX_PAGE_SHIFT)
+
 // Font runtime data and rendering
 // ImFontAtlas automatically loads a default embedded font for you when you call GetTexDataAsAlpha8() or GetTexDataAsRGBA32().
 struct ImFont
 {
-    // [Internal] Members: Hot ~20/24 bytes (for CalcTextSize)
-    ImVector<float>             IndexAdvanceX;      // 12-16 // out //            // Sparse. Glyphs->AdvanceX in a directly indexable way (cache-friendly for CalcTextSize functions which only this info, and are often bottleneck in large UI).
+    // [Internal] Members: Hot ~32/40 bytes (for CalcTextSize)
+    ImVector<ImU16>             IndexPages;         // 12-16 // out //            // Page of IndexAdvanceX/IndexLookup for each block of IM_FONT_INDEX_PAGE_SIZE codepoints, up to the highest used one.
+    ImVector<float>             IndexAdvanceX;      // 12-16 // out //            // Paged. Glyphs->AdvanceX in a directly indexable way (cache-friendly for CalcTextSize functions which only this info, and are often bottleneck in large UI).
     float                       FallbackAdvanceX;   // 4     // out // = FallbackGlyph->AdvanceX
     float                       FontSize;           // 4     // in  //            // Height of characters/line, set during loading (don't change after loading)
 
     // [Internal] Members: Hot ~28/40 bytes (for RenderText loop)
-    ImVector<ImWchar>           IndexLookup;        // 12-16 // out //            // Sparse. Index glyphs by Unicode code-point.
+    ImVector<ImWchar>           IndexLookup;        // 12-16 // out //            // Paged. Index glyphs by Unicode code-point.
     ImVector<ImFontGlyph>       Glyphs;             // 12-16 // out //            // All glyphs.
     const ImFontGlyph*          FallbackGlyph;      // 4-8   // out // = FindGlyph(FontFallbackChar)
 
@@ -3568,14 +3683,22 @@ struct ImFont
     float                       Scale;              // 4     // in  // = 1.f      // Base font scale, multiplied by the per-window font scale which you can adjust with SetWindowFontScale()
     float                       Ascent, Descent;    // 4+4   // out //            // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize] (unscaled)
     int                         MetricsTotalSurface;// 4     // out //            // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
+    float                       SdfThreshold;       // 4     // out // = 0.f      // ImFontConfig::SdfPadding > 0: glyphs are signed distance fields, alpha of the outline. Passed to ImDrawCmd::SdfThreshold by RenderText()/RenderChar().
+    float                       SdfAlphaPerTexel;   // 4     // out //            // ImFontConfig::SdfPadding > 0: alpha change per texel of distance. Passed to ImDrawCmd::SdfAlphaPerTexel.
     ImU8                        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8]; // 2 bytes if ImWchar=ImWchar16, 34 bytes if ImWchar==ImWchar32. Store 1-bit for each block of 4K codepoints that has one active glyph. This is mainly used to facilitate iterations across all used codepoints.
 
+    // [Internal] Members: Glyphs rasterized on demand (ImFontAtlasFlags_DynamicGlyphs)
+    int                         DynamicGlyphsStart;     // out // Glyphs[DynamicGlyphsStart...] live in the dynamic area of the atlas, 0 when the font has no dynamic glyphs
+    ImVector<int>               DynamicGlyphsLastUse;   // out // ContainerAtlas->DynamicGlyphsFrame when FindGlyph() last returned each dynamic glyph
+    ImVector<ImWchar>           DynamicGlyphsQueue;     // out // Codepoints missed by FindGlyph() since the last ImFontAtlasUpdateDynamicGlyphs()
+    ImVector<ImU32>             DynamicGlyphsQueued;    // out // 1-bit per codepoint already queued (kept set for codepoints none of the sources have)
+
     // Methods
     IMGUI_API ImFont();
     IMGUI_API ~ImFont();
-    IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c);
+    IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c);                   // With ImFontAtlasFlags_DynamicGlyphs, misses are queued to be rasterized on next NewFrame()
     IMGUI_API const ImFontGlyph*FindGlyphNoFallback(ImWchar c);
-    float                       GetCharAdvance(ImWchar c)           { return ((int)c < IndexAdvanceX.Size) ? IndexAdvanceX[(int)c] : FallbackAdvanceX; }
+    float                       GetCharAdvance(ImWchar c)           { if (DynamicGlyphsStart > 0) return GetCharAdvanceDynamic(c); return ((unsigned int)c < IM_FONT_INDEX_PAGE_SIZE && IndexPages.Size > 0) ? IndexAdvanceX.Data[c] : ((unsigned int)c >> IM_FONT_INDEX_PAGE_SHIFT < (unsigned int)IndexPages.Size) ? IndexAdvanceX.Data[GetIndexSlot(c)] : FallbackAdvanceX; }
     bool                        IsLoaded() const                    { return ContainerAtlas != NULL; }
     const char*                 GetDebugName() const                { return ConfigData ? ConfigData->Name : "<unknown>"; }
 
@@ -3589,7 +3712,10 @@ struct ImFont
     // [Internal] Don't use!
     IMGUI_API void              BuildLookupTable();
     IMGUI_API void              ClearOutputData();
-    IMGUI_API void              GrowIndex(int new_size);
+    IMGUI_API void              GrowIndex(int new_size);            // Cover codepoints [0, new_size) with IndexPages[], new blocks use the shared empty page
+    IMGUI_API int               AddIndexPage(ImWchar c);            // Give the block of 'c' its own page (copied from the shared empty page), return the slot of 'c'
+    IMGUI_API float             GetCharAdvanceDynamic(ImWchar c);   // GetCharAdvance() with ImFontAtlasFlags_DynamicGlyphs: misses are queued and glyphs marked as used, like FindGlyph()
+    int                         GetIndexSlot(ImWchar c) const       { return ((int)IndexPages.Data[(unsigned int)c >> IM_FONT_INDEX_PAGE_SHIFT] << IM_FONT_INDEX_PAGE_SHIFT) + (int)(c & (IM_FONT_INDEX_PAGE_SIZE - 1)); } // Requires 'c' to be covered by IndexPages[]
     IMGUI_API void              AddGlyph(const ImFontConfig* src_cfg, ImWchar c, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x);
     IMGUI_API void              AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst = true); // Makes 'dst' character/glyph points to 'src' character/glyph. Currently needs to be called AFTER fonts have been built.
     IMGUI_API void              SetGlyphVisible(ImWchar c, bool visible);
@@ -134,8 +134,12 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+// stb_truetype allocations never outlive a build: they go straight to the allocator functions, skipping the debug allocation tracking
+// of the current context which isn't thread-safe, as glyphs may be rasterized from worker threads (see ImFontAtlas::BuildParallelFor).
+static void* ImStbTrueTypeAlloc(size_t size) { ImGuiMemAllocFunc alloc_func; ImGuiMemFreeFunc free_func; void* user_data; ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &user_data); return alloc_func(size, user_data); }
+static void  ImStbTrueTypeFree(void* ptr)    { ImGuiMemAllocFunc alloc_func; ImGuiMemFreeFunc free_func; void* user_data; ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &user_data); free_func(ptr, user_data); }
+#define STBTT_malloc(x,u)   ((void)(u), ImStbTrueTypeAlloc(x))
+#define STBTT_free(x,u)     ((void)(u), ImStbTrueTypeFree(x))
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -401,6 +405,14 @@ void ImDrawListSharedData::SetCircleTessellationMaxError(float max_error)
         CircleSegmentCounts[i] = (ImU8)((i > 0) ? IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC(radius, CircleSegmentMaxError) : IM_DRAWLIST_ARCFAST_SAMPLE_MAX);
     }
     ArcFastRadiusCutoff = IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC_R(IM_DRAWLIST_ARCFAST_SAMPLE_MAX, CircleSegmentMaxError);
+    ClearShapeTemplates();
+}
+
+void ImDrawListSharedData::ClearShapeTemplates()
+{
+    ShapeTemplates.resize(0);
+    ShapeTemplateVtx.resize(0);
+    ShapeTemplateIdx.resize(0);
 }
 
 ImDrawList::ImDrawList(ImDrawListSharedData* shared_data)
@@ -422,6 +434,8 @@ void ImDrawList::_ResetForNewFrame()
     IM_STATIC_ASSERT(offsetof(ImDrawCmd, ClipRect) == 0);
     IM_STATIC_ASSERT(offsetof(ImDrawCmd, TextureId) == sizeof(ImVec4));
     IM_STATIC_ASSERT(offsetof(ImDrawCmd, VtxOffset) == sizeof(ImVec4) + sizeof(ImTextureID));
+    IM_STATIC_ASSERT(offsetof(ImDrawCmd, SdfAlphaPerTexel) == offsetof(ImDrawCmd, VtxOffset) + sizeof(unsigned int) + sizeof(float));
+    IM_STATIC_ASSERT(offsetof(ImDrawCmdHeader, SdfAlphaPerTexel) == offsetof(ImDrawCmd, SdfAlphaPerTexel));
     if (_Splitter._Count > 1)
         _Splitter.Merge(this);
 
@@ -440,6 +454,8 @@ void ImDrawList::_ResetForNewFrame()
     _Splitter.Clear();
     CmdBuffer.push_back(ImDrawCmd());
     _FringeScale = 1.0f;
+    _CulledPrimCount = 0;
+    _CulledVtxCount = 0;
 }
 
 void ImDrawList::_ClearFreeMemory()
@@ -456,6 +472,8 @@ void ImDrawList::_ClearFreeMemory()
     _CallbacksDataBuf.clear();
     _Path.clear();
     _Splitter.ClearFreeMemory();
+    _CulledPrimCount = 0;
+    _CulledVtxCount = 0;
 }
 
 ImDrawList* ImDrawList::CloneOutput() const
@@ -468,12 +486,88 @@ ImDrawList* ImDrawList::CloneOutput() const
     return dst;
 }
 
+void ImDrawList::ResetDetached()
+{
+    _ResetForNewFrame();
+    PushClipRectFullScreen();
+    PushTextureID(_Data->Font ? _Data->Font->ContainerAtlas->TexID : (ImTextureID)NULL);
+}
+
+// Append the commands of another draw list, typically recorded on another thread with ResetDetached().
+// Each command only copies the vertices it references, so indices are rebased and VtxOffset boundaries handled by PrimReserve().
+void ImDrawList::AddDrawList(const ImDrawList* src, const ImVec2& offset)
+{
+    IM_ASSERT(src != this);
+    IM_ASSERT(src->_Splitter._Count <= 1 && "Call ChannelsMerge() on the source draw list first!");
+    const ImVec4 dst_clip_rect = _CmdHeader.ClipRect;
+    const float dst_sdf_threshold = _CmdHeader.SdfThreshold;
+    const float dst_sdf_alpha_per_texel = _CmdHeader.SdfAlphaPerTexel;
+    for (const ImDrawCmd& cmd : src->CmdBuffer)
+    {
+        if (cmd.UserCallback == NULL && cmd.ElemCount == 0)
+            continue;
+        ImVec4 clip_rect(ImMax(cmd.ClipRect.x + offset.x, dst_clip_rect.x), ImMax(cmd.ClipRect.y + offset.y, dst_clip_rect.y), ImMin(cmd.ClipRect.z + offset.x, dst_clip_rect.z), ImMin(cmd.ClipRect.w + offset.y, dst_clip_rect.w));
+        if (clip_rect.x >= clip_rect.z || clip_rect.y >= clip_rect.w)
+            continue;
+        PushClipRect(ImVec2(clip_rect.x, clip_rect.y), ImVec2(clip_rect.z, clip_rect.w));
+        PushTextureID(cmd.TextureId);
+        _SetTextSdf(cmd.SdfThreshold, cmd.SdfAlphaPerTexel);
+        if (cmd.UserCallback != NULL)
+        {
+            void* userdata = (cmd.UserCallbackDataSize > 0) ? (void*)(src->_CallbacksDataBuf.Data + cmd.UserCallbackDataOffset) : cmd.UserCallbackData;
+            AddCallback(cmd.UserCallback, userdata, (size_t)cmd.UserCallbackDataSize);
+        }
+        else
+        {
+            const int idx_count = (int)cmd.ElemCount;
+            const ImDrawIdx* src_idx = src->IdxBuffer.Data + cmd.IdxOffset;
+            unsigned int idx_min = src_idx[0], idx_max = src_idx[0];
+            for (int n = 1; n < idx_count; n++)
+            {
+                const unsigned int idx = src_idx[n];
+                idx_min = (idx < idx_min) ? idx : idx_min;
+                idx_max = (idx > idx_max) ? idx : idx_max;
+            }
+            const int vtx_count = (int)(idx_max - idx_min + 1);
+            PrimReserve(idx_count, vtx_count);
+            const ImDrawVert* src_vtx = src->VtxBuffer.Data + cmd.VtxOffset + idx_min;
+            ImDrawVert* dst_vtx = _VtxWritePtr;
+            if (offset.x == 0.0f && offset.y == 0.0f)
+            {
+                memcpy(dst_vtx, src_vtx, (size_t)vtx_count * sizeof(ImDrawVert));
+            }
+            else
+            {
+                const float offset_x = offset.x, offset_y = offset.y;
+                for (int n = 0; n < vtx_count; n++)
+                {
+                    dst_vtx[n] = src_vtx[n];
+                    dst_vtx[n].pos.x += offset_x;
+                    dst_vtx[n].pos.y += offset_y;
+                }
+            }
+            ImDrawIdx* dst_idx = _IdxWritePtr;
+            const ImDrawIdx idx_delta = (ImDrawIdx)(_VtxCurrentIdx - idx_min);
+            for (int n = 0; n < idx_count; n++)
+                dst_idx[n] = (ImDrawIdx)(src_idx[n] + idx_delta);
+            _VtxWritePtr += vtx_count;
+            _IdxWritePtr += idx_count;
+            _VtxCurrentIdx += vtx_count;
+        }
+        _SetTextSdf(dst_sdf_threshold, dst_sdf_alpha_per_texel);
+        PopTextureID();
+        PopClipRect();
+    }
+}
+
 void ImDrawList::AddDrawCmd()
 {
     ImDrawCmd draw_cmd;
     draw_cmd.ClipRect = _CmdHeader.ClipRect;    // Same as calling ImDrawCmd_HeaderCopy()
     draw_cmd.TextureId = _CmdHeader.TextureId;
     draw_cmd.VtxOffset = _CmdHeader.VtxOffset;
+    draw_cmd.SdfThreshold = _CmdHeader.SdfThreshold;
+    draw_cmd.SdfAlphaPerTexel = _CmdHeader.SdfAlphaPerTexel;
     draw_cmd.IdxOffset = IdxBuffer.Size;
 
     IM_ASSERT(draw_cmd.ClipRect.x <= draw_cmd.ClipRect.z && draw_cmd.ClipRect.y <= draw_cmd.ClipRect.w);
@@ -527,10 +621,10 @@ void ImDrawList::AddCallback(ImDrawCallback callback, void* userdata, size_t use
     AddDrawCmd(); // Force a new command after us (see comment below)
 }
 
-// Compare ClipRect, TextureId and VtxOffset with a single memcmp()
-#define ImDrawCmd_HeaderSize                            (offsetof(ImDrawCmd, VtxOffset) + sizeof(unsigned int))
-#define ImDrawCmd_HeaderCompare(CMD_LHS, CMD_RHS)       (memcmp(CMD_LHS, CMD_RHS, ImDrawCmd_HeaderSize))    // Compare ClipRect, TextureId, VtxOffset
-#define ImDrawCmd_HeaderCopy(CMD_DST, CMD_SRC)          (memcpy(CMD_DST, CMD_SRC, ImDrawCmd_HeaderSize))    // Copy ClipRect, TextureId, VtxOffset
+// Compare ClipRect, TextureId, VtxOffset and the SDF parameters with a single memcmp()
+#define ImDrawCmd_HeaderSize                            (offsetof(ImDrawCmd, SdfAlphaPerTexel) + sizeof(float))
+#define ImDrawCmd_HeaderCompare(CMD_LHS, CMD_RHS)       (memcmp(CMD_LHS, CMD_RHS, ImDrawCmd_HeaderSize))    // Compare ClipRect, TextureId, VtxOffset, SdfThreshold, SdfAlphaPerTexel
+#define ImDrawCmd_HeaderCopy(CMD_DST, CMD_SRC)          (memcpy(CMD_DST, CMD_SRC, ImDrawCmd_HeaderSize))    // Copy ClipRect, TextureId, VtxOffset, SdfThreshold, SdfAlphaPerTexel
 #define ImDrawCmd_AreSequentialIdxOffset(CMD_0, CMD_1)  (CMD_0->IdxOffset + CMD_0->ElemCount == CMD_1->IdxOffset)
 
 // Try to merge two last draw commands
@@ -608,6 +702,29 @@ void ImDrawList::_OnChangedVtxOffset()
     curr_cmd->VtxOffset = _CmdHeader.VtxOffset;
 }
 
+void ImDrawList::_OnChangedTextSdf()
+{
+    // If current command is used with different settings we need to add a new command
+    IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
+    ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    if (curr_cmd->ElemCount != 0 && (curr_cmd->SdfThreshold != _CmdHeader.SdfThreshold || curr_cmd->SdfAlphaPerTexel != _CmdHeader.SdfAlphaPerTexel))
+    {
+        AddDrawCmd();
+        return;
+    }
+    IM_ASSERT(curr_cmd->UserCallback == NULL);
+
+    // Try to merge with previous command if it matches, else use current command
+    ImDrawCmd* prev_cmd = curr_cmd - 1;
+    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
+    {
+        CmdBuffer.pop_back();
+        return;
+    }
+    curr_cmd->SdfThreshold = _CmdHeader.SdfThreshold;
+    curr_cmd->SdfAlphaPerTexel = _CmdHeader.SdfAlphaPerTexel;
+}
+
 int ImDrawList::_CalcCircleAutoSegmentCount(float radius) const
 {
     // Automatic segment count
@@ -673,6 +790,16 @@ void ImDrawList::_SetTextureID(ImTextureID texture_id)
     _OnChangedTextureID();
 }
 
+// This is used by ImFont::RenderText()/RenderChar() to output the glyphs of signed distance field fonts in their own commands (0.0f, 0.0f for regular text).
+void ImDrawList::_SetTextSdf(float sdf_threshold, float sdf_alpha_per_texel)
+{
+    if (_CmdHeader.SdfThreshold == sdf_threshold && _CmdHeader.SdfAlphaPerTexel == sdf_alpha_per_texel)
+        return;
+    _CmdHeader.SdfThreshold = sdf_threshold;
+    _CmdHeader.SdfAlphaPerTexel = sdf_alpha_per_texel;
+    _OnChangedTextSdf();
+}
+
 // Reserve space for a number of vertices and indices.
 // You must finish filling your reserved data before calling PrimReserve() again, as it may reallocate or
 // submit the intermediate results. PrimUnreserve() can be used to release unused allocations.
@@ -701,6 +828,39 @@ void ImDrawList::PrimReserve(int idx_count, int vtx_count)
     _IdxWritePtr = IdxBuffer.Data + idx_buffer_old_size;
 }
 
+// Reserve space for up to 'item_count' items of identical size, returns how many items were reserved (at least one).
+// With 16-bit indices the batch is cut where the per-item PrimReserve() calls would have switched to a new VtxOffset,
+// so batched and individual submissions produce the same draw commands.
+int ImDrawList::_PrimReserveBatch(int item_count, int idx_per_item, int vtx_per_item)
+{
+    IM_ASSERT_PARANOID(item_count > 0 && idx_per_item >= 0 && vtx_per_item > 0);
+    if (sizeof(ImDrawIdx) == 2 && (Flags & ImDrawListFlags_AllowVtxOffset))
+    {
+        int items_fitting = ((1 << 16) - 1 - (int)_VtxCurrentIdx) / vtx_per_item;
+        if (items_fitting <= 0)
+        {
+            _CmdHeader.VtxOffset = VtxBuffer.Size;
+            _OnChangedVtxOffset();
+            items_fitting = ((1 << 16) - 1) / vtx_per_item;
+        }
+        item_count = ImMin(item_count, items_fitting);
+    }
+    PrimReserve(item_count * idx_per_item, item_count * vtx_per_item);
+    return item_count;
+}
+
+// With ImDrawListFlags_CullOffscreen: returns true and counts the primitive as culled if the bounding box doesn't touch the current clip rect.
+// Callers test the flag first so the bounding box is only computed when culling is enabled.
+bool ImDrawList::_CullOffscreen(const ImVec2& bb_min, const ImVec2& bb_max, int vtx_count)
+{
+    const ImVec4& clip_rect = _CmdHeader.ClipRect;
+    if (bb_max.x >= clip_rect.x && bb_max.y >= clip_rect.y && bb_min.x <= clip_rect.z && bb_min.y <= clip_rect.w)
+        return false;
+    _CulledPrimCount++;
+    _CulledVtxCount += vtx_count;
+    return true;
+}
+
 // Release the number of reserved vertices/indices from the end of the last reservation made with PrimReserve().
 void ImDrawList::PrimUnreserve(int idx_count, int vtx_count)
 {
@@ -764,6 +924,218 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+// SIMD kernels for AddPolyline(), processing 4 points per iteration.
+// - They replicate the scalar math operation for operation: normals use the same reciprocal square root as the default ImRsqrt()
+//   (_mm_rsqrt_ps with SSE, 1/sqrt with NEON), miter normals use a full division like IM_FIXNORMAL2F(). Results are bit-identical
+//   unless the compiler contracts the scalar code into FMA instructions.
+// - Both only handle segments which don't wrap around (i2 == i1 + 1) and return how many they processed, callers finish with the scalar loop.
+#if (defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)) && !defined(IMGUI_DISABLE_SIMD_POLYLINE) && !defined(IMGUI_DISABLE_DEFAULT_MATH_FUNCTIONS)
+#define IMGUI_ENABLE_SIMD_POLYLINE
+#endif
+
+// Normals for segments [0, segment_count), requires segment_count < points_count.
+static int ImPolylineComputeNormals(const ImVec2* points, int segment_count, ImVec2* out_normals)
+{
+    int i1 = 0;
+#if defined(IMGUI_ENABLE_SIMD_POLYLINE) && defined(IMGUI_ENABLE_SSE)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+    for (; i1 + 4 <= segment_count; i1 += 4)
+    {
+        const __m128 p0 = _mm_loadu_ps(&points[i1].x);      // x0 y0 x1 y1
+        const __m128 p1 = _mm_loadu_ps(&points[i1 + 2].x);  // x2 y2 x3 y3
+        const __m128 q0 = _mm_loadu_ps(&points[i1 + 1].x);
+        const __m128 q1 = _mm_loadu_ps(&points[i1 + 3].x);
+        __m128 dx = _mm_sub_ps(_mm_shuffle_ps(q0, q1, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128 dy = _mm_sub_ps(_mm_shuffle_ps(q0, q1, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1)));
+
+        // IM_NORMALIZE2F_OVER_ZERO()
+        const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        const __m128 non_zero = _mm_cmpgt_ps(d2, zero);
+        const __m128 inv_len = _mm_rsqrt_ps(d2);
+        dx = _mm_or_ps(_mm_and_ps(non_zero, _mm_mul_ps(dx, inv_len)), _mm_andnot_ps(non_zero, dx));
+        dy = _mm_or_ps(_mm_and_ps(non_zero, _mm_mul_ps(dy, inv_len)), _mm_andnot_ps(non_zero, dy));
+
+        // normal = (dy, -dx)
+        const __m128 nx = dy;
+        const __m128 ny = _mm_xor_ps(dx, sign_mask);
+        _mm_storeu_ps(&out_normals[i1].x, _mm_unpacklo_ps(nx, ny));
+        _mm_storeu_ps(&out_normals[i1 + 2].x, _mm_unpackhi_ps(nx, ny));
+    }
+#elif defined(IMGUI_ENABLE_SIMD_POLYLINE) && defined(IMGUI_ENABLE_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    for (; i1 + 4 <= segment_count; i1 += 4)
+    {
+        const float32x4x2_t p = vld2q_f32(&points[i1].x);      // val[0] = x, val[1] = y
+        const float32x4x2_t q = vld2q_f32(&points[i1 + 1].x);
+        float32x4_t dx = vsubq_f32(q.val[0], p.val[0]);
+        float32x4_t dy = vsubq_f32(q.val[1], p.val[1]);
+
+        // IM_NORMALIZE2F_OVER_ZERO()
+        const float32x4_t d2 = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+        const uint32x4_t non_zero = vcgtq_f32(d2, zero);
+        const float32x4_t inv_len = vdivq_f32(one, vsqrtq_f32(d2));
+        dx = vbslq_f32(non_zero, vmulq_f32(dx, inv_len), dx);
+        dy = vbslq_f32(non_zero, vmulq_f32(dy, inv_len), dy);
+
+        float32x4x2_t n;
+        n.val[0] = dy;
+        n.val[1] = vnegq_f32(dx);
+        vst2q_f32(&out_normals[i1].x, n);
+    }
+#else
+    IM_UNUSED(points);
+    IM_UNUSED(out_normals);
+#endif
+    IM_UNUSED(segment_count);
+    return i1;
+}
+
+// Outer (and inner) edge points for the end point of segments [0, segment_count), requires segment_count < points_count.
+// - edge_count == 2: p + dm * offset0, p - dm * offset0
+// - edge_count == 4: p + dm * offset1, p + dm * offset0, p - dm * offset0, p - dm * offset1
+static int ImPolylineComputeEdges(const ImVec2* points, const ImVec2* normals, int segment_count, ImVec2* out_points, int edge_count, float offset0, float offset1)
+{
+    int i1 = 0;
+#if defined(IMGUI_ENABLE_SIMD_POLYLINE) && defined(IMGUI_ENABLE_SSE)
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 min_d2 = _mm_set1_ps(0.000001f);
+    const __m128 max_inv_len2 = _mm_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 o0 = _mm_set1_ps(offset0);
+    const __m128 o1 = _mm_set1_ps(offset1);
+    for (; i1 + 4 <= segment_count; i1 += 4)
+    {
+        const int i2 = i1 + 1;
+        const __m128 n0 = _mm_loadu_ps(&normals[i1].x);
+        const __m128 n1 = _mm_loadu_ps(&normals[i1 + 2].x);
+        const __m128 m0 = _mm_loadu_ps(&normals[i2].x);
+        const __m128 m1 = _mm_loadu_ps(&normals[i2 + 2].x);
+        const __m128 p0 = _mm_loadu_ps(&points[i2].x);
+        const __m128 p1 = _mm_loadu_ps(&points[i2 + 2].x);
+        const __m128 px = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 py = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1));
+
+        // Average normals, IM_FIXNORMAL2F()
+        __m128 dm_x = _mm_mul_ps(_mm_add_ps(_mm_shuffle_ps(n0, n1, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(2, 0, 2, 0))), half);
+        __m128 dm_y = _mm_mul_ps(_mm_add_ps(_mm_shuffle_ps(n0, n1, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(3, 1, 3, 1))), half);
+        const __m128 d2 = _mm_add_ps(_mm_mul_ps(dm_x, dm_x), _mm_mul_ps(dm_y, dm_y));
+        const __m128 fix = _mm_cmpgt_ps(d2, min_d2);
+        const __m128 inv_len2 = _mm_min_ps(_mm_div_ps(one, d2), max_inv_len2);
+        dm_x = _mm_or_ps(_mm_and_ps(fix, _mm_mul_ps(dm_x, inv_len2)), _mm_andnot_ps(fix, dm_x));
+        dm_y = _mm_or_ps(_mm_and_ps(fix, _mm_mul_ps(dm_y, inv_len2)), _mm_andnot_ps(fix, dm_y));
+
+        const __m128 d0_x = _mm_mul_ps(dm_x, o0);
+        const __m128 d0_y = _mm_mul_ps(dm_y, o0);
+        const __m128 a01 = _mm_unpacklo_ps(_mm_add_ps(px, d0_x), _mm_add_ps(py, d0_y)); // p + d0 for points 0,1
+        const __m128 a23 = _mm_unpackhi_ps(_mm_add_ps(px, d0_x), _mm_add_ps(py, d0_y));
+        const __m128 b01 = _mm_unpacklo_ps(_mm_sub_ps(px, d0_x), _mm_sub_ps(py, d0_y)); // p - d0 for points 0,1
+        const __m128 b23 = _mm_unpackhi_ps(_mm_sub_ps(px, d0_x), _mm_sub_ps(py, d0_y));
+        if (edge_count == 2)
+        {
+            ImVec2* out = &out_points[i2 * 2];
+            _mm_storeu_ps(&out[0].x, _mm_movelh_ps(a01, b01));
+            _mm_storeu_ps(&out[2].x, _mm_movehl_ps(b01, a01));
+            _mm_storeu_ps(&out[4].x, _mm_movelh_ps(a23, b23));
+            _mm_storeu_ps(&out[6].x, _mm_movehl_ps(b23, a23));
+        }
+        else
+        {
+            const __m128 d1_x = _mm_mul_ps(dm_x, o1);
+            const __m128 d1_y = _mm_mul_ps(dm_y, o1);
+            const __m128 c01 = _mm_unpacklo_ps(_mm_add_ps(px, d1_x), _mm_add_ps(py, d1_y)); // p + d1
+            const __m128 c23 = _mm_unpackhi_ps(_mm_add_ps(px, d1_x), _mm_add_ps(py, d1_y));
+            const __m128 e01 = _mm_unpacklo_ps(_mm_sub_ps(px, d1_x), _mm_sub_ps(py, d1_y)); // p - d1
+            const __m128 e23 = _mm_unpackhi_ps(_mm_sub_ps(px, d1_x), _mm_sub_ps(py, d1_y));
+            ImVec2* out = &out_points[i2 * 4];
+            _mm_storeu_ps(&out[0].x,  _mm_movelh_ps(c01, a01));
+            _mm_storeu_ps(&out[2].x,  _mm_movelh_ps(b01, e01));
+            _mm_storeu_ps(&out[4].x,  _mm_movehl_ps(a01, c01));
+            _mm_storeu_ps(&out[6].x,  _mm_movehl_ps(e01, b01));
+            _mm_storeu_ps(&out[8].x,  _mm_movelh_ps(c23, a23));
+            _mm_storeu_ps(&out[10].x, _mm_movelh_ps(b23, e23));
+            _mm_storeu_ps(&out[12].x, _mm_movehl_ps(a23, c23));
+            _mm_storeu_ps(&out[14].x, _mm_movehl_ps(e23, b23));
+        }
+    }
+#elif defined(IMGUI_ENABLE_SIMD_POLYLINE) && defined(IMGUI_ENABLE_NEON)
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t min_d2 = vdupq_n_f32(0.000001f);
+    const float32x4_t max_inv_len2 = vdupq_n_f32(IM_FIXNORMAL2F_MAX_INVLEN2);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t o0 = vdupq_n_f32(offset0);
+    const float32x4_t o1 = vdupq_n_f32(offset1);
+    for (; i1 + 4 <= segment_count; i1 += 4)
+    {
+        const int i2 = i1 + 1;
+        const float32x4x2_t n = vld2q_f32(&normals[i1].x);
+        const float32x4x2_t m = vld2q_f32(&normals[i2].x);
+        const float32x4x2_t p = vld2q_f32(&points[i2].x);
+
+        // Average normals, IM_FIXNORMAL2F()
+        float32x4_t dm_x = vmulq_f32(vaddq_f32(n.val[0], m.val[0]), half);
+        float32x4_t dm_y = vmulq_f32(vaddq_f32(n.val[1], m.val[1]), half);
+        const float32x4_t d2 = vaddq_f32(vmulq_f32(dm_x, dm_x), vmulq_f32(dm_y, dm_y));
+        const uint32x4_t fix = vcgtq_f32(d2, min_d2);
+        const float32x4_t inv_len2 = vminq_f32(vdivq_f32(one, d2), max_inv_len2);
+        dm_x = vbslq_f32(fix, vmulq_f32(dm_x, inv_len2), dm_x);
+        dm_y = vbslq_f32(fix, vmulq_f32(dm_y, inv_len2), dm_y);
+
+        const float32x4_t d0_x = vmulq_f32(dm_x, o0);
+        const float32x4_t d0_y = vmulq_f32(dm_y, o0);
+        if (edge_count == 2)
+        {
+            float32x4x4_t out;
+            out.val[0] = vaddq_f32(p.val[0], d0_x);
+            out.val[1] = vaddq_f32(p.val[1], d0_y);
+            out.val[2] = vsubq_f32(p.val[0], d0_x);
+            out.val[3] = vsubq_f32(p.val[1], d0_y);
+            vst4q_f32(&out_points[i2 * 2].x, out);
+        }
+        else
+        {
+            const float32x4_t d1_x = vmulq_f32(dm_x, o1);
+            const float32x4_t d1_y = vmulq_f32(dm_y, o1);
+            const float32x4x2_t a = vzipq_f32(vaddq_f32(p.val[0], d1_x), vaddq_f32(p.val[1], d1_y)); // p + d1, val[0] = points 0,1
+            const float32x4x2_t b = vzipq_f32(vaddq_f32(p.val[0], d0_x), vaddq_f32(p.val[1], d0_y)); // p + d0
+            const float32x4x2_t c = vzipq_f32(vsubq_f32(p.val[0], d0_x), vsubq_f32(p.val[1], d0_y)); // p - d0
+            const float32x4x2_t d = vzipq_f32(vsubq_f32(p.val[0], d1_x), vsubq_f32(p.val[1], d1_y)); // p - d1
+            float* out = &out_points[i2 * 4].x;
+            for (int half_idx = 0; half_idx < 2; half_idx++, out += 16)
+            {
+                vst1q_f32(out + 0,  vcombine_f32(vget_low_f32(a.val[half_idx]), vget_low_f32(b.val[half_idx])));
+                vst1q_f32(out + 4,  vcombine_f32(vget_low_f32(c.val[half_idx]), vget_low_f32(d.val[half_idx])));
+                vst1q_f32(out + 8,  vcombine_f32(vget_high_f32(a.val[half_idx]), vget_high_f32(b.val[half_idx])));
+                vst1q_f32(out + 12, vcombine_f32(vget_high_f32(c.val[half_idx]), vget_high_f32(d.val[half_idx])));
+            }
+        }
+    }
+#else
+    IM_UNUSED(points);
+    IM_UNUSED(normals);
+    IM_UNUSED(out_points);
+    IM_UNUSED(edge_count);
+    IM_UNUSED(offset0);
+    IM_UNUSED(offset1);
+#endif
+    IM_UNUSED(segment_count);
+    return i1;
+}
+
+// Culling test for paths, 'pad' is how far the tessellated geometry may extend beyond the points.
+// Averaged normals get scaled by up to sqrt(IM_FIXNORMAL2F_MAX_INVLEN2) on sharp corners, callers include that in 'pad'.
+static bool ImDrawListCullPoints(ImDrawList* draw_list, const ImVec2* points, int points_count, float pad, int vtx_count)
+{
+    float min_x = points[0].x, min_y = points[0].y, max_x = points[0].x, max_y = points[0].y;
+    for (int i = 1; i < points_count; i++)
+    {
+        min_x = ImMin(min_x, points[i].x); min_y = ImMin(min_y, points[i].y);
+        max_x = ImMax(max_x, points[i].x); max_y = ImMax(max_y, points[i].y);
+    }
+    return draw_list->_CullOffscreen(ImVec2(min_x - pad, min_y - pad), ImVec2(max_x + pad, max_y + pad), vtx_count);
+}
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
@@ -797,6 +1169,8 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
 
         const int idx_count = use_texture ? (count * 6) : (thick_line ? count * 18 : count * 12);
         const int vtx_count = use_texture ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
+        if ((Flags & ImDrawListFlags_CullOffscreen) && ImDrawListCullPoints(this, points, points_count, (thickness * 0.5f + AA_SIZE) * 10.0f, vtx_count))
+            return;
         PrimReserve(idx_count, vtx_count);
 
         // Temporary buffer
@@ -806,7 +1180,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         ImVec2* temp_points = temp_normals + points_count;
 
         // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
+        for (int i1 = ImPolylineComputeNormals(points, ImMin(count, points_count - 1), temp_normals); i1 < count; i1++)
         {
             const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
             float dx = points[i2].x - points[i1].x;
@@ -840,14 +1214,11 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
             }
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
+            // Generate the vertices for the line edges
             // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            for (int i1 = ImPolylineComputeEdges(points, temp_normals, ImMin(count, points_count - 1), temp_points, 2, half_draw_size, 0.0f); i1 < count; i1++) // i1 is the first point of the line segment
             {
                 const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
-                const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
 
                 // Average normals
                 float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
@@ -862,6 +1233,14 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 out_vtx[0].y = points[i2].y + dm_y;
                 out_vtx[1].x = points[i2].x - dm_x;
                 out_vtx[1].y = points[i2].y - dm_y;
+            }
+
+            // Generate the indices to form a number of triangles for each line segment
+            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
+            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            {
+                const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
 
                 if (use_texture)
                 {
@@ -936,14 +1315,11 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
             }
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
+            // Generate the vertices for the line edges
             // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            for (int i1 = ImPolylineComputeEdges(points, temp_normals, ImMin(count, points_count - 1), temp_points, 4, half_inner_thickness, half_inner_thickness + AA_SIZE); i1 < count; i1++) // i1 is the first point of the line segment
             {
                 const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
-                const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
                 // Average normals
                 float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
@@ -964,6 +1340,14 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 out_vtx[2].y = points[i2].y - dm_in_y;
                 out_vtx[3].x = points[i2].x - dm_out_x;
                 out_vtx[3].y = points[i2].y - dm_out_y;
+            }
+
+            // Generate the indices to form a number of triangles for each line segment
+            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
+            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            {
+                const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
                 // Add indexes
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
@@ -994,6 +1378,8 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         // [PATH 4] Non texture-based, Non anti-aliased lines
         const int idx_count = count * 6;
         const int vtx_count = count * 4;    // FIXME-OPT: Not sharing edges
+        if ((Flags & ImDrawListFlags_CullOffscreen) && ImDrawListCullPoints(this, points, points_count, thickness * 0.5f, vtx_count))
+            return;
         PrimReserve(idx_count, vtx_count);
 
         for (int i1 = 0; i1 < count; i1++)
@@ -1038,6 +1424,8 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         const ImU32 col_trans = col & ~IM_COL32_A_MASK;
         const int idx_count = (points_count - 2)*3 + points_count * 6;
         const int vtx_count = (points_count * 2);
+        if ((Flags & ImDrawListFlags_CullOffscreen) && ImDrawListCullPoints(this, points, points_count, AA_SIZE * 0.5f * 10.0f, vtx_count))
+            return;
         PrimReserve(idx_count, vtx_count);
 
         // Add indexes for fill
@@ -1091,6 +1479,8 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         // Non Anti-aliased Fill
         const int idx_count = (points_count - 2)*3;
         const int vtx_count = points_count;
+        if ((Flags & ImDrawListFlags_CullOffscreen) && ImDrawListCullPoints(this, points, points_count, 0.0f, vtx_count))
+            return;
         PrimReserve(idx_count, vtx_count);
         for (int i = 0; i < vtx_count; i++)
         {
@@ -1416,13 +1806,19 @@ static inline ImDrawFlags FixRectCornerFlags(ImDrawFlags flags)
     return flags;
 }
 
+static inline float ClampRectRounding(const ImVec2& a, const ImVec2& b, float rounding, ImDrawFlags flags)
+{
+    rounding = ImMin(rounding, ImFabs(b.x - a.x) * (((flags & ImDrawFlags_RoundCornersTop) == ImDrawFlags_RoundCornersTop) || ((flags & ImDrawFlags_RoundCornersBottom) == ImDrawFlags_RoundCornersBottom) ? 0.5f : 1.0f) - 1.0f);
+    rounding = ImMin(rounding, ImFabs(b.y - a.y) * (((flags & ImDrawFlags_RoundCornersLeft) == ImDrawFlags_RoundCornersLeft) || ((flags & ImDrawFlags_RoundCornersRight) == ImDrawFlags_RoundCornersRight) ? 0.5f : 1.0f) - 1.0f);
+    return rounding;
+}
+
 void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, ImDrawFlags flags)
 {
     if (rounding >= 0.5f)
     {
         flags = FixRectCornerFlags(flags);
-        rounding = ImMin(rounding, ImFabs(b.x - a.x) * (((flags & ImDrawFlags_RoundCornersTop) == ImDrawFlags_RoundCornersTop) || ((flags & ImDrawFlags_RoundCornersBottom) == ImDrawFlags_RoundCornersBottom) ? 0.5f : 1.0f) - 1.0f);
-        rounding = ImMin(rounding, ImFabs(b.y - a.y) * (((flags & ImDrawFlags_RoundCornersLeft) == ImDrawFlags_RoundCornersLeft) || ((flags & ImDrawFlags_RoundCornersRight) == ImDrawFlags_RoundCornersRight) ? 0.5f : 1.0f) - 1.0f);
+        rounding = ClampRectRounding(a, b, rounding, flags);
     }
     if (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
     {
@@ -1444,6 +1840,220 @@ void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, ImDr
     }
 }
 
+// Shape templates
+// - AddRect(), AddRectFilled() with rounding, AddCircle(), AddCircleFilled(), AddNgon() and AddNgonFilled() look up their tessellated mesh by
+//   ImDrawShapeTemplateKey. Vertices are stored relative to the rectangle corner (center of the corner arc) or circle center they were generated
+//   around, so emitting a shape of any size and position is a translate-and-copy without building a path or computing normals.
+// - Straight edges between rectangle corners are at least 1 pixel long after rounding is clamped, so their normals don't depend on their length.
+// - Direct-mapped cache. A shape gets cached the second time it is seen, one-off sizes (e.g. animated) don't churn it. Flushed when full.
+// - Only used with anti-aliasing, where tessellation computes normals and fringes.
+// - Vertex positions may differ from direct tessellation by a few thousandths of a pixel (normals use an approximate ImRsqrt(), whose
+//   error depends on edge lengths). Indices, uv and colors are identical.
+// - The cache lives in ImDrawListSharedData: draw lists recording on other threads need their own (see CreateDrawListSharedDataSnapshot()).
+static void ImDrawListGetRectAnchors(const ImVec2& a, const ImVec2& b, float rounding, ImDrawFlags flags, ImVec2* out_anchors)
+{
+    const float rounding_tl = (flags & ImDrawFlags_RoundCornersTopLeft)     ? rounding : 0.0f;
+    const float rounding_tr = (flags & ImDrawFlags_RoundCornersTopRight)    ? rounding : 0.0f;
+    const float rounding_br = (flags & ImDrawFlags_RoundCornersBottomRight) ? rounding : 0.0f;
+    const float rounding_bl = (flags & ImDrawFlags_RoundCornersBottomLeft)  ? rounding : 0.0f;
+    out_anchors[0] = ImVec2(a.x + rounding_tl, a.y + rounding_tl);
+    out_anchors[1] = ImVec2(b.x - rounding_tr, a.y + rounding_tr);
+    out_anchors[2] = ImVec2(b.x - rounding_br, b.y - rounding_br);
+    out_anchors[3] = ImVec2(a.x + rounding_bl, b.y - rounding_bl);
+}
+
+// Tessellate the shape into a scratch draw list at a canonical position where corners are far apart, and store it in the cache.
+// Returns false if the shape is too large to be cached.
+static bool ImDrawListRecordShapeTemplate(ImDrawListSharedData* data, ImDrawShapeTemplate* shape)
+{
+    const ImDrawShapeTemplateKey& key = shape->Key;
+    ImDrawList scratch(data);
+    scratch._ResetForNewFrame();
+    scratch.PushClipRectFullScreen();
+    scratch.Flags = key.DrawListFlags;
+    scratch._FringeScale = key.FringeScale;
+
+    ImVec2 anchors[4];
+    const bool is_rect = (key.Shape == ImDrawShapeType_Rect || key.Shape == ImDrawShapeType_RectFilled);
+    const float rect_size = (key.Radius + key.Thickness + 8.0f) * 2.0f;
+    if (is_rect)
+    {
+        ImDrawListGetRectAnchors(ImVec2(0.0f, 0.0f), ImVec2(rect_size, rect_size), key.Radius, key.Flags, anchors);
+        scratch.PathRect(ImVec2(0.0f, 0.0f), ImVec2(rect_size, rect_size), key.Radius, key.Flags);
+    }
+    else
+    {
+        anchors[0] = ImVec2(0.0f, 0.0f);
+        if (key.NumSegments <= 0)
+        {
+            scratch._PathArcToFastEx(anchors[0], key.Radius, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
+            scratch._Path.Size--;
+        }
+        else
+        {
+            const float a_max = (IM_PI * 2.0f) * ((float)key.NumSegments - 1.0f) / (float)key.NumSegments;
+            scratch.PathArcTo(anchors[0], key.Radius, 0.0f, a_max, key.NumSegments - 1);
+        }
+    }
+    if (key.Shape == ImDrawShapeType_RectFilled || key.Shape == ImDrawShapeType_CircleFilled)
+        scratch.PathFillConvex(IM_COL32_WHITE);
+    else
+        scratch.PathStroke(IM_COL32_WHITE, ImDrawFlags_Closed, key.Thickness);
+
+    const int vtx_count = scratch.VtxBuffer.Size;
+    const int idx_count = scratch.IdxBuffer.Size;
+    if (vtx_count == 0 || vtx_count > IM_DRAWLIST_SHAPE_TEMPLATE_VTX_MAX)
+    {
+        shape->VtxOffset = -1;
+        return false;
+    }
+
+    shape->VtxOffset = data->ShapeTemplateVtx.Size;
+    shape->VtxCount = vtx_count;
+    shape->IdxOffset = data->ShapeTemplateIdx.Size;
+    shape->IdxCount = idx_count;
+    shape->BoundsPad = 0.0f;
+    data->ShapeTemplateVtx.resize(data->ShapeTemplateVtx.Size + vtx_count);
+    ImDrawVert* vtx_write = data->ShapeTemplateVtx.Data + shape->VtxOffset;
+    for (const ImDrawVert& vtx : scratch.VtxBuffer)
+    {
+        // Rectangle corners each own a quadrant of the canonical rectangle
+        int anchor_n = 0;
+        if (is_rect)
+            anchor_n = (vtx.pos.y < rect_size * 0.5f) ? (vtx.pos.x < rect_size * 0.5f ? 0 : 1) : (vtx.pos.x < rect_size * 0.5f ? 3 : 2);
+        vtx_write->pos = vtx.pos - anchors[anchor_n];
+        vtx_write->uv = vtx.uv;
+        vtx_write->col = (vtx.col & IM_COL32_A_MASK) | (ImU32)anchor_n;
+        vtx_write++;
+        if (is_rect)
+            shape->BoundsPad = ImMax(shape->BoundsPad, ImMax(ImMax(-vtx.pos.x, vtx.pos.x - rect_size), ImMax(-vtx.pos.y, vtx.pos.y - rect_size)));
+        else
+            shape->BoundsPad = ImMax(shape->BoundsPad, ImMax(ImFabs(vtx.pos.x), ImFabs(vtx.pos.y)) - key.Radius);
+    }
+    data->ShapeTemplateIdx.resize(data->ShapeTemplateIdx.Size + idx_count);
+    memcpy(data->ShapeTemplateIdx.Data + shape->IdxOffset, scratch.IdxBuffer.Data, (size_t)idx_count * sizeof(ImDrawIdx));
+    return true;
+}
+
+// Returns true if the shape was emitted (or culled) from the cache, false if the caller needs to tessellate it.
+// For rectangles 'a', 'b' are the corners passed to PathRect(), for circles 'a' is the center and 'radius' the path radius.
+static bool ImDrawListAddShapeTemplate(ImDrawList* draw_list, ImDrawShapeType shape_type, const ImVec2& a, const ImVec2& b, float radius, ImDrawFlags flags, int num_segments, float thickness, ImU32 col)
+{
+#ifdef IMGUI_DISABLE_DRAWLIST_SHAPE_TEMPLATES
+    IM_UNUSED(draw_list); IM_UNUSED(shape_type); IM_UNUSED(a); IM_UNUSED(b); IM_UNUSED(radius); IM_UNUSED(flags); IM_UNUSED(num_segments); IM_UNUSED(thickness); IM_UNUSED(col);
+    return false;
+#else
+    // Without anti-aliasing, tessellation writes one vertex per point (fill) or four per segment (stroke): as cheap as copying.
+    const bool is_filled = (shape_type == ImDrawShapeType_RectFilled || shape_type == ImDrawShapeType_CircleFilled);
+    if ((draw_list->Flags & (is_filled ? ImDrawListFlags_AntiAliasedFill : ImDrawListFlags_AntiAliasedLines)) == 0)
+        return false;
+
+    const bool is_rect = (shape_type == ImDrawShapeType_Rect || shape_type == ImDrawShapeType_RectFilled);
+    if (is_rect)
+    {
+        // Same rounding as PathRect(). Degenerate rectangles would have zero length edges.
+        if (b.x - a.x < 1.0f || b.y - a.y < 1.0f)
+            return false;
+        if (radius >= 0.5f)
+        {
+            flags = FixRectCornerFlags(flags);
+            radius = ClampRectRounding(a, b, radius, flags);
+        }
+        if (radius < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
+        {
+            radius = 0.0f;
+            flags = ImDrawFlags_None;
+        }
+        flags &= ImDrawFlags_RoundCornersMask_;
+    }
+
+    ImDrawListSharedData* data = draw_list->_Data;
+    ImDrawShapeTemplateKey key;
+    key.Shape = shape_type;
+    key.Radius = radius;
+    key.Flags = flags;
+    key.NumSegments = num_segments;
+    key.Thickness = thickness;
+    key.DrawListFlags = draw_list->Flags & (ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill);
+    key.FringeScale = draw_list->_FringeScale;
+
+    // Look up the slot. A different key is recorded (evicting the slot) the second time in a row it is seen there,
+    // so one-off shapes neither pay for recording nor evict templates in use.
+    if (data->ShapeTemplateVtx.Size >= IM_DRAWLIST_SHAPE_TEMPLATES_VTX_MAX || data->ShapeTemplatesTexUvWhitePixel.x != data->TexUvWhitePixel.x || data->ShapeTemplatesTexUvWhitePixel.y != data->TexUvWhitePixel.y || data->ShapeTemplatesTexUvLines != data->TexUvLines)
+        data->ClearShapeTemplates();
+    if (data->ShapeTemplates.Size == 0)
+    {
+        data->ShapeTemplates.resize(IM_DRAWLIST_SHAPE_TEMPLATES_SLOTS);
+        memset(data->ShapeTemplates.Data, 0, (size_t)data->ShapeTemplates.size_in_bytes());
+        data->ShapeTemplatesTexUvWhitePixel = data->TexUvWhitePixel;
+        data->ShapeTemplatesTexUvLines = data->TexUvLines;
+    }
+
+    // Multiplicative hash over the key words (ImHashData() costs as much as tessellating a small shape)
+    ImU32 key_words[sizeof(key) / sizeof(ImU32)];
+    IM_STATIC_ASSERT(sizeof(key) % sizeof(ImU32) == 0);
+    memcpy(key_words, &key, sizeof(key));
+    ImGuiID hash = 0;
+    for (ImU32 word : key_words)
+        hash = (hash ^ word) * 0x9E3779B1u;
+    hash ^= hash >> 16;
+    if (hash == 0) // 0 is an empty slot
+        hash = 1;
+    ImDrawShapeTemplate* shape = &data->ShapeTemplates.Data[hash & (IM_DRAWLIST_SHAPE_TEMPLATES_SLOTS - 1)];
+    if (shape->Hash != hash || memcmp(&shape->Key, &key, sizeof(key)) != 0)
+    {
+        if (shape->SeenHash != hash)
+        {
+            shape->SeenHash = hash;
+            return false;
+        }
+        shape->Hash = hash;
+        shape->Key = key;
+        if (!ImDrawListRecordShapeTemplate(data, shape))
+            return false;
+    }
+    else if (shape->VtxOffset < 0)
+    {
+        return false;
+    }
+
+    ImVec2 anchors[4];
+    if (is_rect)
+        ImDrawListGetRectAnchors(a, b, radius, flags, anchors);
+    else
+        anchors[0] = a;
+    if (draw_list->Flags & ImDrawListFlags_CullOffscreen)
+    {
+        const ImVec2 pad(shape->BoundsPad, shape->BoundsPad);
+        const ImVec2 bb_min = is_rect ? a - pad : a - ImVec2(radius, radius) - pad;
+        const ImVec2 bb_max = is_rect ? b + pad : a + ImVec2(radius, radius) + pad;
+        if (draw_list->_CullOffscreen(bb_min, bb_max, shape->VtxCount))
+            return true;
+    }
+
+    draw_list->PrimReserve(shape->IdxCount, shape->VtxCount);
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    const ImDrawVert* vtx_read = data->ShapeTemplateVtx.Data + shape->VtxOffset;
+    for (int n = 0; n < shape->VtxCount; n++, vtx_read++, vtx_write++)
+    {
+        const ImVec2& anchor = anchors[vtx_read->col & 3];
+        vtx_write->pos.x = anchor.x + vtx_read->pos.x;
+        vtx_write->pos.y = anchor.y + vtx_read->pos.y;
+        vtx_write->uv = vtx_read->uv;
+        vtx_write->col = col & (vtx_read->col | ~IM_COL32_A_MASK); // Opaque or transparent fringe
+    }
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    const ImDrawIdx* idx_read = data->ShapeTemplateIdx.Data + shape->IdxOffset;
+    const unsigned int idx_base = draw_list->_VtxCurrentIdx;
+    for (int n = 0; n < shape->IdxCount; n++)
+        idx_write[n] = (ImDrawIdx)(idx_base + idx_read[n]);
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write + shape->IdxCount;
+    draw_list->_VtxCurrentIdx += (unsigned int)shape->VtxCount;
+    return true;
+#endif
+}
+
 void ImDrawList::AddLine(const ImVec2& p1, const ImVec2& p2, ImU32 col, float thickness)
 {
     if ((col & IM_COL32_A_MASK) == 0)
@@ -1459,10 +2069,11 @@ void ImDrawList::AddRect(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, fl
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
-    if (Flags & ImDrawListFlags_AntiAliasedLines)
-        PathRect(p_min + ImVec2(0.50f, 0.50f), p_max - ImVec2(0.50f, 0.50f), rounding, flags);
-    else
-        PathRect(p_min + ImVec2(0.50f, 0.50f), p_max - ImVec2(0.49f, 0.49f), rounding, flags); // Better looking lower-right corner and rounded non-AA shapes.
+    const ImVec2 a = p_min + ImVec2(0.50f, 0.50f);
+    const ImVec2 b = (Flags & ImDrawListFlags_AntiAliasedLines) ? p_max - ImVec2(0.50f, 0.50f) : p_max - ImVec2(0.49f, 0.49f); // Better looking lower-right corner and rounded non-AA shapes.
+    if (ImDrawListAddShapeTemplate(this, ImDrawShapeType_Rect, a, b, rounding, flags, 0, thickness, col))
+        return;
+    PathRect(a, b, rounding, flags);
     PathStroke(col, ImDrawFlags_Closed, thickness);
 }
 
@@ -1472,11 +2083,15 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
         return;
     if (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
     {
+        if ((Flags & ImDrawListFlags_CullOffscreen) && _CullOffscreen(p_min, p_max, 4))
+            return;
         PrimReserve(6, 4);
         PrimRect(p_min, p_max, col);
     }
     else
     {
+        if (ImDrawListAddShapeTemplate(this, ImDrawShapeType_RectFilled, p_min, p_max, rounding, flags, 0, 0.0f, col))
+            return;
         PathRect(p_min, p_max, rounding, flags);
         PathFillConvex(col);
     }
@@ -1487,6 +2102,8 @@ void ImDrawList::AddRectFilledMultiColor(const ImVec2& p_min, const ImVec2& p_ma
 {
     if (((col_upr_left | col_upr_right | col_bot_right | col_bot_left) & IM_COL32_A_MASK) == 0)
         return;
+    if ((Flags & ImDrawListFlags_CullOffscreen) && _CullOffscreen(p_min, p_max, 4))
+        return;
 
     const ImVec2 uv = _Data->TexUvWhitePixel;
     PrimReserve(6, 4);
@@ -1549,6 +2166,12 @@ void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int nu
     if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
         return;
 
+    // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
+    if (num_segments > 0)
+        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
+    if (ImDrawListAddShapeTemplate(this, ImDrawShapeType_Circle, center, center, radius - 0.5f, 0, num_segments, thickness, col))
+        return;
+
     if (num_segments <= 0)
     {
         // Use arc with automatic segment count
@@ -1557,9 +2180,6 @@ void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int nu
     }
     else
     {
-        // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
-        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
-
         // Because we are filling a closed shape we remove 1 from the count of segments/points
         const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
         PathArcTo(center, radius - 0.5f, 0.0f, a_max, num_segments - 1);
@@ -1573,6 +2193,11 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
     if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
         return;
 
+    if (num_segments > 0)
+        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
+    if (ImDrawListAddShapeTemplate(this, ImDrawShapeType_CircleFilled, center, center, radius, 0, num_segments, 0.0f, col))
+        return;
+
     if (num_segments <= 0)
     {
         // Use arc with automatic segment count
@@ -1581,9 +2206,6 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
     }
     else
     {
-        // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
-        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
-
         // Because we are filling a closed shape we remove 1 from the count of segments/points
         const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
         PathArcTo(center, radius, 0.0f, a_max, num_segments - 1);
@@ -1597,6 +2219,8 @@ void ImDrawList::AddNgon(const ImVec2& center, float radius, ImU32 col, int num_
 {
     if ((col & IM_COL32_A_MASK) == 0 || num_segments <= 2)
         return;
+    if (ImDrawListAddShapeTemplate(this, ImDrawShapeType_Circle, center, center, radius - 0.5f, 0, num_segments, thickness, col))
+        return;
 
     // Because we are filling a closed shape we remove 1 from the count of segments/points
     const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
@@ -1609,6 +2233,8 @@ void ImDrawList::AddNgonFilled(const ImVec2& center, float radius, ImU32 col, in
 {
     if ((col & IM_COL32_A_MASK) == 0 || num_segments <= 2)
         return;
+    if (ImDrawListAddShapeTemplate(this, ImDrawShapeType_CircleFilled, center, center, radius, 0, num_segments, 0.0f, col))
+        return;
 
     // Because we are filling a closed shape we remove 1 from the count of segments/points
     const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
@@ -1645,44 +2271,342 @@ void ImDrawList::AddEllipseFilled(const ImVec2& center, const ImVec2& radius, Im
     PathFillConvex(col);
 }
 
-// Cubic Bezier takes 4 controls points
-void ImDrawList::AddBezierCubic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness, int num_segments)
+// Batched primitives
+// - Each batch loop keeps consuming elements until its reservation is filled, skipping transparent ones like the individual
+//   calls do, so reservations are cut at the same points as a sequence of individual calls would have been.
+void ImDrawList::AddRectFilledBatch(const ImVec2* p_min, const ImVec2* p_max, const ImU32* cols, int count)
 {
-    if ((col & IM_COL32_A_MASK) == 0)
-        return;
-
-    PathLineTo(p1);
-    PathBezierCubicCurveTo(p2, p3, p4, num_segments);
-    PathStroke(col, 0, thickness);
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    const bool cull = (Flags & ImDrawListFlags_CullOffscreen) != 0;
+    int n = 0;
+    while (n < count)
+    {
+        const int reserved = _PrimReserveBatch(count - n, 6, 4);
+        int written = 0;
+        for (; n < count && written < reserved; n++)
+        {
+            const ImU32 col = cols[n];
+            const ImVec2& a = p_min[n];
+            const ImVec2& c = p_max[n];
+            if ((col & IM_COL32_A_MASK) == 0 || (cull && _CullOffscreen(a, c, 4)))
+                continue;
+            const ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
+            _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
+            _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
+            _VtxWritePtr[0].pos.x = a.x; _VtxWritePtr[0].pos.y = a.y; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+            _VtxWritePtr[1].pos.x = c.x; _VtxWritePtr[1].pos.y = a.y; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
+            _VtxWritePtr[2].pos.x = c.x; _VtxWritePtr[2].pos.y = c.y; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
+            _VtxWritePtr[3].pos.x = a.x; _VtxWritePtr[3].pos.y = c.y; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
+            _VtxWritePtr += 4;
+            _VtxCurrentIdx += 4;
+            _IdxWritePtr += 6;
+            written++;
+        }
+        if (written < reserved)
+            PrimUnreserve((reserved - written) * 6, (reserved - written) * 4);
+    }
 }
 
-// Quadratic Bezier takes 3 controls points
-void ImDrawList::AddBezierQuadratic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, ImU32 col, float thickness, int num_segments)
+// Replicates what AddPolyline() emits for the two points of an AddLine() call, see there for the meaning of each path.
+void ImDrawList::AddLineBatch(const ImVec2* p1, const ImVec2* p2, const ImU32* cols, int count, float thickness)
 {
-    if ((col & IM_COL32_A_MASK) == 0)
-        return;
+    const ImVec2 opaque_uv = _Data->TexUvWhitePixel;
+    const bool anti_aliased = (Flags & ImDrawListFlags_AntiAliasedLines) != 0;
+    const bool thick_line = (thickness > _FringeScale);
+    const float AA_SIZE = _FringeScale;
 
-    PathLineTo(p1);
-    PathBezierQuadraticCurveTo(p2, p3, num_segments);
-    PathStroke(col, 0, thickness);
-}
+    int idx_per_line = 6, vtx_per_line = 4;
+    bool use_texture = false;
+    ImVec2 tex_uv0, tex_uv1;
+    float half_draw_size = 0.0f, half_inner_thickness = 0.0f;
+    if (anti_aliased)
+    {
+        thickness = ImMax(thickness, 1.0f);
+        const int integer_thickness = (int)thickness;
+        const float fractional_thickness = thickness - integer_thickness;
+        use_texture = (Flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (fractional_thickness <= 0.00001f) && (AA_SIZE == 1.0f);
+        idx_per_line = use_texture ? 6 : (thick_line ? 18 : 12);
+        vtx_per_line = use_texture ? 4 : (thick_line ? 8 : 6);
+        if (use_texture)
+        {
+            const ImVec4 tex_uvs = _Data->TexUvLines[integer_thickness];
+            tex_uv0 = ImVec2(tex_uvs.x, tex_uvs.y);
+            tex_uv1 = ImVec2(tex_uvs.z, tex_uvs.w);
+        }
+        half_draw_size = use_texture ? ((thickness * 0.5f) + 1) : AA_SIZE;
+        half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
+    }
+    const bool cull = (Flags & ImDrawListFlags_CullOffscreen) != 0;
+    const float cull_pad = thickness * 0.5f + (anti_aliased ? AA_SIZE : 0.0f);
 
-void ImDrawList::AddText(ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end, float wrap_width, const ImVec4* cpu_fine_clip_rect)
-{
-    if ((col & IM_COL32_A_MASK) == 0)
-        return;
+    int n = 0;
+    while (n < count)
+    {
+        const int reserved = _PrimReserveBatch(count - n, idx_per_line, vtx_per_line);
+        int written = 0;
+        for (; n < count && written < reserved; n++)
+        {
+            const ImU32 col = cols[n];
+            if ((col & IM_COL32_A_MASK) == 0)
+                continue;
 
-    // Accept null ranges
-    if (text_begin == text_end || text_begin[0] == 0)
-        return;
-    if (text_end == NULL)
-        text_end = text_begin + strlen(text_begin);
+            // Same half pixel offset as AddLine()
+            const float ax = p1[n].x + 0.5f, ay = p1[n].y + 0.5f;
+            const float bx = p2[n].x + 0.5f, by = p2[n].y + 0.5f;
+            if (cull && _CullOffscreen(ImVec2(ImMin(ax, bx) - cull_pad, ImMin(ay, by) - cull_pad), ImVec2(ImMax(ax, bx) + cull_pad, ImMax(ay, by) + cull_pad), vtx_per_line))
+                continue;
+            written++;
+            float dx = bx - ax;
+            float dy = by - ay;
+            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+            const unsigned int idx1 = _VtxCurrentIdx;
 
-    // Pull default font/size from the shared ImDrawListSharedData instance
-    if (font == NULL)
-        font = _Data->Font;
-    if (font_size == 0.0f)
-        font_size = _Data->FontSize;
+            if (!anti_aliased)
+            {
+                // [PATH 4] Non texture-based, Non anti-aliased lines
+                dx *= (thickness * 0.5f);
+                dy *= (thickness * 0.5f);
+                _VtxWritePtr[0].pos.x = ax + dy; _VtxWritePtr[0].pos.y = ay - dx; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;
+                _VtxWritePtr[1].pos.x = bx + dy; _VtxWritePtr[1].pos.y = by - dx; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
+                _VtxWritePtr[2].pos.x = bx - dy; _VtxWritePtr[2].pos.y = by + dx; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
+                _VtxWritePtr[3].pos.x = ax - dy; _VtxWritePtr[3].pos.y = ay + dx; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col;
+                _IdxWritePtr[0] = (ImDrawIdx)(idx1); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 2);
+                _IdxWritePtr[3] = (ImDrawIdx)(idx1); _IdxWritePtr[4] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[5] = (ImDrawIdx)(idx1 + 3);
+                _VtxWritePtr += 4;
+                _IdxWritePtr += 6;
+                _VtxCurrentIdx += 4;
+                continue;
+            }
+
+            // Both points share the segment normal. The start point uses it as is, the end point goes through the averaging of AddPolyline().
+            const float n_x = dy, n_y = -dx;
+            float dm_x = (n_x + n_x) * 0.5f;
+            float dm_y = (n_y + n_y) * 0.5f;
+            IM_FIXNORMAL2F(dm_x, dm_y);
+
+            if (use_texture || !thick_line)
+            {
+                // [PATH 1] Texture-based lines (thick or non-thick)
+                // [PATH 2] Non texture-based lines (non-thick)
+                const float a_x = n_x * half_draw_size, a_y = n_y * half_draw_size;
+                const float b_x = dm_x * half_draw_size, b_y = dm_y * half_draw_size;
+                if (use_texture)
+                {
+                    const unsigned int idx2 = idx1 + 2;
+                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 1);
+                    _IdxWritePtr[3] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[4] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0);
+                    _VtxWritePtr[0].pos.x = ax + a_x; _VtxWritePtr[0].pos.y = ay + a_y; _VtxWritePtr[0].uv = tex_uv0; _VtxWritePtr[0].col = col;
+                    _VtxWritePtr[1].pos.x = ax - a_x; _VtxWritePtr[1].pos.y = ay - a_y; _VtxWritePtr[1].uv = tex_uv1; _VtxWritePtr[1].col = col;
+                    _VtxWritePtr[2].pos.x = bx + b_x; _VtxWritePtr[2].pos.y = by + b_y; _VtxWritePtr[2].uv = tex_uv0; _VtxWritePtr[2].col = col;
+                    _VtxWritePtr[3].pos.x = bx - b_x; _VtxWritePtr[3].pos.y = by - b_y; _VtxWritePtr[3].uv = tex_uv1; _VtxWritePtr[3].col = col;
+                    _IdxWritePtr += 6;
+                }
+                else
+                {
+                    const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+                    const unsigned int idx2 = idx1 + 3;
+                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 2);
+                    _IdxWritePtr[3] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0);
+                    _IdxWritePtr[6] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8] = (ImDrawIdx)(idx1 + 0);
+                    _IdxWritePtr[9] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1);
+                    _VtxWritePtr[0].pos.x = ax;       _VtxWritePtr[0].pos.y = ay;       _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;
+                    _VtxWritePtr[1].pos.x = ax + a_x; _VtxWritePtr[1].pos.y = ay + a_y; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col_trans;
+                    _VtxWritePtr[2].pos.x = ax - a_x; _VtxWritePtr[2].pos.y = ay - a_y; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col_trans;
+                    _VtxWritePtr[3].pos.x = bx;       _VtxWritePtr[3].pos.y = by;       _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col;
+                    _VtxWritePtr[4].pos.x = bx + b_x; _VtxWritePtr[4].pos.y = by + b_y; _VtxWritePtr[4].uv = opaque_uv; _VtxWritePtr[4].col = col_trans;
+                    _VtxWritePtr[5].pos.x = bx - b_x; _VtxWritePtr[5].pos.y = by - b_y; _VtxWritePtr[5].uv = opaque_uv; _VtxWritePtr[5].col = col_trans;
+                    _IdxWritePtr += 12;
+                }
+            }
+            else
+            {
+                // [PATH 2] Non texture-based lines (thick)
+                const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+                const float a_out_x = n_x * (half_inner_thickness + AA_SIZE), a_out_y = n_y * (half_inner_thickness + AA_SIZE);
+                const float a_in_x = n_x * half_inner_thickness, a_in_y = n_y * half_inner_thickness;
+                const float b_out_x = dm_x * (half_inner_thickness + AA_SIZE), b_out_y = dm_y * (half_inner_thickness + AA_SIZE);
+                const float b_in_x = dm_x * half_inner_thickness, b_in_y = dm_y * half_inner_thickness;
+                const unsigned int idx2 = idx1 + 4;
+                _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
+                _IdxWritePtr[3]  = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2 + 1);
+                _IdxWritePtr[6]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8]  = (ImDrawIdx)(idx1 + 0);
+                _IdxWritePtr[9]  = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1);
+                _IdxWritePtr[12] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[13] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[14] = (ImDrawIdx)(idx1 + 3);
+                _IdxWritePtr[15] = (ImDrawIdx)(idx1 + 3); _IdxWritePtr[16] = (ImDrawIdx)(idx2 + 3); _IdxWritePtr[17] = (ImDrawIdx)(idx2 + 2);
+                _VtxWritePtr[0].pos.x = ax + a_out_x; _VtxWritePtr[0].pos.y = ay + a_out_y; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col_trans;
+                _VtxWritePtr[1].pos.x = ax + a_in_x;  _VtxWritePtr[1].pos.y = ay + a_in_y;  _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
+                _VtxWritePtr[2].pos.x = ax - a_in_x;  _VtxWritePtr[2].pos.y = ay - a_in_y;  _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
+                _VtxWritePtr[3].pos.x = ax - a_out_x; _VtxWritePtr[3].pos.y = ay - a_out_y; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col_trans;
+                _VtxWritePtr[4].pos.x = bx + b_out_x; _VtxWritePtr[4].pos.y = by + b_out_y; _VtxWritePtr[4].uv = opaque_uv; _VtxWritePtr[4].col = col_trans;
+                _VtxWritePtr[5].pos.x = bx + b_in_x;  _VtxWritePtr[5].pos.y = by + b_in_y;  _VtxWritePtr[5].uv = opaque_uv; _VtxWritePtr[5].col = col;
+                _VtxWritePtr[6].pos.x = bx - b_in_x;  _VtxWritePtr[6].pos.y = by - b_in_y;  _VtxWritePtr[6].uv = opaque_uv; _VtxWritePtr[6].col = col;
+                _VtxWritePtr[7].pos.x = bx - b_out_x; _VtxWritePtr[7].pos.y = by - b_out_y; _VtxWritePtr[7].uv = opaque_uv; _VtxWritePtr[7].col = col_trans;
+                _IdxWritePtr += 18;
+            }
+            _VtxWritePtr += vtx_per_line;
+            _VtxCurrentIdx += vtx_per_line;
+        }
+        if (written < reserved)
+            PrimUnreserve((reserved - written) * idx_per_line, (reserved - written) * vtx_per_line);
+    }
+}
+
+// The circle is tessellated once around (0,0) into the temporary buffer (point offsets + AA fringe offsets),
+// then every element only translates it. Vertex and index layout match AddConvexPolyFilled().
+void ImDrawList::AddCircleFilledBatch(const ImVec2* centers, const ImU32* cols, int count, float radius, int num_segments)
+{
+    if (count <= 0 || radius < 0.5f)
+        return;
+
+    // Same point generation as AddCircleFilled(), around the origin
+    IM_ASSERT(_Path.Size == 0);
+    if (num_segments <= 0)
+    {
+        _PathArcToFastEx(ImVec2(0.0f, 0.0f), radius, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
+        _Path.Size--;
+    }
+    else
+    {
+        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
+        const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
+        PathArcTo(ImVec2(0.0f, 0.0f), radius, 0.0f, a_max, num_segments - 1);
+    }
+    const int points_count = _Path.Size;
+    if (points_count < 3)
+    {
+        _Path.Size = 0;
+        return;
+    }
+
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    const bool anti_aliased = (Flags & ImDrawListFlags_AntiAliasedFill) != 0;
+    const int idx_per_circle = anti_aliased ? (points_count - 2) * 3 + points_count * 6 : (points_count - 2) * 3;
+    const int vtx_per_circle = anti_aliased ? points_count * 2 : points_count;
+    const bool cull = (Flags & ImDrawListFlags_CullOffscreen) != 0;
+    const float cull_radius = radius + (anti_aliased ? _FringeScale : 0.0f);
+
+    // Fringe offsets, see AddConvexPolyFilled()
+    _Data->TempBuffer.reserve_discard(points_count * 2);
+    ImVec2* temp_normals = _Data->TempBuffer.Data;
+    ImVec2* temp_fringe = temp_normals + points_count;
+    if (anti_aliased)
+    {
+        const float AA_SIZE = _FringeScale;
+        const ImVec2* points = _Path.Data;
+        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        {
+            float dx = points[i1].x - points[i0].x;
+            float dy = points[i1].y - points[i0].y;
+            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+            temp_normals[i0].x = dy;
+            temp_normals[i0].y = -dx;
+        }
+        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        {
+            float dm_x = (temp_normals[i0].x + temp_normals[i1].x) * 0.5f;
+            float dm_y = (temp_normals[i0].y + temp_normals[i1].y) * 0.5f;
+            IM_FIXNORMAL2F(dm_x, dm_y);
+            temp_fringe[i1].x = dm_x * (AA_SIZE * 0.5f);
+            temp_fringe[i1].y = dm_y * (AA_SIZE * 0.5f);
+        }
+    }
+
+    int n = 0;
+    while (n < count)
+    {
+        const int reserved = _PrimReserveBatch(count - n, idx_per_circle, vtx_per_circle);
+        int written = 0;
+        for (; n < count && written < reserved; n++)
+        {
+            const ImU32 col = cols[n];
+            const ImVec2 center = centers[n];
+            if ((col & IM_COL32_A_MASK) == 0)
+                continue;
+            if (cull && _CullOffscreen(ImVec2(center.x - cull_radius, center.y - cull_radius), ImVec2(center.x + cull_radius, center.y + cull_radius), vtx_per_circle))
+                continue;
+            written++;
+
+            const ImVec2* offsets = _Path.Data;
+            const unsigned int vtx_inner_idx = _VtxCurrentIdx;
+            if (anti_aliased)
+            {
+                const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+                const unsigned int vtx_outer_idx = vtx_inner_idx + 1;
+                for (int i = 2; i < points_count; i++)
+                {
+                    _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + ((i - 1) << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx + (i << 1));
+                    _IdxWritePtr += 3;
+                }
+                for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+                {
+                    const float p_x = center.x + offsets[i1].x, p_y = center.y + offsets[i1].y;
+                    _VtxWritePtr[0].pos.x = (p_x - temp_fringe[i1].x); _VtxWritePtr[0].pos.y = (p_y - temp_fringe[i1].y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+                    _VtxWritePtr[1].pos.x = (p_x + temp_fringe[i1].x); _VtxWritePtr[1].pos.y = (p_y + temp_fringe[i1].y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+                    _VtxWritePtr += 2;
+                    _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
+                    _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
+                    _IdxWritePtr += 6;
+                }
+            }
+            else
+            {
+                for (int i = 0; i < points_count; i++)
+                {
+                    _VtxWritePtr[0].pos.x = center.x + offsets[i].x; _VtxWritePtr[0].pos.y = center.y + offsets[i].y; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+                    _VtxWritePtr++;
+                }
+                for (int i = 2; i < points_count; i++)
+                {
+                    _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + i - 1); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx + i);
+                    _IdxWritePtr += 3;
+                }
+            }
+            _VtxCurrentIdx += vtx_per_circle;
+        }
+        if (written < reserved)
+            PrimUnreserve((reserved - written) * idx_per_circle, (reserved - written) * vtx_per_circle);
+    }
+    _Path.Size = 0;
+}
+
+// Cubic Bezier takes 4 controls points
+void ImDrawList::AddBezierCubic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness, int num_segments)
+{
+    if ((col & IM_COL32_A_MASK) == 0)
+        return;
+
+    PathLineTo(p1);
+    PathBezierCubicCurveTo(p2, p3, p4, num_segments);
+    PathStroke(col, 0, thickness);
+}
+
+// Quadratic Bezier takes 3 controls points
+void ImDrawList::AddBezierQuadratic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, ImU32 col, float thickness, int num_segments)
+{
+    if ((col & IM_COL32_A_MASK) == 0)
+        return;
+
+    PathLineTo(p1);
+    PathBezierQuadraticCurveTo(p2, p3, num_segments);
+    PathStroke(col, 0, thickness);
+}
+
+void ImDrawList::AddText(ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end, float wrap_width, const ImVec4* cpu_fine_clip_rect)
+{
+    if ((col & IM_COL32_A_MASK) == 0)
+        return;
+
+    // Accept null ranges
+    if (text_begin == text_end || text_begin[0] == 0)
+        return;
+    if (text_end == NULL)
+        text_end = text_begin + strlen(text_begin);
+
+    // Pull default font/size from the shared ImDrawListSharedData instance
+    if (font == NULL)
+        font = _Data->Font;
+    if (font_size == 0.0f)
+        font_size = _Data->FontSize;
 
     IM_ASSERT(font->ContainerAtlas->TexID == _CmdHeader.TextureId);  // Use high-level ImGui::PushFont() or low-level ImDrawList::PushTextureId() to change font.
 
@@ -1694,6 +2618,15 @@ void ImDrawList::AddText(ImFont* font, float font_size, const ImVec2& pos, ImU32
         clip_rect.z = ImMin(clip_rect.z, cpu_fine_clip_rect->z);
         clip_rect.w = ImMin(clip_rect.w, cpu_fine_clip_rect->w);
     }
+
+    // Text starting right of or below the clip rect can't be visible, RenderText() already skips lines above it.
+    // Single unwrapped lines entirely above it are rejected here as well (wrapping may continue the text into view).
+    if ((Flags & ImDrawListFlags_CullOffscreen) && (pos.x > clip_rect.z || pos.y > clip_rect.w || (pos.y + font_size < clip_rect.y && wrap_width <= 0.0f && memchr(text_begin, '\n', (size_t)(text_end - text_begin)) == NULL)))
+    {
+        _CulledPrimCount++;
+        _CulledVtxCount += (int)(text_end - text_begin) * 4;
+        return;
+    }
     font->RenderText(this, font_size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip_rect != NULL);
 }
 
@@ -1706,6 +2639,8 @@ void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& p_min, cons
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if ((Flags & ImDrawListFlags_CullOffscreen) && _CullOffscreen(p_min, p_max, 4))
+        return;
 
     const bool push_texture_id = user_texture_id != _CmdHeader.TextureId;
     if (push_texture_id)
@@ -1722,6 +2657,12 @@ void ImDrawList::AddImageQuad(ImTextureID user_texture_id, const ImVec2& p1, con
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (Flags & ImDrawListFlags_CullOffscreen)
+    {
+        const ImVec2 quad[4] = { p1, p2, p3, p4 };
+        if (ImDrawListCullPoints(this, quad, 4, 0.0f, 4))
+            return;
+    }
 
     const bool push_texture_id = user_texture_id != _CmdHeader.TextureId;
     if (push_texture_id)
@@ -1768,6 +2709,7 @@ void ImDrawList::AddImageRounded(ImTextureID user_texture_id, const ImVec2& p_mi
 // Provided as a convenience for user but not used by main library.
 //-----------------------------------------------------------------------------
 // - ImTriangulator [Internal]
+// - ImTriangulatorMonotone [Internal]
 // - AddConcavePolyFilled()
 //-----------------------------------------------------------------------------
 
@@ -1976,12 +2918,534 @@ void ImTriangulator::ReclassifyNode(ImTriangulatorNode* n1)
     n1->Type = type;
 }
 
-// Use ear-clipping algorithm to triangulate a simple polygon (no self-interaction, no holes).
+//-----------------------------------------------------------------------------
+// Triangulate concave polygons with a sweep-line monotone decomposition, then triangulate each y-monotone piece in linear time.
+// O(N log N) complexity, selected with ImDrawFlags_TriangulateMonotone.
+// Reference: de Berg et al., "Computational Geometry: Algorithms and Applications", chapter 3 (and Ivan Fratric's polypartition).
+// - Works on a counter-clockwise, y-up copy of the polygon (screen y negated).
+// - A diagonal duplicates its two end vertices, so every piece stays a circular list of vertices.
+// - Edges crossing the sweep line are kept ordered left to right in a treap, stored in the scratch buffer.
+// - Returns false on degenerate geometry (self-intersections, duplicate points...) so caller can fall back to ear clipping.
+//-----------------------------------------------------------------------------
+
+enum ImTriangulatorMonotoneVertexType
+{
+    ImTriangulatorMonotoneVertexType_Regular,
+    ImTriangulatorMonotoneVertexType_Start,
+    ImTriangulatorMonotoneVertexType_End,
+    ImTriangulatorMonotoneVertexType_Split,
+    ImTriangulatorMonotoneVertexType_Merge,
+};
+
+struct ImTriangulatorMonotoneVertex
+{
+    ImVec2                  Pos;        // y-up
+    int                     Index;      // Index in source points
+    int                     Prev;
+    int                     Next;
+    int                     Edge;       // Tree node of the edge going from this vertex to Next, while it crosses the sweep line. -1 otherwise
+    int                     Helper;     // Helper vertex of that edge
+    ImTriangulatorMonotoneVertexType Type;
+};
+
+struct ImTriangulatorMonotoneEdge
+{
+    ImVec2                  P1, P2;     // P1 above P2
+    int                     Vertex;     // Vertex the edge goes from
+    int                     Left, Right, Parent;
+    unsigned int            Priority;
+};
+
+struct ImTriangulatorMonotoneSortItem
+{
+    ImVec2                  Pos;
+    int                     Vertex;
+};
+
+struct ImTriangulatorMonotone
+{
+    static int EstimateScratchBufferSize(int points_count)  { return (sizeof(ImTriangulatorMonotoneVertex) * 3 + sizeof(ImTriangulatorMonotoneEdge) + sizeof(ImTriangulatorMonotoneSortItem) + sizeof(int) * 3 * 4 + 3) * points_count + sizeof(unsigned int) * (points_count - 2) * 3; }
+
+    bool    Triangulate(const ImVec2* points, int points_count, void* scratch_buffer);  // Output (points_count - 2) triangles in _Triangles, as relative indexes
+
+    // Internal functions
+    bool    Partition();
+    void    AddDiagonal(int v1, int v2);
+    bool    TriangulatePiece(const int* piece, int piece_size);
+    void    EdgeInsert(int vertex);
+    void    EdgeErase(int node);
+    int     EdgeFindLeftOf(const ImVec2& p) const;
+    void    EdgeRotateUp(int node);
+
+    // Internal members
+    ImTriangulatorMonotoneVertex*   _Vertices = NULL;
+    int                     _VerticesCount = 0;
+    int                     _VerticesCapacity = 0;
+    ImTriangulatorMonotoneEdge*     _Edges = NULL;
+    int                     _EdgesCount = 0;
+    int                     _EdgesRoot = -1;
+    unsigned int            _EdgesSeed = 0;
+    ImTriangulatorMonotoneSortItem* _Sorted = NULL;
+    int*                    _PieceScratch = NULL;   // 4 x _VerticesCapacity: piece vertices, then order/chain/stack
+    bool*                   _Used = NULL;
+    unsigned int*           _Triangles = NULL;
+    int                     _TrianglesCount = 0;
+    int                     _TrianglesMax = 0;
+};
+
+static inline bool ImTriangulatorMonotoneBelow(const ImVec2& p1, const ImVec2& p2)                          { return p1.y < p2.y || (p1.y == p2.y && p1.x < p2.x); }
+static inline bool ImTriangulatorMonotoneIsConvex(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3)     { return (p3.y - p1.y) * (p2.x - p1.x) - (p3.x - p1.x) * (p2.y - p1.y) > 0.0f; }
+
+// Order of edges crossing the sweep line, left to right. Point queries are passed as P1 == P2.
+static bool ImTriangulatorMonotoneEdgeLess(const ImVec2& a1, const ImVec2& a2, const ImVec2& b1, const ImVec2& b2)
+{
+    if (b1.y == b2.y)
+    {
+        if (a1.y == a2.y)
+            return a1.y < b1.y;
+        return ImTriangulatorMonotoneIsConvex(a1, a2, b1);
+    }
+    if (a1.y == a2.y || a1.y < b1.y)
+        return !ImTriangulatorMonotoneIsConvex(b1, b2, a1);
+    return ImTriangulatorMonotoneIsConvex(a1, a2, b1);
+}
+
+static int IMGUI_CDECL ImTriangulatorMonotoneSortComparer(const void* lhs, const void* rhs)
+{
+    const ImVec2& a = ((const ImTriangulatorMonotoneSortItem*)lhs)->Pos;
+    const ImVec2& b = ((const ImTriangulatorMonotoneSortItem*)rhs)->Pos;
+    return ImTriangulatorMonotoneBelow(b, a) ? -1 : ImTriangulatorMonotoneBelow(a, b) ? +1 : 0;
+}
+
+bool ImTriangulatorMonotone::Triangulate(const ImVec2* points, int points_count, void* scratch_buffer)
+{
+    IM_ASSERT(scratch_buffer != NULL && points_count >= 3);
+
+    // Distribute storage
+    _VerticesCapacity = points_count * 3; // Each of the (points_count - 3) diagonals of a simple polygon duplicates 2 vertices
+    _Vertices       = (ImTriangulatorMonotoneVertex*)scratch_buffer;                       // _VerticesCapacity x Vertex
+    _Edges          = (ImTriangulatorMonotoneEdge*)(_Vertices + _VerticesCapacity);        // points_count x Edge
+    _Sorted         = (ImTriangulatorMonotoneSortItem*)(_Edges + points_count);            // points_count x SortItem
+    _PieceScratch   = (int*)(_Sorted + points_count);                                      // _VerticesCapacity x 4 x int
+    _Triangles      = (unsigned int*)(_PieceScratch + _VerticesCapacity * 4);              // (points_count - 2) x 3 x unsigned int
+    _Used           = (bool*)(_Triangles + (points_count - 2) * 3);                        // _VerticesCapacity x bool
+    _TrianglesCount = 0;
+    _TrianglesMax = points_count - 2;
+
+    // Counter-clockwise, y-up vertices
+    float area = 0.0f;
+    for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        area += points[i0].x * points[i1].y - points[i1].x * points[i0].y;
+    const bool reverse = area > 0.0f; // Positive in y-down == clockwise once y is negated
+    for (int i = 0; i < points_count; i++)
+    {
+        ImTriangulatorMonotoneVertex& v = _Vertices[i];
+        v.Index = reverse ? points_count - 1 - i : i;
+        v.Pos = ImVec2(points[v.Index].x, -points[v.Index].y);
+        v.Prev = (i == 0) ? points_count - 1 : i - 1;
+        v.Next = (i == points_count - 1) ? 0 : i + 1;
+        v.Edge = v.Helper = -1;
+    }
+    _VerticesCount = points_count;
+
+    if (!Partition())
+        return false;
+
+    // Triangulate each monotone piece
+    memset(_Used, 0, (size_t)_VerticesCount * sizeof(bool));
+    int* piece = _PieceScratch;
+    for (int first = 0; first < _VerticesCount; first++)
+    {
+        if (_Used[first])
+            continue;
+        int piece_size = 0;
+        int v = first;
+        do
+        {
+            if (piece_size == _VerticesCount || _Used[v])
+                return false;
+            _Used[v] = true;
+            piece[piece_size++] = v;
+            v = _Vertices[v].Next;
+        }
+        while (v != first);
+        if (!TriangulatePiece(piece, piece_size))
+            return false;
+    }
+    if (_TrianglesCount != _TrianglesMax)
+        return false;
+
+    // Triangles have the winding of the source polygon
+    if (reverse)
+        for (int i = 0; i < _TrianglesCount * 3; i += 3)
+            ImSwap(_Triangles[i + 1], _Triangles[i + 2]);
+    return true;
+}
+
+bool ImTriangulatorMonotone::Partition()
+{
+    const int points_count = _VerticesCount;
+    for (int i = 0; i < points_count; i++)
+    {
+        ImTriangulatorMonotoneVertex& v = _Vertices[i];
+        const ImVec2& p0 = _Vertices[v.Prev].Pos;
+        const ImVec2& p2 = _Vertices[v.Next].Pos;
+        if (ImTriangulatorMonotoneBelow(p0, v.Pos) && ImTriangulatorMonotoneBelow(p2, v.Pos))
+            v.Type = ImTriangulatorMonotoneIsConvex(p2, p0, v.Pos) ? ImTriangulatorMonotoneVertexType_Start : ImTriangulatorMonotoneVertexType_Split;
+        else if (ImTriangulatorMonotoneBelow(v.Pos, p0) && ImTriangulatorMonotoneBelow(v.Pos, p2))
+            v.Type = ImTriangulatorMonotoneIsConvex(p2, p0, v.Pos) ? ImTriangulatorMonotoneVertexType_End : ImTriangulatorMonotoneVertexType_Merge;
+        else
+            v.Type = ImTriangulatorMonotoneVertexType_Regular;
+        _Sorted[i].Pos = v.Pos;
+        _Sorted[i].Vertex = i;
+    }
+    ImQsort(_Sorted, (size_t)points_count, sizeof(ImTriangulatorMonotoneSortItem), ImTriangulatorMonotoneSortComparer); // Top to bottom
+    _EdgesCount = 0;
+    _EdgesRoot = -1;
+    _EdgesSeed = 0x12345678;
+
+    // Sweep top to bottom, adding diagonals at split and merge vertices
+    ImTriangulatorMonotoneVertex* vertices = _Vertices;
+    for (int sorted_n = 0; sorted_n < points_count; sorted_n++)
+    {
+        if (_VerticesCount + 4 > _VerticesCapacity) // Up to 2 diagonals per vertex
+            return false;
+        const int v1 = _Sorted[sorted_n].Vertex;
+        int v2 = v1;                // Copy of v1 on the piece left of the diagonals added so far
+        const int prev = vertices[v1].Prev;
+        switch (vertices[v1].Type)
+        {
+        case ImTriangulatorMonotoneVertexType_Start:
+            EdgeInsert(v1);
+            vertices[v1].Helper = v1;
+            break;
+        case ImTriangulatorMonotoneVertexType_End:
+            if (vertices[prev].Edge < 0)
+                return false;
+            if (vertices[vertices[prev].Helper].Type == ImTriangulatorMonotoneVertexType_Merge)
+                AddDiagonal(v1, vertices[prev].Helper);
+            EdgeErase(vertices[prev].Edge);
+            vertices[prev].Edge = -1;
+            break;
+        case ImTriangulatorMonotoneVertexType_Split:
+        {
+            const int left = EdgeFindLeftOf(vertices[v1].Pos);
+            if (left < 0)
+                return false;
+            AddDiagonal(v1, vertices[_Edges[left].Vertex].Helper);
+            v2 = _VerticesCount - 2;
+            vertices[_Edges[left].Vertex].Helper = v1;
+            EdgeInsert(v2);
+            vertices[v2].Helper = v2;
+            break;
+        }
+        case ImTriangulatorMonotoneVertexType_Merge:
+        {
+            if (vertices[prev].Edge < 0)
+                return false;
+            if (vertices[vertices[prev].Helper].Type == ImTriangulatorMonotoneVertexType_Merge)
+            {
+                AddDiagonal(v1, vertices[prev].Helper);
+                v2 = _VerticesCount - 2;
+            }
+            EdgeErase(vertices[prev].Edge);
+            vertices[prev].Edge = -1;
+            const int left = EdgeFindLeftOf(vertices[v1].Pos);
+            if (left < 0)
+                return false;
+            if (vertices[vertices[_Edges[left].Vertex].Helper].Type == ImTriangulatorMonotoneVertexType_Merge)
+                AddDiagonal(v2, vertices[_Edges[left].Vertex].Helper);
+            vertices[_Edges[left].Vertex].Helper = v2;
+            break;
+        }
+        case ImTriangulatorMonotoneVertexType_Regular:
+            if (ImTriangulatorMonotoneBelow(vertices[v1].Pos, vertices[prev].Pos))
+            {
+                // Interior on the right: replace incoming edge with outgoing one
+                if (vertices[prev].Edge < 0)
+                    return false;
+                if (vertices[vertices[prev].Helper].Type == ImTriangulatorMonotoneVertexType_Merge)
+                {
+                    AddDiagonal(v1, vertices[prev].Helper);
+                    v2 = _VerticesCount - 2;
+                }
+                EdgeErase(vertices[prev].Edge);
+                vertices[prev].Edge = -1;
+                EdgeInsert(v2);
+                vertices[v2].Helper = v1;
+            }
+            else
+            {
+                const int left = EdgeFindLeftOf(vertices[v1].Pos);
+                if (left < 0)
+                    return false;
+                if (vertices[vertices[_Edges[left].Vertex].Helper].Type == ImTriangulatorMonotoneVertexType_Merge)
+                    AddDiagonal(v1, vertices[_Edges[left].Vertex].Helper);
+                vertices[_Edges[left].Vertex].Helper = v1;
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+// Split the piece containing v1 and v2 in two. v1 and v2 keep their incoming edge, their copies take their outgoing edge (and its tree node).
+void ImTriangulatorMonotone::AddDiagonal(int v1, int v2)
+{
+    ImTriangulatorMonotoneVertex* vertices = _Vertices;
+    const int new_v1 = _VerticesCount++;
+    const int new_v2 = _VerticesCount++;
+    vertices[new_v1] = vertices[v1];
+    vertices[new_v2] = vertices[v2];
+    vertices[vertices[v1].Next].Prev = new_v1;
+    vertices[vertices[v2].Next].Prev = new_v2;
+    vertices[v1].Next = new_v2;
+    vertices[new_v2].Prev = v1;
+    vertices[v2].Next = new_v1;
+    vertices[new_v1].Prev = v2;
+    if (vertices[new_v1].Edge >= 0)
+        _Edges[vertices[new_v1].Edge].Vertex = new_v1;
+    if (vertices[new_v2].Edge >= 0)
+        _Edges[vertices[new_v2].Edge].Vertex = new_v2;
+    vertices[v1].Edge = vertices[v2].Edge = -1;
+}
+
+// Emit triangles of a y-monotone piece, merging its left and right chains top to bottom.
+bool ImTriangulatorMonotone::TriangulatePiece(const int* piece, int piece_size)
+{
+    if (piece_size < 3 || _TrianglesCount + piece_size - 2 > _TrianglesMax)
+        return false;
+    const ImTriangulatorMonotoneVertex* vertices = _Vertices;
+    #define POS(N)      vertices[piece[N]].Pos
+    #define EMIT(A, B, C)   do { unsigned int* tri = &_Triangles[_TrianglesCount++ * 3]; tri[0] = vertices[piece[A]].Index; tri[1] = vertices[piece[B]].Index; tri[2] = vertices[piece[C]].Index; } while (0)
+    if (piece_size == 3)
+    {
+        EMIT(0, 1, 2);
+        return true;
+    }
+
+    int top = 0, bottom = 0;
+    for (int i = 1; i < piece_size; i++)
+    {
+        if (ImTriangulatorMonotoneBelow(POS(i), POS(bottom)))
+            bottom = i;
+        if (ImTriangulatorMonotoneBelow(POS(top), POS(i)))
+            top = i;
+    }
+
+    // Check the piece is monotone (it isn't if source polygon self-intersects)
+    for (int i = top; i != bottom; )
+    {
+        const int i2 = (i + 1 == piece_size) ? 0 : i + 1;
+        if (!ImTriangulatorMonotoneBelow(POS(i2), POS(i)))
+            return false;
+        i = i2;
+    }
+    for (int i = bottom; i != top; )
+    {
+        const int i2 = (i + 1 == piece_size) ? 0 : i + 1;
+        if (!ImTriangulatorMonotoneBelow(POS(i), POS(i2)))
+            return false;
+        i = i2;
+    }
+
+    // Merge left (+1) and right (-1) chains
+    int* order = _PieceScratch + _VerticesCapacity;
+    int* chain = order + piece_size;
+    int* stack = chain + piece_size;
+    order[0] = top;
+    chain[top] = 0;
+    int left = (top + 1 == piece_size) ? 0 : top + 1;
+    int right = (top == 0) ? piece_size - 1 : top - 1;
+    int order_n = 1;
+    for (; order_n < piece_size - 1; order_n++)
+    {
+        if (left != bottom && (right == bottom || !ImTriangulatorMonotoneBelow(POS(left), POS(right))))
+        {
+            order[order_n] = left;
+            chain[left] = 1;
+            left = (left + 1 == piece_size) ? 0 : left + 1;
+        }
+        else
+        {
+            order[order_n] = right;
+            chain[right] = -1;
+            right = (right == 0) ? piece_size - 1 : right - 1;
+        }
+    }
+    order[order_n] = bottom;
+    chain[bottom] = 0;
+
+    // Cut as many triangles as possible at each vertex
+    stack[0] = order[0];
+    stack[1] = order[1];
+    int stack_size = 2;
+    for (int i = 2; i < piece_size - 1; i++)
+    {
+        const int v = order[i];
+        if (chain[v] != chain[stack[stack_size - 1]])
+        {
+            for (int j = 0; j < stack_size - 1; j++)
+            {
+                if (chain[v] == 1)
+                    EMIT(stack[j + 1], stack[j], v);
+                else
+                    EMIT(stack[j], stack[j + 1], v);
+            }
+            stack[0] = order[i - 1];
+            stack[1] = v;
+            stack_size = 2;
+        }
+        else
+        {
+            stack_size--;
+            while (stack_size > 0)
+            {
+                const int s0 = stack[stack_size - 1];
+                const int s1 = stack[stack_size];
+                if (chain[v] == 1 ? !ImTriangulatorMonotoneIsConvex(POS(v), POS(s0), POS(s1)) : !ImTriangulatorMonotoneIsConvex(POS(v), POS(s1), POS(s0)))
+                    break;
+                if (chain[v] == 1)
+                    EMIT(v, s0, s1);
+                else
+                    EMIT(v, s1, s0);
+                stack_size--;
+            }
+            stack_size++;
+            stack[stack_size++] = v;
+        }
+    }
+    for (int j = 0; j < stack_size - 1; j++)
+    {
+        if (chain[stack[j + 1]] == 1)
+            EMIT(stack[j], stack[j + 1], bottom);
+        else
+            EMIT(stack[j + 1], stack[j], bottom);
+    }
+    #undef POS
+    #undef EMIT
+    return true;
+}
+
+void ImTriangulatorMonotone::EdgeInsert(int vertex)
+{
+    ImTriangulatorMonotoneEdge* edges = _Edges;
+    const int node = _EdgesCount++;
+    ImTriangulatorMonotoneEdge& edge = edges[node];
+    edge.P1 = _Vertices[vertex].Pos;
+    edge.P2 = _Vertices[_Vertices[vertex].Next].Pos;
+    edge.Vertex = vertex;
+    edge.Left = edge.Right = edge.Parent = -1;
+    _EdgesSeed ^= _EdgesSeed << 13; _EdgesSeed ^= _EdgesSeed >> 17; _EdgesSeed ^= _EdgesSeed << 5;
+    edge.Priority = _EdgesSeed;
+    _Vertices[vertex].Edge = node;
+
+    // Binary tree insertion, then rotate up to restore heap order on priorities
+    if (_EdgesRoot < 0)
+    {
+        _EdgesRoot = node;
+        return;
+    }
+    int parent = _EdgesRoot;
+    for (;;)
+    {
+        int& child = ImTriangulatorMonotoneEdgeLess(edge.P1, edge.P2, edges[parent].P1, edges[parent].P2) ? edges[parent].Left : edges[parent].Right;
+        if (child < 0)
+        {
+            child = node;
+            edge.Parent = parent;
+            break;
+        }
+        parent = child;
+    }
+    while (edge.Parent >= 0 && edges[edge.Parent].Priority < edge.Priority)
+        EdgeRotateUp(node);
+}
+
+void ImTriangulatorMonotone::EdgeErase(int node)
+{
+    // Rotate down to a leaf, then unlink
+    ImTriangulatorMonotoneEdge* edges = _Edges;
+    while (edges[node].Left >= 0 || edges[node].Right >= 0)
+    {
+        const int l = edges[node].Left;
+        const int r = edges[node].Right;
+        EdgeRotateUp((l < 0) ? r : (r < 0) ? l : (edges[l].Priority > edges[r].Priority) ? l : r);
+    }
+    const int parent = edges[node].Parent;
+    if (parent < 0)
+        _EdgesRoot = -1;
+    else if (edges[parent].Left == node)
+        edges[parent].Left = -1;
+    else
+        edges[parent].Right = -1;
+}
+
+// Return the tree node of the edge directly left of 'p', or -1. (Read its vertex after adding diagonals, which may move it to a copy)
+int ImTriangulatorMonotone::EdgeFindLeftOf(const ImVec2& p) const
+{
+    int result = -1;
+    for (int node = _EdgesRoot; node >= 0; )
+    {
+        const ImTriangulatorMonotoneEdge& edge = _Edges[node];
+        if (ImTriangulatorMonotoneEdgeLess(edge.P1, edge.P2, p, p))
+        {
+            result = node;
+            node = edge.Right;
+        }
+        else
+        {
+            node = edge.Left;
+        }
+    }
+    return result;
+}
+
+void ImTriangulatorMonotone::EdgeRotateUp(int node)
+{
+    ImTriangulatorMonotoneEdge* edges = _Edges;
+    const int parent = edges[node].Parent;
+    const int grand_parent = edges[parent].Parent;
+    if (edges[parent].Left == node)
+    {
+        edges[parent].Left = edges[node].Right;
+        if (edges[node].Right >= 0)
+            edges[edges[node].Right].Parent = parent;
+        edges[node].Right = parent;
+    }
+    else
+    {
+        edges[parent].Right = edges[node].Left;
+        if (edges[node].Left >= 0)
+            edges[edges[node].Left].Parent = parent;
+        edges[node].Left = parent;
+    }
+    edges[parent].Parent = node;
+    edges[node].Parent = grand_parent;
+    if (grand_parent < 0)
+        _EdgesRoot = node;
+    else if (edges[grand_parent].Left == parent)
+        edges[grand_parent].Left = node;
+    else
+        edges[grand_parent].Right = node;
+}
+
+// Return (points_count - 2) triangles as relative indexes in _Data->TempBuffer, or NULL on degenerate geometry.
+static const unsigned int* ImDrawListTriangulateMonotone(ImDrawListSharedData* data, const ImVec2* points, int points_count)
+{
+    data->TempBuffer.reserve_discard((ImTriangulatorMonotone::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
+    ImTriangulatorMonotone triangulator;
+    if (!triangulator.Triangulate(points, points_count, data->TempBuffer.Data))
+        return NULL;
+    return triangulator._Triangles;
+}
+
+// Use ear-clipping algorithm to triangulate a simple polygon (no self-interaction, no holes), or monotone decomposition with ImDrawFlags_TriangulateMonotone.
 // (Reminder: we don't perform any coarse clipping/culling in ImDrawList layer!
 // It is up to caller to ensure not making costly calls that will be outside of visible area.
 // As concave fill is noticeably more expensive than other primitives, be mindful of this...
 // Caller can build AABB of points, and avoid filling if 'draw_list->_CmdHeader.ClipRect.Overlays(points_bb) == false')
-void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_count, ImU32 col)
+void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags)
 {
     if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
         return;
@@ -1996,19 +3460,31 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
         const ImU32 col_trans = col & ~IM_COL32_A_MASK;
         const int idx_count = (points_count - 2) * 3 + points_count * 6;
         const int vtx_count = (points_count * 2);
+        if ((Flags & ImDrawListFlags_CullOffscreen) && ImDrawListCullPoints(this, points, points_count, AA_SIZE * 0.5f * 10.0f, vtx_count))
+            return;
         PrimReserve(idx_count, vtx_count);
 
         // Add indexes for fill
         unsigned int vtx_inner_idx = _VtxCurrentIdx;
         unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
 
-        _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
-        triangulator.Init(points, points_count, _Data->TempBuffer.Data);
-        while (triangulator._TrianglesLeft > 0)
+        const unsigned int* triangles = (flags & ImDrawFlags_TriangulateMonotone) ? ImDrawListTriangulateMonotone(_Data, points, points_count) : NULL;
+        if (triangles != NULL)
         {
-            triangulator.GetNextTriangle(triangle);
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (triangle[0] << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (triangle[1] << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx + (triangle[2] << 1));
-            _IdxWritePtr += 3;
+            for (int i = 0; i < (points_count - 2) * 3; i++)
+                _IdxWritePtr[i] = (ImDrawIdx)(vtx_inner_idx + (triangles[i] << 1));
+            _IdxWritePtr += (points_count - 2) * 3;
+        }
+        else
+        {
+            _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
+            triangulator.Init(points, points_count, _Data->TempBuffer.Data);
+            while (triangulator._TrianglesLeft > 0)
+            {
+                triangulator.GetNextTriangle(triangle);
+                _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (triangle[0] << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (triangle[1] << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx + (triangle[2] << 1));
+                _IdxWritePtr += 3;
+            }
         }
 
         // Compute normals
@@ -2053,19 +3529,31 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
         // Non Anti-aliased Fill
         const int idx_count = (points_count - 2) * 3;
         const int vtx_count = points_count;
+        if ((Flags & ImDrawListFlags_CullOffscreen) && ImDrawListCullPoints(this, points, points_count, 0.0f, vtx_count))
+            return;
         PrimReserve(idx_count, vtx_count);
         for (int i = 0; i < vtx_count; i++)
         {
             _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
             _VtxWritePtr++;
         }
-        _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
-        triangulator.Init(points, points_count, _Data->TempBuffer.Data);
-        while (triangulator._TrianglesLeft > 0)
+        const unsigned int* triangles = (flags & ImDrawFlags_TriangulateMonotone) ? ImDrawListTriangulateMonotone(_Data, points, points_count) : NULL;
+        if (triangles != NULL)
         {
-            triangulator.GetNextTriangle(triangle);
-            _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx + triangle[0]); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + triangle[1]); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + triangle[2]);
-            _IdxWritePtr += 3;
+            for (int i = 0; i < idx_count; i++)
+                _IdxWritePtr[i] = (ImDrawIdx)(_VtxCurrentIdx + triangles[i]);
+            _IdxWritePtr += idx_count;
+        }
+        else
+        {
+            _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
+            triangulator.Init(points, points_count, _Data->TempBuffer.Data);
+            while (triangulator._TrianglesLeft > 0)
+            {
+                triangulator.GetNextTriangle(triangle);
+                _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx + triangle[0]); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + triangle[1]); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + triangle[2]);
+                _IdxWritePtr += 3;
+            }
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
@@ -2185,7 +3673,7 @@ void ImDrawListSplitter::Merge(ImDrawList* draw_list)
     // If current command is used with different settings we need to add a new command
     ImDrawCmd* curr_cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
     if (curr_cmd->ElemCount == 0)
-        ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TextureId, VtxOffset
+        ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TextureId, VtxOffset, SDF parameters
     else if (ImDrawCmd_HeaderCompare(curr_cmd, &draw_list->_CmdHeader) != 0)
         draw_list->AddDrawCmd();
 
@@ -2211,7 +3699,7 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
     if (curr_cmd == NULL)
         draw_list->AddDrawCmd();
     else if (curr_cmd->ElemCount == 0)
-        ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TextureId, VtxOffset
+        ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TextureId, VtxOffset, SDF parameters
     else if (ImDrawCmd_HeaderCompare(curr_cmd, &draw_list->_CmdHeader) != 0)
         draw_list->AddDrawCmd();
 }
@@ -2227,6 +3715,7 @@ void ImDrawData::Clear()
     CmdLists.resize(0); // The ImDrawList are NOT owned by ImDrawData but e.g. by ImGuiContext, so we don't clear them.
     DisplayPos = DisplaySize = FramebufferScale = ImVec2(0.0f, 0.0f);
     OwnerViewport = NULL;
+    DamageRects.resize(0);
 }
 
 // Important: 'out_list' is generally going to be draw_data->CmdLists, but may be another temporary list
@@ -2310,6 +3799,8 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
     for (ImDrawList* draw_list : CmdLists)
         for (ImDrawCmd& cmd : draw_list->CmdBuffer)
             cmd.ClipRect = ImVec4(cmd.ClipRect.x * fb_scale.x, cmd.ClipRect.y * fb_scale.y, cmd.ClipRect.z * fb_scale.x, cmd.ClipRect.w * fb_scale.y);
+    for (ImVec4& rect : DamageRects)
+        rect = ImVec4(rect.x * fb_scale.x, rect.y * fb_scale.y, rect.z * fb_scale.x, rect.w * fb_scale.y);
 }
 
 //-----------------------------------------------------------------------------
@@ -2410,10 +3901,18 @@ ImFontConfig::ImFontConfig()
 // - ImFontAtlas::CalcCustomRectUV()
 // - ImFontAtlas::GetMouseCursorTexData()
 // - ImFontAtlas::Build()
+// - ImFontAtlasBuildGetInputHash()
+// - ImFontAtlas::SaveToMemory()
+// - ImFontAtlas::LoadFromMemory()
 // - ImFontAtlasBuildMultiplyCalcLookupTable()
 // - ImFontAtlasBuildMultiplyRectAlpha8()
+// - ImFontAtlasBuildRenderGlyphsJob()
 // - ImFontAtlasBuildWithStbTruetype()
 // - ImFontAtlasGetBuilderForStbTruetype()
+// - ImFontAtlasBuildSetupDynamicGlyphs()
+// - ImFontAtlasAddDynamicGlyph()
+// - ImFontAtlasUpdateDynamicGlyphs()
+// - ImFontAtlasDestroyDynamicGlyphs()
 // - ImFontAtlasUpdateConfigDataPointers()
 // - ImFontAtlasBuildSetupFont()
 // - ImFontAtlasBuildPackCustomRects()
@@ -2479,6 +3978,7 @@ ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
     TexGlyphPadding = 1;
+    DynamicGlyphsTexHeight = 512;
     PackIdMouseCursors = PackIdLines = -1;
 }
 
@@ -2491,6 +3991,7 @@ ImFontAtlas::~ImFontAtlas()
 void    ImFontAtlas::ClearInputData()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasDestroyDynamicGlyphs(this); // Glyphs can't be rasterized on demand without the font data
     for (ImFontConfig& font_cfg : ConfigData)
         if (font_cfg.FontData && font_cfg.FontDataOwnedByAtlas)
         {
@@ -2527,8 +4028,10 @@ void    ImFontAtlas::ClearTexData()
 void    ImFontAtlas::ClearFonts()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasDestroyDynamicGlyphs(this);
     Fonts.clear_delete();
     TexReady = false;
+    GlyphsVersion++;
 }
 
 void    ImFontAtlas::Clear()
@@ -2804,8 +4307,284 @@ bool    ImFontAtlas::Build()
 #endif
     }
 
-    // Build
-    return builder_io->FontBuilder_Build(this);
+    // Build
+    return builder_io->FontBuilder_Build(this);
+}
+
+// SaveToMemory() blob: this header, then atlas and per-font sections in the order written by SaveToMemory(), in native endianness.
+#define FONT_ATLAS_CACHE_MAGIC      0x41464D49  // "IMFA"
+#define FONT_ATLAS_CACHE_VERSION    3           // Increment when changing the layout of the blob
+
+struct ImFontAtlasCacheHeader
+{
+    ImU32       Magic;              // FONT_ATLAS_CACHE_MAGIC
+    ImU32       Version;            // FONT_ATLAS_CACHE_VERSION
+    ImU32       ImGuiVersion;       // IMGUI_VERSION_NUM
+    ImU32       SizeofImWchar;      // Glyphs and lookup tables are stored as raw arrays
+    ImU32       SizeofGlyph;
+    ImGuiID     InputHash;          // ImFontAtlasBuildGetInputHash() at the time of saving
+    ImU32       DataSize;           // Whole blob, header included
+};
+
+static void ImFontAtlasCacheWrite(ImVector<unsigned char>* buf, const void* data, size_t size)
+{
+    if (size == 0)
+        return;
+    const int pos = buf->Size;
+    buf->resize(pos + (int)size);
+    memcpy(buf->Data + pos, data, size);
+}
+
+template<typename T>
+static void ImFontAtlasCacheWriteVector(ImVector<unsigned char>* buf, const ImVector<T>& v)
+{
+    ImFontAtlasCacheWrite(buf, &v.Size, sizeof(v.Size));
+    ImFontAtlasCacheWrite(buf, v.Data, (size_t)v.size_in_bytes());
+}
+
+struct ImFontAtlasCacheReader
+{
+    const unsigned char*    Data;
+    const unsigned char*    DataEnd;
+
+    bool Read(void* dst, size_t size)
+    {
+        if ((size_t)(DataEnd - Data) < size)
+            return false;
+        memcpy(dst, Data, size);
+        Data += size;
+        return true;
+    }
+    template<typename T>
+    bool ReadVector(ImVector<T>* v)
+    {
+        int size;
+        if (!Read(&size, sizeof(size)) || size < 0 || (size_t)(DataEnd - Data) / sizeof(T) < (size_t)size)
+            return false;
+        v->resize(size);
+        return size == 0 || Read(v->Data, (size_t)size * sizeof(T));
+    }
+};
+
+// Hash of every input Build() depends on. Also covers the font builder, when it isn't the default one only by whether it was set.
+ImGuiID ImFontAtlasBuildGetInputHash(ImFontAtlas* atlas)
+{
+#ifdef IMGUI_ENABLE_FREETYPE
+    const int builder_id = atlas->FontBuilderIO ? 2 : 1;
+#else
+    const int builder_id = atlas->FontBuilderIO ? 2 : 0;
+#endif
+    const int atlas_params[] = { builder_id, (int)atlas->Flags, atlas->TexDesiredWidth, atlas->TexGlyphPadding, (int)atlas->FontBuilderFlags, atlas->Fonts.Size, atlas->ConfigData.Size };
+    ImGuiID hash = ImHashData(atlas_params, sizeof(atlas_params));
+    for (const ImFontConfig& cfg : atlas->ConfigData)
+    {
+        const int int_params[] = { cfg.FontDataSize, cfg.FontNo, cfg.OversampleH, cfg.OversampleV, cfg.PixelSnapH, cfg.MergeMode, (int)cfg.FontBuilderFlags, (int)cfg.EllipsisChar, cfg.SdfPadding, atlas->Fonts.find_index(cfg.DstFont) };
+        const float float_params[] = { cfg.SizePixels, cfg.GlyphExtraSpacing.x, cfg.GlyphExtraSpacing.y, cfg.GlyphOffset.x, cfg.GlyphOffset.y, cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX, cfg.RasterizerMultiply, cfg.RasterizerDensity };
+        hash = ImHashData(int_params, sizeof(int_params), hash);
+        hash = ImHashData(float_params, sizeof(float_params), hash);
+        int ranges_count = 0;
+        for (const ImWchar* range = cfg.GlyphRanges; range != NULL && range[0] != 0; range += 2)
+            ranges_count += 2;
+        hash = ImHashData(&ranges_count, sizeof(ranges_count), hash);
+        if (ranges_count > 0)
+            hash = ImHashData(cfg.GlyphRanges, ranges_count * sizeof(ImWchar), hash);
+        const ImU64 font_data_hash = ImHashData64(cfg.FontData, (size_t)cfg.FontDataSize);
+        hash = ImHashData(&font_data_hash, sizeof(font_data_hash), hash);
+    }
+
+    // User rectangles, along with their index as returned to the user. The default ones are registered by the builder.
+    for (int rect_n = 0; rect_n < atlas->CustomRects.Size; rect_n++)
+    {
+        if (rect_n == atlas->PackIdMouseCursors || rect_n == atlas->PackIdLines)
+            continue;
+        const ImFontAtlasCustomRect& r = atlas->CustomRects[rect_n];
+        const int rect_params[] = { rect_n, r.Width, r.Height, (int)r.GlyphID, (int)r.GlyphColored, r.Font ? atlas->Fonts.find_index(r.Font) : -1 };
+        const float rect_float_params[] = { r.GlyphAdvanceX, r.GlyphOffset.x, r.GlyphOffset.y };
+        hash = ImHashData(rect_params, sizeof(rect_params), hash);
+        hash = ImHashData(rect_float_params, sizeof(rect_float_params), hash);
+    }
+    return hash;
+}
+
+// Custom rectangles are written whole: the default ones don't exist before the atlas is built.
+// FIXME: Doesn't support ImFontAtlasFlags_DynamicGlyphs, whose texture area and glyphs change after Build().
+bool    ImFontAtlas::SaveToMemory(ImVector<unsigned char>* out_data)
+{
+    if (Flags & ImFontAtlasFlags_DynamicGlyphs)
+        return false;
+    if (!TexReady || (TexPixelsAlpha8 == NULL && TexPixelsRGBA32 == NULL))
+        if (!Build())
+            return false;
+
+    ImFontAtlasCacheHeader header;
+    header.Magic = FONT_ATLAS_CACHE_MAGIC;
+    header.Version = FONT_ATLAS_CACHE_VERSION;
+    header.ImGuiVersion = IMGUI_VERSION_NUM;
+    header.SizeofImWchar = sizeof(ImWchar);
+    header.SizeofGlyph = sizeof(ImFontGlyph);
+    header.InputHash = ImFontAtlasBuildGetInputHash(this);
+    header.DataSize = 0;
+    out_data->resize(0);
+    ImFontAtlasCacheWrite(out_data, &header, sizeof(header));
+
+    // Atlas: texture (Alpha8 when available, the RGBA32 one can be converted from it), UVs and custom rectangles
+    const int bytes_per_pixel = TexPixelsAlpha8 ? 1 : 4;
+    const int tex_params[] = { TexWidth, TexHeight, bytes_per_pixel, TexPixelsUseColors, PackIdMouseCursors, PackIdLines, CustomRects.Size, Fonts.Size };
+    ImFontAtlasCacheWrite(out_data, tex_params, sizeof(tex_params));
+    ImFontAtlasCacheWrite(out_data, &TexUvScale, sizeof(TexUvScale));
+    ImFontAtlasCacheWrite(out_data, &TexUvWhitePixel, sizeof(TexUvWhitePixel));
+    ImFontAtlasCacheWrite(out_data, TexUvLines, sizeof(TexUvLines));
+    for (const ImFontAtlasCustomRect& r : CustomRects)
+    {
+        const int rect_params[] = { r.X, r.Y, r.Width, r.Height, (int)r.GlyphID, (int)r.GlyphColored, r.Font ? Fonts.find_index(r.Font) : -1 };
+        const float rect_float_params[] = { r.GlyphAdvanceX, r.GlyphOffset.x, r.GlyphOffset.y };
+        ImFontAtlasCacheWrite(out_data, rect_params, sizeof(rect_params));
+        ImFontAtlasCacheWrite(out_data, rect_float_params, sizeof(rect_float_params));
+    }
+    ImFontAtlasCacheWrite(out_data, TexPixelsAlpha8 ? (const void*)TexPixelsAlpha8 : (const void*)TexPixelsRGBA32, (size_t)TexWidth * TexHeight * bytes_per_pixel);
+
+    // Fonts: metrics, glyphs and lookup tables, as left by BuildLookupTable()
+    for (ImFont* font : Fonts)
+    {
+        const int font_params[] = { font->FallbackGlyph ? (int)(font->FallbackGlyph - font->Glyphs.Data) : -1, (int)font->FallbackChar, (int)font->EllipsisChar, font->EllipsisCharCount, font->MetricsTotalSurface };
+        const float font_float_params[] = { font->FontSize, font->Ascent, font->Descent, font->FallbackAdvanceX, font->EllipsisWidth, font->EllipsisCharStep, font->SdfThreshold, font->SdfAlphaPerTexel };
+        ImFontAtlasCacheWrite(out_data, font_params, sizeof(font_params));
+        ImFontAtlasCacheWrite(out_data, font_float_params, sizeof(font_float_params));
+        ImFontAtlasCacheWrite(out_data, font->Used4kPagesMap, sizeof(font->Used4kPagesMap));
+        ImFontAtlasCacheWriteVector(out_data, font->Glyphs);
+        ImFontAtlasCacheWriteVector(out_data, font->IndexPages);
+        ImFontAtlasCacheWriteVector(out_data, font->IndexAdvanceX);
+        ImFontAtlasCacheWriteVector(out_data, font->IndexLookup);
+    }
+
+    ((ImFontAtlasCacheHeader*)(void*)out_data->Data)->DataSize = (ImU32)out_data->Size;
+    return true;
+}
+
+// The blob is trusted as far as its header and key match: sizes and indices are only checked so that a truncated or corrupted one can't be read out of bounds.
+bool    ImFontAtlas::LoadFromMemory(const void* data, size_t data_size)
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    if (Flags & ImFontAtlasFlags_DynamicGlyphs)
+        return false;
+
+    // Same default font as Build()
+    if (ConfigData.Size == 0)
+        AddFontDefault();
+
+    ImFontAtlasCacheReader reader = { (const unsigned char*)data, (const unsigned char*)data + data_size };
+    ImFontAtlasCacheHeader header;
+    if (data == NULL || !reader.Read(&header, sizeof(header)))
+        return false;
+    if (header.Magic != FONT_ATLAS_CACHE_MAGIC || header.Version != FONT_ATLAS_CACHE_VERSION || header.ImGuiVersion != IMGUI_VERSION_NUM || header.SizeofImWchar != sizeof(ImWchar) || header.SizeofGlyph != sizeof(ImFontGlyph) || header.DataSize != data_size)
+        return false;
+    if (header.InputHash != ImFontAtlasBuildGetInputHash(this))
+        return false;
+
+    int tex_params[8];
+    if (!reader.Read(tex_params, sizeof(tex_params)))
+        return false;
+    const int tex_width = tex_params[0], tex_height = tex_params[1], bytes_per_pixel = tex_params[2], custom_rects_count = tex_params[6], fonts_count = tex_params[7];
+    if (tex_width <= 0 || tex_height <= 0 || (bytes_per_pixel != 1 && bytes_per_pixel != 4) || custom_rects_count < 0 || fonts_count != Fonts.Size)
+        return false;
+
+    // Past this point, a failure leaves the atlas as if it had never been built
+    ImVector<ImFontAtlasCustomRect> custom_rects_backup;
+    custom_rects_backup.swap(CustomRects);
+    const int pack_id_mouse_cursors_backup = PackIdMouseCursors, pack_id_lines_backup = PackIdLines;
+    ClearTexData();
+    ImFontAtlasDestroyDynamicGlyphs(this);
+    TexDirtyRects.clear();
+    TexReady = false;
+    GlyphsVersion++;
+    TexWidth = tex_width;
+    TexHeight = tex_height;
+    TexPixelsUseColors = tex_params[3] != 0;
+    PackIdMouseCursors = tex_params[4];
+    PackIdLines = tex_params[5];
+    bool ok = reader.Read(&TexUvScale, sizeof(TexUvScale)) && reader.Read(&TexUvWhitePixel, sizeof(TexUvWhitePixel)) && reader.Read(TexUvLines, sizeof(TexUvLines));
+    ok = ok && PackIdMouseCursors >= 0 && PackIdMouseCursors < custom_rects_count && PackIdLines >= -1 && PackIdLines < custom_rects_count;
+    if (ok)
+        CustomRects.resize(custom_rects_count);
+    for (int rect_n = 0; rect_n < custom_rects_count && ok; rect_n++)
+    {
+        int rect_params[7];
+        float rect_float_params[3];
+        ok = reader.Read(rect_params, sizeof(rect_params)) && reader.Read(rect_float_params, sizeof(rect_float_params)) && rect_params[6] >= -1 && rect_params[6] < Fonts.Size;
+        if (!ok)
+            break;
+        ImFontAtlasCustomRect& r = CustomRects[rect_n];
+        r.X = (unsigned short)rect_params[0];
+        r.Y = (unsigned short)rect_params[1];
+        r.Width = (unsigned short)rect_params[2];
+        r.Height = (unsigned short)rect_params[3];
+        r.GlyphID = (unsigned int)rect_params[4];
+        r.GlyphColored = (unsigned int)rect_params[5];
+        r.Font = rect_params[6] >= 0 ? Fonts[rect_params[6]] : NULL;
+        r.GlyphAdvanceX = rect_float_params[0];
+        r.GlyphOffset = ImVec2(rect_float_params[1], rect_float_params[2]);
+    }
+    const size_t tex_size = (size_t)tex_width * tex_height * bytes_per_pixel;
+    ok = ok && (size_t)(reader.DataEnd - reader.Data) >= tex_size;
+    if (ok)
+    {
+        void* pixels = IM_ALLOC(tex_size);
+        reader.Read(pixels, tex_size);
+        if (bytes_per_pixel == 1)
+            TexPixelsAlpha8 = (unsigned char*)pixels;
+        else
+            TexPixelsRGBA32 = (unsigned int*)pixels;
+    }
+
+    for (int font_n = 0; font_n < Fonts.Size && ok; font_n++)
+    {
+        ImFont* font = Fonts[font_n];
+        font->ClearOutputData();
+        int font_params[5];
+        float font_float_params[8];
+        ok = reader.Read(font_params, sizeof(font_params)) && reader.Read(font_float_params, sizeof(font_float_params)) && reader.Read(font->Used4kPagesMap, sizeof(font->Used4kPagesMap));
+        ok = ok && reader.ReadVector(&font->Glyphs) && reader.ReadVector(&font->IndexPages) && reader.ReadVector(&font->IndexAdvanceX) && reader.ReadVector(&font->IndexLookup);
+        ok = ok && font_params[0] >= 0 && font_params[0] < font->Glyphs.Size && font->IndexPages.Size > 0 && font->IndexAdvanceX.Size == font->IndexLookup.Size;
+        ok = ok && font->IndexLookup.Size >= IM_FONT_INDEX_PAGE_SIZE * 2 && (font->IndexLookup.Size % IM_FONT_INDEX_PAGE_SIZE) == 0;
+        ok = ok && font->IndexPages[0] == 0; // Block 0 is page 0 (read directly by GetCharAdvance()), page 1 is the shared empty page other blocks start from
+        for (int n = 1; n < font->IndexPages.Size && ok; n++)
+            ok = font->IndexPages[n] != 0 && (((int)font->IndexPages[n] + 1) << IM_FONT_INDEX_PAGE_SHIFT) <= font->IndexLookup.Size;
+        for (int n = IM_FONT_INDEX_PAGE_SIZE; n < IM_FONT_INDEX_PAGE_SIZE * 2 && ok; n++)
+            ok = font->IndexLookup[n] == (ImWchar)-1;
+        for (int n = 0; n < font->IndexLookup.Size && ok; n++)
+            ok = (font->IndexLookup[n] == (ImWchar)-1 || (unsigned int)font->IndexLookup[n] < (unsigned int)font->Glyphs.Size);
+        if (!ok)
+            break;
+        font->ContainerAtlas = this;
+        font->FallbackGlyph = &font->Glyphs[font_params[0]];
+        font->FallbackChar = (ImWchar)font_params[1];
+        font->EllipsisChar = (ImWchar)font_params[2];
+        font->EllipsisCharCount = (short)font_params[3];
+        font->MetricsTotalSurface = font_params[4];
+        font->FontSize = font_float_params[0];
+        font->Ascent = font_float_params[1];
+        font->Descent = font_float_params[2];
+        font->FallbackAdvanceX = font_float_params[3];
+        font->EllipsisWidth = font_float_params[4];
+        font->EllipsisCharStep = font_float_params[5];
+        font->SdfThreshold = font_float_params[6];
+        font->SdfAlphaPerTexel = font_float_params[7];
+        font->DirtyLookupTables = false;
+    }
+    ok = ok && reader.Data == reader.DataEnd;
+
+    if (!ok)
+    {
+        ClearTexData();
+        for (ImFont* font : Fonts)
+            font->ClearOutputData();
+        CustomRects.swap(custom_rects_backup);
+        PackIdMouseCursors = pack_id_mouse_cursors_backup;
+        PackIdLines = pack_id_lines_backup;
+        return false;
+    }
+    TexReady = true;
+    return true;
 }
 
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
@@ -2826,6 +4605,11 @@ void    ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsig
             *data = table[*data];
 }
 
+// Signed distance field glyphs (ImFontConfig::SdfPadding > 0): the outline has alpha FONT_ATLAS_SDF_ONEDGE_VALUE, which goes up inside
+// the glyph and down outside by FONT_ATLAS_SDF_ALPHA_RANGE over SdfPadding texels.
+#define FONT_ATLAS_SDF_ONEDGE_VALUE     128
+#define FONT_ATLAS_SDF_ALPHA_RANGE      127.0f
+
 #ifdef IMGUI_ENABLE_STB_TRUETYPE
 // Temporary data for one source font (multiple source fonts can be merged into one destination ImFont)
 // (C++03 doesn't allow instancing ImVector<> with function-local types so we declare the type here.)
@@ -2852,6 +4636,109 @@ struct ImFontBuildDstData
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// A batch of consecutive glyphs of one source font, rendered by one job (see ImFontAtlas::BuildParallelFor)
+struct ImFontBuildRenderJob
+{
+    int                 SrcIndex;
+    int                 GlyphsStart;
+    int                 GlyphsCount;
+};
+
+struct ImFontBuildRenderJobsData
+{
+    ImFontAtlas*                Atlas;
+    const stbtt_pack_context*   PackContext;
+    ImFontBuildSrcData*         SrcTmpArray;
+    const ImFontBuildRenderJob* Jobs;
+};
+
+// Every glyph is rendered into its own packed rectangle, so jobs never touch the same pixels or output data.
+static void ImFontAtlasBuildRenderGlyphsJob(void* job_data, int job_index)
+{
+    ImFontBuildRenderJobsData* data = (ImFontBuildRenderJobsData*)job_data;
+    const ImFontBuildRenderJob& job = data->Jobs[job_index];
+    ImFontConfig& cfg = data->Atlas->ConfigData[job.SrcIndex];
+    ImFontBuildSrcData& src_tmp = data->SrcTmpArray[job.SrcIndex];
+
+    // Signed distance fields: stbtt_GetGlyphSDF() allocates each glyph, which is copied into its rectangle. Output the same data as stbtt_PackFontRangesRenderIntoRects().
+    if (cfg.SdfPadding > 0)
+    {
+        ImFontAtlas* atlas = data->Atlas;
+        const float scale = (cfg.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels * cfg.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels * cfg.RasterizerDensity);
+        const float pixel_dist_scale = FONT_ATLAS_SDF_ALPHA_RANGE / cfg.SdfPadding;
+        for (int glyph_i = job.GlyphsStart; glyph_i < job.GlyphsStart + job.GlyphsCount; glyph_i++)
+        {
+            const stbrp_rect& r = src_tmp.Rects[glyph_i];
+            if (!r.was_packed)
+                continue;
+            const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
+            int advance, lsb, w = 0, h = 0, xoff = 0, yoff = 0;
+            stbtt_GetGlyphHMetrics(&src_tmp.FontInfo, glyph_index_in_font, &advance, &lsb);
+            if (unsigned char* sdf = stbtt_GetGlyphSDF(&src_tmp.FontInfo, scale, glyph_index_in_font, cfg.SdfPadding, FONT_ATLAS_SDF_ONEDGE_VALUE, pixel_dist_scale, &w, &h, &xoff, &yoff))
+            {
+                for (int y = 0; y < h; y++)
+                    memcpy(atlas->TexPixelsAlpha8 + r.x + (r.y + y) * atlas->TexWidth, sdf + y * w, (size_t)w);
+                stbtt_FreeSDF(sdf, NULL);
+            }
+            stbtt_packedchar& pc = src_tmp.PackedChars[glyph_i];
+            pc.x0 = (unsigned short)r.x;
+            pc.y0 = (unsigned short)r.y;
+            pc.x1 = (unsigned short)(r.x + w);
+            pc.y1 = (unsigned short)(r.y + h);
+            pc.xoff = (float)xoff;
+            pc.yoff = (float)yoff;
+            pc.xoff2 = (float)(xoff + w);
+            pc.yoff2 = (float)(yoff + h);
+            pc.xadvance = scale * advance;
+        }
+        return;
+    }
+
+    // stbtt_PackFontRangesRenderIntoRects() writes the oversampling factors into the pack context, so each job uses its own copy.
+    stbtt_pack_context spc = *data->PackContext;
+    stbtt_pack_range pack_range = src_tmp.PackRange;
+    pack_range.array_of_unicode_codepoints += job.GlyphsStart;
+    pack_range.chardata_for_range += job.GlyphsStart;
+    pack_range.num_chars = job.GlyphsCount;
+    stbrp_rect* rects = &src_tmp.Rects[job.GlyphsStart];
+    stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &pack_range, 1, rects);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = rects;
+        for (int glyph_i = 0; glyph_i < job.GlyphsCount; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, data->Atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, data->Atlas->TexWidth * 1);
+    }
+}
+
+// Glyphs rasterized on demand (ImFontAtlasFlags_DynamicGlyphs): the area below the packed glyphs is split in rows spanning the
+// texture width, allocated to fonts on demand. Each font splits its rows in cells sized to its bounding box, one glyph per cell.
+// Cell n of a font holds Glyphs[DynamicGlyphsStart + n] and is at ((n % CellsPerRow) * CellWidth, RowsY[n / CellsPerRow]).
+struct ImFontDynamicGlyphsFontData
+{
+    int                 CellWidth, CellHeight;
+    int                 CellsPerRow;
+    ImVector<int>       RowsY;
+};
+
+struct ImFontAtlasDynamicGlyphs
+{
+    ImVector<stbtt_fontinfo>    SrcFontInfo;        // Parsed atlas->ConfigData[] (the font data is owned by the atlas)
+    ImVector<ImFontDynamicGlyphsFontData> FontData; // Indexed like atlas->Fonts[]
+    int                         AreaY;              // Top of the dynamic area, which ends at TexHeight
+    int                         NextRowY;
+    int                         GlyphsAdded;        // Statistics
+    int                         GlyphsEvicted;
+    ImFontAtlasDynamicGlyphs()  { AreaY = NextRowY = GlyphsAdded = GlyphsEvicted = 0; }
+    ~ImFontAtlasDynamicGlyphs() { FontData.clear_destruct(); }
+};
+
+static void ImFontAtlasBuildSetupDynamicGlyphs(ImFontAtlas* atlas);
+
 static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>* out)
 {
     IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
@@ -2891,6 +4778,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
         ImFontConfig& cfg = atlas->ConfigData[src_i];
         IM_ASSERT(cfg.DstFont && (!cfg.DstFont->IsLoaded() || cfg.DstFont->ContainerAtlas == atlas));
+        IM_ASSERT((cfg.SdfPadding == 0 || !(atlas->Flags & ImFontAtlasFlags_DynamicGlyphs)) && "ImFontConfig::SdfPadding is not supported with ImFontAtlasFlags_DynamicGlyphs.");
 
         // Find index from cfg.DstFont (we allow the user to set cfg.DstFont. Also it makes casual debugging nicer than when storing indices)
         src_tmp.DstIndex = -1;
@@ -2998,8 +4886,11 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         src_tmp.PackRange.array_of_unicode_codepoints = src_tmp.GlyphsList.Data;
         src_tmp.PackRange.num_chars = src_tmp.GlyphsList.Size;
         src_tmp.PackRange.chardata_for_range = src_tmp.PackedChars;
-        src_tmp.PackRange.h_oversample = (unsigned char)cfg.OversampleH;
-        src_tmp.PackRange.v_oversample = (unsigned char)cfg.OversampleV;
+        // Signed distance fields are scaled by the renderer instead of oversampled, and have SdfPadding texels of distance around non-empty glyphs.
+        const int oversample_h = (cfg.SdfPadding > 0) ? 1 : cfg.OversampleH;
+        const int oversample_v = (cfg.SdfPadding > 0) ? 1 : cfg.OversampleV;
+        src_tmp.PackRange.h_oversample = (unsigned char)oversample_h;
+        src_tmp.PackRange.v_oversample = (unsigned char)oversample_v;
 
         // Gather the sizes of all rectangles we will need to pack (this loop is based on stbtt_PackFontRangesGatherRects)
         const float scale = (cfg.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels * cfg.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels * cfg.RasterizerDensity);
@@ -3008,9 +4899,10 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
             int x0, y0, x1, y1;
             const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
             IM_ASSERT(glyph_index_in_font != 0);
-            stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + pack_padding + cfg.OversampleH - 1);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + pack_padding + cfg.OversampleV - 1);
+            stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * oversample_h, scale * oversample_v, 0, 0, &x0, &y0, &x1, &y1);
+            const int sdf_padding = (cfg.SdfPadding > 0 && x0 != x1 && y0 != y1) ? cfg.SdfPadding * 2 : 0;
+            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + sdf_padding + pack_padding + oversample_h - 1);
+            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + sdf_padding + pack_padding + oversample_v - 1);
             total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
         }
     }
@@ -3051,7 +4943,10 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
                 atlas->TexHeight = ImMax(atlas->TexHeight, src_tmp.Rects[glyph_i].y + src_tmp.Rects[glyph_i].h);
     }
 
-    // 7. Allocate texture
+    // 7. Allocate texture (with room below the packed glyphs for glyphs rasterized on demand)
+    const int dynamic_glyphs_area_y = atlas->TexHeight;
+    if (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs)
+        atlas->TexHeight += ImMax(atlas->DynamicGlyphsTexHeight, 0);
     atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
     atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
@@ -3060,27 +4955,30 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    // Glyphs are split in small batches which may be rendered concurrently with atlas->BuildParallelFor.
+    const int GLYPHS_PER_JOB = 64;
+    ImVector<ImFontBuildRenderJob> render_jobs;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+        for (int glyph_i = 0; glyph_i < src_tmp_array[src_i].GlyphsCount; glyph_i += GLYPHS_PER_JOB)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            ImFontBuildRenderJob job;
+            job.SrcIndex = src_i;
+            job.GlyphsStart = glyph_i;
+            job.GlyphsCount = ImMin(GLYPHS_PER_JOB, src_tmp_array[src_i].GlyphsCount - glyph_i);
+            render_jobs.push_back(job);
         }
-        src_tmp.Rects = NULL;
-    }
+    ImFontBuildRenderJobsData render_jobs_data;
+    render_jobs_data.Atlas = atlas;
+    render_jobs_data.PackContext = &spc;
+    render_jobs_data.SrcTmpArray = src_tmp_array.Data;
+    render_jobs_data.Jobs = render_jobs.Data;
+    if (atlas->BuildParallelFor != NULL && render_jobs.Size > 1)
+        atlas->BuildParallelFor(ImFontAtlasBuildRenderGlyphsJob, &render_jobs_data, render_jobs.Size, atlas->BuildParallelForUserData);
+    else
+        for (int job_i = 0; job_i < render_jobs.Size; job_i++)
+            ImFontAtlasBuildRenderGlyphsJob(&render_jobs_data, job_i);
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        src_tmp_array[src_i].Rects = NULL;
 
     // End packing
     stbtt_PackEnd(&spc);
@@ -3124,10 +5022,23 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         }
     }
 
+    // Keep source fonts around to rasterize glyphs on demand
+    if (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs)
+    {
+        ImFontAtlasDynamicGlyphs* dyn = IM_NEW(ImFontAtlasDynamicGlyphs)();
+        dyn->SrcFontInfo.resize(src_tmp_array.Size);
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+            dyn->SrcFontInfo[src_i] = src_tmp_array[src_i].FontInfo;
+        dyn->AreaY = dyn->NextRowY = dynamic_glyphs_area_y;
+        atlas->DynamicGlyphs = dyn;
+    }
+
     // Cleanup
     src_tmp_array.clear_destruct();
 
     ImFontAtlasBuildFinish(atlas);
+    if (atlas->DynamicGlyphs)
+        ImFontAtlasBuildSetupDynamicGlyphs(atlas);
     return true;
 }
 
@@ -3138,8 +5049,223 @@ const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
     return &io;
 }
 
+static float ImFontAtlasBuildGetSourceScale(const stbtt_fontinfo* font_info, const ImFontConfig& cfg)
+{
+    return (cfg.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(font_info, cfg.SizePixels * cfg.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(font_info, -cfg.SizePixels * cfg.RasterizerDensity);
+}
+
+// Size cells to hold any glyph of the sources of each font, using the same rectangle size as packed glyphs
+static void ImFontAtlasBuildSetupDynamicGlyphs(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamicGlyphs* dyn = atlas->DynamicGlyphs;
+    dyn->FontData.resize(atlas->Fonts.Size);
+    memset(dyn->FontData.Data, 0, (size_t)dyn->FontData.size_in_bytes());
+    const int pad = atlas->TexGlyphPadding;
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+    {
+        ImFont* font = atlas->Fonts[font_n];
+        ImFontDynamicGlyphsFontData& font_data = dyn->FontData[font_n];
+        for (int src_i = 0; src_i < atlas->ConfigData.Size; src_i++)
+        {
+            const ImFontConfig& cfg = atlas->ConfigData[src_i];
+            if (cfg.DstFont != font)
+                continue;
+            const stbtt_fontinfo* font_info = &dyn->SrcFontInfo[src_i];
+            const float scale = ImFontAtlasBuildGetSourceScale(font_info, cfg);
+            const float scale_x = scale * cfg.OversampleH, scale_y = scale * cfg.OversampleV;
+            int x0, y0, x1, y1;
+            stbtt_GetFontBoundingBox(font_info, &x0, &y0, &x1, &y1);
+            font_data.CellWidth = ImMax(font_data.CellWidth, (int)ImCeil(x1 * scale_x) - (int)ImFloor(x0 * scale_x) + pad + cfg.OversampleH - 1);
+            font_data.CellHeight = ImMax(font_data.CellHeight, (int)ImCeil(-y0 * scale_y) - (int)ImFloor(-y1 * scale_y) + pad + cfg.OversampleV - 1);
+        }
+        if (font_data.CellWidth <= 0 || font_data.CellHeight <= 0)
+            continue;
+        font_data.CellWidth = ImMin(font_data.CellWidth, atlas->TexWidth);
+        font_data.CellsPerRow = atlas->TexWidth / font_data.CellWidth;
+        font->DynamicGlyphsStart = font->Glyphs.Size;
+    }
+}
+
+// Returns false when there is no room for the glyph this frame: every cell is used by glyphs which were found during the previous frame.
+static bool ImFontAtlasAddDynamicGlyph(ImFontAtlas* atlas, int font_n, ImWchar codepoint)
+{
+    ImFontAtlasDynamicGlyphs* dyn = atlas->DynamicGlyphs;
+    ImFontDynamicGlyphsFontData& font_data = dyn->FontData[font_n];
+    ImFont* font = atlas->Fonts[font_n];
+
+    // Find the first source with this glyph. Codepoints no source has stay marked in DynamicGlyphsQueued, so they won't be queued again.
+    int src_i = 0;
+    int glyph_index_in_font = 0;
+    for (; src_i < atlas->ConfigData.Size; src_i++)
+        if (atlas->ConfigData[src_i].DstFont == font)
+            if ((glyph_index_in_font = stbtt_FindGlyphIndex(&dyn->SrcFontInfo[src_i], codepoint)) != 0)
+                break;
+    if (glyph_index_in_font == 0)
+        return true;
+    ImFontConfig& cfg = atlas->ConfigData[src_i];
+    stbtt_fontinfo* font_info = &dyn->SrcFontInfo[src_i];
+    const float scale = ImFontAtlasBuildGetSourceScale(font_info, cfg);
+    const int pad = atlas->TexGlyphPadding;
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBoxSubpixel(font_info, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+    const int rect_w = x1 - x0 + pad + cfg.OversampleH - 1;
+    const int rect_h = y1 - y0 + pad + cfg.OversampleV - 1;
+    if (rect_w > font_data.CellWidth || rect_h > font_data.CellHeight)
+        return true;
+
+    // Take the next cell, a new row, or the least recently used glyph of this font
+    const int cells_used = font->Glyphs.Size - font->DynamicGlyphsStart;
+    int cell_n = cells_used;
+    if (cell_n >= font_data.RowsY.Size * font_data.CellsPerRow || font->Glyphs.Size >= 0xFFFE)
+    {
+        if (font->Glyphs.Size < 0xFFFE && dyn->NextRowY + font_data.CellHeight <= atlas->TexHeight)
+        {
+            font_data.RowsY.push_back(dyn->NextRowY);
+            dyn->NextRowY += font_data.CellHeight;
+        }
+        else
+        {
+            cell_n = -1;
+            int oldest_frame = atlas->DynamicGlyphsFrame - 1;
+            for (int n = 0; n < font->DynamicGlyphsLastUse.Size; n++)
+                if (font->DynamicGlyphsLastUse[n] < oldest_frame)
+                {
+                    oldest_frame = font->DynamicGlyphsLastUse[n];
+                    cell_n = n;
+                }
+            if (cell_n == -1)
+                return false;
+
+            // Evict: the codepoint will be queued again if it is used
+            const unsigned int old_codepoint = font->Glyphs[font->DynamicGlyphsStart + cell_n].Codepoint;
+            const int old_slot = font->GetIndexSlot((ImWchar)old_codepoint);
+            font->IndexLookup[old_slot] = (ImWchar)-1;
+            font->IndexAdvanceX[old_slot] = font->FallbackAdvanceX;
+            font->DynamicGlyphsQueued[old_codepoint >> 5] &= ~((ImU32)1 << (old_codepoint & 31));
+            dyn->GlyphsEvicted++;
+        }
+    }
+    const int cell_x = (cell_n % font_data.CellsPerRow) * font_data.CellWidth;
+    const int cell_y = font_data.RowsY[cell_n / font_data.CellsPerRow];
+
+    // Render into the cell, the same way as packed glyphs
+    for (int y = 0; y < font_data.CellHeight; y++)
+        memset(atlas->TexPixelsAlpha8 + cell_x + (cell_y + y) * atlas->TexWidth, 0, (size_t)font_data.CellWidth);
+    stbtt_pack_context spc = {};
+    spc.width = atlas->TexWidth;
+    spc.height = atlas->TexHeight;
+    spc.stride_in_bytes = atlas->TexWidth;
+    spc.padding = pad;
+    spc.pixels = atlas->TexPixelsAlpha8;
+    int codepoint_int = (int)codepoint;
+    stbtt_packedchar packed_char = {};
+    stbtt_pack_range pack_range = {};
+    pack_range.font_size = cfg.SizePixels * cfg.RasterizerDensity;
+    pack_range.array_of_unicode_codepoints = &codepoint_int;
+    pack_range.num_chars = 1;
+    pack_range.chardata_for_range = &packed_char;
+    pack_range.h_oversample = (unsigned char)cfg.OversampleH;
+    pack_range.v_oversample = (unsigned char)cfg.OversampleV;
+    stbrp_rect rect = {};
+    rect.x = (stbrp_coord)cell_x;
+    rect.y = (stbrp_coord)cell_y;
+    rect.w = (stbrp_coord)rect_w;
+    rect.h = (stbrp_coord)rect_h;
+    rect.was_packed = 1;
+    stbtt_PackFontRangesRenderIntoRects(&spc, font_info, &pack_range, 1, &rect);
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, rect.x, rect.y, rect.w, rect.h, atlas->TexWidth * 1);
+    }
+    if (atlas->TexPixelsRGBA32 != NULL)
+        for (int y = 0; y < font_data.CellHeight; y++)
+        {
+            const unsigned char* src = atlas->TexPixelsAlpha8 + cell_x + (cell_y + y) * atlas->TexWidth;
+            unsigned int* dst = atlas->TexPixelsRGBA32 + cell_x + (cell_y + y) * atlas->TexWidth;
+            for (int x = 0; x < font_data.CellWidth; x++)
+                dst[x] = IM_COL32(255, 255, 255, (unsigned int)src[x]);
+        }
+
+    // Register glyph (same as ImFontAtlasBuildWithStbTruetype). AddGlyph() appends it, move it back into the recycled cell's slot.
+    stbtt_aligned_quad q;
+    float unused_x = 0.0f, unused_y = 0.0f;
+    stbtt_GetPackedQuad(&packed_char, atlas->TexWidth, atlas->TexHeight, 0, &unused_x, &unused_y, &q, 0);
+    const float inv_rasterization_scale = 1.0f / cfg.RasterizerDensity;
+    const float font_off_x = cfg.GlyphOffset.x;
+    const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(font->Ascent);
+    const int fallback_glyph_n = (int)(font->FallbackGlyph - font->Glyphs.Data);
+    const int metrics_total_surface = font->MetricsTotalSurface;
+    font->AddGlyph(&cfg, codepoint, q.x0 * inv_rasterization_scale + font_off_x, q.y0 * inv_rasterization_scale + font_off_y, q.x1 * inv_rasterization_scale + font_off_x, q.y1 * inv_rasterization_scale + font_off_y, q.s0, q.t0, q.s1, q.t1, packed_char.xadvance * inv_rasterization_scale);
+    if (cell_n < cells_used)
+    {
+        font->Glyphs[font->DynamicGlyphsStart + cell_n] = font->Glyphs.back();
+        font->Glyphs.pop_back();
+        font->MetricsTotalSurface = metrics_total_surface;
+    }
+    else
+    {
+        font->DynamicGlyphsLastUse.push_back(0);
+    }
+    font->FallbackGlyph = &font->Glyphs.Data[fallback_glyph_n];
+    font->DirtyLookupTables = false;
+    font->DynamicGlyphsLastUse[cell_n] = atlas->DynamicGlyphsFrame;
+
+    // Update lookup tables
+    const int slot = font->AddIndexPage(codepoint);
+    const ImFontGlyph& glyph = font->Glyphs[font->DynamicGlyphsStart + cell_n];
+    font->IndexLookup[slot] = (ImWchar)(font->DynamicGlyphsStart + cell_n);
+    font->IndexAdvanceX[slot] = glyph.AdvanceX;
+    const int page_n = (int)codepoint / 4096;
+    font->Used4kPagesMap[page_n >> 3] |= 1 << (page_n & 7);
+
+    // Record the modified area, merged with the previous one when adjacent on the same row
+    ImFontAtlasRect* last = atlas->TexDirtyRects.Size > 0 ? &atlas->TexDirtyRects.back() : NULL;
+    if (last != NULL && last->Y == cell_y && last->Height == font_data.CellHeight && last->X + last->Width == cell_x)
+    {
+        last->Width = (unsigned short)(last->Width + font_data.CellWidth);
+    }
+    else
+    {
+        ImFontAtlasRect dirty_rect = { (unsigned short)cell_x, (unsigned short)cell_y, (unsigned short)font_data.CellWidth, (unsigned short)font_data.CellHeight };
+        atlas->TexDirtyRects.push_back(dirty_rect);
+    }
+    dyn->GlyphsAdded++;
+    atlas->GlyphsVersion++;
+    return true;
+}
+
 #endif // IMGUI_ENABLE_STB_TRUETYPE
 
+// Called by ImGui::NewFrame(): rasterize glyphs queued by ImFont::FindGlyph() misses
+void ImFontAtlasUpdateDynamicGlyphs(ImFontAtlas* atlas)
+{
+    atlas->DynamicGlyphsFrame++;
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+    {
+        ImFont* font = atlas->Fonts[font_n];
+        if (font->DynamicGlyphsQueue.Size == 0)
+            continue;
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+        if (atlas->DynamicGlyphs != NULL && atlas->TexPixelsAlpha8 != NULL && font_n < atlas->DynamicGlyphs->FontData.Size)
+            for (ImWchar codepoint : font->DynamicGlyphsQueue)
+                if (!ImFontAtlasAddDynamicGlyph(atlas, font_n, codepoint))
+                    font->DynamicGlyphsQueued[codepoint >> 5] &= ~((ImU32)1 << (codepoint & 31)); // Queue again on next use
+#endif
+        font->DynamicGlyphsQueue.resize(0);
+    }
+}
+
+void ImFontAtlasDestroyDynamicGlyphs(ImFontAtlas* atlas)
+{
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+    if (atlas->DynamicGlyphs)
+        IM_DELETE(atlas->DynamicGlyphs);
+#endif
+    atlas->DynamicGlyphs = NULL;
+}
+
 void ImFontAtlasUpdateConfigDataPointers(ImFontAtlas* atlas)
 {
     for (ImFontConfig& font_cfg : atlas->ConfigData)
@@ -3164,6 +5290,12 @@ void ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* f
         font->ContainerAtlas = atlas;
         font->Ascent = ascent;
         font->Descent = descent;
+        font->SdfThreshold = (font_config->SdfPadding > 0) ? FONT_ATLAS_SDF_ONEDGE_VALUE / 255.0f : 0.0f;
+        font->SdfAlphaPerTexel = (font_config->SdfPadding > 0) ? FONT_ATLAS_SDF_ALPHA_RANGE / font_config->SdfPadding / 255.0f : 0.0f;
+    }
+    else
+    {
+        IM_ASSERT(font_config->SdfPadding == font->ConfigData->SdfPadding && "Merged fonts must use the same SdfPadding as the font they are merged into.");
     }
 }
 
@@ -3312,6 +5444,9 @@ static void ImFontAtlasBuildRenderLinesTexData(ImFontAtlas* atlas)
 // Note: this is called / shared by both the stb_truetype and the FreeType builder
 void ImFontAtlasBuildInit(ImFontAtlas* atlas)
 {
+    ImFontAtlasDestroyDynamicGlyphs(atlas);
+    atlas->TexDirtyRects.clear();
+
     // Register texture region for mouse cursors or standard white pixels
     if (atlas->PackIdMouseCursors < 0)
     {
@@ -3695,7 +5830,9 @@ ImFont::ImFont()
     Scale = 1.0f;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
+    SdfThreshold = SdfAlphaPerTexel = 0.0f;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    DynamicGlyphsStart = 0;
 }
 
 ImFont::~ImFont()
@@ -3708,6 +5845,7 @@ void    ImFont::ClearOutputData()
     FontSize = 0.0f;
     FallbackAdvanceX = 0.0f;
     Glyphs.clear();
+    IndexPages.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
     FallbackGlyph = NULL;
@@ -3715,7 +5853,12 @@ void    ImFont::ClearOutputData()
     DirtyLookupTables = true;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
+    SdfThreshold = SdfAlphaPerTexel = 0.0f;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    DynamicGlyphsStart = 0;
+    DynamicGlyphsLastUse.clear();
+    DynamicGlyphsQueue.clear();
+    DynamicGlyphsQueued.clear();
 }
 
 static ImWchar FindFirstExistingGlyph(ImFont* font, const ImWchar* candidate_chars, int candidate_chars_count)
@@ -3735,16 +5878,20 @@ void ImFont::BuildLookupTable()
     // Build lookup table
     IM_ASSERT(Glyphs.Size > 0 && "Font has not loaded glyph!");
     IM_ASSERT(Glyphs.Size < 0xFFFF); // -1 is reserved
+    IndexPages.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
     DirtyLookupTables = false;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    if (ContainerAtlas)
+        ContainerAtlas->GlyphsVersion++;
     GrowIndex(max_codepoint + 1);
     for (int i = 0; i < Glyphs.Size; i++)
     {
         int codepoint = (int)Glyphs[i].Codepoint;
-        IndexAdvanceX[codepoint] = Glyphs[i].AdvanceX;
-        IndexLookup[codepoint] = (ImWchar)i;
+        const int slot = AddIndexPage((ImWchar)codepoint);
+        IndexAdvanceX[slot] = Glyphs[i].AdvanceX;
+        IndexLookup[slot] = (ImWchar)i;
 
         // Mark 4K page as used
         const int page_n = codepoint / 4096;
@@ -3761,8 +5908,9 @@ void ImFont::BuildLookupTable()
         tab_glyph = *FindGlyph((ImWchar)' ');
         tab_glyph.Codepoint = '\t';
         tab_glyph.AdvanceX *= IM_TABSIZE;
-        IndexAdvanceX[(int)tab_glyph.Codepoint] = (float)tab_glyph.AdvanceX;
-        IndexLookup[(int)tab_glyph.Codepoint] = (ImWchar)(Glyphs.Size - 1);
+        const int tab_slot = GetIndexSlot((ImWchar)tab_glyph.Codepoint);
+        IndexAdvanceX[tab_slot] = (float)tab_glyph.AdvanceX;
+        IndexLookup[tab_slot] = (ImWchar)(Glyphs.Size - 1);
     }
 
     // Mark special glyphs as not visible (note that AddGlyph already mark as non-visible glyphs with zero-size polygons)
@@ -3783,9 +5931,9 @@ void ImFont::BuildLookupTable()
         }
     }
     FallbackAdvanceX = FallbackGlyph->AdvanceX;
-    for (int i = 0; i < max_codepoint + 1; i++)
-        if (IndexAdvanceX[i] < 0.0f)
-            IndexAdvanceX[i] = FallbackAdvanceX;
+    for (float& advance_x : IndexAdvanceX) // Including the shared empty page, which later pages are copied from
+        if (advance_x < 0.0f)
+            advance_x = FallbackAdvanceX;
 
     // Setup Ellipsis character. It is required for rendering elided text. We prefer using U+2026 (horizontal ellipsis).
     // However some old fonts may contain ellipsis at U+0085. Here we auto-detect most suitable ellipsis character.
@@ -3829,13 +5977,36 @@ void ImFont::SetGlyphVisible(ImWchar c, bool visible)
         glyph->Visible = visible ? 1 : 0;
 }
 
+// Pages are only allocated for blocks with glyphs: merging a single high codepoint into a font costs one page, not a table up to it.
 void ImFont::GrowIndex(int new_size)
 {
     IM_ASSERT(IndexAdvanceX.Size == IndexLookup.Size);
-    if (new_size <= IndexLookup.Size)
-        return;
-    IndexAdvanceX.resize(new_size, -1.0f);
-    IndexLookup.resize(new_size, (ImWchar)-1);
+    if (IndexPages.Size == 0)
+    {
+        IndexAdvanceX.resize(IM_FONT_INDEX_PAGE_SIZE * 2, -1.0f);
+        IndexLookup.resize(IM_FONT_INDEX_PAGE_SIZE * 2, (ImWchar)-1);
+        IndexPages.push_back(0);
+    }
+    const int new_pages_count = (new_size + IM_FONT_INDEX_PAGE_SIZE - 1) >> IM_FONT_INDEX_PAGE_SHIFT;
+    if (new_pages_count > IndexPages.Size)
+        IndexPages.resize(new_pages_count, 1);
+}
+
+int ImFont::AddIndexPage(ImWchar c)
+{
+    GrowIndex((int)c + 1);
+    const unsigned int block_n = (unsigned int)c >> IM_FONT_INDEX_PAGE_SHIFT;
+    if (IndexPages.Data[block_n] == 1)
+    {
+        const int page_n = IndexLookup.Size >> IM_FONT_INDEX_PAGE_SHIFT;
+        IM_ASSERT(page_n <= 0xFFFF);
+        IndexAdvanceX.resize(IndexAdvanceX.Size + IM_FONT_INDEX_PAGE_SIZE);
+        IndexLookup.resize(IndexLookup.Size + IM_FONT_INDEX_PAGE_SIZE);
+        memcpy(&IndexAdvanceX.Data[page_n << IM_FONT_INDEX_PAGE_SHIFT], &IndexAdvanceX.Data[IM_FONT_INDEX_PAGE_SIZE], IM_FONT_INDEX_PAGE_SIZE * sizeof(float));
+        memcpy(&IndexLookup.Data[page_n << IM_FONT_INDEX_PAGE_SHIFT], &IndexLookup.Data[IM_FONT_INDEX_PAGE_SIZE], IM_FONT_INDEX_PAGE_SIZE * sizeof(ImWchar));
+        IndexPages.Data[block_n] = (ImU16)page_n;
+    }
+    return GetIndexSlot(c);
 }
 
 // x0/y0/x1/y1 are offset from the character upper-left layout position, in pixels. Therefore x0/y0 are often fairly close to zero.
@@ -3888,40 +6059,80 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
 
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 {
-    IM_ASSERT(IndexLookup.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
-    unsigned int index_size = (unsigned int)IndexLookup.Size;
+    IM_ASSERT(IndexPages.Size > 0);     // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
+    unsigned int pages_count = (unsigned int)IndexPages.Size;
+    const bool dst_indexed = ((unsigned int)dst >> IM_FONT_INDEX_PAGE_SHIFT) < pages_count;
+    const bool src_indexed = ((unsigned int)src >> IM_FONT_INDEX_PAGE_SHIFT) < pages_count;
 
-    if (dst < index_size && IndexLookup.Data[dst] == (ImWchar)-1 && !overwrite_dst) // 'dst' already exists
+    if (dst_indexed && IndexLookup.Data[GetIndexSlot(dst)] == (ImWchar)-1 && !overwrite_dst) // 'dst' already exists
         return;
-    if (src >= index_size && dst >= index_size) // both 'dst' and 'src' don't exist -> no-op
+    if (!src_indexed && !dst_indexed) // both 'dst' and 'src' don't exist -> no-op
         return;
 
-    GrowIndex(dst + 1);
-    IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (ImWchar)-1;
-    IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    const ImWchar src_lookup = src_indexed ? IndexLookup.Data[GetIndexSlot(src)] : (ImWchar)-1;
+    const float src_advance_x = src_indexed ? IndexAdvanceX.Data[GetIndexSlot(src)] : 1.0f;
+    const int dst_slot = AddIndexPage(dst);
+    IndexLookup[dst_slot] = src_lookup;
+    IndexAdvanceX[dst_slot] = src_advance_x;
+    if (ContainerAtlas)
+        ContainerAtlas->GlyphsVersion++;
+}
+
+// Queue a codepoint for ImFontAtlasUpdateDynamicGlyphs(), once
+static const ImFontGlyph* ImFontQueueDynamicGlyph(ImFont* font, ImWchar c)
+{
+    const int word_n = (int)(c >> 5);
+    const ImU32 mask = (ImU32)1 << (c & 31);
+    if (word_n >= font->DynamicGlyphsQueued.Size)
+        font->DynamicGlyphsQueued.resize(word_n + 1, 0);
+    if ((font->DynamicGlyphsQueued.Data[word_n] & mask) == 0)
+    {
+        font->DynamicGlyphsQueued.Data[word_n] |= mask;
+        font->DynamicGlyphsQueue.push_back(c);
+    }
+    return font->FallbackGlyph;
 }
 
 // Find glyph, return fallback if missing
+// Blocks without glyphs share an empty page, so codepoints covered by IndexPages[] need no other check.
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c)
 {
-    if (c >= (size_t)IndexLookup.Size)
-        return FallbackGlyph;
-    const ImWchar i = IndexLookup.Data[c];
+    const ImWchar i = ((unsigned int)c >> IM_FONT_INDEX_PAGE_SHIFT < (unsigned int)IndexPages.Size) ? IndexLookup.Data[GetIndexSlot(c)] : (ImWchar)-1;
     if (i == (ImWchar)-1)
-        return FallbackGlyph;
+        return (DynamicGlyphsStart > 0) ? ImFontQueueDynamicGlyph(this, c) : FallbackGlyph;
+    const unsigned int dynamic_n = (unsigned int)((int)i - DynamicGlyphsStart); // Mark dynamic glyphs as used (LRU)
+    if (dynamic_n < (unsigned int)DynamicGlyphsLastUse.Size)
+        DynamicGlyphsLastUse.Data[dynamic_n] = ContainerAtlas->DynamicGlyphsFrame;
     return &Glyphs.Data[i];
 }
 
 const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c)
 {
-    if (c >= (size_t)IndexLookup.Size)
-        return NULL;
-    const ImWchar i = IndexLookup.Data[c];
+    const ImWchar i = ((unsigned int)c >> IM_FONT_INDEX_PAGE_SHIFT < (unsigned int)IndexPages.Size) ? IndexLookup.Data[GetIndexSlot(c)] : (ImWchar)-1;
     if (i == (ImWchar)-1)
         return NULL;
     return &Glyphs.Data[i];
 }
 
+// Text measured with a missing glyph would otherwise keep the fallback width until something renders it, then jump one frame later.
+float ImFont::GetCharAdvanceDynamic(ImWchar c)
+{
+    const bool indexed = ((unsigned int)c >> IM_FONT_INDEX_PAGE_SHIFT < (unsigned int)IndexPages.Size);
+    const int slot = indexed ? GetIndexSlot(c) : -1;
+    const ImWchar i = indexed ? IndexLookup.Data[slot] : (ImWchar)-1;
+    if (i == (ImWchar)-1)
+    {
+        ImFontQueueDynamicGlyph(this, c);
+    }
+    else
+    {
+        const unsigned int dynamic_n = (unsigned int)((int)i - DynamicGlyphsStart); // Mark dynamic glyphs as used (LRU)
+        if (dynamic_n < (unsigned int)DynamicGlyphsLastUse.Size)
+            DynamicGlyphsLastUse.Data[dynamic_n] = ContainerAtlas->DynamicGlyphsFrame;
+    }
+    return indexed ? IndexAdvanceX.Data[slot] : FallbackAdvanceX;
+}
+
 // Trim trailing space and find beginning of next line
 static inline const char* CalcWordWrapNextLineStartA(const char* text, const char* text_end)
 {
@@ -3932,7 +6143,66 @@ static inline const char* CalcWordWrapNextLineStartA(const char* text, const cha
     return text;
 }
 
-#define ImFontGetCharAdvanceX(_FONT, _CH)  ((int)(_CH) < (_FONT)->IndexAdvanceX.Size ? (_FONT)->IndexAdvanceX.Data[_CH] : (_FONT)->FallbackAdvanceX)
+// GetCharAdvance() without queuing dynamic glyph misses, for the measuring loops: keeping the out of line call of GetCharAdvanceDynamic()
+// out of them lets the lookup tables stay in registers. CalcTextSizeA() queues the misses of fonts with dynamic glyphs in a separate pass.
+static inline float ImFontGetCharAdvanceNoQueue(const ImFont* font, ImWchar c)
+{
+    return ((unsigned int)c < IM_FONT_INDEX_PAGE_SIZE && font->IndexPages.Size > 0) ? font->IndexAdvanceX.Data[c] : ((unsigned int)c >> IM_FONT_INDEX_PAGE_SHIFT < (unsigned int)font->IndexPages.Size) ? font->IndexAdvanceX.Data[font->GetIndexSlot(c)] : font->FallbackAdvanceX;
+}
+#define ImFontGetCharAdvanceX(_FONT, _CH)  ImFontGetCharAdvanceNoQueue(_FONT, (ImWchar)(_CH))
+
+// Queue the glyphs of a measured text missing from a font with dynamic glyphs, as GetCharAdvance() would have
+static void ImFontQueueMissingDynamicGlyphs(ImFont* font, const char* text_begin, const char* text_end)
+{
+    for (const char* s = text_begin; s < text_end; )
+    {
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+            s += 1;
+        else
+            s += ImTextCharFromUtf8(&c, s, text_end);
+        if (c >= 32)
+            font->GetCharAdvanceDynamic((ImWchar)c);
+    }
+}
+
+// SIMD classification of printable ASCII runs for CalcTextSizeA() and RenderText().
+// - Runs need no UTF-8 decoding nor control character handling, and their codepoints all live in page 0 of the index: the loops over them
+//   read IndexAdvanceX[]/IndexLookup[] directly. Multi-byte sequences, newlines, tabs and word-wrap boundaries end a run and go through the
+//   regular per-codepoint loop.
+// - Widths and vertices are computed operation for operation like the regular loop, results are bit-identical.
+#if (defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)) && !defined(IMGUI_DISABLE_SIMD_TEXT)
+#define IMGUI_ENABLE_SIMD_TEXT
+#endif
+
+#ifdef IMGUI_ENABLE_SIMD_TEXT
+// End of the run of printable ASCII characters (0x20-0x7F) starting at 's', 16 bytes at a time then byte per byte.
+static inline const char* ImTextFindPrintableAsciiEnd(const char* s, const char* s_end)
+{
+#if defined(IMGUI_ENABLE_SSE)
+    const __m128i control_max = _mm_set1_epi8(0x1F);
+    while (s_end - s >= 16)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)(const void*)s);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(chars, control_max)) != 0xFFFF) // Signed compare: bytes >= 0x80 are negative
+            break;
+        s += 16;
+    }
+#elif defined(IMGUI_ENABLE_NEON)
+    const int8x16_t control_max = vdupq_n_s8(0x1F);
+    while (s_end - s >= 16)
+    {
+        const int8x16_t chars = vld1q_s8((const int8_t*)(const void*)s);
+        if (vminvq_u8(vcgtq_s8(chars, control_max)) == 0) // Signed compare: bytes >= 0x80 are negative
+            break;
+        s += 16;
+    }
+#endif
+    while (s < s_end && (unsigned char)(*s - 0x20) < 0x60)
+        s++;
+    return s;
+}
+#endif
 
 // Simple word-wrapping for English, not full-featured. Please submit failing cases!
 // This will return the next location to wrap from. If no wrapping if necessary, this will fast-forward to e.g. text_end.
@@ -4070,6 +6340,30 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+#ifdef IMGUI_ENABLE_SIMD_TEXT
+        // Printable ASCII run, up to the wrapping point. Continue with the character which ended it, unless the run reached the wrapping point.
+        if (IndexPages.Size > 0)
+        {
+            const char* run_limit = word_wrap_enabled ? word_wrap_eol : text_end;
+            const char* run_end = ImTextFindPrintableAsciiEnd(s, run_limit);
+            if (run_end > s)
+            {
+                const float* advance_x = IndexAdvanceX.Data;
+                for (; s < run_end; s++)
+                {
+                    const float char_width = advance_x[(unsigned char)*s] * scale;
+                    if (line_width + char_width >= max_width)
+                        break;
+                    line_width += char_width;
+                }
+                if (s < run_end)
+                    break;
+                if (s == run_limit)
+                    continue;
+            }
+        }
+#endif
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -4109,10 +6403,221 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
 
     if (remaining)
         *remaining = s;
+    if (DynamicGlyphsStart > 0)
+        ImFontQueueMissingDynamicGlyphs(this, text_begin, s);
 
     return text_size;
 }
 
+// Text layouts
+// - ImGui::CalcTextSize() measures the same texts every frame. For wrapped texts, ImDrawListSharedData::CalcTextLayoutSize() keeps CalcTextSizeA()
+//   results keyed by font, size, wrap width and a 64-bit hash of the text with its length. Hashing runs 8 bytes at a time, several times faster
+//   than finding word wrap positions. Unwrapped texts aren't cached: measuring them costs about as much as hashing and looking them up.
+// - Wrapped layouts also store their line breaks, which RenderText() uses instead of calling CalcWordWrapPositionA() again when the same
+//   text is drawn with the same wrap width (e.g. TextWrapped() measures then renders). Output is identical.
+// - Open addressing hash table, at most half full. Layouts unused for IM_DRAWLIST_TEXT_LAYOUTS_MAX_AGE frames are evicted when the table needs
+//   room and every IM_DRAWLIST_TEXT_LAYOUTS_MAX_AGE frames. Everything is dropped when ImFontAtlas::GlyphsVersion changes.
+// - When a frame measures more texts than the largest table holds, the cache is bypassed (no hashing nor lookup) for the rest of the frame
+//   and the next 1, 2, 4... IM_DRAWLIST_TEXT_LAYOUTS_BACKOFF_MAX frames while it keeps overflowing.
+// - The text isn't compared, see the collision note above ImDrawTextLayout.
+// - The cache lives in ImDrawListSharedData: draw lists recording on other threads need their own (see CreateDrawListSharedDataSnapshot()).
+static ImU64 ImDrawTextLayoutHash(const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end)
+{
+    ImU32 size_bits, wrap_width_bits;
+    memcpy(&size_bits, &size, sizeof(size_bits));
+    memcpy(&wrap_width_bits, &wrap_width, sizeof(wrap_width_bits));
+    ImU64 hash = ImHashData64(text_begin, (size_t)(text_end - text_begin));
+    hash = (hash ^ (ImU64)(size_t)font) * 0x9E3779B97F4A7C15ull;
+    hash = (hash ^ (((ImU64)size_bits << 32) | wrap_width_bits)) * 0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 32);
+}
+
+// Slot holding this layout, or the empty slot where it would be inserted
+static ImDrawTextLayout* ImDrawListFindTextLayoutSlot(ImDrawListSharedData* data, ImU64 hash, const ImFont* font, float size, float wrap_width, int text_length)
+{
+    const int mask = data->TextLayouts.Size - 1;
+    for (int slot_n = (int)(hash & (ImU64)mask);; slot_n = (slot_n + 1) & mask)
+    {
+        ImDrawTextLayout* layout = &data->TextLayouts.Data[slot_n];
+        if (layout->Font == NULL || (layout->Hash == hash && layout->Font == font && layout->FontSize == size && layout->WrapWidth == wrap_width && layout->TextLength == text_length))
+            return layout;
+    }
+}
+
+static int ImDrawListCountTextLayouts(const ImDrawListSharedData* data, int min_frame)
+{
+    int count = 0;
+    for (const ImDrawTextLayout& layout : data->TextLayouts)
+        if (layout.Font != NULL && layout.LastUsedFrame >= min_frame)
+            count++;
+    return count;
+}
+
+// Rebuild the table with the layouts used since 'min_frame', at most a quarter full. When they wouldn't fit in IM_DRAWLIST_TEXT_LAYOUTS_SLOTS_MAX,
+// only keep the layouts used this frame, or none. Wrap breaks are compacted.
+static void ImDrawListSweepTextLayouts(ImDrawListSharedData* data, int min_frame)
+{
+    int count = ImDrawListCountTextLayouts(data, min_frame);
+    if (count * 4 > IM_DRAWLIST_TEXT_LAYOUTS_SLOTS_MAX)
+    {
+        min_frame = data->TextLayoutsFrame;
+        count = ImDrawListCountTextLayouts(data, min_frame);
+        if (count * 2 > IM_DRAWLIST_TEXT_LAYOUTS_SLOTS_MAX)
+            min_frame = INT_MAX;
+    }
+    int slots_count = IM_DRAWLIST_TEXT_LAYOUTS_SLOTS_MIN;
+    while (slots_count < count * 4 && slots_count < IM_DRAWLIST_TEXT_LAYOUTS_SLOTS_MAX)
+        slots_count *= 2;
+
+    ImVector<ImDrawTextLayout> old_layouts;
+    ImVector<int> old_wrap_breaks;
+    old_layouts.swap(data->TextLayouts);
+    old_wrap_breaks.swap(data->TextLayoutWrapBreaks);
+    data->TextLayouts.resize(slots_count);
+    memset(data->TextLayouts.Data, 0, (size_t)data->TextLayouts.size_in_bytes());
+    data->TextLayoutsCount = 0;
+    for (const ImDrawTextLayout& old_layout : old_layouts)
+    {
+        if (old_layout.Font == NULL || old_layout.LastUsedFrame < min_frame)
+            continue;
+        ImDrawTextLayout* layout = ImDrawListFindTextLayoutSlot(data, old_layout.Hash, old_layout.Font, old_layout.FontSize, old_layout.WrapWidth, old_layout.TextLength);
+        *layout = old_layout;
+        layout->WrapBreaksOffset = data->TextLayoutWrapBreaks.Size;
+        data->TextLayoutWrapBreaks.resize(data->TextLayoutWrapBreaks.Size + old_layout.WrapBreaksCount);
+        if (old_layout.WrapBreaksCount > 0)
+            memcpy(data->TextLayoutWrapBreaks.Data + layout->WrapBreaksOffset, old_wrap_breaks.Data + old_layout.WrapBreaksOffset, (size_t)old_layout.WrapBreaksCount * sizeof(int));
+        data->TextLayoutsCount++;
+    }
+}
+
+void ImDrawListSharedData::ClearTextLayouts()
+{
+    TextLayouts.resize(0);
+    TextLayoutWrapBreaks.resize(0);
+    TextLayoutsCount = 0;
+    TextLayoutsSwept = false;
+    TextLayoutsAtlas = NULL;
+    TextLayoutsAtlasGlyphsVersion = 0;
+}
+
+// Called once a frame by ImGui::NewFrame()
+void ImDrawListSharedData::UpdateTextLayouts()
+{
+    if (TextLayoutsFrame >= TextLayoutsBypassUntilFrame) // Cache used without overflowing during the last frame
+        TextLayoutsBackoff = 0;
+    TextLayoutsFrame++;
+    TextLayoutsSwept = false;
+    if (TextLayoutsCount > 0 && (TextLayoutsFrame % IM_DRAWLIST_TEXT_LAYOUTS_MAX_AGE) == 0)
+        ImDrawListSweepTextLayouts(this, TextLayoutsFrame - IM_DRAWLIST_TEXT_LAYOUTS_MAX_AGE);
+}
+
+// Same as font->CalcTextSizeA(size, FLT_MAX, wrap_width, text_begin, text_end), reusing the result of a previous call for wrapped texts
+ImVec2 ImDrawListSharedData::CalcTextLayoutSize(ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end)
+{
+#ifndef IMGUI_DISABLE_TEXT_LAYOUT_CACHE
+    if (!text_end)
+        text_end = text_begin + strlen(text_begin);
+    const ImFontAtlas* atlas = font->ContainerAtlas;
+    if (atlas != NULL && wrap_width > 0.0f && TextLayoutsFrame >= TextLayoutsBypassUntilFrame)
+    {
+        if (atlas != TextLayoutsAtlas || atlas->GlyphsVersion != TextLayoutsAtlasGlyphsVersion)
+        {
+            ClearTextLayouts();
+            TextLayoutsAtlas = atlas;
+            TextLayoutsAtlasGlyphsVersion = atlas->GlyphsVersion;
+        }
+        if (TextLayouts.Size == 0)
+            ImDrawListSweepTextLayouts(this, INT_MAX);
+
+        const int text_length = (int)(text_end - text_begin);
+        const ImU64 hash = ImDrawTextLayoutHash(font, size, wrap_width, text_begin, text_end);
+        ImDrawTextLayout* layout = ImDrawListFindTextLayoutSlot(this, hash, font, size, wrap_width, text_length);
+        if (layout->Font != NULL)
+        {
+            layout->LastUsedFrame = TextLayoutsFrame;
+            TextLayoutsHits++;
+            return layout->Size;
+        }
+        TextLayoutsMisses++;
+
+        // Make room. Sweeping again in the same frame only helps while it can grow the table: when more texts are measured in a frame than
+        // the largest table can hold (e.g. a large table without clipper), every lookup would miss and every sweep would evict nothing.
+        // Stop hashing and looking up texts for the rest of the frame and the next ones, for longer while it keeps overflowing.
+        if ((TextLayoutsCount + 1) * 2 > TextLayouts.Size)
+        {
+            if (!TextLayoutsSwept || TextLayouts.Size < IM_DRAWLIST_TEXT_LAYOUTS_SLOTS_MAX)
+            {
+                ImDrawListSweepTextLayouts(this, TextLayoutsFrame - IM_DRAWLIST_TEXT_LAYOUTS_MAX_AGE);
+                TextLayoutsSwept = true;
+            }
+            layout = NULL;
+            if ((TextLayoutsCount + 1) * 2 <= TextLayouts.Size)
+            {
+                layout = ImDrawListFindTextLayoutSlot(this, hash, font, size, wrap_width, text_length);
+            }
+            else
+            {
+                TextLayoutsBackoff = ImClamp(TextLayoutsBackoff * 2, 1, IM_DRAWLIST_TEXT_LAYOUTS_BACKOFF_MAX);
+                TextLayoutsBypassUntilFrame = TextLayoutsFrame + 1 + TextLayoutsBackoff;
+            }
+        }
+        if (layout != NULL)
+        {
+            layout->Font = font;
+            layout->FontSize = size;
+            layout->WrapWidth = wrap_width;
+            layout->TextLength = text_length;
+            layout->Hash = hash;
+            layout->LastUsedFrame = TextLayoutsFrame;
+            layout->Size = font->CalcTextSizeA(size, FLT_MAX, wrap_width, text_begin, text_end);
+            layout->WrapBreaksOffset = TextLayoutWrapBreaks.Size;
+            TextLayoutsCount++;
+
+            // Same line breaks as the CalcTextSizeA()/RenderText() loops. The break forced when a line can't fit its first character
+            // may be within a UTF-8 sequence: those loops continue after the whole character.
+            const float scale = size / font->FontSize;
+            if (wrap_width > 0.0f)
+                for (const char* s = text_begin; s < text_end && TextLayoutWrapBreaks.Size < IM_DRAWLIST_TEXT_LAYOUTS_WRAP_BREAKS_MAX;)
+                {
+                    const char* line_end = font->CalcWordWrapPositionA(scale, s, text_end, wrap_width);
+                    TextLayoutWrapBreaks.push_back((int)(line_end - text_begin));
+                    if (line_end == s + 1)
+                    {
+                        unsigned int c;
+                        line_end = s + ImTextCharFromUtf8(&c, s, text_end);
+                    }
+                    s = CalcWordWrapNextLineStartA(line_end, text_end);
+                }
+            layout->WrapBreaksCount = TextLayoutWrapBreaks.Size - layout->WrapBreaksOffset;
+            return layout->Size;
+        }
+    }
+#endif
+    return font->CalcTextSizeA(size, FLT_MAX, wrap_width, text_begin, text_end);
+}
+
+// Layout of a text measured by CalcTextLayoutSize(), NULL if it isn't cached
+const ImDrawTextLayout* ImDrawListSharedData::FindTextLayout(const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end)
+{
+#ifndef IMGUI_DISABLE_TEXT_LAYOUT_CACHE
+    if (TextLayoutsCount == 0 || TextLayoutsFrame < TextLayoutsBypassUntilFrame || font->ContainerAtlas != TextLayoutsAtlas || font->ContainerAtlas->GlyphsVersion != TextLayoutsAtlasGlyphsVersion)
+        return NULL;
+    const ImU64 hash = ImDrawTextLayoutHash(font, size, wrap_width, text_begin, text_end);
+    ImDrawTextLayout* layout = ImDrawListFindTextLayoutSlot(this, hash, font, size, wrap_width, (int)(text_end - text_begin));
+    if (layout->Font == NULL)
+        return NULL;
+    layout->LastUsedFrame = TextLayoutsFrame;
+    return layout;
+#else
+    IM_UNUSED(font);
+    IM_UNUSED(size);
+    IM_UNUSED(wrap_width);
+    IM_UNUSED(text_begin);
+    IM_UNUSED(text_end);
+    return NULL;
+#endif
+}
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, ImWchar c)
 {
@@ -4124,8 +6629,12 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     float scale = (size >= 0.0f) ? (size / FontSize) : 1.0f;
     float x = IM_TRUNC(pos.x);
     float y = IM_TRUNC(pos.y);
+    if (SdfThreshold > 0.0f)
+        draw_list->_SetTextSdf(SdfThreshold, SdfAlphaPerTexel);
     draw_list->PrimReserve(6, 4);
     draw_list->PrimRectUV(ImVec2(x + glyph->X0 * scale, y + glyph->Y0 * scale), ImVec2(x + glyph->X1 * scale, y + glyph->Y1 * scale), ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
+    if (SdfThreshold > 0.0f)
+        draw_list->_SetTextSdf(0.0f, 0.0f);
 }
 
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
@@ -4183,6 +6692,10 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     if (s == text_end)
         return;
 
+    // Signed distance field glyphs go in their own draw command, which consecutive texts of the same font merge into
+    if (SdfThreshold > 0.0f)
+        draw_list->_SetTextSdf(SdfThreshold, SdfAlphaPerTexel);
+
     // Reserve vertices for remaining worse case (over-reserving is useful and easily amortized)
     const int vtx_count_max = (int)(text_end - s) * 4;
     const int idx_count_max = (int)(text_end - s) * 6;
@@ -4195,13 +6708,36 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
     const char* word_wrap_eol = NULL;
 
+    // Wrapped text measured by ImGui::CalcTextSize() (e.g. TextWrapped()) reuses its line breaks, unless lines were skipped above
+    const int* wrap_breaks = NULL;
+    int wrap_breaks_count = 0;
+    if (word_wrap_enabled && s == text_begin)
+        if (const ImDrawTextLayout* layout = draw_list->_Data->FindTextLayout(this, size, wrap_width, text_begin, text_end))
+        {
+            wrap_breaks = draw_list->_Data->TextLayoutWrapBreaks.Data + layout->WrapBreaksOffset;
+            wrap_breaks_count = layout->WrapBreaksCount;
+        }
+#ifdef IMGUI_ENABLE_SIMD_TEXT
+    const bool ascii_runs = IndexPages.Size > 0 && DynamicGlyphsStart == 0 && FallbackGlyph != NULL && !cpu_fine_clip; // Dynamic glyphs need FindGlyph() to mark them as used
+#endif
+
     while (s < text_end)
     {
         if (word_wrap_enabled)
         {
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
             if (!word_wrap_eol)
-                word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - origin_x));
+            {
+                if (wrap_breaks_count > 0)
+                {
+                    word_wrap_eol = text_begin + *wrap_breaks++;
+                    wrap_breaks_count--;
+                }
+                else
+                {
+                    word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - origin_x));
+                }
+            }
 
             if (s >= word_wrap_eol)
             {
@@ -4215,6 +6751,44 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
             }
         }
 
+#ifdef IMGUI_ENABLE_SIMD_TEXT
+        // Printable ASCII run, up to the wrapping point: glyphs are read from page 0 of the index and emitted back to back
+        if (ascii_runs)
+        {
+            const char* run_limit = word_wrap_enabled ? word_wrap_eol : text_end;
+            const char* run_end = ImTextFindPrintableAsciiEnd(s, run_limit);
+            for (; s < run_end; s++)
+            {
+                const ImWchar glyph_n = IndexLookup.Data[(unsigned char)*s];
+                const ImFontGlyph* glyph = (glyph_n != (ImWchar)-1) ? &Glyphs.Data[glyph_n] : FallbackGlyph;
+                const float char_width = glyph->AdvanceX * scale;
+                if (glyph->Visible)
+                {
+                    const float x1 = x + glyph->X0 * scale;
+                    const float x2 = x + glyph->X1 * scale;
+                    if (x1 <= clip_rect.z && x2 >= clip_rect.x)
+                    {
+                        const float y1 = y + glyph->Y0 * scale;
+                        const float y2 = y + glyph->Y1 * scale;
+                        const ImU32 glyph_col = glyph->Colored ? col_untinted : col;
+                        vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = glyph->U0; vtx_write[0].uv.y = glyph->V0;
+                        vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = glyph->U1; vtx_write[1].uv.y = glyph->V0;
+                        vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = glyph->U1; vtx_write[2].uv.y = glyph->V1;
+                        vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = glyph->U0; vtx_write[3].uv.y = glyph->V1;
+                        idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
+                        idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
+                        vtx_write += 4;
+                        vtx_index += 4;
+                        idx_write += 6;
+                    }
+                }
+                x += char_width;
+            }
+            if (s == run_limit)
+                continue;
+        }
+#endif
+
         // Decode and advance source
         unsigned int c = (unsigned int)*s;
         if (c < 0x80)
@@ -4313,6 +6887,8 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     draw_list->_VtxWritePtr = vtx_write;
     draw_list->_IdxWritePtr = idx_write;
     draw_list->_VtxCurrentIdx = vtx_index;
+    if (SdfThreshold > 0.0f)
+        draw_list->_SetTextSdf(0.0f, 0.0f);
 }
 
 //-----------------------------------------------------------------------------
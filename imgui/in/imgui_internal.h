@@ -66,6 +66,11 @@ Index of this file:
 #include <nmmintrin.h>
 #endif
 #endif
+// Enable NEON intrinsics if available (AArch64 only: ARMv7 NEON has no vector sqrt/div, which we need to match the scalar math)
+#if (defined __aarch64__ || defined _M_ARM64) && !defined(IMGUI_DISABLE_NEON)
+#define IMGUI_ENABLE_NEON
+#include <arm_neon.h>
+#endif
 // Emscripten has partial SSE 4.2 support where _mm_crc32_u32 is not available. See https://emscripten.org/docs/porting/simd.html#id11 and #8213
 #if defined(IMGUI_ENABLE_SSE4_2) && !defined(IMGUI_USE_LEGACY_CRC32_ADLER) && !defined(__EMSCRIPTEN__)
 #define IMGUI_ENABLE_SSE4_2_CRC
@@ -160,6 +165,7 @@ struct ImGuiNextItemData;           // Storage for SetNextItem** functions
 struct ImGuiOldColumnData;          // Storage data for a single column for legacy Columns() api
 struct ImGuiOldColumns;             // Storage data for a columns set for legacy Columns() api
 struct ImGuiPopupData;              // Storage for current popup stack
+struct ImGuiRetainedRegion;         // Storage for BeginRetained()/EndRetained(): cached draw output and layout of a region
 struct ImGuiSettingsHandler;        // Storage for one type registered in the .ini file
 struct ImGuiStyleMod;               // Stacked style modifier, backup of modified data so we can restore it
 struct ImGuiTabBar;                 // Storage for a tab bar
@@ -359,6 +365,7 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 // Helpers: Hashing
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImGuiID seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImGuiID seed = 0);
+IMGUI_API ImU64         ImHashData64(const void* data, size_t data_size, ImU64 seed = 0);
 
 // Helpers: Sorting
 #ifndef ImQsort
@@ -775,6 +782,67 @@ IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStorag
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// ImDrawList: Shape templates, cached tessellation of AddRect()/AddRectFilled()/AddCircle()/AddCircleFilled()/AddNgon()/AddNgonFilled().
+#define IM_DRAWLIST_SHAPE_TEMPLATES_SLOTS                       1024        // Direct-mapped by key hash, must be a power of 2.
+#define IM_DRAWLIST_SHAPE_TEMPLATES_VTX_MAX                     (64 * 1024) // Cached vertices after which the cache is flushed.
+#define IM_DRAWLIST_SHAPE_TEMPLATE_VTX_MAX                      512         // Shapes with more vertices are always tessellated.
+
+enum ImDrawShapeType
+{
+    ImDrawShapeType_Rect,
+    ImDrawShapeType_RectFilled,
+    ImDrawShapeType_Circle,
+    ImDrawShapeType_CircleFilled,
+};
+
+// Everything the tessellated geometry of a shape depends on, besides its position and the atlas uv (the cache is flushed when they change).
+// Hashed and compared as raw 32-bit words.
+struct ImDrawShapeTemplateKey
+{
+    ImDrawShapeType Shape;
+    float           Radius;                     // Rounding after clamping (rectangles) or path radius (circles)
+    ImDrawFlags     Flags;                      // ImDrawFlags_RoundCornersXXX (rectangles)
+    int             NumSegments;                // 0: auto (circles)
+    float           Thickness;                  // 0.0f for filled shapes
+    ImDrawListFlags DrawListFlags;              // Anti-aliasing flags
+    float           FringeScale;                // ImDrawList::_FringeScale
+};
+
+struct ImDrawShapeTemplate
+{
+    ImGuiID         Hash;                       // 0: empty slot
+    ImGuiID         SeenHash;                   // Last key hash seen for this slot but not recorded yet
+    ImDrawShapeTemplateKey Key;
+    int             VtxOffset;                  // Range in ImDrawListSharedData::ShapeTemplateVtx. -1: not cacheable.
+    int             VtxCount;
+    int             IdxOffset;                  // Range in ImDrawListSharedData::ShapeTemplateIdx
+    int             IdxCount;
+    float           BoundsPad;                  // How far vertices extend beyond the rectangle or circle, for ImDrawListFlags_CullOffscreen
+};
+
+// ImDrawList: Text layouts, cached ImFont::CalcTextSizeA() results and word-wrap breaks of wrapped texts measured every frame.
+#define IM_DRAWLIST_TEXT_LAYOUTS_SLOTS_MIN                      256         // Open addressing, at most half full. Must be a power of 2.
+#define IM_DRAWLIST_TEXT_LAYOUTS_SLOTS_MAX                      (64 * 1024) // Past this, layouts unused for a frame are evicted, then new ones aren't cached.
+#define IM_DRAWLIST_TEXT_LAYOUTS_MAX_AGE                        60          // Frames after which an unused layout is evicted.
+#define IM_DRAWLIST_TEXT_LAYOUTS_WRAP_BREAKS_MAX                (256 * 1024)// Stored wrap breaks after which new wrapped layouts only cache their size.
+#define IM_DRAWLIST_TEXT_LAYOUTS_BACKOFF_MAX                    64          // Frames the cache is bypassed after it overflowed several frames in a row.
+
+// Keyed by font, size, wrap width and a 64-bit hash of the text with its length. The text itself isn't stored nor compared: two different texts
+// of the same length, font, size and wrap width whose hashes collide share a layout (odds around 2^-64 per pair of texts, like ImGuiID collisions
+// at 2^-32 for every widget id).
+struct ImDrawTextLayout
+{
+    ImU64           Hash;                       // Of the text, its length, font, size and wrap width
+    const ImFont*   Font;                       // NULL: empty slot
+    float           FontSize;
+    float           WrapWidth;
+    int             TextLength;
+    int             LastUsedFrame;              // ImDrawListSharedData::TextLayoutsFrame
+    ImVec2          Size;                       // ImFont::CalcTextSizeA(FontSize, FLT_MAX, WrapWidth, ...) result, before rounding
+    int             WrapBreaksOffset;           // Range in ImDrawListSharedData::TextLayoutWrapBreaks: end of each wrapped line, as returned by ImFont::CalcWordWrapPositionA()
+    int             WrapBreaksCount;            // 0 when not wrapped. May only cover the first lines when the cache ran out of room for them.
+};
+
 // Data shared between all ImDrawList instances
 // Conceptually this could have been called e.g. ImDrawListSharedContext
 // Typically one ImGui context would create and maintain one of this.
@@ -797,8 +865,33 @@ struct IMGUI_API ImDrawListSharedData
     float           ArcFastRadiusCutoff;                        // Cutoff radius after which arc drawing will fallback to slower PathArcTo()
     ImU8            CircleSegmentCounts[64];    // Precomputed segment count for given radius before we calculate it dynamically (to avoid calculation overhead)
 
+    // Shape templates
+    ImVector<ImDrawShapeTemplate>   ShapeTemplates;     // IM_DRAWLIST_SHAPE_TEMPLATES_SLOTS entries once used
+    ImVec2                          ShapeTemplatesTexUvWhitePixel;  // Atlas uv the templates were recorded with
+    const ImVec4*                   ShapeTemplatesTexUvLines;
+    ImVector<ImDrawVert>            ShapeTemplateVtx;   // Positions relative to their anchor (rectangle corner or circle center), anchor index in the low bits of 'col'
+    ImVector<ImDrawIdx>             ShapeTemplateIdx;   // Relative to the first vertex of their template
+
+    // Text layouts
+    ImVector<ImDrawTextLayout>      TextLayouts;        // Hash table, IM_DRAWLIST_TEXT_LAYOUTS_SLOTS_MIN..MAX slots once used
+    ImVector<int>                   TextLayoutWrapBreaks;
+    int                             TextLayoutsCount;
+    int                             TextLayoutsFrame;   // Incremented by UpdateTextLayouts(), once per frame
+    bool                            TextLayoutsSwept;   // Swept to make room during this frame
+    int                             TextLayoutsBypassUntilFrame;    // Cache not used before this frame: more texts were measured in a frame than the table can hold
+    int                             TextLayoutsBackoff; // Frames to bypass the cache for on the next overflow, doubles while overflowing
+    const ImFontAtlas*              TextLayoutsAtlas;   // Atlas and ImFontAtlas::GlyphsVersion the layouts were measured with
+    int                             TextLayoutsAtlasGlyphsVersion;
+    int                             TextLayoutsHits;    // Statistics, cumulative
+    int                             TextLayoutsMisses;
+
     ImDrawListSharedData();
     void SetCircleTessellationMaxError(float max_error);
+    void ClearShapeTemplates();
+    void ClearTextLayouts();
+    void UpdateTextLayouts();
+    ImVec2 CalcTextLayoutSize(ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end);
+    const ImDrawTextLayout* FindTextLayout(const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end);
 };
 
 struct ImDrawDataBuilder
@@ -1278,6 +1371,53 @@ struct ImGuiLastItemData
     ImGuiLastItemData()     { memset(this, 0, sizeof(*this)); }
 };
 
+// One draw command of a retained region, relative to the region's own index buffer
+struct ImGuiRetainedDrawCmd
+{
+    ImVec4                  ClipRect;
+    ImTextureID             TextureId;
+    float                   SdfThreshold;
+    float                   SdfAlphaPerTexel;
+    unsigned int            ElemCount;
+};
+
+// Storage for BeginRetained()/EndRetained()
+struct IMGUI_API ImGuiRetainedRegion
+{
+    ImGuiID                 ID;
+    ImGuiID                 Fingerprint;        // Hash of everything the cached output depends on
+    bool                    Valid;              // Cached output can be replayed (false until recorded once, after InvalidateRetained() or when the output couldn't be cached)
+    float                   LastTimeActive;     // For garbage collection
+
+    // Recording state, between BeginRetained() and EndRetained()
+    ImGuiWindow*            Window;
+    int                     CmdStart;
+    int                     VtxStart;
+    int                     IdxStart;
+    unsigned int            VtxCurrentIdxStart;
+    unsigned int            VtxOffsetStart;
+
+    // Cached output
+    ImVector<ImDrawVert>    VtxBuffer;
+    ImVector<ImDrawIdx>     IdxBuffer;          // Relative to VtxBuffer[0]
+    ImVector<ImGuiRetainedDrawCmd> Cmds;
+
+    // Layout state after the region, restored when replaying
+    ImVec2                  CursorPos;
+    ImVec2                  CursorPosPrevLine;
+    ImVec2                  CursorMaxPos;
+    ImVec2                  IdealMaxPos;
+    ImVec2                  CurrLineSize;
+    ImVec2                  PrevLineSize;
+    float                   CurrLineTextBaseOffset;
+    float                   PrevLineTextBaseOffset;
+    bool                    IsSameLine;
+    bool                    IsSetPos;
+    ImGuiLastItemData       LastItemData;
+
+    ImGuiRetainedRegion()   { ID = Fingerprint = 0; Valid = false; LastTimeActive = -1.0f; Window = NULL; CmdStart = VtxStart = IdxStart = 0; VtxCurrentIdxStart = VtxOffsetStart = 0; CurrLineTextBaseOffset = PrevLineTextBaseOffset = 0.0f; IsSameLine = IsSetPos = false; }
+};
+
 // Store data emitted by TreeNode() for usage by TreePop()
 // - To implement ImGuiTreeNodeFlags_NavLeftJumpsBackHere: store the minimum amount of data
 //   which we can't infer in TreePop(), to perform the equivalent of NavApplyItemToResult().
@@ -1979,6 +2119,14 @@ struct ImGuiDockContext
 // [SECTION] Viewport support
 //-----------------------------------------------------------------------------
 
+// Draw list submitted to a viewport on the previous frame, for damage tracking (ImGuiBackendFlags_RendererHasDamageRects)
+struct ImGuiViewportDamageEntry
+{
+    ImDrawList*         DrawList;
+    ImU64               Hash;                   // Hash of commands, vertices and indices
+    ImRect              Bounds;                 // Vertices bounding box clipped by the commands clip rectangles
+};
+
 // ImGuiViewport Private/Internals fields (cardinal sin: we are using inheritance!)
 // Every instance of ImGuiViewport is in fact a ImGuiViewportP.
 struct ImGuiViewportP : public ImGuiViewport
@@ -2002,6 +2150,12 @@ struct ImGuiViewportP : public ImGuiViewport
     ImVec2              LastPlatformSize;
     ImVec2              LastRendererSize;
 
+    // Damage tracking (when ImGuiBackendFlags_RendererHasDamageRects is set)
+    ImVector<ImGuiViewportDamageEntry> DamageEntries; // Draw lists of the previous frame, in display order
+    ImRect              DamageLastRect;         // Viewport rectangle on the previous frame, any change damages the whole viewport
+    ImVec2              DamageLastFramebufferScale;
+    bool                DamageEntriesValid;     // Set once DamageEntries was filled, cleared when the flag is not set
+
     // Per-viewport work area
     // - Insets are >= 0.0f values, distance from viewport corners to work area.
     // - BeginMainMenuBar() and DockspaceOverViewport() tend to use work area to avoid stepping over existing contents.
@@ -2011,7 +2165,7 @@ struct ImGuiViewportP : public ImGuiViewport
     ImVec2              BuildWorkInsetMin;      // Work Area inset accumulator for current frame, to become next frame's WorkInset
     ImVec2              BuildWorkInsetMax;      // "
 
-    ImGuiViewportP()                    { Window = NULL; Idx = -1; LastFrameActive = BgFgDrawListsLastFrame[0] = BgFgDrawListsLastFrame[1] = LastFocusedStampCount = -1; LastNameHash = 0; Alpha = LastAlpha = 1.0f; LastFocusedHadNavWindow = false; PlatformMonitor = -1; BgFgDrawLists[0] = BgFgDrawLists[1] = NULL; LastPlatformPos = LastPlatformSize = LastRendererSize = ImVec2(FLT_MAX, FLT_MAX); }
+    ImGuiViewportP()                    { Window = NULL; Idx = -1; LastFrameActive = BgFgDrawListsLastFrame[0] = BgFgDrawListsLastFrame[1] = LastFocusedStampCount = -1; LastNameHash = 0; Alpha = LastAlpha = 1.0f; LastFocusedHadNavWindow = false; PlatformMonitor = -1; BgFgDrawLists[0] = BgFgDrawLists[1] = NULL; LastPlatformPos = LastPlatformSize = LastRendererSize = ImVec2(FLT_MAX, FLT_MAX); DamageEntriesValid = false; }
     ~ImGuiViewportP()                   { if (BgFgDrawLists[0]) IM_DELETE(BgFgDrawLists[0]); if (BgFgDrawLists[1]) IM_DELETE(BgFgDrawLists[1]); }
     void    ClearRequestFlags()         { PlatformRequestClose = PlatformRequestMove = PlatformRequestResize = false; }
 
@@ -2475,6 +2629,12 @@ struct ImGuiContext
     ImVector<ImGuiMultiSelectTempData> MultiSelectTempData;
     ImPool<ImGuiMultiSelectState>   MultiSelectStorage;
 
+    // Retained regions
+    ImGuiRetainedRegion*            CurrentRetained;            // Region being recorded, between BeginRetained() and EndRetained()
+    ImPool<ImGuiRetainedRegion>     RetainedRegions;
+    ImGuiStyle                      RetainedStyle;              // Copy of the style hashed into RetainedStyleHash, hashing the whole style for every region would cost more than most replays save
+    ImGuiID                         RetainedStyleHash;
+
     // Hover Delay system
     ImGuiID                 HoverItemDelayId;
     ImGuiID                 HoverItemDelayIdPreviousFrame;
@@ -2591,6 +2751,12 @@ struct ImGuiContext
     ImGuiDebugAllocInfo     DebugAllocInfo;
     ImGuiDockNode*          DebugHoveredDockNode;               // Hovered dock node.
 
+    // Idle state (io.ConfigIdleSkipFrames)
+    int                     IdleLastBusyFrame;                  // Last frame which required producing the next frame
+    double                  IdleWakeUpTime;                     // Earliest time a frame is required without inputs, as computed by EndFrame()
+    double                  IdleWakeUpRequestTime;              // Earliest time requested by RequestIdleWakeUp()
+    const char*             IdleBusyReason;                     // [Debug] Why IdleLastBusyFrame was last updated
+
     // Misc
     float                   FramerateSecPerFrame[60];           // Calculate estimate of framerate for user over the last 60 frames..
     int                     FramerateSecPerFrameIdx;
@@ -3852,6 +4018,9 @@ IMGUI_API void      ImFontAtlasBuildInit(ImFontAtlas* atlas);
 IMGUI_API void      ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent);
 IMGUI_API void      ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opaque);
 IMGUI_API void      ImFontAtlasBuildFinish(ImFontAtlas* atlas);
+IMGUI_API ImGuiID   ImFontAtlasBuildGetInputHash(ImFontAtlas* atlas);
+IMGUI_API void      ImFontAtlasUpdateDynamicGlyphs(ImFontAtlas* atlas);
+IMGUI_API void      ImFontAtlasDestroyDynamicGlyphs(ImFontAtlas* atlas);
 IMGUI_API void      ImFontAtlasBuildRender8bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned char in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned int in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
@@ -0,0 +1,183 @@
+// Dear ImGui: batched ImDrawList primitives, equivalence check and benchmark
+
+// Submits the same heatmap / line / scatter data once through individual AddRectFilled()/AddLine()/AddCircleFilled() calls
+// and once through the *Batch() functions, then compares the resulting draw lists and prints the time of both.
+// Rects and lines have to match bit for bit. Circles have to match in layout (commands, indices, colors, uvs) and may
+// differ by a tiny amount in vertex positions, see AddCircleFilledBatch().
+//
+// Usage: bench_batch [iterations]      (default: 50)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct BatchData
+{
+    ImVector<ImVec2>    A;
+    ImVector<ImVec2>    B;
+    ImVector<ImU32>     Cols;
+};
+
+// Every 16th element is fully transparent, both paths have to skip those.
+static void GenerateData(BatchData& data, int count, unsigned int seed)
+{
+    data.A.resize(count);
+    data.B.resize(count);
+    data.Cols.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        ImVec2 p((float)((seed >> 4) % 1280) + 0.25f, (float)((seed >> 16) % 800) + 0.75f);
+        data.A[i] = p;
+        data.B[i] = ImVec2(p.x + (float)((seed >> 8) & 31) - 8.0f, p.y + (float)((seed >> 20) & 31) - 4.0f);
+        data.Cols[i] = (i % 16 == 15) ? (seed & 0x00FFFFFF) : (seed | IM_COL32_A_MASK);
+    }
+}
+
+enum Primitive { Primitive_Rect, Primitive_Line, Primitive_ThickLine, Primitive_Circle };
+
+static void Submit(ImDrawList* draw_list, const BatchData& data, Primitive primitive, bool batched)
+{
+    const int count = data.A.Size;
+    switch (primitive)
+    {
+    case Primitive_Rect:
+        if (batched)
+            draw_list->AddRectFilledBatch(data.A.Data, data.B.Data, data.Cols.Data, count);
+        else
+            for (int i = 0; i < count; i++)
+                draw_list->AddRectFilled(data.A[i], data.B[i], data.Cols[i]);
+        break;
+    case Primitive_Line:
+    case Primitive_ThickLine:
+    {
+        const float thickness = primitive == Primitive_Line ? 1.0f : 3.5f;
+        if (batched)
+            draw_list->AddLineBatch(data.A.Data, data.B.Data, data.Cols.Data, count, thickness);
+        else
+            for (int i = 0; i < count; i++)
+                draw_list->AddLine(data.A[i], data.B[i], data.Cols[i], thickness);
+        break;
+    }
+    case Primitive_Circle:
+        if (batched)
+            draw_list->AddCircleFilledBatch(data.A.Data, data.Cols.Data, count, 3.0f);
+        else
+            for (int i = 0; i < count; i++)
+                draw_list->AddCircleFilled(data.A[i], 3.0f, data.Cols[i]);
+        break;
+    }
+}
+
+static void ResetDrawList(ImDrawList* draw_list, ImDrawListFlags flags)
+{
+    draw_list->_ResetForNewFrame();
+    draw_list->PushClipRectFullScreen();
+    draw_list->Flags = flags;
+}
+
+// Returns the largest vertex position difference, or -1.0f if anything but vertex positions differs.
+static float CompareDrawLists(const ImDrawList* a, const ImDrawList* b)
+{
+    if (a->CmdBuffer.Size != b->CmdBuffer.Size || a->VtxBuffer.Size != b->VtxBuffer.Size || a->IdxBuffer.Size != b->IdxBuffer.Size)
+        return -1.0f;
+    for (int i = 0; i < a->CmdBuffer.Size; i++)
+        if (a->CmdBuffer[i].VtxOffset != b->CmdBuffer[i].VtxOffset || a->CmdBuffer[i].IdxOffset != b->CmdBuffer[i].IdxOffset || a->CmdBuffer[i].ElemCount != b->CmdBuffer[i].ElemCount)
+            return -1.0f;
+    if (memcmp(a->IdxBuffer.Data, b->IdxBuffer.Data, (size_t)a->IdxBuffer.Size * sizeof(ImDrawIdx)) != 0)
+        return -1.0f;
+    float max_diff = 0.0f;
+    for (int i = 0; i < a->VtxBuffer.Size; i++)
+    {
+        const ImDrawVert& va = a->VtxBuffer[i];
+        const ImDrawVert& vb = b->VtxBuffer[i];
+        if (va.col != vb.col || va.uv.x != vb.uv.x || va.uv.y != vb.uv.y)
+            return -1.0f;
+        max_diff = ImMax(max_diff, ImMax(ImFabs(va.pos.x - vb.pos.x), ImFabs(va.pos.y - vb.pos.y)));
+    }
+    return max_diff;
+}
+
+struct BatchCase
+{
+    const char*         Name;
+    Primitive           Prim;
+    ImDrawListFlags     DrawListFlags;
+    bool                MustBeExact;
+};
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? atoi(argv[1]) : 50;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+    ImGui::NewFrame();
+
+    const ImDrawListFlags aa_flags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill | ImDrawListFlags_AllowVtxOffset;
+    const BatchCase cases[] =
+    {
+        { "rect_filled",        Primitive_Rect,         aa_flags,                                                           true },
+        { "line_aa_tex",        Primitive_Line,         aa_flags,                                                           true },
+        { "line_aa",            Primitive_Line,         aa_flags & ~ImDrawListFlags_AntiAliasedLinesUseTex,                 true },
+        { "line_thick_aa",      Primitive_ThickLine,    aa_flags,                                                           true },
+        { "line_no_aa",         Primitive_Line,         ImDrawListFlags_AllowVtxOffset,                                     true },
+        { "circle_filled_aa",   Primitive_Circle,       aa_flags,                                                           false },
+        { "circle_filled",      Primitive_Circle,       ImDrawListFlags_AllowVtxOffset,                                     true },
+    };
+
+    BatchData data;
+    GenerateData(data, 50000, 1234);
+    ImDrawList single(ImGui::GetDrawListSharedData());
+    ImDrawList batched(ImGui::GetDrawListSharedData());
+    int failures = 0;
+    for (const BatchCase& c : cases)
+    {
+        ImU64 single_ns = 0, batched_ns = 0;
+        for (int run = 0; run < iterations; run++)
+        {
+            ResetDrawList(&single, c.DrawListFlags);
+            ImU64 t0 = NowNs();
+            Submit(&single, data, c.Prim, false);
+            ImU64 t1 = NowNs();
+            ResetDrawList(&batched, c.DrawListFlags);
+            ImU64 t2 = NowNs();
+            Submit(&batched, data, c.Prim, true);
+            ImU64 t3 = NowNs();
+            single_ns += t1 - t0;
+            batched_ns += t3 - t2;
+        }
+
+        const float max_diff = CompareDrawLists(&single, &batched);
+        const bool ok = c.MustBeExact ? (max_diff == 0.0f) : (max_diff >= 0.0f && max_diff < 0.001f);
+        failures += ok ? 0 : 1;
+        printf("%-18s %s (max pos diff %g, %d cmds, %d vtx)  single %8.1f us  batched %8.1f us  x%.2f\n", c.Name, ok ? "same" : "DIFFERS", max_diff,
+            batched.CmdBuffer.Size, batched.VtxBuffer.Size, single_ns / 1000.0 / iterations, batched_ns / 1000.0 / iterations, batched_ns > 0 ? (double)single_ns / batched_ns : 0.0);
+    }
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds and runs bench_batch.cpp: compares batched ImDrawList primitives against individual calls and prints both timings.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o bench_batch bench_batch.cpp
+./bench_batch "${1:-50}"
@@ -0,0 +1,194 @@
+// Dear ImGui: concave polygon triangulation, correctness check and scaling benchmark
+//
+// Triangulates polygons of 100, 1k, 10k and 100k points with ear clipping (ImTriangulator, default) and with monotone
+// decomposition (ImTriangulatorMonotone, ImDrawFlags_TriangulateMonotone), and checks that both cover the polygon exactly:
+// (N - 2) triangles, all with the polygon winding, whose areas add up to the polygon area.
+// Polygons are a noisy blob (most vertices reflex, like a map outline) and a comb (many edges crossing every horizontal line).
+// Also times AddConcavePolyFilled() with anti-aliasing for both. bench_concave.sh builds with 32-bit indices for the 100k case.
+//
+// Usage: bench_concave [max_points]      (default: 100000)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+enum Shape { Shape_Blob, Shape_Comb };
+
+static void GeneratePolygon(ImVector<ImVec2>& points, Shape shape, int count, unsigned int seed)
+{
+    points.resize(count);
+    if (shape == Shape_Blob)
+    {
+        // Star-shaped around the center, random radius per point: simple, with about half the vertices reflex.
+        for (int i = 0; i < count; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            const float a = IM_PI * 2.0f * i / count;
+            const float r = 300.0f + (float)((seed >> 8) % 1000) * 0.08f;
+            points[i] = ImVec2(640.0f + ImCos(a) * r, 400.0f + ImSin(a) * r);
+        }
+    }
+    else
+    {
+        // Teeth hanging from a horizontal bar, 4 points per tooth. Generated counter-clockwise on screen then reversed, as ear
+        // clipping expects clockwise polygons.
+        const int teeth = count / 4;
+        const float w = 1000.0f / teeth;
+        int n = 0;
+        for (int t = 0; t < teeth; t++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            const float x = 100.0f + t * w;
+            const float depth = 200.0f + (float)((seed >> 8) % 400);
+            points[n++] = ImVec2(x + w * 0.50f, 200.0f + depth);
+            points[n++] = ImVec2(x + w * 0.75f, 200.0f + depth);
+            points[n++] = ImVec2(x + w * 0.75f, 200.0f);
+            points[n++] = ImVec2(x + w * 1.25f, 200.0f);
+        }
+        points.resize(n);
+        points.push_back(ImVec2(100.0f + teeth * w, 100.0f));
+        points.push_back(ImVec2(100.0f, 100.0f));
+        points.push_back(ImVec2(100.0f + w * 0.5f, 200.0f));
+        for (int i = 0, j = points.Size - 1; i < j; i++, j--)
+            ImSwap(points[i], points[j]);
+    }
+}
+
+static double SignedArea(const ImVec2& a, const ImVec2& b, const ImVec2& c)
+{
+    return ((double)b.x - a.x) * ((double)c.y - a.y) - ((double)c.x - a.x) * ((double)b.y - a.y);
+}
+
+// The triangles tile the polygon when they all have its winding and their areas add up to its area.
+static bool CheckTriangulation(const ImVector<ImVec2>& points, const unsigned int* triangles, int triangles_count)
+{
+    const int count = points.Size;
+    if (triangles_count != count - 2)
+        return false;
+    double polygon_area = 0.0;
+    for (int i = 1; i < count - 1; i++)
+        polygon_area += SignedArea(points[0], points[i], points[i + 1]);
+    double triangles_area = 0.0;
+    for (int t = 0; t < triangles_count; t++)
+    {
+        const unsigned int* tri = &triangles[t * 3];
+        if (tri[0] >= (unsigned int)count || tri[1] >= (unsigned int)count || tri[2] >= (unsigned int)count)
+            return false;
+        double area = SignedArea(points[tri[0]], points[tri[1]], points[tri[2]]);
+        if (area * polygon_area < 0.0 && ImFabs((float)area) > 1e-3f)
+            return false;
+        triangles_area += ImFabs((float)area);
+    }
+    return ImFabs((float)(triangles_area - ImFabs((float)polygon_area))) <= ImFabs((float)polygon_area) * 1e-5f;
+}
+
+static int TriangulateEarClipping(const ImVector<ImVec2>& points, ImVector<char>& scratch, ImVector<unsigned int>& out_triangles)
+{
+    scratch.resize(ImTriangulator::EstimateScratchBufferSize(points.Size));
+    out_triangles.resize((points.Size - 2) * 3);
+    ImTriangulator triangulator;
+    triangulator.Init(points.Data, points.Size, scratch.Data);
+    int triangles_count = 0;
+    while (triangulator._TrianglesLeft > 0)
+        triangulator.GetNextTriangle(&out_triangles[triangles_count++ * 3]);
+    return triangles_count;
+}
+
+static int TriangulateMonotone(const ImVector<ImVec2>& points, ImVector<char>& scratch, ImVector<unsigned int>& out_triangles)
+{
+    scratch.resize(ImTriangulatorMonotone::EstimateScratchBufferSize(points.Size));
+    ImTriangulatorMonotone triangulator;
+    if (!triangulator.Triangulate(points.Data, points.Size, scratch.Data))
+        return -1;
+    out_triangles.resize((points.Size - 2) * 3);
+    memcpy(out_triangles.Data, triangulator._Triangles, (size_t)out_triangles.Size * sizeof(unsigned int));
+    return triangulator._TrianglesCount;
+}
+
+int main(int argc, char** argv)
+{
+    const int max_points = argc > 1 ? atoi(argv[1]) : 100000;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+    ImGui::NewFrame();
+
+    const char* shape_names[] = { "blob", "comb" };
+    const int max_vtx = (sizeof(ImDrawIdx) == 2) ? 0xFFFF : 0x7FFFFFFF;
+    ImVector<ImVec2> points;
+    ImVector<char> scratch;
+    ImVector<unsigned int> triangles;
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    int failures = 0;
+    for (int shape = 0; shape < IM_ARRAYSIZE(shape_names); shape++)
+        for (int count = 100; count <= max_points; count *= 10)
+        {
+            GeneratePolygon(points, (Shape)shape, count, 1234);
+            const int runs = ImClamp(100000 / count, 1, 20);
+
+            // Triangulators alone, fastest run
+            ImU64 ear_ns = (ImU64)-1, monotone_ns = (ImU64)-1;
+            bool ear_ok = true, monotone_ok = true;
+            for (int run = 0; run < runs; run++)
+            {
+                ImU64 t0 = NowNs();
+                int ear_count = TriangulateEarClipping(points, scratch, triangles);
+                ear_ns = ImMin(ear_ns, NowNs() - t0);
+                ear_ok &= CheckTriangulation(points, triangles.Data, ear_count);
+                t0 = NowNs();
+                int monotone_count = TriangulateMonotone(points, scratch, triangles);
+                monotone_ns = ImMin(monotone_ns, NowNs() - t0);
+                monotone_ok &= CheckTriangulation(points, triangles.Data, monotone_count);
+            }
+            failures += (ear_ok && monotone_ok) ? 0 : 1;
+            printf("%s %6d pts: ear clipping %10.1f us %-4s  monotone %8.1f us %-4s  x%.1f\n", shape_names[shape], points.Size,
+                ear_ns / 1000.0, ear_ok ? "ok" : "BAD", monotone_ns / 1000.0, monotone_ok ? "ok" : "BAD", (double)ear_ns / monotone_ns);
+
+            // AddConcavePolyFilled(), anti-aliased (ear clipping only up to 10k points, it takes seconds above)
+            if (points.Size * 2 > max_vtx)
+                continue;
+            ImU64 fill_ns[2] = {};
+            for (int run = 0; run < runs; run++)
+                for (int n = (count > 10000) ? 1 : 0; n < 2; n++)
+                {
+                    draw_list._ResetForNewFrame();
+                    draw_list.PushClipRectFullScreen();
+                    draw_list.Flags = ImDrawListFlags_AntiAliasedFill | ImDrawListFlags_AllowVtxOffset;
+                    const ImU64 t0 = NowNs();
+                    draw_list.AddConcavePolyFilled(points.Data, points.Size, IM_COL32_WHITE, n ? ImDrawFlags_TriangulateMonotone : ImDrawFlags_None);
+                    fill_ns[n] = (run == 0) ? NowNs() - t0 : ImMin(fill_ns[n], NowNs() - t0);
+                }
+            if (count > 10000)
+                printf("%s %6d pts: AddConcavePolyFilled() %10s     with ImDrawFlags_TriangulateMonotone %8.1f us\n", shape_names[shape], points.Size, "-", fill_ns[1] / 1000.0);
+            else
+                printf("%s %6d pts: AddConcavePolyFilled() %10.1f us  with ImDrawFlags_TriangulateMonotone %8.1f us\n", shape_names[shape], points.Size, fill_ns[0] / 1000.0, fill_ns[1] / 1000.0);
+        }
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    printf("%s\n", failures == 0 ? "all triangulations ok" : "triangulation FAILED");
+    return failures == 0 ? 0 : 1;
+}
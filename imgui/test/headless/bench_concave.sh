@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds bench_concave.cpp with 32-bit indices, checks ear clipping and monotone triangulations and compares how they scale.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in "-DImDrawIdx=unsigned int" -o bench_concave bench_concave.cpp
+./bench_concave "${1:-100000}"
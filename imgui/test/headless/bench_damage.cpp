@@ -0,0 +1,149 @@
+// Dear ImGui: viewport damage rectangles (ImDrawData::DamageRects) check and benchmark
+
+// Renders two small windows and a foreground rectangle drawn in signed distance field mode, with
+// ImGuiBackendFlags_RendererHasDamageRects, and checks the damage reported for a sequence of frames:
+// the whole display on the first frame, nothing while nothing changes, only the first window when one of its labels
+// changes, only the foreground rectangle when only its SdfThreshold changes, and the whole display again once the
+// backend flag is cleared. Then prints the frame time of the demo window with and without damage tracking.
+//
+// Usage: bench_damage [iterations]      (default: 200)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include "imgui_demo.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const ImRect LEFT_RECT(20.0f, 20.0f, 320.0f, 220.0f);
+static const ImRect RIGHT_RECT(600.0f, 300.0f, 900.0f, 500.0f);
+static const ImRect SDF_RECT(1000.0f, 600.0f, 1100.0f, 700.0f);
+
+static ImDrawData* RenderFrame(const char* label, float sdf_threshold)
+{
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(LEFT_RECT.Min);
+    ImGui::SetNextWindowSize(LEFT_RECT.GetSize());
+    ImGui::Begin("Left", NULL, ImGuiWindowFlags_NoSavedSettings);
+    ImGui::TextUnformatted(label);
+    ImGui::Button("Button");
+    ImGui::End();
+    ImGui::SetNextWindowPos(RIGHT_RECT.Min);
+    ImGui::SetNextWindowSize(RIGHT_RECT.GetSize());
+    ImGui::Begin("Right", NULL, ImGuiWindowFlags_NoSavedSettings);
+    ImGui::TextUnformatted("Static text");
+    ImGui::End();
+    ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+    draw_list->_SetTextSdf(sdf_threshold, 0.1f);
+    draw_list->AddRectFilled(SDF_RECT.Min, SDF_RECT.Max, IM_COL32(255, 128, 0, 255));
+    draw_list->_SetTextSdf(0.0f, 0.0f);
+    ImGui::Render();
+    return ImGui::GetDrawData();
+}
+
+// Union of the damage rectangles, inverted when there are none.
+static ImRect DamageBounds(const ImDrawData* draw_data)
+{
+    ImRect bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (const ImVec4& rect : draw_data->DamageRects)
+        bounds.Add(ImRect(rect));
+    return bounds;
+}
+
+static bool Check(const char* name, bool ok, const ImDrawData* draw_data)
+{
+    const ImRect bounds = draw_data->DamageRects.Size > 0 ? DamageBounds(draw_data) : ImRect();
+    printf("%-22s %d rects, bounds (%6.1f,%6.1f)-(%6.1f,%6.1f): %s\n", name, draw_data->DamageRects.Size, bounds.Min.x, bounds.Min.y, bounds.Max.x, bounds.Max.y, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+static bool CheckDamageRects()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    const ImRect display_rect(ImVec2(0.0f, 0.0f), io.DisplaySize);
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasDamageRects;
+    bool ok = true;
+
+    ImDrawData* draw_data = RenderFrame("Label A", 0.5f);
+    ok &= Check("first frame", draw_data->DamageRects.Size == 1 && DamageBounds(draw_data).ToVec4() == display_rect.ToVec4(), draw_data);
+    for (int n = 0; n < 3; n++) // Let windows appear and settle
+        RenderFrame("Label A", 0.5f);
+    draw_data = RenderFrame("Label A", 0.5f);
+    ok &= Check("unchanged", draw_data->DamageRects.Size == 0, draw_data);
+
+    draw_data = RenderFrame("Label B", 0.5f);
+    ImRect bounds = DamageBounds(draw_data);
+    ImRect left_rect_with_border = LEFT_RECT; // Damage rectangles are rounded outward to whole pixels, the window border is antialiased
+    left_rect_with_border.Expand(4.0f);
+    ok &= Check("label changed", draw_data->DamageRects.Size > 0 && left_rect_with_border.Contains(bounds) && !bounds.Overlaps(RIGHT_RECT) && !bounds.Overlaps(SDF_RECT), draw_data);
+
+    draw_data = RenderFrame("Label B", 0.6f);
+    bounds = DamageBounds(draw_data);
+    ok &= Check("sdf threshold changed", draw_data->DamageRects.Size > 0 && bounds.Contains(SDF_RECT) && !bounds.Overlaps(LEFT_RECT) && !bounds.Overlaps(RIGHT_RECT), draw_data);
+
+    draw_data = RenderFrame("Label B", 0.6f);
+    ok &= Check("unchanged", draw_data->DamageRects.Size == 0, draw_data);
+
+    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasDamageRects;
+    draw_data = RenderFrame("Label B", 0.6f);
+    ok &= Check("no backend support", draw_data->DamageRects.Size == 1 && DamageBounds(draw_data).ToVec4() == display_rect.ToVec4(), draw_data);
+    return ok;
+}
+
+// Keeps the fastest frame, this machine may be shared.
+static double RunDemo(int iterations)
+{
+    ImU64 best_ns = (ImU64)-1;
+    for (int run = -2; run < iterations; run++)
+    {
+        const ImU64 t0 = NowNs();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+        ImGui::ShowDemoWindow();
+        ImGui::Render();
+        if (run >= 0)
+            best_ns = ImMin(best_ns, NowNs() - t0);
+    }
+    return best_ns / 1000.0;
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? ImMax(atoi(argv[1]), 1) : 200;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+
+    const bool ok = CheckDamageRects();
+
+    const double frame_us = RunDemo(iterations);
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasDamageRects;
+    const double damage_frame_us = RunDemo(iterations);
+    printf("demo %6d vtx  frame %8.1f us, with damage tracking %8.1f us, %d rects\n", ImGui::GetDrawData()->TotalVtxCount, frame_us, damage_frame_us, ImGui::GetDrawData()->DamageRects.Size);
+
+    ImGui::DestroyContext();
+    printf("%s\n", ok ? "output ok" : "output FAILED");
+    return ok ? 0 : 1;
+}
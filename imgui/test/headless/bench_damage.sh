@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds bench_damage.cpp, checks the damage rectangles reported for a scripted sequence of frames and times damage tracking on the demo window.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o bench_damage bench_damage.cpp
+./bench_damage "${1:-200}"
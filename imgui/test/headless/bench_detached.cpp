@@ -0,0 +1,194 @@
+// Dear ImGui: detached draw lists, equivalence check and benchmark
+
+// Draws a grid of waveform canvases into a window, once directly into the window draw list and once recorded on worker
+// threads into detached draw lists (ImGui::CreateDrawListSharedDataSnapshot(), ImDrawList::ResetDetached()) then spliced
+// into the window with ImDrawList::AddDrawList(). Canvases are recorded at their final position so both window draw lists
+// have to render the same triangles bit for bit. Prints the time of both.
+//
+// Usage: bench_detached [iterations] [threads]     (defaults: 50, 4)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <thread>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static ImU64 HashBytes(ImU64 hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    return hash;
+}
+
+// Hash what a renderer would draw: the vertices of every triangle in order, and the clip rectangle / texture whenever they change.
+// VtxOffset splits are not part of it, as splicing whole commands may start a new VtxOffset at a different vertex than direct recording.
+static ImU64 HashDrawListOutput(const ImDrawList* draw_list)
+{
+    ImU64 hash = 0xCBF29CE484222325ull;
+    const ImDrawCmd* prev_cmd = NULL;
+    for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+    {
+        if (cmd.ElemCount == 0)
+            continue;
+        if (prev_cmd == NULL || memcmp(&prev_cmd->ClipRect, &cmd.ClipRect, sizeof(ImVec4)) != 0 || prev_cmd->TextureId != cmd.TextureId)
+        {
+            hash = HashBytes(hash, &cmd.ClipRect, sizeof(cmd.ClipRect));
+            hash = HashBytes(hash, &cmd.TextureId, sizeof(cmd.TextureId));
+        }
+        for (unsigned int n = 0; n < cmd.ElemCount; n++)
+            hash = HashBytes(hash, &draw_list->VtxBuffer[cmd.VtxOffset + draw_list->IdxBuffer[cmd.IdxOffset + n]], sizeof(ImDrawVert));
+        prev_cmd = &cmd;
+    }
+    return hash;
+}
+
+static const int CANVAS_COUNT = 16;
+static const int CANVAS_POINTS = 4000;
+
+struct Canvas
+{
+    ImRect              Rect;
+    ImVector<float>     Samples;
+};
+
+static void DrawCanvas(ImDrawList* draw_list, const Canvas& canvas, int idx)
+{
+    const ImRect& r = canvas.Rect;
+    draw_list->AddRectFilled(r.Min, r.Max, IM_COL32(20, 20, 30, 255), 4.0f);
+    ImVec2 points[CANVAS_POINTS];
+    for (int n = 0; n < CANVAS_POINTS; n++)
+        points[n] = ImVec2(r.Min.x + r.GetWidth() * n / (CANVAS_POINTS - 1), r.GetCenter().y + canvas.Samples[n] * r.GetHeight() * 0.45f);
+    draw_list->AddPolyline(points, CANVAS_POINTS, IM_COL32(100, 220, 120, 255), ImDrawFlags_None, 1.5f);
+    draw_list->AddCircleFilled(points[CANVAS_POINTS / 2], 4.0f, IM_COL32(255, 200, 0, 255));
+    char label[32];
+    ImFormatString(label, IM_ARRAYSIZE(label), "channel %d", idx);
+    draw_list->AddText(ImVec2(r.Min.x + 4.0f, r.Min.y + 2.0f), IM_COL32_WHITE, label);
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? atoi(argv[1]) : 50;
+    const int thread_count = argc > 2 ? ImClamp(atoi(argv[2]), 1, CANVAS_COUNT) : 4;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+
+    Canvas canvases[CANVAS_COUNT];
+    unsigned int seed = 1234;
+    for (Canvas& canvas : canvases)
+    {
+        canvas.Samples.resize(CANVAS_POINTS);
+        for (float& sample : canvas.Samples)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            sample = (float)((seed >> 8) & 0xFFFF) / 32768.0f - 1.0f;
+        }
+    }
+
+    // One snapshot per worker thread, each canvas always recorded by the same thread.
+    // (Take new snapshots when the font or style changes.)
+    ImGui::NewFrame();
+    ImDrawListSharedData* snapshots[CANVAS_COUNT] = {};
+    ImDrawList* detached[CANVAS_COUNT] = {};
+    for (int t = 0; t < thread_count; t++)
+        snapshots[t] = ImGui::CreateDrawListSharedDataSnapshot();
+    for (int n = 0; n < CANVAS_COUNT; n++)
+        detached[n] = IM_NEW(ImDrawList)(snapshots[n % thread_count]);
+    ImGui::EndFrame();
+
+    ImU64 hashes[2] = {};
+    ImU64 total_ns[2] = {};
+    ImU64 record_ns = 0;
+    for (int run = 0; run < iterations * 2; run++)
+    {
+        const bool use_detached = (run & 1) != 0;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f));
+        ImGui::SetNextWindowSize(ImVec2(1260.0f, 780.0f));
+        ImGui::Begin("Canvases", NULL, ImGuiWindowFlags_NoSavedSettings);
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        for (int n = 0; n < CANVAS_COUNT; n++)
+            canvases[n].Rect = ImRect(origin + ImVec2((n % 4) * 310.0f, (n / 4) * 185.0f), origin + ImVec2((n % 4) * 310.0f + 300.0f, (n / 4) * 185.0f + 175.0f));
+
+        const ImU64 t0 = NowNs();
+        if (!use_detached)
+        {
+            for (int n = 0; n < CANVAS_COUNT; n++)
+            {
+                draw_list->PushClipRect(canvases[n].Rect.Min, canvases[n].Rect.Max, true);
+                DrawCanvas(draw_list, canvases[n], n);
+                draw_list->PopClipRect();
+            }
+        }
+        else
+        {
+            // Record on worker threads
+            std::thread threads[CANVAS_COUNT];
+            for (int t = 0; t < thread_count; t++)
+                threads[t] = std::thread([&, t]()
+                {
+                    for (int n = t; n < CANVAS_COUNT; n += thread_count)
+                    {
+                        detached[n]->ResetDetached();
+                        DrawCanvas(detached[n], canvases[n], n);
+                    }
+                });
+            for (int t = 0; t < thread_count; t++)
+                threads[t].join();
+            record_ns += NowNs() - t0;
+
+            // Splice on the main thread
+            for (int n = 0; n < CANVAS_COUNT; n++)
+            {
+                draw_list->PushClipRect(canvases[n].Rect.Min, canvases[n].Rect.Max, true);
+                draw_list->AddDrawList(detached[n]);
+                draw_list->PopClipRect();
+            }
+        }
+        total_ns[use_detached ? 1 : 0] += NowNs() - t0;
+        ImGui::End();
+        ImGui::Render();
+        if (run >= iterations * 2 - 2)
+            hashes[use_detached ? 1 : 0] = HashDrawListOutput(draw_list);
+    }
+
+    const bool same = hashes[0] == hashes[1];
+    printf("direct   %8.1f us\n", total_ns[0] / 1000.0 / iterations);
+    printf("detached %8.1f us (record on %d threads %.1f us, splice %.1f us)  x%.2f\n", total_ns[1] / 1000.0 / iterations, thread_count,
+        record_ns / 1000.0 / iterations, (total_ns[1] - record_ns) / 1000.0 / iterations, total_ns[1] > 0 ? (double)total_ns[0] / total_ns[1] : 0.0);
+    printf("%s\n", same ? "output identical" : "output differs");
+
+    for (int n = 0; n < CANVAS_COUNT; n++)
+    {
+        if (detached[n] != NULL)
+            IM_DELETE(detached[n]);
+        if (snapshots[n] != NULL)
+            ImGui::DestroyDrawListSharedDataSnapshot(snapshots[n]);
+    }
+    ImGui::DestroyContext();
+    return same ? 0 : 1;
+}
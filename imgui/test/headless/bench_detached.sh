@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds bench_detached.cpp, checks that draw lists recorded on worker threads and spliced into a window match direct recording, and compares their timings.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -pthread -I ../../in -o bench_detached bench_detached.cpp
+./bench_detached "${1:-50}" "${2:-4}"
@@ -0,0 +1,216 @@
+// Dear ImGui: glyphs rasterized on demand (ImFontAtlasFlags_DynamicGlyphs) check and benchmark
+
+// Start-up: builds an atlas pre-baking every glyph of a font, then one baking only Basic Latin with ImFontAtlasFlags_DynamicGlyphs,
+// and prints their build time and texture memory (RGBA32, as uploaded by most backends).
+// Paging: draws every glyph of the font, one page of text per few frames, through a dynamic area too small to hold them all.
+// Checks that each page is resident on the frame after it was first drawn and stays resident while drawn, that every dynamic glyph
+// has the same metrics and pixels as the pre-baked one, and that TexDirtyRects covered every texture change.
+// Also checks that measuring text (without drawing it) is enough to have its missing glyphs rasterized on next frame.
+//
+// Usage: bench_dynamic_glyphs [font.ttf] [size]      (default: misc/fonts/DroidSans.ttf, 18)
+// With a CJK font, the pre-baked atlas uses GetGlyphRangesChineseFull() instead of every glyph of the font.
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const int PAGE_COLUMNS = 32;
+static const int DYNAMIC_TEX_HEIGHT = 256;
+
+struct AtlasStats
+{
+    ImU64   BuildNs;
+    int     Glyphs;
+    int     TexWidth, TexHeight;
+};
+
+static AtlasStats BuildAtlas(ImFontAtlas* atlas, const char* font_file, float size, const ImWchar* ranges)
+{
+    if (atlas->AddFontFromFileTTF(font_file, size, NULL, ranges) == NULL)
+        exit(1);
+    AtlasStats stats;
+    const ImU64 t0 = NowNs();
+    unsigned char* pixels;
+    atlas->GetTexDataAsRGBA32(&pixels, &stats.TexWidth, &stats.TexHeight);
+    stats.BuildNs = NowNs() - t0;
+    stats.Glyphs = atlas->Fonts[0]->Glyphs.Size;
+    return stats;
+}
+
+static void PrintStats(const char* name, const AtlasStats& stats)
+{
+    printf("%-10s build %8.2f ms, %5d glyphs, texture %4dx%-5d %7.2f MB\n", name, stats.BuildNs / 1000000.0, stats.Glyphs, stats.TexWidth, stats.TexHeight,
+        (double)stats.TexWidth * stats.TexHeight * 4 / (1024.0 * 1024.0));
+}
+
+// Same glyph metrics and the same pixels under the glyph quad
+static bool CompareGlyph(ImFontAtlas* atlas_a, const ImFontGlyph* a, ImFontAtlas* atlas_b, const ImFontGlyph* b)
+{
+    if (a->X0 != b->X0 || a->Y0 != b->Y0 || a->X1 != b->X1 || a->Y1 != b->Y1 || a->AdvanceX != b->AdvanceX || a->Visible != b->Visible)
+        return false;
+    const int ax = (int)IM_ROUND(a->U0 * atlas_a->TexWidth), ay = (int)IM_ROUND(a->V0 * atlas_a->TexHeight);
+    const int bx = (int)IM_ROUND(b->U0 * atlas_b->TexWidth), by = (int)IM_ROUND(b->V0 * atlas_b->TexHeight);
+    const int w = (int)IM_ROUND((a->U1 - a->U0) * atlas_a->TexWidth), h = (int)IM_ROUND((a->V1 - a->V0) * atlas_a->TexHeight);
+    if (w != (int)IM_ROUND((b->U1 - b->U0) * atlas_b->TexWidth) || h != (int)IM_ROUND((b->V1 - b->V0) * atlas_b->TexHeight))
+        return false;
+    for (int y = 0; y < h; y++)
+        if (memcmp(atlas_a->TexPixelsAlpha8 + ax + (ay + y) * atlas_a->TexWidth, atlas_b->TexPixelsAlpha8 + bx + (by + y) * atlas_b->TexWidth, (size_t)w) != 0)
+            return false;
+    return true;
+}
+
+static void BuildPageText(ImVector<char>& text, const ImVector<ImWchar>& codepoints, int page_begin, int page_end)
+{
+    text.resize(0);
+    for (int n = page_begin; n < page_end; n++)
+    {
+        char utf8[5];
+        for (const char* p = ImTextCharToUtf8(utf8, codepoints[n]); *p != 0; p++)
+            text.push_back(*p);
+        if ((n - page_begin) % PAGE_COLUMNS == PAGE_COLUMNS - 1)
+            text.push_back('\n');
+    }
+    text.push_back(0);
+}
+
+int main(int argc, char** argv)
+{
+    const char* font_file = argc > 1 ? argv[1] : "../../in/misc/fonts/DroidSans.ttf";
+    const float size = argc > 2 ? (float)atof(argv[2]) : 18.0f;
+
+    // Every codepoint of the font (or the Chinese ranges for a CJK font)
+    size_t font_data_size = 0;
+    unsigned char* font_data = (unsigned char*)ImFileLoadToMemory(font_file, "rb", &font_data_size);
+    stbtt_fontinfo font_info;
+    if (font_data == NULL || !stbtt_InitFont(&font_info, font_data, stbtt_GetFontOffsetForIndex(font_data, 0)))
+        return 1;
+    ImFontAtlas scratch_atlas;
+    const bool is_cjk = stbtt_FindGlyphIndex(&font_info, 0x4E00) != 0;
+    ImVector<ImWchar> codepoints;
+    const ImWchar* ranges = is_cjk ? scratch_atlas.GetGlyphRangesChineseFull() : NULL;
+    for (unsigned int c = 0x20; c <= 0xFFFF; c++)
+    {
+        bool requested = (ranges == NULL);
+        for (const ImWchar* r = ranges; r != NULL && r[0] != 0 && !requested; r += 2)
+            requested = (c >= r[0] && c <= r[1]);
+        if (requested && stbtt_FindGlyphIndex(&font_info, (int)c) != 0)
+            codepoints.push_back((ImWchar)c);
+    }
+    IM_FREE(font_data);
+    static const ImWchar all_codepoints_ranges[] = { 0x0020, 0xFFFF, 0 };
+    static const ImWchar latin_ranges[] = { 0x0020, 0x007E, 0 };
+
+    // Start-up
+    ImFontAtlas prebaked_atlas;
+    const AtlasStats prebaked_stats = BuildAtlas(&prebaked_atlas, font_file, size, is_cjk ? ranges : all_codepoints_ranges);
+    ImFontAtlas dynamic_atlas;
+    dynamic_atlas.Flags |= ImFontAtlasFlags_DynamicGlyphs;
+    dynamic_atlas.DynamicGlyphsTexHeight = DYNAMIC_TEX_HEIGHT;
+    const AtlasStats dynamic_stats = BuildAtlas(&dynamic_atlas, font_file, size, latin_ranges);
+    printf("%s %.0fpx, %d codepoints\n", font_file, size, codepoints.Size);
+    PrintStats("pre-baked", prebaked_stats);
+    PrintStats("dynamic", dynamic_stats);
+
+    // Paging
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext(&dynamic_atlas);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1920.0f, 1080.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexDirtyRects; // Dirty rectangles are uploaded to the shadow texture below
+    ImFont* dynamic_font = dynamic_atlas.Fonts[0];
+    ImFont* prebaked_font = prebaked_atlas.Fonts[0];
+    const ImFontAtlasDynamicGlyphs* dyn = dynamic_atlas.DynamicGlyphs;
+
+    // Pages of half the number of cells: the previous page is protected from eviction while the next one is rasterized
+    const ImFontDynamicGlyphsFontData& cells = dyn->FontData[0];
+    const int cells_count = cells.CellsPerRow * ((dynamic_atlas.TexHeight - dyn->AreaY) / cells.CellHeight);
+    const int page_glyphs = cells_count / 2;
+    printf("dynamic area: %d rows, %d cells of %dx%d, pages of %d glyphs\n", dynamic_atlas.TexHeight - dyn->AreaY, cells_count, cells.CellWidth, cells.CellHeight, page_glyphs);
+
+    // Measuring text queues its missing glyphs too: the width is right from the next frame on, without drawing the text
+    ImWchar measure_codepoint = 0;
+    for (ImWchar c : codepoints)
+        if (c > latin_ranges[1] && dynamic_font->FindGlyphNoFallback(c) == NULL && measure_codepoint == 0)
+            measure_codepoint = c;
+    char measure_text[5];
+    ImTextCharToUtf8(measure_text, measure_codepoint);
+    float measure_widths[2];
+    for (int frame = 0; frame < 2; frame++)
+    {
+        ImGui::NewFrame();
+        measure_widths[frame] = dynamic_font->CalcTextSizeA(size, FLT_MAX, 0.0f, measure_text).x;
+        ImGui::Render();
+    }
+    const float prebaked_width = prebaked_font->CalcTextSizeA(size, FLT_MAX, 0.0f, measure_text).x;
+    const bool measure_ok = measure_widths[0] == dynamic_font->FallbackAdvanceX && measure_widths[1] == prebaked_width;
+    printf("measure: U+%04X width %.1f, then %.1f (pre-baked %.1f): %s\n", measure_codepoint, measure_widths[0], measure_widths[1], prebaked_width, measure_ok ? "ok" : "FAILED");
+    dynamic_atlas.TexDirtyRects.resize(0); // Already in the shadow copy below
+
+    // Shadow copy of the texture, only updated from TexDirtyRects like a backend would
+    ImVector<unsigned char> shadow_pixels;
+    shadow_pixels.resize(dynamic_atlas.TexWidth * dynamic_atlas.TexHeight);
+    memcpy(shadow_pixels.Data, dynamic_atlas.TexPixelsAlpha8, (size_t)shadow_pixels.Size);
+
+    ImVector<char> text;
+    int bad_resident = 0, bad_glyphs = 0, frames = 0;
+    ImU64 update_ns = 0;
+    for (int page_begin = 0; page_begin < codepoints.Size; page_begin += page_glyphs)
+    {
+        const int page_end = ImMin(page_begin + page_glyphs, codepoints.Size);
+        BuildPageText(text, codepoints, page_begin, page_end);
+        for (int frame = 0; frame < 3; frame++, frames++)
+        {
+            const ImU64 t0 = NowNs();
+            ImGui::NewFrame();
+            update_ns += NowNs() - t0;
+
+            // From the second frame on, every glyph of the page must be resident and identical to the pre-baked one
+            if (frame > 0)
+                for (int n = page_begin; n < page_end; n++)
+                {
+                    const ImFontGlyph* glyph = dynamic_font->FindGlyphNoFallback(codepoints[n]);
+                    if (glyph == NULL)
+                        bad_resident++;
+                    else if (!CompareGlyph(&dynamic_atlas, glyph, &prebaked_atlas, prebaked_font->FindGlyphNoFallback(codepoints[n])))
+                        bad_glyphs++;
+                }
+
+            ImGui::GetForegroundDrawList()->AddText(ImVec2(10.0f, 10.0f), IM_COL32_WHITE, text.Data);
+            ImGui::Render();
+            for (const ImFontAtlasRect& r : dynamic_atlas.TexDirtyRects)
+                for (int y = r.Y; y < r.Y + r.Height; y++)
+                    memcpy(shadow_pixels.Data + r.X + y * dynamic_atlas.TexWidth, dynamic_atlas.TexPixelsAlpha8 + r.X + y * dynamic_atlas.TexWidth, r.Width);
+            dynamic_atlas.TexDirtyRects.resize(0);
+        }
+    }
+    const bool shadow_ok = memcmp(shadow_pixels.Data, dynamic_atlas.TexPixelsAlpha8, (size_t)shadow_pixels.Size) == 0;
+
+    printf("paging: %d frames, %d glyphs rasterized, %d evicted, %.2f us per rasterized glyph (NewFrame)\n", frames, dyn->GlyphsAdded, dyn->GlyphsEvicted,
+        update_ns / 1000.0 / ImMax(dyn->GlyphsAdded, 1));
+    printf("paging: %d glyphs not resident when expected, %d glyphs different from pre-baked, dirty rects %s\n", bad_resident, bad_glyphs, shadow_ok ? "ok" : "MISSED CHANGES");
+
+    // Small fonts may fit in the dynamic area entirely, otherwise paging has to evict
+    int dynamic_codepoints = 0;
+    for (ImWchar c : codepoints)
+        if (c > latin_ranges[1])
+            dynamic_codepoints++;
+    const bool ok = measure_ok && bad_resident == 0 && bad_glyphs == 0 && shadow_ok && (dyn->GlyphsEvicted > 0 || dynamic_codepoints <= cells_count);
+    printf("%s\n", ok ? "output ok" : "output FAILED");
+    ImGui::DestroyContext();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds bench_dynamic_glyphs.cpp, compares start-up time and texture memory of pre-baked and dynamic glyphs, and checks LRU paging of a whole font.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o bench_dynamic_glyphs bench_dynamic_glyphs.cpp
+./bench_dynamic_glyphs "$@"
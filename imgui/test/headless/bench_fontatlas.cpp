@@ -0,0 +1,145 @@
+// Dear ImGui: font atlas build benchmark (ImFontAtlas::BuildParallelFor)
+
+// Builds an atlas with the fonts from misc/fonts at several sizes (or with a user provided font, e.g. a CJK font with
+// the full Chinese glyph ranges), serially and with a std::thread based BuildParallelFor on 1, 2, 4 and 8 threads.
+// Prints the best build time for each and checks that every build produces the same texture and glyphs.
+//
+// Usage: bench_fontatlas [iterations] [font.ttf]      (default: 5, fonts from misc/fonts)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static ImU64 HashBytes(ImU64 hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    return hash;
+}
+
+// Spawns (thread_count - 1) threads per call, the calling thread takes jobs as well.
+struct ThreadParallelFor
+{
+    int                 ThreadCount;
+
+    static void Run(ImFontAtlasJobFunc job_func, void* job_data, int job_count, void* user_data)
+    {
+        ThreadParallelFor* self = (ThreadParallelFor*)user_data;
+        std::atomic<int> next_job(0);
+        auto worker = [&]()
+        {
+            for (int job_i = next_job++; job_i < job_count; job_i = next_job++)
+                job_func(job_data, job_i);
+        };
+        std::vector<std::thread> threads;
+        for (int n = 1; n < self->ThreadCount; n++)
+            threads.emplace_back(worker);
+        worker();
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+};
+
+static const float FONT_SIZES[] = { 13.0f, 18.0f, 24.0f, 32.0f, 48.0f };
+
+static void AddFonts(ImFontAtlas* atlas, const char* user_font)
+{
+    static const ImWchar all_ranges[] = { 0x0020, 0xFFFF, 0 };
+    const char* fonts[] = { "../../in/misc/fonts/DroidSans.ttf", "../../in/misc/fonts/Cousine-Regular.ttf", "../../in/misc/fonts/Karla-Regular.ttf" };
+    for (float size : FONT_SIZES)
+    {
+        if (user_font != NULL)
+        {
+            if (atlas->AddFontFromFileTTF(user_font, size, NULL, atlas->GetGlyphRangesChineseFull()) == NULL)
+                exit(1);
+            continue;
+        }
+        for (const char* font : fonts)
+        {
+            ImFontConfig cfg;
+            cfg.OversampleH = 2;
+            cfg.RasterizerMultiply = (size < 16.0f) ? 1.2f : 1.0f;
+            if (atlas->AddFontFromFileTTF(font, size, &cfg, all_ranges) == NULL)
+                exit(1);
+        }
+    }
+}
+
+static ImU64 HashAtlas(ImFontAtlas* atlas)
+{
+    ImU64 hash = HashBytes(0xCBF29CE484222325ull, atlas->TexPixelsAlpha8, (size_t)atlas->TexWidth * atlas->TexHeight);
+    for (ImFont* font : atlas->Fonts)
+        hash = HashBytes(hash, font->Glyphs.Data, (size_t)font->Glyphs.size_in_bytes());
+    return hash;
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? atoi(argv[1]) : 5;
+    const char* user_font = argc > 2 ? argv[2] : NULL;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+
+    bool ok = true;
+    ImU64 serial_hash = 0;
+    const int thread_counts[] = { 0, 1, 2, 4, 8 };     // 0: no BuildParallelFor
+    for (int thread_count : thread_counts)
+    {
+        ThreadParallelFor parallel_for = { thread_count };
+        ImU64 best_ns = (ImU64)-1;
+        ImU64 hash = 0;
+        int glyphs_count = 0;
+        for (int run = 0; run < iterations; run++)
+        {
+            ImFontAtlas atlas;
+            AddFonts(&atlas, user_font);
+            if (thread_count > 0)
+            {
+                atlas.BuildParallelFor = ThreadParallelFor::Run;
+                atlas.BuildParallelForUserData = &parallel_for;
+            }
+            const ImU64 t0 = NowNs();
+            atlas.Build();
+            best_ns = ImMin(best_ns, NowNs() - t0);
+
+            hash = HashAtlas(&atlas);
+            glyphs_count = 0;
+            for (ImFont* font : atlas.Fonts)
+                glyphs_count += font->Glyphs.Size;
+            if (run == 0 && thread_count == 0)
+                printf("atlas %dx%d, %d fonts, %d glyphs\n", atlas.TexWidth, atlas.TexHeight, atlas.Fonts.Size, glyphs_count);
+        }
+
+        if (thread_count == 0)
+            serial_hash = hash;
+        else if (hash != serial_hash)
+            ok = false;
+        if (thread_count == 0)
+            printf("serial:     %8.2f ms  hash %016llx\n", best_ns / 1000000.0, (unsigned long long)hash);
+        else
+            printf("%d threads: %8.2f ms  hash %016llx\n", thread_count, best_ns / 1000000.0, (unsigned long long)hash);
+    }
+    printf("hardware threads: %d\n", (int)std::thread::hardware_concurrency());
+
+    printf("%s\n", ok ? "output ok" : "output FAILED");
+    ImGui::DestroyContext();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds bench_fontatlas.cpp, checks that parallel glyph rasterization gives the same atlas as a serial build and measures it on 1 to 8 threads.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -pthread -I ../../in -o bench_fontatlas bench_fontatlas.cpp
+./bench_fontatlas "$@"
@@ -0,0 +1,214 @@
+// Dear ImGui: font atlas cache (ImFontAtlas::SaveToMemory/LoadFromMemory) check and benchmark
+
+// Start-up: for each scene, measures adding the fonts and building the atlas (cold start), against adding the same fonts, reading
+// the cache file saved from the first build and loading it (cached start). Checks that the loaded atlas is identical to the built one:
+// texture, UVs, custom rectangles, glyphs, lookup tables and metrics.
+// Key: checks that a blob is rejected, leaving the atlas unbuilt, when a font setting changed or when the blob is truncated.
+//
+// Usage: bench_fontcache [iterations] [font.ttf]      (default: 10, fonts from misc/fonts; a user font is added with the full Chinese ranges)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const char* CACHE_FILENAME = "bench_fontcache.bin";
+
+struct Scene
+{
+    const char*     Name;
+    void            (*AddFonts)(ImFontAtlas* atlas, const char* user_font);
+};
+
+static void AddFontsDefault(ImFontAtlas* atlas, const char*)
+{
+    atlas->AddFontDefault();
+}
+
+// Three fonts at five sizes, plus a custom glyph and a custom rectangle
+static void AddFontsMisc(ImFontAtlas* atlas, const char*)
+{
+    static const ImWchar all_ranges[] = { 0x0020, 0xFFFF, 0 };
+    const char* fonts[] = { "../../in/misc/fonts/DroidSans.ttf", "../../in/misc/fonts/Cousine-Regular.ttf", "../../in/misc/fonts/Karla-Regular.ttf" };
+    const float sizes[] = { 13.0f, 18.0f, 24.0f, 32.0f, 48.0f };
+    for (float size : sizes)
+        for (const char* font : fonts)
+            if (atlas->AddFontFromFileTTF(font, size, NULL, all_ranges) == NULL)
+                exit(1);
+    atlas->AddCustomRectFontGlyph(atlas->Fonts[0], 0xE000, 13, 13, 15.0f, ImVec2(1.0f, -2.0f));
+    atlas->AddCustomRectRegular(64, 32);
+}
+
+static void AddFontsUser(ImFontAtlas* atlas, const char* user_font)
+{
+    if (atlas->AddFontFromFileTTF(user_font, 18.0f, NULL, atlas->GetGlyphRangesChineseFull()) == NULL)
+        exit(1);
+}
+
+template<typename T>
+static bool SameVector(const ImVector<T>& a, const ImVector<T>& b)
+{
+    return a.Size == b.Size && memcmp(a.Data, b.Data, (size_t)a.size_in_bytes()) == 0;
+}
+
+static bool SameAtlas(const ImFontAtlas* a, const ImFontAtlas* b)
+{
+    if (a->TexWidth != b->TexWidth || a->TexHeight != b->TexHeight || a->TexPixelsUseColors != b->TexPixelsUseColors || !a->TexReady || !b->TexReady)
+        return false;
+    if (memcmp(a->TexPixelsAlpha8, b->TexPixelsAlpha8, (size_t)a->TexWidth * a->TexHeight) != 0)
+        return false;
+    if (memcmp(&a->TexUvScale, &b->TexUvScale, sizeof(a->TexUvScale)) != 0 || memcmp(&a->TexUvWhitePixel, &b->TexUvWhitePixel, sizeof(a->TexUvWhitePixel)) != 0 || memcmp(a->TexUvLines, b->TexUvLines, sizeof(a->TexUvLines)) != 0)
+        return false;
+    if (a->CustomRects.Size != b->CustomRects.Size || a->PackIdMouseCursors != b->PackIdMouseCursors || a->PackIdLines != b->PackIdLines || a->Fonts.Size != b->Fonts.Size)
+        return false;
+    for (int n = 0; n < a->CustomRects.Size; n++)
+    {
+        const ImFontAtlasCustomRect& ra = a->CustomRects[n];
+        const ImFontAtlasCustomRect& rb = b->CustomRects[n];
+        if (ra.X != rb.X || ra.Y != rb.Y || ra.Width != rb.Width || ra.Height != rb.Height || ra.GlyphID != rb.GlyphID || ra.GlyphAdvanceX != rb.GlyphAdvanceX)
+            return false;
+        if ((ra.Font ? a->Fonts.find_index(ra.Font) : -1) != (rb.Font ? b->Fonts.find_index(rb.Font) : -1))
+            return false;
+    }
+    for (int n = 0; n < a->Fonts.Size; n++)
+    {
+        const ImFont* fa = a->Fonts[n];
+        const ImFont* fb = b->Fonts[n];
+        if (!SameVector(fa->Glyphs, fb->Glyphs) || !SameVector(fa->IndexPages, fb->IndexPages) || !SameVector(fa->IndexAdvanceX, fb->IndexAdvanceX) || !SameVector(fa->IndexLookup, fb->IndexLookup))
+            return false;
+        if (fa->FallbackGlyph - fa->Glyphs.Data != fb->FallbackGlyph - fb->Glyphs.Data || fa->FallbackAdvanceX != fb->FallbackAdvanceX || fa->FallbackChar != fb->FallbackChar)
+            return false;
+        if (fa->EllipsisChar != fb->EllipsisChar || fa->EllipsisCharCount != fb->EllipsisCharCount || fa->EllipsisWidth != fb->EllipsisWidth || fa->EllipsisCharStep != fb->EllipsisCharStep)
+            return false;
+        if (fa->FontSize != fb->FontSize || fa->Ascent != fb->Ascent || fa->Descent != fb->Descent || fa->MetricsTotalSurface != fb->MetricsTotalSurface || fa->ContainerAtlas != a || fb->ContainerAtlas != b)
+            return false;
+        if (memcmp(fa->Used4kPagesMap, fb->Used4kPagesMap, sizeof(fa->Used4kPagesMap)) != 0 || fb->DirtyLookupTables)
+            return false;
+    }
+    return true;
+}
+
+static bool RunScene(const Scene& scene, int iterations, const char* user_font)
+{
+    // Cold start, then save the cache file from the last build
+    ImU64 cold_ns = (ImU64)-1;
+    ImFontAtlas* built_atlas = NULL;
+    for (int run = 0; run < iterations; run++)
+    {
+        IM_DELETE(built_atlas);
+        const ImU64 t0 = NowNs();
+        built_atlas = IM_NEW(ImFontAtlas)();
+        scene.AddFonts(built_atlas, user_font);
+        built_atlas->Build();
+        cold_ns = ImMin(cold_ns, NowNs() - t0);
+    }
+    ImVector<unsigned char> blob;
+    if (!built_atlas->SaveToMemory(&blob))
+        return false;
+    FILE* f = ImFileOpen(CACHE_FILENAME, "wb");
+    if (f == NULL || fwrite(blob.Data, 1, (size_t)blob.Size, f) != (size_t)blob.Size)
+        return false;
+    fclose(f);
+
+    // Cached start
+    ImU64 cached_ns = (ImU64)-1, load_ns = (ImU64)-1, hash_ns = (ImU64)-1;
+    bool ok = true;
+    for (int run = 0; run < iterations; run++)
+    {
+        const ImU64 t0 = NowNs();
+        ImFontAtlas atlas;
+        scene.AddFonts(&atlas, user_font);
+        size_t data_size = 0;
+        void* data = ImFileLoadToMemory(CACHE_FILENAME, "rb", &data_size);
+        const ImU64 t1 = NowNs();
+        const bool loaded = atlas.LoadFromMemory(data, data_size);
+        const ImU64 t2 = NowNs();
+        IM_FREE(data);
+        cached_ns = ImMin(cached_ns, t2 - t0);
+        load_ns = ImMin(load_ns, t2 - t1);
+        ok &= loaded && SameAtlas(built_atlas, &atlas);
+
+        const ImU64 t3 = NowNs();
+        volatile ImGuiID hash = ImFontAtlasBuildGetInputHash(&atlas);
+        hash_ns = ImMin(hash_ns, NowNs() - t3);
+        IM_UNUSED(hash);
+    }
+
+    int glyphs_count = 0;
+    for (ImFont* font : built_atlas->Fonts)
+        glyphs_count += font->Glyphs.Size;
+    printf("%-8s %2d fonts, %6d glyphs, atlas %4dx%-5d blob %7.2f MB | cold %8.2f ms | cached %7.2f ms (LoadFromMemory %6.2f ms, key hash %6.2f ms) | x%.1f%s\n",
+        scene.Name, built_atlas->Fonts.Size, glyphs_count, built_atlas->TexWidth, built_atlas->TexHeight, blob.Size / (1024.0 * 1024.0),
+        cold_ns / 1000000.0, cached_ns / 1000000.0, load_ns / 1000000.0, hash_ns / 1000000.0, (double)cold_ns / cached_ns, ok ? "" : "  MISMATCH");
+    IM_DELETE(built_atlas);
+    remove(CACHE_FILENAME);
+    return ok;
+}
+
+// A blob must only be accepted for the exact same input
+static bool CheckKey()
+{
+    ImFontAtlas saved_atlas;
+    AddFontsMisc(&saved_atlas, NULL);
+    ImVector<unsigned char> blob;
+    saved_atlas.SaveToMemory(&blob);
+
+    // Variants 0-5 change one input or truncate the blob, variant 6 is the same input
+    int rejected = 0, accepted = 0;
+    const int variants_count = 7;
+    for (int variant = 0; variant < variants_count; variant++)
+    {
+        ImFontAtlas atlas;
+        if (variant == 0)
+            atlas.TexGlyphPadding = 2;
+        AddFontsMisc(&atlas, NULL);
+        if (variant == 1)
+            atlas.ConfigData[0].SizePixels += 1.0f;
+        if (variant == 2)
+            atlas.ConfigData[3].RasterizerMultiply = 1.2f;
+        if (variant == 3)
+            atlas.ConfigData[5].GlyphRanges = atlas.GetGlyphRangesDefault();
+        if (variant == 4)
+            atlas.AddCustomRectRegular(64, 33);
+        const size_t size = (variant == 5) ? (size_t)blob.Size - 1 : (size_t)blob.Size;
+        const bool loaded = atlas.LoadFromMemory(blob.Data, size);
+        if (variant < 6 && !loaded && !atlas.IsBuilt() && atlas.Build())
+            rejected++;
+        if (variant == 6 && loaded && SameAtlas(&saved_atlas, &atlas))
+            accepted++;
+    }
+    printf("key: %d/%d changed inputs or truncated blobs rejected, same input %s\n", rejected, variants_count - 1, accepted ? "accepted" : "REJECTED");
+    return rejected == variants_count - 1 && accepted == 1;
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? atoi(argv[1]) : 10;
+    const char* user_font = argc > 2 ? argv[2] : NULL;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+
+    const Scene scenes[] = { { "default", AddFontsDefault }, { "misc", AddFontsMisc }, { "user", AddFontsUser } };
+    bool ok = true;
+    for (const Scene& scene : scenes)
+        if (scene.AddFonts != AddFontsUser || user_font != NULL)
+            ok &= RunScene(scene, iterations, user_font);
+    ok &= CheckKey();
+
+    printf("%s\n", ok ? "output ok" : "output FAILED");
+    ImGui::DestroyContext();
+    return ok ? 0 : 1;
+}
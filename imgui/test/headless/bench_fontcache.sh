@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds bench_fontcache.cpp, compares cold and cached font atlas start-up and checks that cached atlases are identical to built ones.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o bench_fontcache bench_fontcache.cpp
+./bench_fontcache "$@"
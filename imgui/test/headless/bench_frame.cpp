@@ -0,0 +1,398 @@
+// Dear ImGui: headless frame benchmark, null platform and renderer
+
+// Replays scripted input (mouse sweeps, clicks, scrolling, typing) over a few scenes for N frames each:
+// - demo:    ShowDemoWindow()
+// - tables:  a sortable 12x100000 table with a clipper and a 24x400 table without
+// - text:    a 20000 lines text block in a scrolling child, and a multiline text input being typed into
+// - windows: 200 small windows with a few widgets each
+// Every scene runs in its own context. Each frame records the time of NewFrame(), user code, EndFrame() and Render(),
+// the vertex/index/command counts of the draw data and the allocations made through ImGui's allocator.
+//
+// Output: one JSON object per scene on stdout (averages over measured frames, first frames of a scene are warm-up),
+// and optionally one CSV line per frame.
+//
+// Usage: bench_frame [frames] [per_frame.csv]     (default: 600, no CSV)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include "imgui_demo.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//-----------------------------------------------------------------------------
+// Allocation counting, through ImGui::SetAllocatorFunctions()
+//-----------------------------------------------------------------------------
+
+struct AllocCounters
+{
+    ImU64   Count;
+    ImU64   Bytes;
+};
+
+static AllocCounters Allocs;
+
+static void* CountingAlloc(size_t size, void* user_data)
+{
+    IM_UNUSED(user_data);
+    Allocs.Count++;
+    Allocs.Bytes += size;
+    return malloc(size);
+}
+
+static void CountingFree(void* ptr, void* user_data)
+{
+    IM_UNUSED(user_data);
+    free(ptr);
+}
+
+//-----------------------------------------------------------------------------
+// Scenes
+//-----------------------------------------------------------------------------
+
+static const float WIDTH = 1280.0f;
+static const float HEIGHT = 800.0f;
+
+// Zig-zag over the whole display, one pixel row band at a time
+static ImVec2 MouseSweep(int frame)
+{
+    const int x = (frame * 23) % 2536;
+    return ImVec2(4.0f + (float)(x < 1268 ? x : 2536 - x), 4.0f + (float)((frame * 3) % 790));
+}
+
+static void ClickEvery(ImGuiIO& io, int frame, int period)
+{
+    if (frame % period == period / 2)
+        io.AddMouseButtonEvent(ImGuiMouseButton_Left, true);
+    if (frame % period == period / 2 + 2)
+        io.AddMouseButtonEvent(ImGuiMouseButton_Left, false);
+}
+
+// Demo
+static void DemoInput(ImGuiIO& io, int frame)
+{
+    const ImVec2 mouse = MouseSweep(frame);
+    io.AddMousePosEvent(mouse.x * 0.55f, mouse.y);
+    ClickEvery(io, frame, 40);
+    if (frame % 15 == 0)
+        io.AddMouseWheelEvent(0.0f, (frame / 300) % 2 ? 1.0f : -1.0f);
+}
+
+static void DemoDraw(int frame)
+{
+    ImGui::ShowDemoWindow();
+    if (frame == 0)
+    {
+        // Place the window and open every top-level section, clicks open more as the mouse sweeps over them
+        ImGui::SetWindowPos("Dear ImGui Demo", ImVec2(0.0f, 0.0f));
+        ImGui::SetWindowSize("Dear ImGui Demo", ImVec2(WIDTH * 0.55f, HEIGHT));
+        ImGui::Begin("Dear ImGui Demo");
+        const char* sections[] = { "Help", "Configuration", "Window options", "Widgets", "Layout & Scrolling", "Popups & Modal windows", "Tables & Columns", "Inputs & Focus" };
+        for (const char* section : sections)
+            ImGui::GetStateStorage()->SetInt(ImGui::GetID(section), 1);
+        ImGui::End();
+    }
+}
+
+// Tables
+static const int TABLE_ROWS = 100000;
+static const int TABLE_COLUMNS = 12;
+
+static void TablesInput(ImGuiIO& io, int frame)
+{
+    const ImVec2 mouse = MouseSweep(frame);
+    io.AddMousePosEvent(mouse.x, mouse.y * 0.6f);
+    if (frame % 100 == 50)      // Click a header to toggle sorting
+        io.AddMousePosEvent(60.0f + (frame / 100 % 6) * 100.0f, 38.0f);
+    ClickEvery(io, frame, 100);
+    io.AddMouseWheelEvent(0.0f, (frame / 200) % 2 ? 2.0f : -3.0f);
+}
+
+static void TablesDraw(int frame)
+{
+    IM_UNUSED(frame);
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(WIDTH, HEIGHT));
+    ImGui::Begin("Tables", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoMove);
+
+    const ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable | ImGuiTableFlags_Sortable
+        | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("big", TABLE_COLUMNS, flags, ImVec2(0.0f, HEIGHT * 0.55f)))
+    {
+        ImGui::TableSetupScrollFreeze(1, 1);
+        for (int column = 0; column < TABLE_COLUMNS; column++)
+        {
+            char label[16];
+            ImFormatString(label, IM_ARRAYSIZE(label), "Column %d", column);
+            ImGui::TableSetupColumn(label, column == 0 ? ImGuiTableColumnFlags_DefaultSort : ImGuiTableColumnFlags_None);
+        }
+        ImGui::TableHeadersRow();
+
+        // Rows are generated, sorting only decides which end to start from
+        ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs();
+        const bool descending = sort_specs && sort_specs->SpecsCount > 0 && sort_specs->Specs[0].SortDirection == ImGuiSortDirection_Descending;
+        if (sort_specs)
+            sort_specs->SpecsDirty = false;
+
+        ImGuiListClipper clipper;
+        clipper.Begin(TABLE_ROWS);
+        while (clipper.Step())
+            for (int row_n = clipper.DisplayStart; row_n < clipper.DisplayEnd; row_n++)
+            {
+                const int row = descending ? TABLE_ROWS - 1 - row_n : row_n;
+                ImGui::TableNextRow();
+                for (int column = 0; column < TABLE_COLUMNS; column++)
+                {
+                    ImGui::TableSetColumnIndex(column);
+                    if (column == 0)
+                        ImGui::Text("%06d", row);
+                    else if (column == 1)
+                        ImGui::SmallButton("Edit");
+                    else
+                        ImGui::Text("%.3f", (float)((row * 31 + column * 17) % 1000) * 0.001f);
+                }
+            }
+        ImGui::EndTable();
+    }
+
+    if (ImGui::BeginTable("grid", 24, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY))
+    {
+        for (int row = 0; row < 400; row++)
+        {
+            ImGui::TableNextRow();
+            for (int column = 0; column < 24; column++)
+            {
+                ImGui::TableSetColumnIndex(column);
+                ImGui::Text("%d:%d", row, column);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+// Text
+static ImGuiTextBuffer TextLog;
+static char TextInput[1 << 18];
+
+static void TextSetup()
+{
+    TextLog.clear();
+    for (int line = 0; line < 20000; line++)
+        TextLog.appendf("[%05d] The quick brown fox jumps over the lazy dog, line %d of the log, value %.4f\n", line, line, line * 0.1234f);
+    int len = 0;
+    for (int line = 0; line < 4000 && len < (int)sizeof(TextInput) - 128; line++)
+        len += ImFormatString(TextInput + len, sizeof(TextInput) - len, "Line %d: some text being edited in a multiline input.\n", line);
+}
+
+static void TextInputEvents(ImGuiIO& io, int frame)
+{
+    // Move the text cursor to the end once the input is focused, then type
+    io.AddMousePosEvent(200.0f, 200.0f + (float)((frame * 3) % 400));
+    if (frame == 2 || frame == 3)
+    {
+        io.AddKeyEvent(ImGuiMod_Ctrl, frame == 2);
+        io.AddKeyEvent(ImGuiKey_End, frame == 2);
+    }
+    else if (frame > 3)
+    {
+        if (frame % 40 == 0 || frame % 40 == 1)
+            io.AddKeyEvent(ImGuiKey_Enter, frame % 40 == 0);
+        else
+            io.AddInputCharacter((unsigned int)('a' + frame % 26));
+    }
+    io.AddMouseWheelEvent(0.0f, (frame / 250) % 2 ? 3.0f : -4.0f);
+}
+
+static void TextDraw(int frame)
+{
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(WIDTH, HEIGHT));
+    ImGui::Begin("Text", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoMove);
+    ImGui::BeginChild("log", ImVec2(WIDTH * 0.5f, 0.0f), ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar);
+    ImGui::TextUnformatted(TextLog.begin(), TextLog.end());
+    ImGui::EndChild();
+    ImGui::SameLine();
+    if (frame == 0)
+        ImGui::SetKeyboardFocusHere();
+    ImGui::InputTextMultiline("##input", TextInput, IM_ARRAYSIZE(TextInput), ImVec2(-FLT_MIN, -FLT_MIN));
+    ImGui::End();
+}
+
+// Windows
+static const int WINDOW_COUNT = 200;
+static float WindowValues[WINDOW_COUNT];
+static bool WindowChecks[WINDOW_COUNT];
+
+static void WindowsInput(ImGuiIO& io, int frame)
+{
+    const ImVec2 mouse = MouseSweep(frame);
+    io.AddMousePosEvent(mouse.x, mouse.y);
+    ClickEvery(io, frame, 12);
+}
+
+static void WindowsDraw(int frame)
+{
+    IM_UNUSED(frame);
+    for (int n = 0; n < WINDOW_COUNT; n++)
+    {
+        const int layer = n / 100, cell = n % 100;
+        ImGui::SetNextWindowPos(ImVec2((cell % 10) * 128.0f + layer * 40.0f, (cell / 10) * 80.0f + layer * 30.0f), ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowSize(ImVec2(124.0f, 76.0f), ImGuiCond_FirstUseEver);
+        char title[32];
+        ImFormatString(title, IM_ARRAYSIZE(title), "Window %d", n);
+        ImGui::Begin(title, NULL, ImGuiWindowFlags_NoSavedSettings);
+        ImGui::Text("Item %d", n);
+        ImGui::Checkbox("Check", &WindowChecks[n]);
+        ImGui::SliderFloat("##value", &WindowValues[n], 0.0f, 1.0f);
+        ImGui::End();
+    }
+}
+
+struct Scene
+{
+    const char* Name;
+    void        (*Setup)();
+    void        (*Input)(ImGuiIO& io, int frame);
+    void        (*Draw)(int frame);
+};
+
+static const Scene Scenes[] =
+{
+    { "demo", NULL, DemoInput, DemoDraw },
+    { "tables", NULL, TablesInput, TablesDraw },
+    { "text", TextSetup, TextInputEvents, TextDraw },
+    { "windows", NULL, WindowsInput, WindowsDraw },
+};
+
+//-----------------------------------------------------------------------------
+
+struct FrameStats
+{
+    ImU64   NewFrameNs, UserNs, EndFrameNs, RenderNs;
+    int     DrawLists, Cmds, Vtx, Idx;
+    ImU64   Allocs, AllocBytes;
+};
+
+static const int WARMUP_FRAMES = 10;
+
+static int CompareU64(const void* a, const void* b)
+{
+    const ImU64 va = *(const ImU64*)a, vb = *(const ImU64*)b;
+    return va < vb ? -1 : va > vb ? 1 : 0;
+}
+
+static void RunScene(const Scene& scene, int frame_count, FILE* csv)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(WIDTH, HEIGHT);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+    // Null renderer: build the atlas so the font is usable, but never upload it anywhere.
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+    if (scene.Setup)
+        scene.Setup();
+
+    ImVector<FrameStats> frames;
+    frames.resize(frame_count);
+    for (int frame = 0; frame < frame_count; frame++)
+    {
+        FrameStats& stats = frames[frame];
+        scene.Input(io, frame);
+        const AllocCounters allocs_before = Allocs;
+
+        const ImU64 t0 = NowNs();
+        ImGui::NewFrame();
+        const ImU64 t1 = NowNs();
+        scene.Draw(frame);
+        const ImU64 t2 = NowNs();
+        ImGui::EndFrame();
+        const ImU64 t3 = NowNs();
+        ImGui::Render();
+        const ImU64 t4 = NowNs();
+
+        const ImDrawData* draw_data = ImGui::GetDrawData();
+        stats.NewFrameNs = t1 - t0;
+        stats.UserNs = t2 - t1;
+        stats.EndFrameNs = t3 - t2;
+        stats.RenderNs = t4 - t3;
+        stats.DrawLists = draw_data->CmdListsCount;
+        stats.Vtx = draw_data->TotalVtxCount;
+        stats.Idx = draw_data->TotalIdxCount;
+        stats.Cmds = 0;
+        for (const ImDrawList* draw_list : draw_data->CmdLists)
+            stats.Cmds += draw_list->CmdBuffer.Size;
+        stats.Allocs = Allocs.Count - allocs_before.Count;
+        stats.AllocBytes = Allocs.Bytes - allocs_before.Bytes;
+        if (csv)
+            fprintf(csv, "%s,%d,%llu,%llu,%llu,%llu,%d,%d,%d,%d,%llu,%llu\n", scene.Name, frame,
+                (unsigned long long)stats.NewFrameNs, (unsigned long long)stats.UserNs, (unsigned long long)stats.EndFrameNs, (unsigned long long)stats.RenderNs,
+                stats.DrawLists, stats.Cmds, stats.Vtx, stats.Idx, (unsigned long long)stats.Allocs, (unsigned long long)stats.AllocBytes);
+    }
+    ImGui::DestroyContext();
+
+    // Averages over measured frames, and percentiles of the total frame time
+    const int first = frame_count > WARMUP_FRAMES ? WARMUP_FRAMES : 0;
+    const int measured = frame_count - first;
+    double sums[10] = {};
+    ImVector<ImU64> totals;
+    for (int frame = first; frame < frame_count; frame++)
+    {
+        const FrameStats& stats = frames[frame];
+        const double values[10] = { (double)stats.NewFrameNs, (double)stats.UserNs, (double)stats.EndFrameNs, (double)stats.RenderNs,
+            (double)stats.DrawLists, (double)stats.Cmds, (double)stats.Vtx, (double)stats.Idx, (double)stats.Allocs, (double)stats.AllocBytes };
+        for (int n = 0; n < 10; n++)
+            sums[n] += values[n];
+        totals.push_back(stats.NewFrameNs + stats.UserNs + stats.EndFrameNs + stats.RenderNs);
+    }
+    qsort(totals.Data, (size_t)totals.Size, sizeof(ImU64), CompareU64);
+    for (double& sum : sums)
+        sum /= measured;
+    printf("{\"scene\":\"%s\",\"frames\":%d,\"new_frame_us\":%.3f,\"user_us\":%.3f,\"end_frame_us\":%.3f,\"render_us\":%.3f,\"total_us\":%.3f,"
+        "\"total_p50_us\":%.3f,\"total_p99_us\":%.3f,\"draw_lists\":%.1f,\"cmds\":%.1f,\"vtx\":%.1f,\"idx\":%.1f,\"allocs\":%.2f,\"alloc_bytes\":%.1f}\n",
+        scene.Name, measured, sums[0] / 1000.0, sums[1] / 1000.0, sums[2] / 1000.0, sums[3] / 1000.0, (sums[0] + sums[1] + sums[2] + sums[3]) / 1000.0,
+        totals[totals.Size / 2] / 1000.0, totals[(totals.Size * 99) / 100] / 1000.0, sums[4], sums[5], sums[6], sums[7], sums[8], sums[9]);
+}
+
+int main(int argc, char** argv)
+{
+    const int frame_count = argc > 1 ? ImMax(atoi(argv[1]), 1) : 600;
+    FILE* csv = NULL;
+    if (argc > 2)
+    {
+        csv = fopen(argv[2], "w");
+        if (csv == NULL)
+        {
+            fprintf(stderr, "Failed to write %s\n", argv[2]);
+            return 1;
+        }
+        fprintf(csv, "scene,frame,new_frame_ns,user_ns,end_frame_ns,render_ns,draw_lists,cmds,vtx,idx,allocs,alloc_bytes\n");
+    }
+
+    IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(CountingAlloc, CountingFree);
+    for (const Scene& scene : Scenes)
+        RunScene(scene, frame_count, csv);
+
+    if (csv)
+        fclose(csv);
+    return 0;
+}
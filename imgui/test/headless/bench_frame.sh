@@ -0,0 +1,7 @@
+#!/bin/sh
+# Builds bench_frame.cpp and replays scripted input over the demo window, large tables, huge text and many windows without platform or renderer.
+# Prints one JSON object per scene: per-phase timings, draw data counts and allocations per frame.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o bench_frame bench_frame.cpp
+./bench_frame "$@"
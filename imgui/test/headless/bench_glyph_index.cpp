@@ -0,0 +1,234 @@
+// Dear ImGui: paged glyph index (ImFont::IndexPages) check and benchmark
+
+// Memory: for each scene, the size of the paged glyph index of every font, against the dense tables sized to the highest codepoint
+// which fonts used before (one float and one ImWchar per codepoint). The "emoji" scene merges a single U+1F600 glyph into each font.
+// Lookups: checks that FindGlyph/GetCharAdvance return the same as a dense table built from ImFont::Glyphs for every codepoint.
+// Throughput: CalcTextSizeA on ASCII and on mixed (Latin-1 and U+1F600) text, and the same advance loop over a dense table.
+//
+// Usage: bench_glyph_index [font.ttf]      (default: fonts from misc/fonts; a user font is added with the full Chinese ranges)
+
+#define IMGUI_USE_WCHAR32   // Codepoints above U+FFFF
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const ImWchar EMOJI = 0x1F600;
+static const int ITERATIONS = 50;
+
+struct Scene
+{
+    const char*     Name;
+    void            (*AddFonts)(ImFontAtlas* atlas, const char* user_font);
+};
+
+static void AddFontsDefault(ImFontAtlas* atlas, const char*)
+{
+    atlas->AddFontDefault();
+}
+
+static void AddFontsMisc(ImFontAtlas* atlas, const char*)
+{
+    static const ImWchar all_ranges[] = { 0x0020, 0xFFFF, 0 };
+    const char* fonts[] = { "../../in/misc/fonts/DroidSans.ttf", "../../in/misc/fonts/Cousine-Regular.ttf", "../../in/misc/fonts/Karla-Regular.ttf" };
+    const float sizes[] = { 13.0f, 18.0f, 24.0f, 32.0f, 48.0f };
+    for (float size : sizes)
+        for (const char* font : fonts)
+            if (atlas->AddFontFromFileTTF(font, size, NULL, all_ranges) == NULL)
+                exit(1);
+}
+
+static void AddFontsMiscEmoji(ImFontAtlas* atlas, const char* user_font)
+{
+    AddFontsMisc(atlas, user_font);
+    for (ImFont* font : atlas->Fonts)
+        atlas->AddCustomRectFontGlyph(font, EMOJI, 13, 13, 15.0f);
+}
+
+static void AddFontsUser(ImFontAtlas* atlas, const char* user_font)
+{
+    ImFont* font = atlas->AddFontFromFileTTF(user_font, 18.0f, NULL, atlas->GetGlyphRangesChineseFull());
+    if (font == NULL)
+        exit(1);
+    atlas->AddCustomRectFontGlyph(font, EMOJI, 13, 13, 15.0f);
+}
+
+// The tables fonts had before IndexPages: glyph index and advance by codepoint, up to the highest one
+struct DenseIndex
+{
+    ImVector<float>     AdvanceX;
+    ImVector<int>       Lookup;
+
+    void Build(const ImFont* font)
+    {
+        unsigned int max_codepoint = 0;
+        for (const ImFontGlyph& glyph : font->Glyphs)
+            max_codepoint = ImMax(max_codepoint, (unsigned int)glyph.Codepoint);
+        AdvanceX.resize((int)max_codepoint + 1);
+        Lookup.resize((int)max_codepoint + 1);
+        for (int n = 0; n < Lookup.Size; n++)
+        {
+            AdvanceX[n] = font->FallbackAdvanceX;
+            Lookup[n] = -1;
+        }
+        for (int glyph_n = 0; glyph_n < font->Glyphs.Size; glyph_n++)
+        {
+            AdvanceX[font->Glyphs[glyph_n].Codepoint] = font->Glyphs[glyph_n].AdvanceX;
+            Lookup[font->Glyphs[glyph_n].Codepoint] = glyph_n;
+        }
+    }
+    static size_t Bytes(const ImFont* font)
+    {
+        unsigned int max_codepoint = 0;
+        for (const ImFontGlyph& glyph : font->Glyphs)
+            max_codepoint = ImMax(max_codepoint, (unsigned int)glyph.Codepoint);
+        return (size_t)(max_codepoint + 1) * (sizeof(float) + sizeof(ImWchar));
+    }
+};
+
+static size_t PagedBytes(const ImFont* font)
+{
+    return (size_t)(font->IndexPages.size_in_bytes() + font->IndexAdvanceX.size_in_bytes() + font->IndexLookup.size_in_bytes());
+}
+
+// Every codepoint up to one page past the highest one, and a few past the end of the page table
+static int CheckLookups(ImFont* font)
+{
+    DenseIndex dense;
+    dense.Build(font);
+    int errors = 0;
+    for (int c = 0; c < dense.Lookup.Size + IM_FONT_INDEX_PAGE_SIZE * 3; c++)
+    {
+        const int glyph_n = (c < dense.Lookup.Size) ? dense.Lookup[c] : -1;
+        const float advance_x = (c < dense.Lookup.Size) ? dense.AdvanceX[c] : font->FallbackAdvanceX;
+        const ImFontGlyph* expected_glyph = (glyph_n != -1) ? &font->Glyphs[glyph_n] : NULL;
+        if (font->FindGlyphNoFallback((ImWchar)c) != expected_glyph || font->FindGlyph((ImWchar)c) != (expected_glyph ? expected_glyph : font->FallbackGlyph))
+            errors++;
+        if (font->GetCharAdvance((ImWchar)c) != advance_x)
+            errors++;
+    }
+    return errors;
+}
+
+static bool RunScene(const Scene& scene, const char* user_font)
+{
+    ImFontAtlas atlas;
+    scene.AddFonts(&atlas, user_font);
+    atlas.Build();
+
+    size_t dense_bytes = 0, paged_bytes = 0;
+    int glyphs_count = 0, pages_count = 0, errors = 0;
+    for (ImFont* font : atlas.Fonts)
+    {
+        dense_bytes += DenseIndex::Bytes(font);
+        paged_bytes += PagedBytes(font);
+        glyphs_count += font->Glyphs.Size;
+        pages_count += font->IndexLookup.Size / IM_FONT_INDEX_PAGE_SIZE;
+        errors += CheckLookups(font);
+    }
+    const int fonts_count = atlas.Fonts.Size;
+    printf("%-8s %2d fonts, %6d glyphs | index per font: dense %9.1f KB, paged %7.1f KB (%5.1f pages) = %5.1f%% | %d lookup errors\n",
+        scene.Name, fonts_count, glyphs_count, dense_bytes / 1024.0 / fonts_count, paged_bytes / 1024.0 / fonts_count, (double)pages_count / fonts_count,
+        100.0 * paged_bytes / dense_bytes, errors);
+    return errors == 0;
+}
+
+// The advance loop of CalcTextSizeA, without wrapping
+template<typename GetAdvanceX>
+static float CalcTextWidth(const char* text, const char* text_end, GetAdvanceX get_advance_x)
+{
+    float text_width = 0.0f, line_width = 0.0f;
+    for (const char* s = text; s < text_end;)
+    {
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+            s += 1;
+        else
+            s += ImTextCharFromUtf8(&c, s, text_end);
+        if (c == '\n')
+        {
+            text_width = ImMax(text_width, line_width);
+            line_width = 0.0f;
+            continue;
+        }
+        line_width += get_advance_x(c);
+    }
+    return ImMax(text_width, line_width);
+}
+
+static bool RunThroughput(const char* name, ImFont* font, const ImGuiTextBuffer& text)
+{
+    DenseIndex dense;
+    dense.Build(font);
+    const float* dense_advance_x = dense.AdvanceX.Data;
+    const unsigned int dense_size = (unsigned int)dense.AdvanceX.Size;
+    const float fallback_advance_x = font->FallbackAdvanceX;
+
+    ImU64 calc_ns = (ImU64)-1, wrapped_ns = (ImU64)-1, dense_ns = (ImU64)-1, paged_ns = (ImU64)-1;
+    float calc_width = 0.0f, dense_width = 0.0f, paged_width = 0.0f;
+    for (int run = 0; run < ITERATIONS; run++)
+    {
+        ImU64 t0 = NowNs();
+        calc_width = font->CalcTextSizeA(font->FontSize, FLT_MAX, 0.0f, text.begin(), text.end()).x;
+        calc_ns = ImMin(calc_ns, NowNs() - t0);
+        t0 = NowNs();
+        volatile float wrapped_height = font->CalcTextSizeA(font->FontSize, FLT_MAX, 400.0f, text.begin(), text.end()).y;
+        wrapped_ns = ImMin(wrapped_ns, NowNs() - t0);
+        IM_UNUSED(wrapped_height);
+        t0 = NowNs();
+        dense_width = CalcTextWidth(text.begin(), text.end(), [&](unsigned int c) { return c < dense_size ? dense_advance_x[c] : fallback_advance_x; });
+        dense_ns = ImMin(dense_ns, NowNs() - t0);
+        t0 = NowNs();
+        paged_width = CalcTextWidth(text.begin(), text.end(), [&](unsigned int c) { return font->GetCharAdvance((ImWchar)c); });
+        paged_ns = ImMin(paged_ns, NowNs() - t0);
+    }
+    const double mb = text.size() / (1024.0 * 1024.0);
+    printf("%-6s %5.2f MB | CalcTextSizeA %7.1f MB/s, wrapped %7.1f MB/s | advance loop: dense %7.1f MB/s, paged %7.1f MB/s\n", name, mb,
+        mb / (calc_ns / 1e9), mb / (wrapped_ns / 1e9), mb / (dense_ns / 1e9), mb / (paged_ns / 1e9));
+    return calc_width == dense_width && paged_width == dense_width;
+}
+
+int main(int argc, char** argv)
+{
+    const char* user_font = argc > 1 ? argv[1] : NULL;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+
+    // Memory and lookups
+    const Scene scenes[] = { { "default", AddFontsDefault }, { "misc", AddFontsMisc }, { "emoji", AddFontsMiscEmoji }, { "user", AddFontsUser } };
+    bool ok = true;
+    for (const Scene& scene : scenes)
+        if (scene.AddFonts != AddFontsUser || user_font != NULL)
+            ok &= RunScene(scene, user_font);
+
+    // Throughput, with the first font of the "emoji" scene
+    ImFontAtlas atlas;
+    AddFontsMiscEmoji(&atlas, NULL);
+    atlas.Build();
+    const char* ascii_words[] = { "lorem ", "ipsum ", "dolor ", "sit ", "amet, ", "consectetur ", "adipiscing ", "elit.\n" };
+    const char* mixed_words[] = { "d\xC3\xA9j\xC3\xA0 ", "vu ", "gr\xC3\xBC\xC3\x9F" "e ", "\xF0\x9F\x98\x80 ", "na\xC3\xAFve ", "caf\xC3\xA9\n" };
+    ImGuiTextBuffer ascii_text, mixed_text;
+    for (int n = 0; ascii_text.size() < 1 << 20; n++)
+        ascii_text.append(ascii_words[n % IM_ARRAYSIZE(ascii_words)]);
+    for (int n = 0; mixed_text.size() < 1 << 20; n++)
+        mixed_text.append(mixed_words[n % IM_ARRAYSIZE(mixed_words)]);
+    ok &= RunThroughput("ascii", atlas.Fonts[0], ascii_text);
+    ok &= RunThroughput("mixed", atlas.Fonts[0], mixed_text);
+
+    printf("%s\n", ok ? "output ok" : "output FAILED");
+    ImGui::DestroyContext();
+    return ok ? 0 : 1;
+}
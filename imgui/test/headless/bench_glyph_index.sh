@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds bench_glyph_index.cpp, compares the memory of paged and dense glyph indices and their CalcTextSizeA throughput.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o bench_glyph_index bench_glyph_index.cpp
+./bench_glyph_index "$@"
@@ -0,0 +1,144 @@
+// Dear ImGui: idle mode (io.ConfigIdleSkipFrames) CPU usage check
+
+// Runs the demo window for a few seconds of real time with a short scripted mouse interaction at the start, once producing
+// frames continuously at 60 Hz (as with vsync) and once sleeping whenever GetIdleState() allows it. Prints the number of
+// frames and the CPU time used by each, and fails if the idle run doesn't stay near zero CPU once the interaction is over.
+//
+// Usage: bench_idle [seconds]      (default: 3)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include "imgui_demo.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <chrono>
+#include <thread>
+
+static double NowSeconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static double CpuSeconds()
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+// Mouse moves over the demo window, opens a header, then leaves the window alone.
+struct ScriptEvent
+{
+    double      Time;
+    ImVec2      MousePos;
+    int         MouseDown;  // -1: unchanged
+};
+
+static const ScriptEvent Script[] =
+{
+    { 0.10, ImVec2(200.0f, 150.0f), -1 },
+    { 0.20, ImVec2(120.0f, 120.0f), -1 },
+    { 0.30, ImVec2(100.0f, 100.0f), -1 },
+    { 0.40, ImVec2(100.0f, 100.0f), 1 },
+    { 0.45, ImVec2(100.0f, 100.0f), 0 },
+    { 0.60, ImVec2(300.0f, 200.0f), -1 },
+};
+
+struct RunResult
+{
+    int         Frames;
+    int         FramesAfterScript;
+    double      CpuAfterScript;
+    double      WallAfterScript;
+};
+
+static RunResult Run(double seconds, bool idle_mode)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.ConfigIdleSkipFrames = idle_mode;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+
+    const double frame_period = 1.0 / 60.0;
+    const double script_end = Script[IM_ARRAYSIZE(Script) - 1].Time;
+    const double t_start = NowSeconds();
+    double t_prev_frame = t_start;
+    double cpu_at_script_end = -1.0;
+    int frames_at_script_end = 0;
+    int next_event = 0;
+    RunResult result = {};
+    for (;;)
+    {
+        const double t = NowSeconds() - t_start;
+        if (t >= seconds)
+            break;
+
+        // Inputs due by now
+        while (next_event < IM_ARRAYSIZE(Script) && Script[next_event].Time <= t)
+        {
+            const ScriptEvent& e = Script[next_event++];
+            io.AddMousePosEvent(e.MousePos.x, e.MousePos.y);
+            if (e.MouseDown >= 0)
+                io.AddMouseButtonEvent(0, e.MouseDown != 0);
+        }
+        if (cpu_at_script_end < 0.0 && t > script_end)
+        {
+            cpu_at_script_end = CpuSeconds();
+            frames_at_script_end = result.Frames;
+        }
+
+        // Frame
+        const double t_now = NowSeconds();
+        io.DeltaTime = (float)ImMax(t_now - t_prev_frame, 1e-6);
+        t_prev_frame = t_now;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(20.0f, 20.0f), ImGuiCond_Once);
+        ImGui::ShowDemoWindow();
+        ImGui::Render();
+        result.Frames++;
+
+        // Wait: until the next vsync, or until the next input event / wake up time when idle
+        double wait = frame_period;
+        float idle_timeout;
+        if (idle_mode && ImGui::GetIdleState(&idle_timeout))
+            wait = ImMax(wait, (double)idle_timeout);
+        const double t_next_event = next_event < IM_ARRAYSIZE(Script) ? Script[next_event].Time : seconds;
+        wait = ImMin(wait, ImMax(t_next_event - (NowSeconds() - t_start), 0.0));
+        wait = ImMin(wait, ImMax(seconds - (NowSeconds() - t_start), 0.0));
+        std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+    }
+    result.FramesAfterScript = result.Frames - frames_at_script_end;
+    result.CpuAfterScript = CpuSeconds() - cpu_at_script_end;
+    result.WallAfterScript = seconds - script_end;
+    ImGui::DestroyContext();
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    const double seconds = argc > 1 ? atof(argv[1]) : 3.0;
+
+    IMGUI_CHECKVERSION();
+    const RunResult continuous = Run(seconds, false);
+    const RunResult idle = Run(seconds, true);
+    const double continuous_usage = continuous.CpuAfterScript / continuous.WallAfterScript * 100.0;
+    const double idle_usage = idle.CpuAfterScript / idle.WallAfterScript * 100.0;
+    printf("continuous: %4d frames, after interaction %4d frames, %7.2f ms CPU (%.3f%%)\n", continuous.Frames, continuous.FramesAfterScript, continuous.CpuAfterScript * 1000.0, continuous_usage);
+    printf("idle:       %4d frames, after interaction %4d frames, %7.2f ms CPU (%.3f%%)\n", idle.Frames, idle.FramesAfterScript, idle.CpuAfterScript * 1000.0, idle_usage);
+
+    // A few frames for settling and timers (tooltip delays, stationary mouse) are expected after the last input.
+    const bool ok = idle.FramesAfterScript <= 10 && idle_usage < 0.5;
+    printf("%s\n", ok ? "idle ok" : "idle FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds bench_idle.cpp and compares the CPU usage of the demo window with and without io.ConfigIdleSkipFrames.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o bench_idle bench_idle.cpp
+./bench_idle "${1:-3}"
@@ -0,0 +1,124 @@
+// Dear ImGui: AddPolyline() equivalence check and benchmark
+
+// Tessellates a fixed set of long polylines through every AddPolyline() path and prints a hash of the
+// generated vertices/indices and the time per call. bench_polyline.sh builds this once with the SIMD kernels and
+// once with IMGUI_DISABLE_SIMD_POLYLINE, then compares the hashes of both builds.
+//
+// Usage: bench_polyline [iterations]      (default: 200)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static ImU64 HashBytes(ImU64 hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    return hash;
+}
+
+// Random walk with the odd repeated point (zero length segment) and sharp turn (clamped miter) mixed in.
+static void GeneratePoints(ImVector<ImVec2>& points, int count, unsigned int seed)
+{
+    points.resize(count);
+    ImVec2 p(640.0f, 400.0f);
+    for (int i = 0; i < count; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        if (i > 0 && (seed >> 28) == 0)
+        {
+            points[i] = points[i - 1];
+            continue;
+        }
+        if (i > 1 && (seed >> 28) == 1)
+        {
+            points[i] = points[i - 2];
+            continue;
+        }
+        p.x += (float)((seed >> 8) & 0xFF) / 16.0f - 8.0f;
+        p.y += (float)((seed >> 16) & 0xFF) / 16.0f - 8.0f;
+        points[i] = p;
+    }
+}
+
+struct PolylineCase
+{
+    const char*         Name;
+    float               Thickness;
+    ImDrawFlags         Flags;
+    ImDrawListFlags     DrawListFlags;
+};
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? atoi(argv[1]) : 200;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+    ImGui::NewFrame();
+
+    const PolylineCase cases[] =
+    {
+        { "thin_aa_tex",        1.0f,   ImDrawFlags_None,   ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex },
+        { "thin_aa_tex_closed", 1.0f,   ImDrawFlags_Closed, ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex },
+        { "thin_aa",            1.0f,   ImDrawFlags_None,   ImDrawListFlags_AntiAliasedLines },
+        { "thin_aa_closed",     1.0f,   ImDrawFlags_Closed, ImDrawListFlags_AntiAliasedLines },
+        { "thick_aa",           4.0f,   ImDrawFlags_None,   ImDrawListFlags_AntiAliasedLines },
+        { "thick_aa_closed",    4.0f,   ImDrawFlags_Closed, ImDrawListFlags_AntiAliasedLines },
+        { "no_aa",              2.0f,   ImDrawFlags_None,   ImDrawListFlags_None },
+    };
+    const int point_counts[] = { 2, 3, 5, 8, 13, 10000 };
+
+    ImVector<ImVec2> points;
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    for (const PolylineCase& c : cases)
+    {
+        ImU64 hash = 0xCBF29CE484222325ull;
+        ImU64 total_ns = 0;
+        for (int point_count : point_counts)
+        {
+            GeneratePoints(points, point_count, (unsigned int)point_count);
+            const int runs = point_count >= 1000 ? iterations : 1;
+            for (int run = 0; run < runs; run++)
+            {
+                draw_list._ResetForNewFrame();
+                draw_list.PushClipRectFullScreen();
+                draw_list.Flags = c.DrawListFlags;
+                ImU64 t0 = NowNs();
+                draw_list.AddPolyline(points.Data, points.Size, IM_COL32(255, 200, 100, 255), c.Flags, c.Thickness);
+                if (point_count >= 1000)
+                    total_ns += NowNs() - t0;
+            }
+            hash = HashBytes(hash, draw_list.VtxBuffer.Data, (size_t)draw_list.VtxBuffer.Size * sizeof(ImDrawVert));
+            hash = HashBytes(hash, draw_list.IdxBuffer.Data, (size_t)draw_list.IdxBuffer.Size * sizeof(ImDrawIdx));
+        }
+        printf("%-20s hash %016llx  %8.2f us/call\n", c.Name, (unsigned long long)hash, iterations > 0 ? total_ns / 1000.0 / iterations : 0.0);
+    }
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    return 0;
+}
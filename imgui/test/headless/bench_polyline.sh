@@ -0,0 +1,13 @@
+#!/bin/sh
+# Builds bench_polyline.cpp with and without the SIMD AddPolyline() kernels, prints both timings and fails if the output differs.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o bench_polyline_simd bench_polyline.cpp
+c++ -O2 -std=c++11 -I ../../in -DIMGUI_DISABLE_SIMD_POLYLINE -o bench_polyline_scalar bench_polyline.cpp
+echo "simd:"
+./bench_polyline_simd "${1:-200}" | tee bench_polyline_simd.txt
+echo "scalar:"
+./bench_polyline_scalar "${1:-200}" | tee bench_polyline_scalar.txt
+cut -c1-40 bench_polyline_simd.txt > bench_polyline_simd.hash
+cut -c1-40 bench_polyline_scalar.txt > bench_polyline_scalar.hash
+if cmp -s bench_polyline_simd.hash bench_polyline_scalar.hash; then echo "output identical"; else echo "output differs"; exit 1; fi
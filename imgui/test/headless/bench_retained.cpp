@@ -0,0 +1,156 @@
+// Dear ImGui: retained regions (ImGui::BeginRetained()/EndRetained()) check and benchmark
+
+// Draws a window made of blocks of labels and progress bars, once submitted every frame and once with each block in a retained
+// region, with the memory compaction timer enabled (short, so it runs during the test) and disabled. Halfway through each run
+// g.GcCompactAll is requested once. Fails unless every block is replayed on every timed frame except the one following the
+// GcCompactAll request, and unless the replayed frames render the same triangles as direct submission. Prints the time of each run.
+//
+// Usage: bench_retained [iterations]      (default: 200)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static ImU64 HashBytes(ImU64 hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    return hash;
+}
+
+// Hash what a renderer would draw: the vertices of every triangle in order, and the clip rectangle / texture whenever they change.
+// Command splits are not part of it, as a replayed region may push its clip rectangle where direct submission merged commands.
+static ImU64 HashDrawDataOutput(const ImDrawData* draw_data)
+{
+    ImU64 hash = 0xCBF29CE484222325ull;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        const ImDrawCmd* prev_cmd = NULL;
+        for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        {
+            if (cmd.ElemCount == 0)
+                continue;
+            if (prev_cmd == NULL || memcmp(&prev_cmd->ClipRect, &cmd.ClipRect, sizeof(ImVec4)) != 0 || prev_cmd->TextureId != cmd.TextureId)
+            {
+                hash = HashBytes(hash, &cmd.ClipRect, sizeof(cmd.ClipRect));
+                hash = HashBytes(hash, &cmd.TextureId, sizeof(cmd.TextureId));
+            }
+            for (unsigned int n = 0; n < cmd.ElemCount; n++)
+                hash = HashBytes(hash, &draw_list->VtxBuffer[cmd.VtxOffset + draw_list->IdxBuffer[cmd.IdxOffset + n]], sizeof(ImDrawVert));
+            prev_cmd = &cmd;
+        }
+    }
+    return hash;
+}
+
+static const int BLOCKS_COUNT = 24;
+static const int BLOCK_LINES = 12;
+
+// Returns the number of blocks replayed from their retained region.
+static int ShowBlocks(bool retained)
+{
+    int replayed = 0;
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin("Blocks", NULL, ImGuiWindowFlags_NoDecoration);
+    for (int block = 0; block < BLOCKS_COUNT; block++)
+    {
+        ImGui::PushID(block);
+        if (!retained || ImGui::BeginRetained("block", (ImGuiID)block))
+        {
+            ImGui::SeparatorText("Block");
+            for (int line = 0; line < BLOCK_LINES; line++)
+            {
+                ImGui::Text("Item %d.%d", block, line);
+                ImGui::SameLine(160.0f);
+                ImGui::ProgressBar((float)((block * BLOCK_LINES + line) % 17) / 16.0f, ImVec2(200.0f, 0.0f));
+            }
+            if (retained)
+                ImGui::EndRetained();
+        }
+        else
+        {
+            replayed++;
+        }
+        ImGui::PopID();
+        if ((block % 4) != 3)
+            ImGui::SameLine();
+    }
+    ImGui::End();
+    return replayed;
+}
+
+struct RunResult
+{
+    ImU64       Hash;
+    ImU64       BestNs;
+    int         Replayed;
+};
+
+static RunResult Run(bool retained, float compact_timer, int iterations)
+{
+    ImGuiContext& g = *GImGui;
+    g.IO.ConfigMemoryCompactTimer = compact_timer;
+    RunResult result = { 0, (ImU64)-1, 0 };
+    for (int run = -2; run < iterations; run++)
+    {
+        if (run == iterations / 2)
+            g.GcCompactAll = true;
+        const ImU64 t0 = NowNs();
+        ImGui::NewFrame();
+        const int replayed = ShowBlocks(retained);
+        ImGui::Render();
+        if (run < 0)
+            continue;
+        result.BestNs = ImMin(result.BestNs, NowNs() - t0);
+        result.Replayed += replayed;
+    }
+    result.Hash = HashDrawDataOutput(ImGui::GetDrawData());
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? ImMax(atoi(argv[1]), 2) : 200;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+
+    // Every region is submitted every frame, the only frame recording them is the one after the GcCompactAll request.
+    const int expected_replayed = (iterations - 1) * BLOCKS_COUNT;
+    const RunResult direct = Run(false, 1.0f, iterations);
+    const RunResult timer = Run(true, 1.0f, iterations);
+    const RunResult no_timer = Run(true, -1.0f, iterations);
+    printf("direct:             %8.1f us, hash %016llx\n", direct.BestNs / 1000.0, (unsigned long long)direct.Hash);
+    printf("retained:           %8.1f us, hash %016llx, %d/%d blocks replayed\n", timer.BestNs / 1000.0, (unsigned long long)timer.Hash, timer.Replayed, expected_replayed);
+    printf("retained, no timer: %8.1f us, hash %016llx, %d/%d blocks replayed\n", no_timer.BestNs / 1000.0, (unsigned long long)no_timer.Hash, no_timer.Replayed, expected_replayed);
+    ImGui::DestroyContext();
+
+    const bool ok = timer.Hash == direct.Hash && no_timer.Hash == direct.Hash && timer.Replayed == expected_replayed && no_timer.Replayed == expected_replayed;
+    printf(ok ? "output ok\n" : "output FAILED\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds bench_retained.cpp, checks that retained regions replay with and without the memory compaction timer and compares frame times.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o bench_retained bench_retained.cpp
+./bench_retained "${1:-200}"
@@ -0,0 +1,194 @@
+// Dear ImGui: signed distance field fonts (ImFontConfig::SdfPadding) check and benchmark
+
+// Memory: texture memory (RGBA32, as uploaded by most backends) and build time of one SDF atlas, against a bitmap atlas rebuilt
+// at the pixel size of each DPI scale, and against one bitmap atlas pre-baking every scale.
+// Rebuilds: replays a window moving between monitors of different DPI scales, counting the atlas rebuilds each strategy needs.
+// Quality: renders a line of text with imgui_impl_softraster at each scale with a bitmap font built at that exact size (reference),
+// the SDF font, and the base size bitmap font scaled up. Checks that SDF text has the same amount of ink as the reference, that its
+// edges are as sharp (share of partially covered pixels, blurry scaled bitmaps have more), and that consecutive SDF texts share a draw command.
+//
+// Usage: bench_sdf [font.ttf] [size]      (default: misc/fonts/DroidSans.ttf, 16)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include "backends/imgui_impl_softraster.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const float SCALES[] = { 1.0f, 1.25f, 1.5f, 1.75f, 2.0f, 2.5f, 3.0f };
+static const int SCALES_COUNT = IM_ARRAYSIZE(SCALES);
+static const float SDF_SIZE = 32.0f;
+static const int SDF_PADDING = 4;
+
+static const char* TEXT = "The quick brown fox jumps over the lazy dog. 0123456789 (Grüße, déjà vu)";
+static const int WIDTH = 1600;
+static const int HEIGHT = 96;
+
+struct AtlasStats
+{
+    ImU64   BuildNs;
+    int     TexWidth, TexHeight;
+    double  TexMB() const { return (double)TexWidth * TexHeight * 4 / (1024.0 * 1024.0); }
+};
+
+static ImFont* AddFont(ImFontAtlas* atlas, const char* font_file, float size, int sdf_padding)
+{
+    ImFontConfig cfg;
+    cfg.SdfPadding = sdf_padding;
+    ImFont* font = atlas->AddFontFromFileTTF(font_file, size, &cfg);
+    if (font == NULL)
+        exit(1);
+    return font;
+}
+
+static AtlasStats BuildAtlas(ImFontAtlas* atlas)
+{
+    AtlasStats stats;
+    const ImU64 t0 = NowNs();
+    unsigned char* pixels;
+    atlas->GetTexDataAsRGBA32(&pixels, &stats.TexWidth, &stats.TexHeight);
+    stats.BuildNs = NowNs() - t0;
+    return stats;
+}
+
+// Text coverage in [0, 255] per pixel, white text over a black target
+static void RenderText(ImVector<ImU32>& target, ImVector<unsigned char>& coverage, ImFont* font, float size, int* out_cmd_count)
+{
+    ImGui_ImplSoftRaster_NewFrame();
+    ImGui::NewFrame();
+    ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+    const int cmd_count_before = draw_list->CmdBuffer.Size;
+    draw_list->AddText(font, size, ImVec2(8.0f, 8.0f), IM_COL32_WHITE, TEXT);
+    draw_list->AddText(font, size, ImVec2(8.0f, 8.0f + size * 1.25f), IM_COL32_WHITE, "Second line");
+    *out_cmd_count = draw_list->CmdBuffer.Size - cmd_count_before;
+    ImGui::Render();
+    memset(target.Data, 0, (size_t)target.size_in_bytes());
+    ImGui_ImplSoftRaster_RenderDrawData(ImGui::GetDrawData(), target.Data, WIDTH, HEIGHT, WIDTH * (int)sizeof(ImU32));
+    coverage.resize(target.Size);
+    for (int n = 0; n < target.Size; n++)
+        coverage[n] = (unsigned char)(target[n] & 0xFF);
+}
+
+static double Ink(const ImVector<unsigned char>& coverage)
+{
+    double sum = 0.0;
+    for (unsigned char c : coverage)
+        sum += c;
+    return sum;
+}
+
+// Share of the covered pixels which are partially covered: anti-aliased edges. Doesn't depend on sub-pixel glyph positions, unlike a pixel difference.
+static double Blur(const ImVector<unsigned char>& coverage)
+{
+    int covered = 0, partial = 0;
+    for (unsigned char c : coverage)
+        if (c >= 16)
+        {
+            covered++;
+            partial += (c < 240) ? 1 : 0;
+        }
+    return covered ? (double)partial / covered : 0.0;
+}
+
+int main(int argc, char** argv)
+{
+    const char* font_file = argc > 1 ? argv[1] : "../../in/misc/fonts/DroidSans.ttf";
+    const float base_size = argc > 2 ? (float)atof(argv[2]) : 16.0f;
+
+    // Memory
+    printf("%s %.0fpx, SDF atlas %.0fpx with %d texels of padding, scales", font_file, base_size, SDF_SIZE, SDF_PADDING);
+    for (float scale : SCALES)
+        printf(" %.2f", scale);
+    printf("\n");
+    AtlasStats bitmap_stats[SCALES_COUNT];
+    double bitmap_max_mb = 0.0;
+    for (int n = 0; n < SCALES_COUNT; n++)
+    {
+        ImFontAtlas atlas;
+        AddFont(&atlas, font_file, base_size * SCALES[n], 0);
+        bitmap_stats[n] = BuildAtlas(&atlas);
+        bitmap_max_mb = ImMax(bitmap_max_mb, bitmap_stats[n].TexMB());
+    }
+    ImFontAtlas prebaked_atlas;
+    for (float scale : SCALES)
+        AddFont(&prebaked_atlas, font_file, base_size * scale, 0);
+    const AtlasStats prebaked_stats = BuildAtlas(&prebaked_atlas);
+    ImFontAtlas sdf_atlas;
+    AddFont(&sdf_atlas, font_file, SDF_SIZE, SDF_PADDING);
+    const AtlasStats sdf_stats = BuildAtlas(&sdf_atlas);
+    printf("bitmap per scale    texture %4dx%-4d .. %4dx%-4d %6.2f MB max, build %6.2f .. %6.2f ms\n", bitmap_stats[0].TexWidth, bitmap_stats[0].TexHeight,
+        bitmap_stats[SCALES_COUNT - 1].TexWidth, bitmap_stats[SCALES_COUNT - 1].TexHeight, bitmap_max_mb, bitmap_stats[0].BuildNs / 1000000.0, bitmap_stats[SCALES_COUNT - 1].BuildNs / 1000000.0);
+    printf("bitmap all scales   texture %4dx%-4d             %6.2f MB,     build %6.2f ms\n", prebaked_stats.TexWidth, prebaked_stats.TexHeight, prebaked_stats.TexMB(), prebaked_stats.BuildNs / 1000000.0);
+    printf("sdf                 texture %4dx%-4d             %6.2f MB,     build %6.2f ms\n", sdf_stats.TexWidth, sdf_stats.TexHeight, sdf_stats.TexMB(), sdf_stats.BuildNs / 1000000.0);
+
+    // Rebuilds: the window goes back and forth between monitors. Only the bitmap font needs its atlas rebuilt at each change.
+    const int moves[] = { 0, 2, 0, 4, 1, 4, 6, 0 };
+    int bitmap_rebuilds = 0;
+    ImU64 bitmap_rebuild_ns = 0, bitmap_stall_ns = 0;
+    for (int n = 1; n < IM_ARRAYSIZE(moves); n++)
+        if (moves[n] != moves[n - 1])
+        {
+            ImFontAtlas atlas;
+            AddFont(&atlas, font_file, base_size * SCALES[moves[n]], 0);
+            const ImU64 build_ns = BuildAtlas(&atlas).BuildNs;
+            bitmap_rebuilds++;
+            bitmap_rebuild_ns += build_ns;
+            bitmap_stall_ns = ImMax(bitmap_stall_ns, build_ns);
+        }
+    printf("rebuilds over %d monitor changes: bitmap %d (%.2f ms total, %.2f ms longest stall), sdf 0\n", IM_ARRAYSIZE(moves) - 1, bitmap_rebuilds,
+        bitmap_rebuild_ns / 1000000.0, bitmap_stall_ns / 1000000.0);
+
+    // Quality: one atlas with the SDF font, the base bitmap font and a reference bitmap font per scale
+    ImFontAtlas atlas;
+    ImFont* sdf_font = AddFont(&atlas, font_file, SDF_SIZE, SDF_PADDING);
+    ImFont* base_font = AddFont(&atlas, font_file, base_size, 0);
+    ImFont* reference_fonts[SCALES_COUNT];
+    for (int n = 0; n < SCALES_COUNT; n++)
+        reference_fonts[n] = AddFont(&atlas, font_file, base_size * SCALES[n], 0);
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext(&atlas);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2((float)WIDTH, (float)HEIGHT);
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui_ImplSoftRaster_Init(1);
+
+    ImVector<ImU32> target;
+    target.resize(WIDTH * HEIGHT);
+    ImVector<unsigned char> reference, sdf, scaled;
+    bool ok = true;
+    for (int n = 0; n < SCALES_COUNT; n++)
+    {
+        const float size = base_size * SCALES[n];
+        int reference_cmds, sdf_cmds, scaled_cmds;
+        RenderText(target, reference, reference_fonts[n], size, &reference_cmds);
+        RenderText(target, sdf, sdf_font, size, &sdf_cmds);
+        RenderText(target, scaled, base_font, size, &scaled_cmds);
+        const double sdf_ink = Ink(sdf) / Ink(reference);
+        const double scaled_ink = Ink(scaled) / Ink(reference);
+        const double reference_blur = Blur(reference), sdf_blur = Blur(sdf), scaled_blur = Blur(scaled);
+        printf("scale %.2f (%4.1fpx): ink vs reference: sdf %5.3f, scaled bitmap %5.3f | partially covered pixels: reference %4.1f%%, sdf %4.1f%%, scaled bitmap %4.1f%% | draw cmds %d\n",
+            SCALES[n], size, sdf_ink, scaled_ink, reference_blur * 100.0, sdf_blur * 100.0, scaled_blur * 100.0, sdf_cmds);
+        ok &= sdf_ink > 0.9 && sdf_ink < 1.1 && sdf_cmds == 1;
+        if (SCALES[n] > 1.0f)
+            ok &= sdf_blur < scaled_blur;
+    }
+
+    printf("%s\n", ok ? "output ok" : "output FAILED");
+    ImGui_ImplSoftRaster_Shutdown();
+    ImGui::DestroyContext();
+    return ok ? 0 : 1;
+}
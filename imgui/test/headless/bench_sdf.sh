@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds bench_sdf.cpp, compares one signed distance field font atlas with per-size bitmap atlases and checks SDF text rendering.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -pthread -I ../../in -o bench_sdf bench_sdf.cpp
+./bench_sdf "$@"
@@ -0,0 +1,295 @@
+// Dear ImGui: shape templates, equivalence check and benchmark
+//
+// 1. Draws random rectangles (rounded or not, filled or not, all corner flags) and circles/n-gons through AddRect(), AddRectFilled(),
+//    AddCircle(), AddCircleFilled(), AddNgon() and AddNgonFilled() once the shape templates are warm, and compares them with the same
+//    shapes tessellated directly through the path functions. Same for the shapes of a widget list drawn with one style.
+//    Prints the fastest time of both: "path" for the path functions, "Add*()" for the Add functions (templated unless disabled).
+//    Indices, uv and colors have to match, positions may differ by float rounding (normals use an approximate reciprocal
+//    square root, whose error depends on edge lengths).
+// 2. Runs the demo window with a few sections open, with the default and a rounded style, and prints vertices written per second.
+// bench_shapes.sh builds this once with shape templates and once with IMGUI_DISABLE_DRAWLIST_SHAPE_TEMPLATES.
+//
+// Usage: bench_shapes [iterations]      (default: 200)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include "imgui_demo.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+enum ShapeKind { ShapeKind_Rect, ShapeKind_RectFilled, ShapeKind_Circle, ShapeKind_CircleFilled, ShapeKind_Ngon, ShapeKind_NgonFilled, ShapeKind_COUNT };
+
+struct Shape
+{
+    ShapeKind   Kind;
+    ImVec2      A, B;       // Rectangle corners, or center in A
+    float       Radius;     // Rounding or radius
+    ImDrawFlags Flags;
+    int         Segments;
+    float       Thickness;
+    ImU32       Col;
+};
+
+// Few distinct radii / flags / thicknesses like a UI style would use, random sizes and positions.
+static void GenerateShapes(ImVector<Shape>& shapes, int count, unsigned int seed)
+{
+    const float radii[] = { 0.0f, 3.0f, 4.0f, 12.0f };
+    const ImDrawFlags corner_flags[] = { ImDrawFlags_None, ImDrawFlags_RoundCornersTop, ImDrawFlags_RoundCornersLeft, ImDrawFlags_RoundCornersTopLeft, ImDrawFlags_RoundCornersBottomRight, ImDrawFlags_RoundCornersNone };
+    const float thicknesses[] = { 1.0f, 2.0f };
+    const int segments[] = { 0, 0, 6, 12 };
+    shapes.resize(count);
+    for (Shape& shape : shapes)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        shape.Kind = (ShapeKind)((seed >> 24) % ShapeKind_COUNT);
+        shape.A = ImVec2((float)((seed >> 4) % 1200) + ((seed & 1) ? 0.5f : 0.0f), (float)((seed >> 12) % 760));
+        seed = seed * 1664525u + 1013904223u;
+        shape.B = shape.A + ImVec2(8.0f + (float)((seed >> 8) % 200), 8.0f + (float)((seed >> 16) % 120)); // Some get their rounding clamped
+        shape.Radius = radii[(seed >> 24) % IM_ARRAYSIZE(radii)];
+        shape.Flags = corner_flags[(seed >> 4) % IM_ARRAYSIZE(corner_flags)];
+        shape.Thickness = thicknesses[(seed >> 2) % IM_ARRAYSIZE(thicknesses)];
+        shape.Segments = (shape.Kind == ShapeKind_Ngon || shape.Kind == ShapeKind_NgonFilled) ? 3 + (int)((seed >> 28) % 6) : segments[(seed >> 28) % IM_ARRAYSIZE(segments)];
+        if (shape.Kind != ShapeKind_Rect && shape.Kind != ShapeKind_RectFilled)
+            shape.Radius = shape.Radius * 0.5f + 1.0f;
+        shape.Col = (seed | IM_COL32_A_MASK) ^ ((seed & 0x80) ? 0x40000000 : 0);
+    }
+}
+
+// One style like a widget list: rounded frames and their borders, radio buttons, bullets. Random widths and positions.
+static void GenerateWidgetShapes(ImVector<Shape>& shapes, int count, unsigned int seed)
+{
+    shapes.resize(count);
+    for (Shape& shape : shapes)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const int kind = (seed >> 24) % 4;
+        shape.A = ImVec2((float)((seed >> 4) % 1000), (float)((seed >> 12) % 760));
+        shape.B = shape.A + ImVec2(40.0f + (float)((seed >> 16) % 200), 19.0f);
+        shape.Kind = kind == 0 ? ShapeKind_RectFilled : kind == 1 ? ShapeKind_Rect : kind == 2 ? ShapeKind_CircleFilled : ShapeKind_Circle;
+        shape.Radius = (kind <= 1) ? 4.0f : (kind == 2 && (seed & 1)) ? 3.0f : 9.5f;
+        shape.Flags = ImDrawFlags_None;
+        shape.Segments = 0;
+        shape.Thickness = 1.0f;
+        shape.Col = seed | IM_COL32_A_MASK;
+    }
+}
+
+static void DrawShape(ImDrawList* draw_list, const Shape& shape)
+{
+    switch (shape.Kind)
+    {
+    case ShapeKind_Rect:            draw_list->AddRect(shape.A, shape.B, shape.Col, shape.Radius, shape.Flags, shape.Thickness); break;
+    case ShapeKind_RectFilled:      draw_list->AddRectFilled(shape.A, shape.B, shape.Col, shape.Radius, shape.Flags); break;
+    case ShapeKind_Circle:          draw_list->AddCircle(shape.A, shape.Radius, shape.Col, shape.Segments, shape.Thickness); break;
+    case ShapeKind_CircleFilled:    draw_list->AddCircleFilled(shape.A, shape.Radius, shape.Col, shape.Segments); break;
+    case ShapeKind_Ngon:            draw_list->AddNgon(shape.A, shape.Radius, shape.Col, shape.Segments, shape.Thickness); break;
+    case ShapeKind_NgonFilled:      draw_list->AddNgonFilled(shape.A, shape.Radius, shape.Col, shape.Segments); break;
+    default: break;
+    }
+}
+
+// Direct tessellation, same paths as the ImDrawList functions without the shape templates.
+static void DrawShapeReference(ImDrawList* draw_list, const Shape& shape)
+{
+    int segments = shape.Segments;
+    float radius = shape.Radius;
+    switch (shape.Kind)
+    {
+    case ShapeKind_Rect:
+    {
+        const ImVec2 b = (draw_list->Flags & ImDrawListFlags_AntiAliasedLines) ? shape.B - ImVec2(0.50f, 0.50f) : shape.B - ImVec2(0.49f, 0.49f);
+        draw_list->PathRect(shape.A + ImVec2(0.50f, 0.50f), b, shape.Radius, shape.Flags);
+        draw_list->PathStroke(shape.Col, ImDrawFlags_Closed, shape.Thickness);
+        return;
+    }
+    case ShapeKind_RectFilled:
+        if (shape.Radius < 0.5f || (shape.Flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
+            draw_list->AddRectFilled(shape.A, shape.B, shape.Col);
+        else
+        {
+            draw_list->PathRect(shape.A, shape.B, shape.Radius, shape.Flags);
+            draw_list->PathFillConvex(shape.Col);
+        }
+        return;
+    case ShapeKind_Circle:
+    case ShapeKind_Ngon:
+        radius -= 0.5f;
+        break;
+    default:
+        break;
+    }
+    if (shape.Kind == ShapeKind_Circle || shape.Kind == ShapeKind_CircleFilled)
+        segments = segments > 0 ? ImClamp(segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX) : 0;
+    if (segments <= 0)
+    {
+        draw_list->_PathArcToFastEx(shape.A, radius, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
+        draw_list->_Path.Size--;
+    }
+    else
+    {
+        draw_list->PathArcTo(shape.A, radius, 0.0f, (IM_PI * 2.0f) * ((float)segments - 1.0f) / (float)segments, segments - 1);
+    }
+    if (shape.Kind == ShapeKind_CircleFilled || shape.Kind == ShapeKind_NgonFilled)
+        draw_list->PathFillConvex(shape.Col);
+    else
+        draw_list->PathStroke(shape.Col, ImDrawFlags_Closed, shape.Thickness);
+}
+
+// Returns the largest vertex position difference, or -1.0f if anything but vertex positions differs.
+static float CompareDrawLists(const ImDrawList* a, const ImDrawList* b)
+{
+    if (a->CmdBuffer.Size != b->CmdBuffer.Size || a->VtxBuffer.Size != b->VtxBuffer.Size || a->IdxBuffer.Size != b->IdxBuffer.Size)
+        return -1.0f;
+    for (int i = 0; i < a->CmdBuffer.Size; i++)
+        if (a->CmdBuffer[i].VtxOffset != b->CmdBuffer[i].VtxOffset || a->CmdBuffer[i].IdxOffset != b->CmdBuffer[i].IdxOffset || a->CmdBuffer[i].ElemCount != b->CmdBuffer[i].ElemCount)
+            return -1.0f;
+    if (memcmp(a->IdxBuffer.Data, b->IdxBuffer.Data, (size_t)a->IdxBuffer.Size * sizeof(ImDrawIdx)) != 0)
+        return -1.0f;
+    float max_diff = 0.0f;
+    for (int i = 0; i < a->VtxBuffer.Size; i++)
+    {
+        const ImDrawVert& va = a->VtxBuffer[i];
+        const ImDrawVert& vb = b->VtxBuffer[i];
+        if (va.col != vb.col || va.uv.x != vb.uv.x || va.uv.y != vb.uv.y)
+            return -1.0f;
+        max_diff = ImMax(max_diff, ImMax(ImFabs(va.pos.x - vb.pos.x), ImFabs(va.pos.y - vb.pos.y)));
+    }
+    return max_diff;
+}
+
+static void ResetDrawList(ImDrawList* draw_list, ImDrawListFlags flags)
+{
+    draw_list->_ResetForNewFrame();
+    draw_list->PushClipRectFullScreen();
+    draw_list->Flags = flags;
+}
+
+static void OpenDemoSections()
+{
+    ImGuiWindow* window = ImGui::FindWindowByName("Dear ImGui Demo");
+    const char* sections[] = { "Widgets", "Basic", "Tables & Columns", "Layout & Scrolling" };
+    for (const char* section : sections)
+        window->StateStorage.SetInt(ImHashStr(section, 0, window->ID), 1);
+}
+
+struct DemoResult
+{
+    double      FrameUs;
+    int         VtxCount;
+};
+
+// Keeps the fastest frame, this machine may be shared.
+static DemoResult RunDemo(int iterations)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    DemoResult result = {};
+    ImU64 best_ns = (ImU64)-1;
+    for (int run = -2; run < iterations; run++)
+    {
+        const ImU64 t0 = NowNs();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::ShowDemoWindow();
+        ImGui::Render();
+        if (run >= 0)
+            best_ns = ImMin(best_ns, NowNs() - t0);
+        if (run == -2)
+            OpenDemoSections();
+    }
+    result.FrameUs = best_ns / 1000.0;
+    result.VtxCount = ImGui::GetDrawData()->TotalVtxCount;
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? ImMax(atoi(argv[1]), 1) : 200;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 2000.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+
+    // Equivalence
+    ImGui::NewFrame();
+    const ImDrawListFlags aa_flags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill | ImDrawListFlags_AllowVtxOffset;
+    const ImDrawListFlags flags_cases[] = { aa_flags, aa_flags & ~ImDrawListFlags_AntiAliasedLinesUseTex, ImDrawListFlags_AllowVtxOffset };
+    const char* flags_names[] = { "aa_tex", "aa", "no_aa" };
+    ImVector<Shape> shape_sets[2];
+    const char* shape_set_names[] = { "mixed", "widgets" };
+    GenerateShapes(shape_sets[0], 20000, 1234);
+    GenerateWidgetShapes(shape_sets[1], 20000, 1234);
+    ImDrawList templated(ImGui::GetDrawListSharedData());
+    ImDrawList reference(ImGui::GetDrawListSharedData());
+    int failures = 0;
+    for (int set_n = 0; set_n < IM_ARRAYSIZE(shape_sets); set_n++)
+        for (int flags_n = 0; flags_n < IM_ARRAYSIZE(flags_cases); flags_n++)
+        {
+            const ImVector<Shape>& shapes = shape_sets[set_n];
+            ImU64 templated_ns = (ImU64)-1, reference_ns = (ImU64)-1;
+            const int runs = 2 + ImMax(iterations / 10, 1);
+            for (int run = 0; run < runs; run++) // First runs see and record shapes, then keep the fastest run
+            {
+                ResetDrawList(&templated, flags_cases[flags_n]);
+                ImU64 t0 = NowNs();
+                for (const Shape& shape : shapes)
+                    DrawShape(&templated, shape);
+                ImU64 t1 = NowNs();
+                ResetDrawList(&reference, flags_cases[flags_n]);
+                ImU64 t2 = NowNs();
+                for (const Shape& shape : shapes)
+                    DrawShapeReference(&reference, shape);
+                ImU64 t3 = NowNs();
+                if (run >= 2)
+                {
+                    templated_ns = ImMin(templated_ns, t1 - t0);
+                    reference_ns = ImMin(reference_ns, t3 - t2);
+                }
+            }
+            const float max_diff = CompareDrawLists(&templated, &reference);
+            const bool ok = max_diff >= 0.0f && max_diff < 0.01f;
+            failures += ok ? 0 : 1;
+            printf("%-7s %-6s %s (max pos diff %g, %6d vtx)  path %7.1f us %6.1f Mvtx/s  Add*() %7.1f us %6.1f Mvtx/s\n", shape_set_names[set_n], flags_names[flags_n], ok ? "same" : "DIFFERS", max_diff,
+                templated.VtxBuffer.Size, reference_ns / 1000.0, templated.VtxBuffer.Size * 1000.0 / reference_ns, templated_ns / 1000.0, templated.VtxBuffer.Size * 1000.0 / templated_ns);
+        }
+    printf("shape templates: %d vtx\n", ImGui::GetDrawListSharedData()->ShapeTemplateVtx.Size);
+    ImGui::EndFrame();
+
+    // Demo window
+    for (int style_n = 0; style_n < 2; style_n++)
+    {
+        if (style_n == 1)
+        {
+            ImGuiStyle& style = ImGui::GetStyle();
+            style.WindowRounding = style.ChildRounding = style.PopupRounding = 6.0f;
+            style.FrameRounding = style.GrabRounding = style.TabRounding = 4.0f;
+            style.FrameBorderSize = 1.0f;
+        }
+        const DemoResult result = RunDemo(iterations);
+        printf("demo %-8s %6d vtx  %8.1f us/frame  %6.1f Mvtx/s\n", style_n == 0 ? "default" : "rounded", result.VtxCount, result.FrameUs, result.VtxCount / result.FrameUs);
+    }
+
+    ImGui::DestroyContext();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,10 @@
+#!/bin/sh
+# Builds bench_shapes.cpp with and without shape templates, checks templated shapes against direct tessellation and compares demo window vertex throughput.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o bench_shapes bench_shapes.cpp
+c++ -O2 -std=c++11 -I ../../in -DIMGUI_DISABLE_DRAWLIST_SHAPE_TEMPLATES -o bench_shapes_direct bench_shapes.cpp
+echo "templates:"
+./bench_shapes "${1:-200}"
+echo "direct:"
+./bench_shapes_direct "${1:-200}"
@@ -0,0 +1,193 @@
+// Dear ImGui: software rasterizer backend (imgui_impl_softraster) check and benchmark
+
+// Coverage check: a 1280x800 mesh of triangles with jittered fractional vertices is drawn with a translucent color over a
+// cleared target, every pixel has to be covered exactly once (no cracks, no double blending along shared edges).
+// Benchmark: renders the demo window and style editor at 1280x800 with 1, 2, 4 and all hardware threads, prints the
+// throughput in megapixels/s of target per second and checks that every thread count produces the same image.
+//
+// Usage: bench_softraster [iterations] [output.ppm]      (default: 100, no image written)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include "imgui_demo.cpp"
+#include "backends/imgui_impl_softraster.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <thread>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static ImU64 HashBytes(ImU64 hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    return hash;
+}
+
+static const int WIDTH = 1280;
+static const int HEIGHT = 800;
+
+// Grid of quads covering the display, inner vertices moved by up to 0.15 cell (quads stay convex), two triangles per quad with alternating diagonals.
+static void DrawJitteredMesh(ImDrawList* draw_list, ImU32 col)
+{
+    const int cells_x = 160, cells_y = 100;
+    const float cell_w = (float)WIDTH / cells_x, cell_h = (float)HEIGHT / cells_y;
+    ImVector<ImVec2> grid;
+    grid.resize((cells_x + 1) * (cells_y + 1));
+    unsigned int seed = 1234;
+    for (int y = 0; y <= cells_y; y++)
+        for (int x = 0; x <= cells_x; x++)
+        {
+            ImVec2 p(x * cell_w, y * cell_h);
+            if (x > 0 && x < cells_x && y > 0 && y < cells_y)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                p.x += ((float)((seed >> 8) & 0xFFFF) / 65535.0f - 0.5f) * 0.3f * cell_w;
+                seed = seed * 1664525u + 1013904223u;
+                p.y += ((float)((seed >> 8) & 0xFFFF) / 65535.0f - 0.5f) * 0.3f * cell_h;
+            }
+            grid[y * (cells_x + 1) + x] = p;
+        }
+
+    const ImVec2 uv = draw_list->_Data->TexUvWhitePixel;
+    for (int y = 0; y < cells_y; y++)
+        for (int x = 0; x < cells_x; x++)
+        {
+            draw_list->PrimReserve(6, 4);
+            const ImDrawIdx idx = (ImDrawIdx)draw_list->_VtxCurrentIdx;
+            const ImVec2 corners[4] = { grid[y * (cells_x + 1) + x], grid[y * (cells_x + 1) + x + 1], grid[(y + 1) * (cells_x + 1) + x + 1], grid[(y + 1) * (cells_x + 1) + x] };
+            for (const ImVec2& corner : corners)
+                draw_list->PrimWriteVtx(corner, uv, col);
+            if ((x + y) & 1)
+            {
+                draw_list->PrimWriteIdx(idx); draw_list->PrimWriteIdx((ImDrawIdx)(idx + 1)); draw_list->PrimWriteIdx((ImDrawIdx)(idx + 2));
+                draw_list->PrimWriteIdx(idx); draw_list->PrimWriteIdx((ImDrawIdx)(idx + 2)); draw_list->PrimWriteIdx((ImDrawIdx)(idx + 3));
+            }
+            else
+            {
+                draw_list->PrimWriteIdx(idx); draw_list->PrimWriteIdx((ImDrawIdx)(idx + 1)); draw_list->PrimWriteIdx((ImDrawIdx)(idx + 3));
+                draw_list->PrimWriteIdx((ImDrawIdx)(idx + 1)); draw_list->PrimWriteIdx((ImDrawIdx)(idx + 2)); draw_list->PrimWriteIdx((ImDrawIdx)(idx + 3));
+            }
+        }
+}
+
+static void NewFrame()
+{
+    ImGui_ImplSoftRaster_NewFrame();
+    ImGui::NewFrame();
+}
+
+static bool CheckCoverage(ImVector<ImU32>& target)
+{
+    const ImU32 col = IM_COL32(255, 128, 0, 128);
+    NewFrame();
+    DrawJitteredMesh(ImGui::GetBackgroundDrawList(), col);
+    ImGui::Render();
+    memset(target.Data, 0, (size_t)target.size_in_bytes());
+    ImGui_ImplSoftRaster_RenderDrawData(ImGui::GetDrawData(), target.Data, WIDTH, HEIGHT, WIDTH * (int)sizeof(ImU32));
+
+    const ImU32 expected = ImGui_ImplSoftRaster_Blend(col, 0);
+    int bad = 0;
+    for (ImU32 pixel : target)
+        if (pixel != expected)
+            bad++;
+    printf("coverage: %d triangles, %d pixels not covered exactly once\n", ImGui::GetDrawData()->TotalIdxCount / 3, bad);
+    return bad == 0;
+}
+
+static void DrawDemoFrame()
+{
+    NewFrame();
+    ImGui::ShowDemoWindow();
+    ImGui::SetWindowPos("Dear ImGui Demo", ImVec2(10.0f, 10.0f));  // The demo sets its own position on first use
+    ImGui::SetWindowSize("Dear ImGui Demo", ImVec2(760.0f, 780.0f));
+    ImGui::SetNextWindowPos(ImVec2(780.0f, 10.0f));
+    ImGui::SetNextWindowSize(ImVec2(490.0f, 780.0f));
+    ImGui::Begin("Dear ImGui Style Editor", NULL, ImGuiWindowFlags_NoSavedSettings);
+    ImGui::ShowStyleEditor();
+    ImGui::End();
+    ImGui::Render();
+}
+
+static void WritePPM(const char* filename, const ImVector<ImU32>& target)
+{
+    FILE* f = fopen(filename, "wb");
+    if (f == NULL)
+        return;
+    fprintf(f, "P6\n%d %d\n255\n", WIDTH, HEIGHT);
+    for (ImU32 pixel : target)
+    {
+        const ImColor c(pixel);
+        const unsigned char rgb[3] = { (unsigned char)(c.Value.x * 255.0f + 0.5f), (unsigned char)(c.Value.y * 255.0f + 0.5f), (unsigned char)(c.Value.z * 255.0f + 0.5f) };
+        fwrite(rgb, 1, 3, f);
+    }
+    fclose(f);
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? atoi(argv[1]) : 100;
+    const char* output_filename = argc > 2 ? argv[2] : NULL;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2((float)WIDTH, (float)HEIGHT);
+    io.DeltaTime = 1.0f / 60.0f;
+
+    ImVector<ImU32> target;
+    target.resize(WIDTH * HEIGHT);
+
+    ImGui_ImplSoftRaster_Init(1);
+    bool ok = CheckCoverage(target);
+    ImGui_ImplSoftRaster_Shutdown();
+
+    const int hardware_threads = ImMax((int)std::thread::hardware_concurrency(), 1);
+    const int thread_counts[] = { 1, 2, 4, hardware_threads };
+    ImU64 first_hash = 0;
+    for (int thread_count : thread_counts)
+    {
+        ImGui_ImplSoftRaster_Init(thread_count);
+        for (int n = 0; n < 3; n++)     // Let windows settle
+            DrawDemoFrame();
+        ImDrawData* draw_data = ImGui::GetDrawData();
+
+        ImU64 best_ns = (ImU64)-1;
+        for (int run = 0; run < iterations; run++)
+        {
+            for (ImU32& pixel : target)
+                pixel = IM_COL32(45, 55, 60, 255);
+            const ImU64 t0 = NowNs();
+            ImGui_ImplSoftRaster_RenderDrawData(draw_data, target.Data, WIDTH, HEIGHT, WIDTH * (int)sizeof(ImU32));
+            best_ns = ImMin(best_ns, NowNs() - t0);
+        }
+
+        const ImU64 hash = HashBytes(0xCBF29CE484222325ull, target.Data, (size_t)target.size_in_bytes());
+        if (first_hash == 0)
+            first_hash = hash;
+        else if (hash != first_hash)
+            ok = false;
+        printf("demo %dx%d, %6d triangles, %2d threads: %7.3f ms  %8.1f Mpix/s  hash %016llx\n", WIDTH, HEIGHT, draw_data->TotalIdxCount / 3, thread_count,
+            best_ns / 1000000.0, (double)WIDTH * HEIGHT / (best_ns / 1000.0), (unsigned long long)hash);
+        if (output_filename != NULL && thread_count == 1)
+            WritePPM(output_filename, target);
+        ImGui_ImplSoftRaster_Shutdown();
+    }
+
+    printf("%s\n", ok ? "output ok" : "output FAILED");
+    ImGui::DestroyContext();
+    return ok ? 0 : 1;
+}
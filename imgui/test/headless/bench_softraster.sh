@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds bench_softraster.cpp, checks the coverage rules of the software rasterizer backend and measures its throughput on the demo window.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -pthread -I ../../in -o bench_softraster bench_softraster.cpp
+./bench_softraster "${1:-100}"
@@ -0,0 +1,217 @@
+// Dear ImGui: ImDrawListSplitter::Merge() equivalence check and benchmark
+//
+// Fills a splitter the way a 64-column, 1000-row table does (one channel per column, text in every cell, columns sharing
+// a clip rectangle so their commands merge), then merges it with ImDrawListSplitter::Merge() and with a single-pass variant
+// (final IdxOffset written directly, no erase() of merged commands), alternating which one runs first and keeping the
+// fastest run of each. Both draw lists have to match bit for bit. Also times full frames of a real 64x1000 table for context.
+//
+// A merge that doesn't copy indices isn't feasible with the current ImDrawList/ImDrawData layout:
+// - Channels can't record into slices of the parent IdxBuffer: each ImVector owns and reallocates its storage, and a channel's
+//   final offset is only known once every channel before it is complete.
+// - Commands can't keep pointing into the channel buffers: ImDrawCmd::IdxOffset is relative to the single IdxBuffer of the
+//   draw list that renderers upload, and tables rely on consecutive columns merging into a single draw call.
+// Both variants are bound by the index memcpy (~2M indices here), so Merge() keeps its two-pass implementation.
+//
+// Usage: bench_table_merge [iterations]      (default: 50)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const int COLUMNS = 64;
+static const int ROWS = 1000;
+
+// Single-pass variant of ImDrawListSplitter::Merge(): sizes the parent buffers up front and writes commands with their final
+// IdxOffset, leaving channel buffers untouched. Measured against Merge(), not adopted: both are bound by the index memcpy.
+static void MergeSinglePass(ImDrawListSplitter* splitter, ImDrawList* draw_list)
+{
+    if (splitter->_Count <= 1)
+        return;
+
+    splitter->SetCurrentChannel(draw_list, 0);
+    draw_list->_PopUnusedDrawCmd();
+
+    int cmd_count_max = 0;
+    int idx_count = 0;
+    for (int i = 1; i < splitter->_Count; i++)
+    {
+        ImDrawChannel& ch = splitter->_Channels[i];
+        if (ch._CmdBuffer.Size > 0 && ch._CmdBuffer.back().ElemCount == 0 && ch._CmdBuffer.back().UserCallback == NULL)
+            ch._CmdBuffer.pop_back();
+        cmd_count_max += ch._CmdBuffer.Size;
+        idx_count += ch._IdxBuffer.Size;
+    }
+    const int cmd_start = draw_list->CmdBuffer.Size;
+    draw_list->CmdBuffer.resize(cmd_start + cmd_count_max);
+    draw_list->IdxBuffer.resize(draw_list->IdxBuffer.Size + idx_count);
+
+    ImDrawCmd* cmd_write = draw_list->CmdBuffer.Data + cmd_start;
+    ImDrawIdx* idx_write = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size - idx_count;
+    ImDrawCmd* last_cmd = (cmd_start > 0) ? cmd_write - 1 : NULL;
+    unsigned int idx_offset = last_cmd ? last_cmd->IdxOffset + last_cmd->ElemCount : 0;
+    for (int i = 1; i < splitter->_Count; i++)
+    {
+        ImDrawChannel& ch = splitter->_Channels[i];
+        const ImDrawCmd* src_cmd = ch._CmdBuffer.Data;
+        const ImDrawCmd* src_cmd_end = src_cmd + ch._CmdBuffer.Size;
+        if (src_cmd < src_cmd_end && last_cmd != NULL && ImDrawCmd_HeaderCompare(last_cmd, src_cmd) == 0 && last_cmd->UserCallback == NULL && src_cmd->UserCallback == NULL)
+        {
+            last_cmd->ElemCount += src_cmd->ElemCount;
+            idx_offset += src_cmd->ElemCount;
+            src_cmd++;
+        }
+        for (; src_cmd < src_cmd_end; src_cmd++)
+        {
+            *cmd_write = *src_cmd;
+            cmd_write->IdxOffset = idx_offset;
+            idx_offset += src_cmd->ElemCount;
+            last_cmd = cmd_write++;
+        }
+        if (int sz = ch._IdxBuffer.Size) { memcpy(idx_write, ch._IdxBuffer.Data, sz * sizeof(ImDrawIdx)); idx_write += sz; }
+    }
+    draw_list->CmdBuffer.resize((int)(cmd_write - draw_list->CmdBuffer.Data));
+    draw_list->_IdxWritePtr = idx_write;
+
+    if (draw_list->CmdBuffer.Size == 0 || draw_list->CmdBuffer.back().UserCallback != NULL)
+        draw_list->AddDrawCmd();
+
+    ImDrawCmd* curr_cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
+    if (curr_cmd->ElemCount == 0)
+        ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader);
+    else if (ImDrawCmd_HeaderCompare(curr_cmd, &draw_list->_CmdHeader) != 0)
+        draw_list->AddDrawCmd();
+
+    splitter->_Count = 1;
+}
+
+// One channel per column. Columns are grouped by 16 sharing a clip rectangle (as TableMergeDrawChannels() does for columns
+// fitting in their merge group), with every 8th column keeping its own so some commands don't merge.
+static void FillTableChannels(ImDrawListSplitter* splitter, ImDrawList* draw_list)
+{
+    draw_list->ResetDetached();
+    draw_list->AddRectFilled(ImVec2(0.0f, 0.0f), ImVec2(1280.0f, 20.0f), IM_COL32(40, 40, 60, 255));
+    splitter->Split(draw_list, COLUMNS + 1);
+    const float column_width = 1280.0f / COLUMNS;
+    for (int column = 0; column < COLUMNS; column++)
+    {
+        splitter->SetCurrentChannel(draw_list, column + 1);
+        const float x = column * column_width;
+        if ((column % 8) == 7)
+            draw_list->PushClipRect(ImVec2(x, 0.0f), ImVec2(x + column_width, 20000.0f));
+        else
+            draw_list->PushClipRect(ImVec2((column / 16) * column_width * 16, 0.0f), ImVec2((column / 16 + 1) * column_width * 16, 20000.0f));
+        char buf[16];
+        for (int row = 0; row < ROWS; row++)
+        {
+            ImFormatString(buf, IM_ARRAYSIZE(buf), "%d,%d", row, column);
+            draw_list->AddText(ImVec2(x + 2.0f, row * 17.0f), IM_COL32_WHITE, buf);
+        }
+        draw_list->PopClipRect();
+    }
+}
+
+static bool SameDrawList(const ImDrawList* a, const ImDrawList* b)
+{
+    if (a->CmdBuffer.Size != b->CmdBuffer.Size || a->IdxBuffer.Size != b->IdxBuffer.Size || a->VtxBuffer.Size != b->VtxBuffer.Size)
+        return false;
+    for (int i = 0; i < a->CmdBuffer.Size; i++)
+    {
+        const ImDrawCmd& ca = a->CmdBuffer[i];
+        const ImDrawCmd& cb = b->CmdBuffer[i];
+        if (memcmp(&ca.ClipRect, &cb.ClipRect, sizeof(ImVec4)) != 0 || ca.TextureId != cb.TextureId || ca.VtxOffset != cb.VtxOffset || ca.IdxOffset != cb.IdxOffset || ca.ElemCount != cb.ElemCount)
+            return false;
+    }
+    return memcmp(a->IdxBuffer.Data, b->IdxBuffer.Data, (size_t)a->IdxBuffer.Size * sizeof(ImDrawIdx)) == 0
+        && memcmp(a->VtxBuffer.Data, b->VtxBuffer.Data, (size_t)a->VtxBuffer.Size * sizeof(ImDrawVert)) == 0
+        && a->_IdxWritePtr - a->IdxBuffer.Data == b->_IdxWritePtr - b->IdxBuffer.Data;
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? atoi(argv[1]) : 50;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+
+    // Splitter merge alone
+    ImGui::NewFrame();
+    ImDrawList merged(ImGui::GetDrawListSharedData());
+    ImDrawList single_pass(ImGui::GetDrawListSharedData());
+    merged.Flags = single_pass.Flags = ImDrawListFlags_AllowVtxOffset;
+    ImDrawListSplitter splitter;
+    ImU64 merge_ns = (ImU64)-1, single_pass_ns = (ImU64)-1;
+    for (int run = 0; run < iterations * 2; run++)
+    {
+        // Alternate the order of both implementations (Merge, single pass, single pass, Merge...) so neither always runs right after the other
+        const bool use_single_pass = (((run & 1) ^ ((run >> 1) & 1)) != 0);
+        ImDrawList* draw_list = use_single_pass ? &single_pass : &merged;
+        FillTableChannels(&splitter, draw_list);
+        const ImU64 t0 = NowNs();
+        if (use_single_pass)
+            MergeSinglePass(&splitter, draw_list);
+        else
+            splitter.Merge(draw_list);
+        ImU64& best_ns = use_single_pass ? single_pass_ns : merge_ns;
+        best_ns = ImMin(best_ns, NowNs() - t0);
+    }
+    splitter.ClearFreeMemory();
+    ImGui::EndFrame();
+    const bool same = SameDrawList(&merged, &single_pass);
+    printf("merge %d channels, %d cmds, %d indices (best of %d): Merge() %8.1f us  single pass %8.1f us  x%.2f\n", COLUMNS + 1, merged.CmdBuffer.Size, merged.IdxBuffer.Size,
+        iterations, merge_ns / 1000.0, single_pass_ns / 1000.0, (double)merge_ns / single_pass_ns);
+
+    // Full frames of a real table, no clipper
+    ImU64 frame_ns = 0;
+    for (int run = 0; run < iterations; run++)
+    {
+        const ImU64 t0 = NowNs();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Table", NULL, ImGuiWindowFlags_NoSavedSettings);
+        if (ImGui::BeginTable("table", COLUMNS, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY))
+        {
+            for (int row = 0; row < ROWS; row++)
+            {
+                ImGui::TableNextRow();
+                for (int column = 0; column < COLUMNS; column++)
+                {
+                    ImGui::TableSetColumnIndex(column);
+                    ImGui::Text("%d,%d", row, column);
+                }
+            }
+            ImGui::EndTable();
+        }
+        ImGui::End();
+        ImGui::Render();
+        frame_ns += NowNs() - t0;
+    }
+    printf("table %dx%d frame %8.1f us, %d cmds\n", COLUMNS, ROWS, frame_ns / 1000.0 / iterations, ImGui::GetDrawData()->CmdListsCount > 0 ? ImGui::GetDrawData()->CmdLists[0]->CmdBuffer.Size : 0);
+    printf("%s\n", same ? "output identical" : "output differs");
+
+    ImGui::DestroyContext();
+    return same ? 0 : 1;
+}
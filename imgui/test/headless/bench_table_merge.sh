@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds bench_table_merge.cpp, checks that ImDrawListSplitter::Merge() matches the previous implementation and compares their timings.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o bench_table_merge bench_table_merge.cpp
+./bench_table_merge "${1:-50}"
@@ -0,0 +1,177 @@
+// Dear ImGui: CalcTextSizeA()/RenderText() printable ASCII runs equivalence check and benchmark
+
+// Measures and renders a log of long lines (timestamps, levels, source paths, messages, hex dumps), pure ASCII and with some
+// tabs and UTF-8 lines, and prints a hash of the sizes/vertices and the throughput of each pass. bench_text.sh builds this once with
+// the SIMD text loops and once with IMGUI_DISABLE_SIMD_TEXT, then compares the hashes of both builds.
+//
+// Usage: bench_text [iterations]      (default: 20)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static ImU64 HashBytes(ImU64 hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    return hash;
+}
+
+static const int LINES_COUNT = 20000;
+static const int LINES_PER_FRAME = 60;
+static const float WRAP_WIDTH = 600.0f;
+static const float MAX_WIDTH = 500.0f;
+
+static unsigned int Rand(unsigned int* seed)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return *seed >> 8;
+}
+
+// Lines of 60 to 400 bytes. With 'utf8', one line in four has a tab and words outside of ASCII (some of them missing from the font).
+static void GenerateLog(ImGuiTextBuffer* log, ImVector<int>* line_offsets, bool utf8)
+{
+    static const char* levels[] = { "INFO ", "DEBUG", "WARN ", "ERROR" };
+    static const char* words[] = { "connection", "request", "handler", "timeout", "retrying", "buffer", "flushed", "user=42", "status=200", "latency_ms=17", "queue", "worker", "(cached)", "ok.", "failed:", "path=/var/log/app" };
+    static const char* utf8_words[] = { "\tGr\xC3\xBC\xC3\x9F" "e", "d\xC3\xA9j\xC3\xA0 vu", "\xE2\x86\x92", "\xE6\x97\xA5\xE6\x9C\xAC", "na\xC3\xAFve" };
+    unsigned int seed = 1234;
+    for (int line_n = 0; line_n < LINES_COUNT; line_n++)
+    {
+        line_offsets->push_back(log->size());
+        const unsigned int ms = (unsigned int)line_n * 37;
+        log->appendf("2026-10-19 %02u:%02u:%02u.%03u [%s] src/net/module_%u.cpp:%u: ", (ms / 3600000) % 24, (ms / 60000) % 60, (ms / 1000) % 60, ms % 1000,
+            levels[Rand(&seed) % IM_ARRAYSIZE(levels)], Rand(&seed) % 16, Rand(&seed) % 2000);
+        const int line_len = 60 + (int)(Rand(&seed) % 340);
+        const bool utf8_line = utf8 && (line_n % 4) == 0;
+        while (log->size() - line_offsets->back() < line_len)
+        {
+            if (utf8_line && Rand(&seed) % 4 == 0)
+                log->appendf("%s ", utf8_words[Rand(&seed) % IM_ARRAYSIZE(utf8_words)]);
+            else if (Rand(&seed) % 8 == 0)
+                log->appendf("0x%08x ", Rand(&seed));
+            else
+                log->appendf("%s ", words[Rand(&seed) % IM_ARRAYSIZE(words)]);
+        }
+        log->append("\n");
+    }
+    line_offsets->push_back(log->size());
+}
+
+struct Pass
+{
+    const char*     Name;
+    bool            Render;
+    float           WrapWidth;
+    float           MaxWidth;
+};
+
+static void RunPass(const char* scene_name, const Pass& pass, ImFont* font, const ImGuiTextBuffer& log, const ImVector<int>& line_offsets, int iterations)
+{
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    const float size = font->FontSize;
+    const ImVec4 clip_rect(0.0f, 0.0f, 1280.0f, 800.0f);
+    ImU64 hash = 0xCBF29CE484222325ull;
+    ImU64 best_ns = (ImU64)-1;
+    for (int run = 0; run < iterations; run++)
+    {
+        ImU64 run_ns = 0;
+        for (int frame_begin = 0; frame_begin < LINES_COUNT; frame_begin += LINES_PER_FRAME)
+        {
+            const int frame_end = ImMin(frame_begin + LINES_PER_FRAME, LINES_COUNT);
+            if (pass.Render)
+            {
+                draw_list._ResetForNewFrame();
+                draw_list.Flags = ImDrawListFlags_AllowVtxOffset;
+                draw_list.PushClipRectFullScreen();
+                draw_list.PushTextureID((ImTextureID)1);
+            }
+            ImVec2 sizes[LINES_PER_FRAME];
+            const ImU64 t0 = NowNs();
+            for (int line_n = frame_begin; line_n < frame_end; line_n++)
+            {
+                const char* line = log.begin() + line_offsets[line_n];
+                const char* line_end = log.begin() + line_offsets[line_n + 1] - 1;
+                if (pass.Render)
+                {
+                    const ImVec2 pos(4.0f, (float)((line_n - frame_begin) % 40) * size * 2.0f);
+                    font->RenderText(&draw_list, size, pos, IM_COL32_WHITE, clip_rect, line, line_end, pass.WrapWidth);
+                }
+                else
+                {
+                    const char* remaining = NULL;
+                    sizes[line_n - frame_begin] = font->CalcTextSizeA(size, pass.MaxWidth, pass.WrapWidth, line, line_end, &remaining);
+                    sizes[line_n - frame_begin].x += (float)(remaining - line) * 1000.0f;
+                }
+            }
+            run_ns += NowNs() - t0;
+            if (run > 0)
+                continue;
+            if (pass.Render)
+            {
+                hash = HashBytes(hash, draw_list.VtxBuffer.Data, (size_t)draw_list.VtxBuffer.Size * sizeof(ImDrawVert));
+                hash = HashBytes(hash, draw_list.IdxBuffer.Data, (size_t)draw_list.IdxBuffer.Size * sizeof(ImDrawIdx));
+            }
+            else
+            {
+                hash = HashBytes(hash, sizes, (size_t)(frame_end - frame_begin) * sizeof(ImVec2));
+            }
+        }
+        best_ns = ImMin(best_ns, run_ns);
+    }
+    char name[64];
+    ImFormatString(name, IM_ARRAYSIZE(name), "%s_%s", scene_name, pass.Name);
+    printf("%-20s hash %016llx  %8.2f ms/pass  %8.1f MB/s\n", name, (unsigned long long)hash, best_ns / 1000000.0, log.size() / (1024.0 * 1024.0) / (best_ns / 1e9));
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? ImMax(atoi(argv[1]), 1) : 20;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    ImFont* font = io.Fonts->AddFontDefault();
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+    ImGui::NewFrame();
+
+    const Pass passes[] =
+    {
+        { "size",           false,  0.0f,       FLT_MAX },
+        { "size_max",       false,  0.0f,       MAX_WIDTH },
+        { "size_wrap",      false,  WRAP_WIDTH, FLT_MAX },
+        { "render",         true,   0.0f,       FLT_MAX },
+        { "render_wrap",    true,   WRAP_WIDTH, FLT_MAX },
+    };
+    for (int scene_n = 0; scene_n < 2; scene_n++)
+    {
+        ImGuiTextBuffer log;
+        ImVector<int> line_offsets;
+        GenerateLog(&log, &line_offsets, scene_n == 1);
+        for (const Pass& pass : passes)
+            RunPass(scene_n == 0 ? "ascii" : "utf8", pass, font, log, line_offsets, iterations);
+    }
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    return 0;
+}
@@ -0,0 +1,13 @@
+#!/bin/sh
+# Builds bench_text.cpp with and without the SIMD text loops, prints both throughputs and fails if the output differs.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o bench_text_simd bench_text.cpp
+c++ -O2 -std=c++11 -I ../../in -DIMGUI_DISABLE_SIMD_TEXT -o bench_text_scalar bench_text.cpp
+echo "simd:"
+./bench_text_simd "${1:-20}" | tee bench_text_simd.txt
+echo "scalar:"
+./bench_text_scalar "${1:-20}" | tee bench_text_scalar.txt
+cut -c1-42 bench_text_simd.txt > bench_text_simd.hash
+cut -c1-42 bench_text_scalar.txt > bench_text_scalar.hash
+if cmp -s bench_text_simd.hash bench_text_scalar.hash; then echo "output identical"; else echo "output differs"; exit 1; fi
@@ -0,0 +1,224 @@
+// Dear ImGui: text layout cache (ImDrawListSharedData::CalcTextLayoutSize()) check and benchmark
+//
+// Runs frames of a few scenes and prints a hash of the last frame's draw data, the fastest frame time and the share of CalcTextSize()
+// calls answered by the cache during the timed frames:
+// - demo: the demo window with a few sections open, including wrapped text.
+// - table: a 10k-row, 5-column table of labels (clipped, about 40 rows visible), not scrolling.
+// - table_scroll: the same table scrolling by 3 rows per frame, every visible row is new after a dozen frames.
+// - table_64x1000: a 64-column, 1000-row table of labels without clipper (unwrapped, not cached).
+// - table_wrapped: the same table with TextWrapped(), more wrapped texts a frame than the cache can hold.
+// - wrapped: 60 paragraphs of TextWrapped(), whose line breaks RenderText() takes from the cache.
+// bench_textcache.sh builds this once with the cache and once with IMGUI_DISABLE_TEXT_LAYOUT_CACHE, then compares the hashes of both builds.
+//
+// Usage: bench_textcache [iterations]      (default: 300)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include "imgui_demo.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static ImU64 HashBytes(ImU64 hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    return hash;
+}
+
+static const int TABLE_ROWS = 10000;
+static const int PARAGRAPHS_COUNT = 60;
+
+static void OpenDemoSections()
+{
+    ImGuiWindow* window = ImGui::FindWindowByName("Dear ImGui Demo");
+    const char* sections[] = { "Widgets", "Basic", "Tables & Columns", "Layout & Scrolling", "Text" };
+    for (const char* section : sections)
+        window->StateStorage.SetInt(ImHashStr(section, 0, window->ID), 1);
+    window->StateStorage.SetInt(ImHashStr("Word Wrapping", 0, ImHashStr("Text", 0, window->ID)), 1);
+}
+
+static void ShowDemo(int)
+{
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::ShowDemoWindow();
+}
+
+static const char* NAMES[] = { "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel", "india", "juliett", "kilo", "lima" };
+static const char* STATES[] = { "Idle", "Running", "Waiting for input", "Done", "Failed (see log)" };
+
+static void ShowTable(int scroll_rows_per_frame)
+{
+    static int frame = 0;
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin("Table", NULL, ImGuiWindowFlags_NoDecoration);
+    if (ImGui::BeginTable("rows", 5, ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("ID");
+        ImGui::TableSetupColumn("Name");
+        ImGui::TableSetupColumn("Path");
+        ImGui::TableSetupColumn("State");
+        ImGui::TableSetupColumn("Size");
+        ImGui::TableHeadersRow();
+        if (scroll_rows_per_frame > 0)
+            ImGui::SetScrollY((float)((frame++ * scroll_rows_per_frame) % (TABLE_ROWS / 2)) * ImGui::GetTextLineHeightWithSpacing());
+        ImGuiListClipper clipper;
+        clipper.Begin(TABLE_ROWS);
+        while (clipper.Step())
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                char label[32];
+                ImFormatString(label, IM_ARRAYSIZE(label), "%05d", row);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Selectable(label, false, ImGuiSelectableFlags_SpanAllColumns);
+                ImGui::TableNextColumn();
+                ImGui::Text("%s_%s", NAMES[row % IM_ARRAYSIZE(NAMES)], NAMES[(row / 7) % IM_ARRAYSIZE(NAMES)]);
+                ImGui::TableNextColumn();
+                ImGui::Text("/data/%s/%d/file_%05d.bin", NAMES[(row / 3) % IM_ARRAYSIZE(NAMES)], row % 97, row);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(STATES[row % IM_ARRAYSIZE(STATES)]);
+                ImGui::TableNextColumn();
+                ImGui::Text("%d KB", (row * 7919) % 100000);
+            }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+static void ShowLargeTable(int wrapped)
+{
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin("Large Table", NULL, ImGuiWindowFlags_NoDecoration);
+    if (ImGui::BeginTable("cells", 64, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY))
+    {
+        for (int row = 0; row < 1000; row++)
+        {
+            ImGui::TableNextRow();
+            for (int column = 0; column < 64; column++)
+            {
+                ImGui::TableSetColumnIndex(column);
+                if (wrapped)
+                    ImGui::TextWrapped("%d,%d", row, column);
+                else
+                    ImGui::Text("%d,%d", row, column);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+static void ShowWrapped(int)
+{
+    static ImGuiTextBuffer paragraphs[PARAGRAPHS_COUNT];
+    if (paragraphs[0].empty())
+    {
+        const char* words[] = { "lorem", "ipsum", "dolor", "sit", "amet,", "consectetur", "adipiscing", "elit.", "sed", "do", "eiusmod", "tempor" };
+        unsigned int seed = 1234;
+        for (ImGuiTextBuffer& paragraph : paragraphs)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            const int words_count = 20 + (int)((seed >> 8) % 80);
+            for (int n = 0; n < words_count; n++)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                paragraph.appendf("%s ", words[(seed >> 8) % IM_ARRAYSIZE(words)]);
+            }
+        }
+    }
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin("Wrapped", NULL, ImGuiWindowFlags_NoDecoration);
+    for (int n = 0; n < PARAGRAPHS_COUNT; n++)
+    {
+        ImGui::PushTextWrapPos(ImGui::GetCursorPosX() + 200.0f + (float)(n % 4) * 150.0f);
+        ImGui::TextUnformatted(paragraphs[n].begin(), paragraphs[n].end());
+        ImGui::PopTextWrapPos();
+    }
+    ImGui::End();
+}
+
+struct Scene
+{
+    const char*     Name;
+    void            (*Show)(int param);
+    int             Param;
+};
+
+static void RunScene(const Scene& scene, int iterations)
+{
+    ImDrawListSharedData& shared_data = GImGui->DrawListSharedData;
+    int hits = 0, misses = 0;
+    ImU64 best_ns = (ImU64)-1;
+    for (int run = -2; run < iterations; run++)
+    {
+        const int hits_before = shared_data.TextLayoutsHits, misses_before = shared_data.TextLayoutsMisses;
+        const ImU64 t0 = NowNs();
+        ImGui::NewFrame();
+        scene.Show(scene.Param);
+        ImGui::Render();
+        if (run < 0)
+        {
+            if (scene.Show == ShowDemo && run == -2)
+                OpenDemoSections();
+            continue;
+        }
+        best_ns = ImMin(best_ns, NowNs() - t0);
+        hits += shared_data.TextLayoutsHits - hits_before;
+        misses += shared_data.TextLayoutsMisses - misses_before;
+    }
+
+    ImU64 hash = 0xCBF29CE484222325ull;
+    ImDrawData* draw_data = ImGui::GetDrawData();
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        hash = HashBytes(hash, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes());
+        hash = HashBytes(hash, draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes());
+    }
+    const int lookups = hits + misses;
+    printf("%-14s hash %016llx  frame %8.1f us | %7.1f CalcTextSize()/frame, hits %5.1f%% | %5d layouts, %5d slots, %6d wrap breaks\n",
+        scene.Name, (unsigned long long)hash, best_ns / 1000.0, (double)lookups / iterations, lookups ? 100.0 * hits / lookups : 0.0,
+        shared_data.TextLayoutsCount, shared_data.TextLayouts.Size, shared_data.TextLayoutWrapBreaks.Size);
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? ImMax(atoi(argv[1]), 1) : 300;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+
+    const Scene scenes[] = { { "demo", ShowDemo, 0 }, { "table", ShowTable, 0 }, { "table_scroll", ShowTable, 3 }, { "table_64x1000", ShowLargeTable, 0 }, { "table_wrapped", ShowLargeTable, 1 }, { "wrapped", ShowWrapped, 0 } };
+    for (const Scene& scene : scenes)
+        RunScene(scene, iterations);
+
+    ImGui::DestroyContext();
+    return 0;
+}
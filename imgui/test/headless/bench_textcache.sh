@@ -0,0 +1,13 @@
+#!/bin/sh
+# Builds bench_textcache.cpp with and without the text layout cache, prints both frame times and hit rates and fails if the output differs.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o bench_textcache_cached bench_textcache.cpp
+c++ -O2 -std=c++11 -I ../../in -DIMGUI_DISABLE_TEXT_LAYOUT_CACHE -o bench_textcache_uncached bench_textcache.cpp
+echo "cached:"
+./bench_textcache_cached "${1:-300}" | tee bench_textcache_cached.txt
+echo "uncached:"
+./bench_textcache_uncached "${1:-300}" | tee bench_textcache_uncached.txt
+cut -c1-36 bench_textcache_cached.txt > bench_textcache_cached.hash
+cut -c1-36 bench_textcache_uncached.txt > bench_textcache_uncached.hash
+if cmp -s bench_textcache_cached.hash bench_textcache_uncached.hash; then echo "output identical"; else echo "output differs"; exit 1; fi
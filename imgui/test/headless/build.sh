@@ -0,0 +1,7 @@
+#!/bin/sh
+# Builds and runs the C++ side, then runs the Odin port against its records.
+set -e
+cd "$(dirname "$0")"
+c++ -O2 -std=c++11 -I ../../in -o headless_cpp headless.cpp
+./headless_cpp "${1:-600}" headless_cpp.bin
+odin run . -o:speed -- "${1:-600}" headless_cpp.bin headless_odin.bin
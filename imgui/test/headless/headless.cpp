@@ -0,0 +1,167 @@
+// Dear ImGui: headless parity harness, C++ side
+
+// Runs the same scene as main.cpp / main.odin without any platform or renderer, feeding it scripted input.
+// Every frame is recorded as counts + a hash of the draw data, plus the time spent in each phase.
+// The Odin side (main.odin in this directory) runs the identical script and compares its records against ours.
+//
+// Usage: headless_cpp [frame_count] [output_file]      (defaults: 600, headless_cpp.bin)
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../stb_truetype.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.cpp"
+char ImGuiTextBuffer::EmptyString[1] = { 0 };
+#include "imgui_draw.cpp"
+#include "imgui_widgets.cpp"
+#include "imgui_tables.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include "headless_record.h"
+
+static ImU64 NowNs()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// FNV-1a over everything a renderer would consume, except texture ids and callbacks which are pointers.
+static ImU64 HashBytes(ImU64 hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    return hash;
+}
+
+static void RecordDrawData(const ImDrawData* draw_data, HeadlessFrameRecord* record)
+{
+    ImU64 hash = 0xCBF29CE484222325ull;
+    record->CmdListCount = (ImU32)draw_data->CmdListsCount;
+    record->VtxCount = (ImU32)draw_data->TotalVtxCount;
+    record->IdxCount = (ImU32)draw_data->TotalIdxCount;
+    record->CmdCount = 0;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        hash = HashBytes(hash, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        hash = HashBytes(hash, draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+        for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        {
+            hash = HashBytes(hash, &cmd.ClipRect, sizeof(cmd.ClipRect));
+            hash = HashBytes(hash, &cmd.VtxOffset, sizeof(cmd.VtxOffset));
+            hash = HashBytes(hash, &cmd.IdxOffset, sizeof(cmd.IdxOffset));
+            hash = HashBytes(hash, &cmd.ElemCount, sizeof(cmd.ElemCount));
+        }
+        record->CmdCount += (ImU32)draw_list->CmdBuffer.Size;
+    }
+    record->Hash = hash;
+}
+
+// Has to stay in sync with headless_script() in main.odin.
+static void ApplyScript(ImGuiIO& io, int frame, bool* show_another_window)
+{
+    io.AddMousePosEvent(40.0f + (float)((frame * 7) % 560), 40.0f + (float)((frame * 5) % 360));
+    if (frame % 60 == 20)
+        io.AddMouseButtonEvent(ImGuiMouseButton_Left, true);
+    if (frame % 60 == 22)
+        io.AddMouseButtonEvent(ImGuiMouseButton_Left, false);
+    if (frame % 120 == 90)
+        io.AddMouseWheelEvent(0.0f, -1.0f);
+    if (frame % 300 == 150)
+        *show_another_window = !*show_another_window;
+}
+
+int main(int argc, char** argv)
+{
+    const int frame_count = argc > 1 ? atoi(argv[1]) : 600;
+    const char* output_file = argc > 2 ? argv[2] : "headless_cpp.bin";
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::StyleColorsDark();
+
+    // Null renderer: build the atlas so the font is usable, but never upload it anywhere.
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+
+    bool show_demo_window = true;
+    bool show_another_window = false;
+    ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
+    float f = 0.0f;
+    int counter = 0;
+
+    HeadlessFrameRecord* records = (HeadlessFrameRecord*)calloc((size_t)frame_count, sizeof(HeadlessFrameRecord));
+    for (int frame = 0; frame < frame_count; frame++)
+    {
+        HeadlessFrameRecord* record = &records[frame];
+        ApplyScript(io, frame, &show_another_window);
+
+        ImU64 t0 = NowNs();
+        ImGui::NewFrame();
+        ImU64 t1 = NowNs();
+
+        // Same scene as main.cpp, minus ShowDemoWindow() which the Odin port doesn't have.
+        if (show_demo_window)
+            ImGui::ShowDebugLogWindow(&show_demo_window);
+        {
+            ImGui::Begin("Hello, world!");
+            ImGui::Text("This is some useful text.");
+            ImGui::Checkbox("Demo Window", &show_demo_window);
+            ImGui::Checkbox("Another Window", &show_another_window);
+            ImGui::SliderFloat("float", &f, 0.0f, 1.0f);
+            ImGui::ColorEdit3("clear color", (float*)&clear_color);
+            if (ImGui::Button("Button"))
+                counter++;
+            ImGui::SameLine();
+            ImGui::Text("counter = %d", counter);
+            ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
+            ImGui::End();
+        }
+        if (show_another_window)
+        {
+            ImGui::Begin("Another Window", &show_another_window);
+            ImGui::Text("Hello from another window!");
+            if (ImGui::Button("Close Me"))
+                show_another_window = false;
+            ImGui::End();
+        }
+        ImU64 t2 = NowNs();
+
+        ImGui::Render();
+        ImU64 t3 = NowNs();
+
+        record->NewFrameNs = t1 - t0;
+        record->SceneNs = t2 - t1;
+        record->RenderNs = t3 - t2;
+        RecordDrawData(ImGui::GetDrawData(), record);
+    }
+
+    ImGui::DestroyContext();
+
+    if (!HeadlessWriteRecords(output_file, records, frame_count))
+    {
+        fprintf(stderr, "Failed to write %s\n", output_file);
+        return 1;
+    }
+
+    // Frame 0 includes one time setup, leave it out like main.odin does.
+    ImU64 totals[3] = {};
+    const int measured = frame_count > 1 ? frame_count - 1 : 1;
+    for (int frame = 1; frame < frame_count; frame++)
+    {
+        totals[0] += records[frame].NewFrameNs;
+        totals[1] += records[frame].SceneNs;
+        totals[2] += records[frame].RenderNs;
+    }
+    printf("frames %d\n", frame_count);
+    printf("new_frame_us %.3f\nscene_us %.3f\nrender_us %.3f\n", totals[0] / 1000.0 / measured, totals[1] / 1000.0 / measured, totals[2] / 1000.0 / measured);
+    free(records);
+    return 0;
+}
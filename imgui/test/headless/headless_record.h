@@ -0,0 +1,44 @@
+// Dear ImGui: headless parity harness, record file layout shared with main.odin
+
+// File: HeadlessFileHeader followed by FrameCount HeadlessFrameRecord, little endian, no padding.
+
+#pragma once
+
+#include <stdio.h>
+
+#define HEADLESS_MAGIC      0x4C48494Du     // "MIHL"
+#define HEADLESS_VERSION    1
+
+struct HeadlessFileHeader
+{
+    ImU32   Magic;
+    ImU32   Version;
+    ImU32   FrameCount;
+    ImU32   RecordSize;
+};
+
+struct HeadlessFrameRecord
+{
+    ImU32   CmdListCount;
+    ImU32   CmdCount;
+    ImU32   VtxCount;
+    ImU32   IdxCount;
+    ImU64   Hash;       // FNV-1a over vertices, indices and draw command clip rects/offsets/counts
+    ImU64   NewFrameNs;
+    ImU64   SceneNs;
+    ImU64   RenderNs;
+};
+static_assert(sizeof(HeadlessFileHeader) == 16, "");
+static_assert(sizeof(HeadlessFrameRecord) == 48, "");
+
+static bool HeadlessWriteRecords(const char* path, const HeadlessFrameRecord* records, int frame_count)
+{
+    FILE* f = fopen(path, "wb");
+    if (!f)
+        return false;
+    HeadlessFileHeader header = { HEADLESS_MAGIC, HEADLESS_VERSION, (ImU32)frame_count, (ImU32)sizeof(HeadlessFrameRecord) };
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    ok &= fwrite(records, sizeof(HeadlessFrameRecord), (size_t)frame_count, f) == (size_t)frame_count;
+    ok &= fclose(f) == 0;
+    return ok;
+}
@@ -0,0 +1,211 @@
+package test_headless
+
+import "core:fmt"
+import "core:os"
+import "core:time"
+import "core:strconv"
+import im "../../out_manual"
+
+// Odin side of the headless parity harness, see headless.cpp.
+// Runs the identical script against the port, writes its own records and compares them to the ones written by the C++ build.
+//
+// Usage: odin run imgui/test/headless -- [frame_count] [cpp_records] [output_file]
+//        (defaults: 600, headless_cpp.bin, headless_odin.bin)
+
+HEADLESS_MAGIC   :: 0x4C48494D // "MIHL"
+HEADLESS_VERSION :: 1
+
+HeadlessFileHeader :: struct #packed {
+	magic, version, frame_count, record_size : u32,
+}
+
+HeadlessFrameRecord :: struct #packed {
+	cmd_list_count, cmd_count, vtx_count, idx_count : u32,
+	hash : u64,
+	new_frame_ns, scene_ns, render_ns : u64,
+}
+
+#assert(size_of(HeadlessFileHeader) == 16)
+#assert(size_of(HeadlessFrameRecord) == 48)
+
+main :: proc()
+{
+	frame_count := len(os.args) > 1 ? strconv.atoi(os.args[1]) : 600
+	cpp_records_path := len(os.args) > 2 ? os.args[2] : "headless_cpp.bin"
+	output_path := len(os.args) > 3 ? os.args[3] : "headless_odin.bin"
+
+	im.CHECKVERSION()
+	im.CreateContext()
+	io := im.GetIO()
+	io.IniFilename = ""
+	io.DisplaySize = { 1280, 800 }
+	io.DeltaTime = 1.0 / 60.0
+	im.StyleColorsDark()
+
+	// null renderer
+	pixels : ^u8
+	width, height : i32
+	im.GetTexDataAsRGBA32(io.Fonts, &pixels, &width, &height)
+	im.SetTexID(io.Fonts, 1)
+
+	show_demo := true
+	show_other := false
+	clear_color := im.Vec4{.45, .55, .60, 1}
+	f : f32 = 0
+	counter := 0
+
+	records := make([]HeadlessFrameRecord, frame_count)
+	for &record, frame in records {
+		headless_script(io, frame, &show_other)
+
+		t0 := time.tick_now()
+		im.NewFrame()
+		t1 := time.tick_now()
+
+		if show_demo { im.ShowDebugLogWindow(&show_demo) }
+		{
+			im.Begin("Hello, world!")
+			im.Text("This is some useful text.")
+			im.Checkbox("Demo Window", &show_demo)
+			im.Checkbox("Another Window", &show_other)
+			im.SliderFloat("float", &f, 0, 1)
+			im.ColorEdit3("clear color", cast(^[3]f32)&clear_color)
+			if im.Button("Button") { counter += 1 }
+			im.SameLine()
+			im.Text("counter = %d", counter)
+			im.Text("Application average %.3f ms/frame (%.1f FPS)", 1000 / io.Framerate, io.Framerate)
+			im.End()
+		}
+		if show_other {
+			im.Begin("Another Window", &show_other)
+			im.Text("Hello from another window!")
+			if im.Button("Close Me") { show_other = false }
+			im.End()
+		}
+		t2 := time.tick_now()
+
+		im.Render()
+		t3 := time.tick_now()
+
+		record.new_frame_ns = u64(time.tick_diff(t0, t1))
+		record.scene_ns     = u64(time.tick_diff(t1, t2))
+		record.render_ns    = u64(time.tick_diff(t2, t3))
+		record_draw_data(im.GetDrawData(), &record)
+	}
+
+	im.DestroyContext()
+
+	if !write_records(output_path, records) {
+		fmt.eprintfln("Failed to write %v", output_path)
+		os.exit(1)
+	}
+
+	cpp_records, ok := read_records(cpp_records_path)
+	if !ok {
+		fmt.eprintfln("No usable C++ records at %v, run headless_cpp first.", cpp_records_path)
+		os.exit(1)
+	}
+	os.exit(compare_records(cpp_records, records) ? 0 : 1)
+}
+
+// Has to stay in sync with ApplyScript() in headless.cpp.
+headless_script :: proc(io : ^im.IO, frame : int, show_other : ^bool)
+{
+	im.AddMousePosEvent(io, 40 + f32((frame * 7) % 560), 40 + f32((frame * 5) % 360))
+	if frame % 60 == 20 { im.AddMouseButtonEvent(io, .MouseButton_Left, true) }
+	if frame % 60 == 22 { im.AddMouseButtonEvent(io, .MouseButton_Left, false) }
+	if frame % 120 == 90 { im.AddMouseWheelEvent(io, 0, -1) }
+	if frame % 300 == 150 { show_other^ = !show_other^ }
+}
+
+record_draw_data :: proc(draw_data : ^im.DrawData, record : ^HeadlessFrameRecord)
+{
+	hash_bytes :: proc(hash : u64, data : rawptr, size : int) -> u64
+	{
+		hash := hash
+		for b in (cast([^]u8) data)[:size] { hash = (hash ~ u64(b)) * 0x100000001B3 }
+		return hash
+	}
+
+	hash : u64 = 0xCBF29CE484222325
+	record.cmd_list_count = u32(draw_data.CmdListsCount)
+	record.vtx_count = u32(draw_data.TotalVtxCount)
+	record.idx_count = u32(draw_data.TotalIdxCount)
+	for draw_list in draw_data.CmdLists.Data[:draw_data.CmdLists.Size] {
+		hash = hash_bytes(hash, draw_list.VtxBuffer.Data, int(draw_list.VtxBuffer.Size) * size_of(im.DrawVert))
+		hash = hash_bytes(hash, draw_list.IdxBuffer.Data, int(draw_list.IdxBuffer.Size) * size_of(im.DrawIdx))
+		for &cmd in draw_list.CmdBuffer.Data[:draw_list.CmdBuffer.Size] {
+			hash = hash_bytes(hash, &cmd.ClipRect, size_of(cmd.ClipRect))
+			hash = hash_bytes(hash, &cmd.VtxOffset, size_of(cmd.VtxOffset))
+			hash = hash_bytes(hash, &cmd.IdxOffset, size_of(cmd.IdxOffset))
+			hash = hash_bytes(hash, &cmd.ElemCount, size_of(cmd.ElemCount))
+		}
+		record.cmd_count += u32(draw_list.CmdBuffer.Size)
+	}
+	record.hash = hash
+}
+
+write_records :: proc(path : string, records : []HeadlessFrameRecord) -> bool
+{
+	header := HeadlessFileHeader{ HEADLESS_MAGIC, HEADLESS_VERSION, u32(len(records)), size_of(HeadlessFrameRecord) }
+
+	data := make([]u8, size_of(header) + len(records) * size_of(HeadlessFrameRecord), context.temp_allocator)
+	(cast(^HeadlessFileHeader) raw_data(data))^ = header
+	copy(data[size_of(header):], (cast([^]u8) raw_data(records))[:len(records) * size_of(HeadlessFrameRecord)])
+	return os.write_entire_file(path, data)
+}
+
+read_records :: proc(path : string) -> (records : []HeadlessFrameRecord, ok : bool)
+{
+	data := os.read_entire_file(path) or_return
+	if len(data) < size_of(HeadlessFileHeader) { return }
+
+	header := (cast(^HeadlessFileHeader) raw_data(data))^
+	if header.magic != HEADLESS_MAGIC || header.version != HEADLESS_VERSION || header.record_size != size_of(HeadlessFrameRecord) { return }
+	if len(data) != size_of(header) + int(header.frame_count) * size_of(HeadlessFrameRecord) { return }
+
+	return (cast([^]HeadlessFrameRecord) &data[size_of(header)])[:header.frame_count], true
+}
+
+// Reports the first frames that differ and the per phase time ratio odin / c++. Frame 0 is left out of the timings, it includes one time setup.
+compare_records :: proc(cpp, odin : []HeadlessFrameRecord) -> (equivalent : bool)
+{
+	if len(cpp) != len(odin) {
+		fmt.printfln("frame count differs: c++ %v, odin %v", len(cpp), len(odin))
+		return false
+	}
+
+	MAX_REPORTED :: 10
+	count_mismatches, hash_mismatches := 0, 0
+	for frame in 0..<len(cpp) {
+		c, o := cpp[frame], odin[frame]
+		if c.cmd_list_count != o.cmd_list_count || c.cmd_count != o.cmd_count || c.vtx_count != o.vtx_count || c.idx_count != o.idx_count {
+			if count_mismatches < MAX_REPORTED {
+				fmt.printfln("frame %v: counts differ: c++ %v lists %v cmds %v vtx %v idx, odin %v lists %v cmds %v vtx %v idx", frame,
+					c.cmd_list_count, c.cmd_count, c.vtx_count, c.idx_count, o.cmd_list_count, o.cmd_count, o.vtx_count, o.idx_count)
+			}
+			count_mismatches += 1
+		}
+		else if c.hash != o.hash {
+			if hash_mismatches < MAX_REPORTED { fmt.printfln("frame %v: same counts but different vertex/index/command data", frame) }
+			hash_mismatches += 1
+		}
+	}
+
+	cpp_totals, odin_totals : [3]f64
+	for frame in 1..<len(cpp) {
+		cpp_totals  += { f64(cpp[frame].new_frame_ns),  f64(cpp[frame].scene_ns),  f64(cpp[frame].render_ns)  }
+		odin_totals += { f64(odin[frame].new_frame_ns), f64(odin[frame].scene_ns), f64(odin[frame].render_ns) }
+	}
+
+	measured := f64(max(len(cpp) - 1, 1))
+	fmt.printfln("frames %v", len(cpp))
+	fmt.printfln("count_mismatches %v", count_mismatches)
+	fmt.printfln("hash_mismatches %v", hash_mismatches)
+	for name, i in ([3]string{ "new_frame", "scene", "render" }) {
+		ratio := cpp_totals[i] > 0 ? odin_totals[i] / cpp_totals[i] : 0
+		fmt.printfln("%v_us cpp %.3f odin %.3f ratio %.2f", name, cpp_totals[i] / 1000 / measured, odin_totals[i] / 1000 / measured, ratio)
+	}
+
+	return count_mismatches == 0 && hash_mismatches == 0
+}